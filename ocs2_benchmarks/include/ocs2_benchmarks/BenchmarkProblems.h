@@ -0,0 +1,84 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <ocs2_core/Types.h>
+#include <ocs2_ddp/DDP_Settings.h>
+#include <ocs2_ipm/IpmSettings.h>
+#include <ocs2_oc/rollout/RolloutBase.h>
+#include <ocs2_robotic_tools/common/RobotInterface.h>
+#include <ocs2_slp/SlpSettings.h>
+#include <ocs2_sqp/SqpSettings.h>
+
+namespace ocs2 {
+namespace benchmark {
+
+/**
+ * A fixed snapshot of an example problem: the robot interface loaded from the task file shipped with the example, the settings of each
+ * solver, the initial state and the target trajectories. The snapshot does not change between runs, such that the timings of different
+ * builds are comparable.
+ */
+struct BenchmarkProblem {
+  std::string name;
+
+  /** Owns the optimal control problem, the initializer and the reference manager */
+  std::unique_ptr<RobotInterface> robotInterfacePtr;
+  /** Rollout of the robot interface, used by the DDP solvers */
+  const RolloutBase* rolloutPtr = nullptr;
+
+  ddp::Settings ddpSettings;
+  sqp::Settings sqpSettings;
+  ipm::Settings ipmSettings;
+  slp::Settings slpSettings;
+
+  scalar_t initTime = 0.0;
+  scalar_t finalTime = 1.0;
+  vector_t initialState;
+};
+
+/** Gets the names of the problems in the corpus: cartpole, ballbot, quadrotor, mobile_manipulator and legged_robot. */
+std::vector<std::string> getProblemNames();
+
+/**
+ * Loads a problem of the corpus. The settings of a solver that has no section in the task file of the example are loaded with their
+ * default values.
+ *
+ * @param [in] name : Name of the problem, see getProblemNames().
+ * @param [in] libraryFolder : Folder for the auto-generated CppAD libraries.
+ * @return the loaded problem
+ */
+std::unique_ptr<BenchmarkProblem> loadProblem(const std::string& name, const std::string& libraryFolder);
+
+}  // namespace benchmark
+}  // namespace ocs2
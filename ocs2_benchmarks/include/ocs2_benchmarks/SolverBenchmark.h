@@ -0,0 +1,128 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <memory>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <ocs2_core/Types.h>
+#include <ocs2_oc/oc_solver/SolverBase.h>
+
+#include "ocs2_benchmarks/BenchmarkProblems.h"
+
+namespace ocs2 {
+namespace benchmark {
+
+/** Gets the names of the benchmarked solvers: SQP, IPM, SLP, SLQ and ILQR. */
+inline std::vector<std::string> getSolverNames() {
+  return {"SQP", "IPM", "SLP", "SLQ", "ILQR"};
+}
+
+/** Settings of a benchmark run. */
+struct Settings {
+  /** Problems to run, all problems of the corpus if empty */
+  std::vector<std::string> problems;
+  /** Solvers to run, see getSolverNames() */
+  std::vector<std::string> solvers = getSolverNames();
+  /** Number of threads of the solvers. Each value is a separate benchmark, used to report the scaling. */
+  std::vector<size_t> nThreads = {1, 2, 4};
+  /** Number of measured runs per benchmark */
+  size_t numRepetitions = 10;
+  /** Number of runs before the measurement */
+  size_t numWarmupRuns = 1;
+  /** If false, the solver is reset before each run (cold start). Otherwise it is warm started with the previous solution. */
+  bool warmStart = false;
+  /** Folder for the auto-generated CppAD libraries */
+  std::string libraryFolder = "/tmp/ocs2_benchmarks";
+  /** Whether to collect the per-phase times in additional traced runs */
+  bool tracePhases = true;
+};
+
+/** Result of a benchmark. All times are in milliseconds and all counts are per run. */
+struct Result {
+  std::string problemName;
+  std::string solverName;
+  size_t nThreads = 1;
+  size_t numRepetitions = 0;
+
+  scalar_t medianTime = 0.0;
+  scalar_t minTime = 0.0;
+  scalar_t maxTime = 0.0;
+  scalar_t meanIterations = 0.0;
+  /** The merit of the last solution, to detect changes in the computed solution */
+  scalar_t merit = 0.0;
+
+  /** Whether the allocations were counted, see allocation::isTrackingEnabled() */
+  bool hasAllocations = false;
+  scalar_t meanAllocations = 0.0;
+  scalar_t meanAllocatedBytes = 0.0;
+
+  /** Mean time of each traced zone per run, over all threads */
+  std::vector<std::pair<std::string, scalar_t>> phaseTimes;
+
+  /** Message of the exception if the benchmark failed */
+  std::string error;
+};
+
+/**
+ * Creates a solver for the given problem.
+ *
+ * @param [in] solverName : One of SQP, IPM, SLP, SLQ or ILQR.
+ * @param [in] problem : The benchmark problem.
+ * @param [in] nThreads : Number of threads of the solver.
+ * @return the solver with the reference manager of the problem
+ */
+std::unique_ptr<SolverBase> createSolver(const std::string& solverName, const BenchmarkProblem& problem, size_t nThreads);
+
+/**
+ * Runs a single benchmark. The measured runs are not traced. The per-phase times are collected in the same number of additional runs
+ * with the tracer enabled (see ocs2_core/misc/Trace.h), such that the tracing overhead does not distort the measured times. The heap
+ * allocations of the measured runs are counted if ocs2_core is built with OCS2_ALLOCATION_TRACKING (see AllocationTracking.h).
+ * Exceptions thrown by the solver are caught and reported in Result::error.
+ */
+Result runBenchmark(const BenchmarkProblem& problem, const std::string& solverName, size_t nThreads, const Settings& settings);
+
+/** Runs all combinations of problems, solvers and number of threads of the settings. */
+std::vector<Result> runBenchmarks(const Settings& settings);
+
+/**
+ * Prints the results as a table. The speedup is relative to the run of the same problem and solver with the fewest threads.
+ * @param [in] printPhases : Whether to print the per-phase times below each benchmark.
+ */
+void printResults(std::ostream& stream, const std::vector<Result>& results, bool printPhases = true);
+
+/** Writes the results in CSV format with one row per benchmark and phase. */
+void writeCsv(std::ostream& stream, const std::vector<Result>& results);
+
+}  // namespace benchmark
+}  // namespace ocs2
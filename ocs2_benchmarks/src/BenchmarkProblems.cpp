@@ -0,0 +1,198 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_benchmarks/BenchmarkProblems.h"
+
+#include <stdexcept>
+
+#include <ocs2_ballbot/BallbotInterface.h>
+#include <ocs2_ballbot/definitions.h>
+#include <ocs2_cartpole/CartPoleInterface.h>
+#include <ocs2_legged_robot/LeggedRobotInterface.h>
+#include <ocs2_mobile_manipulator/MobileManipulatorInterface.h>
+#include <ocs2_quadrotor/QuadrotorInterface.h>
+#include <ocs2_quadrotor/definitions.h>
+#include <ocs2_robotic_assets/package_path.h>
+
+#include "ocs2_benchmarks/config_folders.h"
+
+namespace ocs2 {
+namespace benchmark {
+
+namespace {
+
+/** Loads the settings of the solvers which are not exposed by the robot interface. */
+void loadMissingSettings(const std::string& taskFile, BenchmarkProblem& problem) {
+  problem.sqpSettings = sqp::loadSettings(taskFile, "sqp", false);
+  problem.ipmSettings = ipm::loadSettings(taskFile, "ipm", false);
+  problem.slpSettings = slp::loadSettings(taskFile, "slp", false);
+}
+
+std::unique_ptr<BenchmarkProblem> loadCartpole(const std::string& libraryFolder) {
+  const std::string taskFile = std::string(config_folders::cartpole) + "/mpc/task.info";
+  auto interfacePtr = std::make_unique<cartpole::CartPoleInterface>(taskFile, libraryFolder + "/cartpole", false);
+
+  auto problemPtr = std::make_unique<BenchmarkProblem>();
+  loadMissingSettings(taskFile, *problemPtr);
+  problemPtr->ddpSettings = interfacePtr->ddpSettings();
+  problemPtr->finalTime = problemPtr->initTime + interfacePtr->mpcSettings().timeHorizon_;
+  problemPtr->initialState = interfacePtr->getInitialState();
+  problemPtr->rolloutPtr = &interfacePtr->getRollout();
+  problemPtr->robotInterfacePtr = std::move(interfacePtr);
+  return problemPtr;
+}
+
+std::unique_ptr<BenchmarkProblem> loadBallbot(const std::string& libraryFolder) {
+  const std::string taskFile = std::string(config_folders::ballbot) + "/mpc/task.info";
+  auto interfacePtr = std::make_unique<ballbot::BallbotInterface>(taskFile, libraryFolder + "/ballbot");
+
+  auto problemPtr = std::make_unique<BenchmarkProblem>();
+  loadMissingSettings(taskFile, *problemPtr);
+  problemPtr->ddpSettings = interfacePtr->ddpSettings();
+  problemPtr->sqpSettings = interfacePtr->sqpSettings();
+  problemPtr->slpSettings = interfacePtr->slpSettings();
+  problemPtr->finalTime = problemPtr->initTime + interfacePtr->mpcSettings().timeHorizon_;
+  problemPtr->initialState = interfacePtr->getInitialState();
+
+  // move one meter forward
+  vector_t targetState = problemPtr->initialState;
+  targetState(0) += 1.0;
+  interfacePtr->getReferenceManagerPtr()->setTargetTrajectories(
+      TargetTrajectories({problemPtr->initTime}, {targetState}, {vector_t::Zero(ballbot::INPUT_DIM)}));
+
+  problemPtr->rolloutPtr = &interfacePtr->getRollout();
+  problemPtr->robotInterfacePtr = std::move(interfacePtr);
+  return problemPtr;
+}
+
+std::unique_ptr<BenchmarkProblem> loadQuadrotor(const std::string& libraryFolder) {
+  const std::string taskFile = std::string(config_folders::quadrotor) + "/mpc/task.info";
+  auto interfacePtr = std::make_unique<quadrotor::QuadrotorInterface>(taskFile, libraryFolder + "/quadrotor");
+
+  auto problemPtr = std::make_unique<BenchmarkProblem>();
+  loadMissingSettings(taskFile, *problemPtr);
+  problemPtr->ddpSettings = interfacePtr->ddpSettings();
+  problemPtr->finalTime = problemPtr->initTime + interfacePtr->mpcSettings().timeHorizon_;
+  problemPtr->initialState = interfacePtr->getInitialState();
+
+  // climb one meter
+  vector_t targetState = problemPtr->initialState;
+  targetState(2) += 1.0;
+  interfacePtr->getReferenceManagerPtr()->setTargetTrajectories(
+      TargetTrajectories({problemPtr->initTime}, {targetState}, {vector_t::Zero(quadrotor::INPUT_DIM)}));
+
+  problemPtr->rolloutPtr = &interfacePtr->getRollout();
+  problemPtr->robotInterfacePtr = std::move(interfacePtr);
+  return problemPtr;
+}
+
+std::unique_ptr<BenchmarkProblem> loadMobileManipulator(const std::string& libraryFolder) {
+  const std::string taskFile = std::string(config_folders::mobileManipulator) + "/franka/task.info";
+  const std::string urdfFile = robotic_assets::getPath() + "/resources/mobile_manipulator/franka/urdf/panda.urdf";
+  auto interfacePtr =
+      std::make_unique<mobile_manipulator::MobileManipulatorInterface>(taskFile, libraryFolder + "/mobile_manipulator", urdfFile);
+
+  auto problemPtr = std::make_unique<BenchmarkProblem>();
+  loadMissingSettings(taskFile, *problemPtr);
+  problemPtr->ddpSettings = interfacePtr->ddpSettings();
+  problemPtr->finalTime = problemPtr->initTime + interfacePtr->mpcSettings().timeHorizon_;
+  problemPtr->initialState = interfacePtr->getInitialState();
+
+  // end-effector pose target
+  vector_t targetPose(7);
+  targetPose.head(3) << 1.0, 0.0, 1.0;
+  targetPose.tail(4) << Eigen::Quaternion<scalar_t>(1.0, 0.0, 0.0, 0.0).coeffs();
+  const size_t inputDim = interfacePtr->getManipulatorModelInfo().inputDim;
+  interfacePtr->getReferenceManagerPtr()->setTargetTrajectories(
+      TargetTrajectories({problemPtr->initTime}, {targetPose}, {vector_t::Zero(inputDim)}));
+
+  problemPtr->rolloutPtr = &interfacePtr->getRollout();
+  problemPtr->robotInterfacePtr = std::move(interfacePtr);
+  return problemPtr;
+}
+
+std::unique_ptr<BenchmarkProblem> loadLeggedRobot(const std::string&) {
+  // the legged robot reads its library folder from the task file
+  const std::string configFolder = config_folders::leggedRobot;
+  const std::string taskFile = configFolder + "/mpc/task.info";
+  const std::string referenceFile = configFolder + "/command/reference.info";
+  const std::string urdfFile = robotic_assets::getPath() + "/resources/anymal_c/urdf/anymal.urdf";
+  auto interfacePtr = std::make_unique<legged_robot::LeggedRobotInterface>(taskFile, urdfFile, referenceFile);
+
+  auto problemPtr = std::make_unique<BenchmarkProblem>();
+  loadMissingSettings(taskFile, *problemPtr);
+  problemPtr->ddpSettings = interfacePtr->ddpSettings();
+  problemPtr->sqpSettings = interfacePtr->sqpSettings();
+  problemPtr->ipmSettings = interfacePtr->ipmSettings();
+  problemPtr->finalTime = problemPtr->initTime + interfacePtr->mpcSettings().timeHorizon_;
+  problemPtr->initialState = interfacePtr->getInitialState();
+
+  // stand still
+  const size_t inputDim = interfacePtr->getCentroidalModelInfo().inputDim;
+  interfacePtr->getReferenceManagerPtr()->setTargetTrajectories(
+      TargetTrajectories({problemPtr->initTime}, {problemPtr->initialState}, {vector_t::Zero(inputDim)}));
+
+  problemPtr->rolloutPtr = &interfacePtr->getRollout();
+  problemPtr->robotInterfacePtr = std::move(interfacePtr);
+  return problemPtr;
+}
+
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::vector<std::string> getProblemNames() {
+  return {"cartpole", "ballbot", "quadrotor", "mobile_manipulator", "legged_robot"};
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::unique_ptr<BenchmarkProblem> loadProblem(const std::string& name, const std::string& libraryFolder) {
+  std::unique_ptr<BenchmarkProblem> problemPtr;
+  if (name == "cartpole") {
+    problemPtr = loadCartpole(libraryFolder);
+  } else if (name == "ballbot") {
+    problemPtr = loadBallbot(libraryFolder);
+  } else if (name == "quadrotor") {
+    problemPtr = loadQuadrotor(libraryFolder);
+  } else if (name == "mobile_manipulator") {
+    problemPtr = loadMobileManipulator(libraryFolder);
+  } else if (name == "legged_robot") {
+    problemPtr = loadLeggedRobot(libraryFolder);
+  } else {
+    throw std::invalid_argument("[loadProblem] Unknown benchmark problem: " + name);
+  }
+  problemPtr->name = name;
+  return problemPtr;
+}
+
+}  // namespace benchmark
+}  // namespace ocs2
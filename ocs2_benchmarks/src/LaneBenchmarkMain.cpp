@@ -0,0 +1,199 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <ocs2_core/cost/QuadraticStateInputCost.h>
+#include <ocs2_core/integration/SensitivityIntegrator.h>
+#include <ocs2_oc/multiple_shooting/Transcription.h>
+#include <ocs2_oc/oc_problem/OptimalControlProblem.h>
+
+#include <ocs2_ballbot/dynamics/BallbotSystemDynamics.h>
+
+using namespace ocs2;
+
+namespace {
+
+using steady_clock_t = std::chrono::steady_clock;
+
+struct Settings {
+  std::vector<size_t> numLanes{0, 4, 8};        // lane counts of the generated flow map, 0 is the scalar library only
+  size_t numNodes = 100;                        // intermediate nodes of the horizon
+  size_t numRepetitions = 200;                  // repetitions of the node setup
+  std::string libraryFolder = "/tmp/ocs2/lane_benchmark";
+  SensitivityIntegratorType integratorType = SensitivityIntegratorType::RK4;
+};
+
+/** Average time of a call to f in microseconds. */
+template <typename Function>
+double timeIt(size_t numRepetitions, Function&& f) {
+  f();  // warm up, sets the dimensions of the buffers
+  const auto startTime = steady_clock_t::now();
+  for (size_t i = 0; i < numRepetitions; i++) {
+    f();
+  }
+  return std::chrono::duration<double, std::micro>(steady_clock_t::now() - startTime).count() / static_cast<double>(numRepetitions);
+}
+
+void printUsage(const char* programName) {
+  std::cerr << "Usage: " << programName << " [options]\n"
+            << "  --lanes <n>,...         lane counts of the generated flow map (default: 0,4,8)\n"
+            << "  --nodes <n>             intermediate nodes of the horizon (default: 100)\n"
+            << "  --repetitions <n>       repetitions of the node setup (default: 200)\n"
+            << "  --integrator <name>     euler, rk2 or rk4 (default: rk4)\n"
+            << "  --library-folder <dir>  folder of the generated libraries (default: /tmp/ocs2/lane_benchmark)\n";
+}
+
+std::vector<size_t> parseLanes(const std::string& arg) {
+  std::vector<size_t> numLanes;
+  size_t begin = 0;
+  while (begin < arg.size()) {
+    const auto end = std::min(arg.find(',', begin), arg.size());
+    numLanes.push_back(std::stoul(arg.substr(begin, end - begin)));
+    begin = end + 1;
+  }
+  return numLanes;
+}
+
+SensitivityIntegratorType parseIntegratorType(const std::string& arg) {
+  if (arg == "euler") {
+    return SensitivityIntegratorType::EULER;
+  } else if (arg == "rk2") {
+    return SensitivityIntegratorType::RK2;
+  } else if (arg == "rk4") {
+    return SensitivityIntegratorType::RK4;
+  }
+  throw std::invalid_argument("Unknown integrator " + arg);
+}
+
+}  // unnamed namespace
+
+/**
+ * Times the multiple shooting transcription of the intermediate nodes of a ballbot horizon, once node by node as in
+ * multiple_shooting::setupIntermediateNode and once in blocks of consecutive nodes whose dynamics are linearized at once, see
+ * multiple_shooting::setupIntermediateNodes. The blocks are those the SQP solver forms for the given number of lanes.
+ */
+int main(int argc, char** argv) {
+  Settings settings;
+  try {
+    for (int i = 1; i < argc; i++) {
+      const std::string arg = argv[i];
+      const auto nextArg = [&]() -> std::string {
+        if (i + 1 >= argc) {
+          throw std::invalid_argument("Missing value of " + arg);
+        }
+        return argv[++i];
+      };
+
+      if (arg == "--lanes") {
+        settings.numLanes = parseLanes(nextArg());
+      } else if (arg == "--nodes") {
+        settings.numNodes = std::stoul(nextArg());
+      } else if (arg == "--repetitions") {
+        settings.numRepetitions = std::stoul(nextArg());
+      } else if (arg == "--integrator") {
+        settings.integratorType = parseIntegratorType(nextArg());
+      } else if (arg == "--library-folder") {
+        settings.libraryFolder = nextArg();
+      } else {
+        printUsage(argv[0]);
+        return arg == "--help" ? 0 : 1;
+      }
+    }
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << "\n";
+    printUsage(argv[0]);
+    return 1;
+  }
+
+  const size_t N = settings.numNodes;
+  const scalar_t dt = 0.01;
+  scalar_array_t time(N + 1);
+  vector_array_t x(N + 1);
+  vector_array_t u(N);
+  for (size_t i = 0; i <= N; i++) {
+    time[i] = i * dt;
+    x[i] = 0.1 * vector_t::Random(ballbot::STATE_DIM);
+    if (i < N) {
+      u[i] = vector_t::Random(ballbot::INPUT_DIM);
+    }
+  }
+
+  const TargetTrajectories targetTrajectories({0.0}, {vector_t::Zero(ballbot::STATE_DIM)}, {vector_t::Zero(ballbot::INPUT_DIM)});
+  auto sensitivityDiscretizer = selectDynamicsSensitivityDiscretization(settings.integratorType);
+  auto blockSensitivityDiscretizer = selectDynamicsSensitivityBlockDiscretization(settings.integratorType);
+
+  std::cout << std::left << std::setw(8) << "lanes" << std::right << std::setw(18) << "node by node [us]" << std::setw(18) << "blocks [us]"
+            << std::setw(12) << "speed-up"
+            << "\n";
+  for (const auto numLanes : settings.numLanes) {
+    OptimalControlProblem problem;
+    const std::string libraryFolder = settings.libraryFolder + "/lanes_" + std::to_string(numLanes);
+    problem.dynamicsPtr.reset(new ballbot::BallbotSystemDynamics(libraryFolder, /*recompileLibraries=*/false, numLanes));
+    problem.costPtr->add("cost", std::make_unique<QuadraticStateInputCost>(matrix_t::Identity(ballbot::STATE_DIM, ballbot::STATE_DIM),
+                                                                           matrix_t::Identity(ballbot::INPUT_DIM, ballbot::INPUT_DIM)));
+    problem.targetTrajectoriesPtr = &targetTrajectories;
+    const auto blockSize = problem.dynamicsPtr->getNumLanes();
+
+    std::vector<multiple_shooting::Transcription> transcriptions(N);
+    const double nodeTime = timeIt(settings.numRepetitions, [&]() {
+      for (size_t i = 0; i < N; i++) {
+        multiple_shooting::setupIntermediateNode(problem, sensitivityDiscretizer, time[i], dt, x[i], x[i + 1], u[i], transcriptions[i]);
+      }
+    });
+
+    SensitivityDiscretizationBlock block;
+    vector_array_t xNext(blockSize);
+    std::vector<multiple_shooting::Transcription> blockTranscriptions(blockSize);
+    const double blockTime = timeIt(settings.numRepetitions, [&]() {
+      for (size_t begin = 0; begin < N; begin += blockSize) {
+        block.resize(std::min(blockSize, N - begin));
+        for (size_t k = 0; k < block.size; k++) {
+          block.t[k] = time[begin + k];
+          block.dt[k] = dt;
+          block.x[k] = x[begin + k];
+          block.u[k] = u[begin + k];
+          xNext[k] = x[begin + k + 1];
+        }
+        multiple_shooting::setupIntermediateNodes(problem, blockSensitivityDiscretizer, block, xNext, blockTranscriptions);
+      }
+    });
+
+    std::cout << std::left << std::setw(8) << numLanes << std::right << std::fixed << std::setprecision(1) << std::setw(18) << nodeTime
+              << std::setw(18) << blockTime << std::setw(12) << std::setprecision(2) << nodeTime / blockTime << "\n";
+  }
+
+  return 0;
+}
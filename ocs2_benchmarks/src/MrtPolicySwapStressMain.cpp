@@ -0,0 +1,246 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <ocs2_core/control/LinearController.h>
+#include <ocs2_mpc/MRT_BASE.h>
+
+using namespace ocs2;
+
+namespace {
+
+using steady_clock_t = std::chrono::steady_clock;
+
+struct Settings {
+  double duration = 10.0;           // [s]
+  double mrtFrequency = 1000.0;     // [Hz]
+  double mpcFrequency = 100.0;      // [Hz]
+  double bufferDelay = 5.0;         // [ms] spent in modifyBufferedSolution
+  size_t numNodes = 100;            // nodes of the policy
+  size_t stateDim = 24;             // state dimension of the policy
+  size_t inputDim = 24;             // input dimension of the policy
+  double resamplingPeriod = 0.0;    // [s] see MRT_BASE::setPolicyResamplingPeriod
+  double maxUpdateLatency = 100.0;  // [us] bound on updatePolicy()
+};
+
+/** Exposes the buffer of MRT_BASE to the producer thread. */
+class StressMrt final : public MRT_BASE {
+ public:
+  void resetMpcNode(const TargetTrajectories&) override {}
+  void setCurrentObservation(const SystemObservation&) override {}
+  using MRT_BASE::moveToBuffer;
+};
+
+/** Simulates an expensive modification of the buffered policy. */
+class SlowBufferObserver final : public MrtObserver {
+ public:
+  explicit SlowBufferObserver(double delay) : delay_(delay) {}
+  void modifyBufferedSolution(const CommandData&, PrimalSolution&) override {
+    std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(delay_));
+  }
+
+ private:
+  double delay_;
+};
+
+void fillPolicy(const Settings& settings, scalar_t initTime, CommandData& command, PrimalSolution& primalSolution) {
+  // the policy covers one second
+  const scalar_t dt = 1.0 / static_cast<scalar_t>(settings.numNodes - 1);
+  vector_array_t bias(settings.numNodes, vector_t::Random(settings.inputDim));
+  matrix_array_t gain(settings.numNodes, matrix_t::Random(settings.inputDim, settings.stateDim));
+  for (size_t k = 0; k < settings.numNodes; k++) {
+    primalSolution.timeTrajectory_.push_back(initTime + k * dt);
+    primalSolution.stateTrajectory_.push_back(vector_t::Random(settings.stateDim));
+    primalSolution.inputTrajectory_.push_back(bias[k]);
+  }
+  primalSolution.controllerPtr_.reset(new LinearController(primalSolution.timeTrajectory_, std::move(bias), std::move(gain)));
+  command.mpcInitObservation_.time = initTime;
+  command.mpcInitObservation_.state = primalSolution.stateTrajectory_.front();
+  command.mpcInitObservation_.input = primalSolution.inputTrajectory_.front();
+}
+
+double percentile(std::vector<double> samples, double p) {
+  if (samples.empty()) {
+    return 0.0;
+  }
+  const auto n = static_cast<size_t>(p * static_cast<double>(samples.size() - 1));
+  std::nth_element(samples.begin(), samples.begin() + n, samples.end());
+  return samples[n];
+}
+
+void printStatistics(const std::string& name, const std::vector<double>& samples) {
+  std::cout << std::left << std::setw(22) << name << std::right << std::fixed << std::setprecision(2) << " p50: " << std::setw(9)
+            << percentile(samples, 0.5) << " [us]  p99: " << std::setw(9) << percentile(samples, 0.99) << " [us]  max: " << std::setw(9)
+            << (samples.empty() ? 0.0 : *std::max_element(samples.begin(), samples.end())) << " [us]\n";
+}
+
+void printUsage(const char* programName) {
+  std::cerr << "Usage: " << programName << " [options]\n"
+            << "  --duration <s>         length of the run (default: 10)\n"
+            << "  --mrt-rate <Hz>        rate of updatePolicy() and evaluatePolicy() (default: 1000)\n"
+            << "  --mpc-rate <Hz>        rate of the new policies (default: 100)\n"
+            << "  --buffer-delay <ms>    time spent in MrtObserver::modifyBufferedSolution (default: 5)\n"
+            << "  --nodes <n>            nodes of the policy (default: 100)\n"
+            << "  --state-dim <n>        state dimension (default: 24)\n"
+            << "  --input-dim <n>        input dimension (default: 24)\n"
+            << "  --resampling <s>       resampling period of the policy, 0 disables the resampling (default: 0)\n"
+            << "  --max-update <us>      fails if an updatePolicy() call takes longer (default: 100)\n";
+}
+
+}  // unnamed namespace
+
+/**
+ * Stress test of the policy swap of MRT_BASE: a producer thread moves new policies into the buffer while the MRT loop updates and
+ * evaluates the policy at a fixed rate. The latency of updatePolicy() must stay bounded independent of the time spent by the producer.
+ */
+int main(int argc, char** argv) {
+  Settings settings;
+  try {
+    for (int i = 1; i < argc; i++) {
+      const std::string arg = argv[i];
+      const auto nextArg = [&]() -> std::string {
+        if (i + 1 >= argc) {
+          throw std::invalid_argument("Missing value of " + arg);
+        }
+        return argv[++i];
+      };
+
+      if (arg == "--duration") {
+        settings.duration = std::stod(nextArg());
+      } else if (arg == "--mrt-rate") {
+        settings.mrtFrequency = std::stod(nextArg());
+      } else if (arg == "--mpc-rate") {
+        settings.mpcFrequency = std::stod(nextArg());
+      } else if (arg == "--buffer-delay") {
+        settings.bufferDelay = std::stod(nextArg());
+      } else if (arg == "--nodes") {
+        settings.numNodes = std::max<size_t>(std::stoul(nextArg()), 2);
+      } else if (arg == "--state-dim") {
+        settings.stateDim = std::stoul(nextArg());
+      } else if (arg == "--input-dim") {
+        settings.inputDim = std::stoul(nextArg());
+      } else if (arg == "--resampling") {
+        settings.resamplingPeriod = std::stod(nextArg());
+      } else if (arg == "--max-update") {
+        settings.maxUpdateLatency = std::stod(nextArg());
+      } else {
+        printUsage(argv[0]);
+        return arg == "--help" ? 0 : 1;
+      }
+    }
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << "\n";
+    printUsage(argv[0]);
+    return 1;
+  }
+
+  StressMrt mrt;
+  mrt.setPolicyResamplingPeriod(settings.resamplingPeriod);
+  mrt.addMrtObserver(std::make_shared<SlowBufferObserver>(settings.bufferDelay));
+
+  const auto startTime = steady_clock_t::now();
+  const auto getTime = [&]() { return std::chrono::duration<scalar_t>(steady_clock_t::now() - startTime).count(); };
+
+  // MPC side
+  std::atomic_bool terminate{false};
+  size_t numPublished = 0;
+  std::thread producer([&]() {
+    const auto period = std::chrono::duration<double>(1.0 / settings.mpcFrequency);
+    auto wakeTime = steady_clock_t::now();
+    while (!terminate) {
+      auto commandPtr = std::make_unique<CommandData>();
+      auto primalSolutionPtr = std::make_unique<PrimalSolution>();
+      fillPolicy(settings, getTime(), *commandPtr, *primalSolutionPtr);
+      mrt.moveToBuffer(std::move(commandPtr), std::move(primalSolutionPtr), std::make_unique<PerformanceIndex>());
+      numPublished++;
+      wakeTime += std::chrono::duration_cast<steady_clock_t::duration>(period);
+      std::this_thread::sleep_until(wakeTime);
+    }
+  });
+
+  while (!mrt.initialPolicyReceived()) {
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+  }
+
+  // MRT loop
+  const auto period = std::chrono::duration_cast<steady_clock_t::duration>(std::chrono::duration<double>(1.0 / settings.mrtFrequency));
+  const auto numTicks = static_cast<size_t>(settings.duration * settings.mrtFrequency);
+  std::vector<double> updateLatency, evaluationLatency;
+  updateLatency.reserve(numTicks);
+  evaluationLatency.reserve(numTicks);
+  size_t numUpdates = 0;
+  size_t numOverruns = 0;
+  vector_t state = vector_t::Zero(settings.stateDim);
+  vector_t mpcState, mpcInput;
+  size_t mode;
+
+  auto wakeTime = steady_clock_t::now();
+  for (size_t tick = 0; tick < numTicks; tick++) {
+    const scalar_t time = getTime();
+    const auto tickStart = steady_clock_t::now();
+    numUpdates += mrt.updatePolicy() ? 1 : 0;
+    const auto updateEnd = steady_clock_t::now();
+    mrt.evaluatePolicy(time, state, mpcState, mpcInput, mode);
+    const auto tickEnd = steady_clock_t::now();
+
+    updateLatency.push_back(std::chrono::duration<double, std::micro>(updateEnd - tickStart).count());
+    evaluationLatency.push_back(std::chrono::duration<double, std::micro>(tickEnd - updateEnd).count());
+
+    wakeTime += period;
+    if (tickEnd > wakeTime) {
+      numOverruns++;
+    }
+    std::this_thread::sleep_until(wakeTime);
+  }
+
+  terminate = true;
+  producer.join();
+
+  std::cout << "MRT ticks: " << numTicks << ", policies published: " << numPublished << ", policy updates: " << numUpdates
+            << ", overruns: " << numOverruns << "\n";
+  printStatistics("updatePolicy", updateLatency);
+  printStatistics("evaluatePolicy", evaluationLatency);
+
+  const double maxUpdateLatency = *std::max_element(updateLatency.begin(), updateLatency.end());
+  if (maxUpdateLatency > settings.maxUpdateLatency) {
+    std::cout << "FAILED: updatePolicy() took " << maxUpdateLatency << " [us] > " << settings.maxUpdateLatency << " [us]\n";
+    return 1;
+  }
+  std::cout << "PASSED\n";
+  return 0;
+}
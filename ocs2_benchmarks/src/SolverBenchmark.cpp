@@ -0,0 +1,294 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_benchmarks/SolverBenchmark.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+
+#include <ocs2_core/misc/AllocationTracking.h>
+#include <ocs2_core/misc/Benchmark.h>
+#include <ocs2_core/misc/Trace.h>
+#include <ocs2_ddp/ILQR.h>
+#include <ocs2_ddp/SLQ.h>
+#include <ocs2_ipm/IpmSolver.h>
+#include <ocs2_slp/SlpSolver.h>
+#include <ocs2_sqp/SqpSolver.h>
+
+namespace ocs2 {
+namespace benchmark {
+
+namespace {
+
+scalar_t getMedian(std::vector<scalar_t> values) {
+  if (values.empty()) {
+    return 0.0;
+  }
+  const auto middle = values.begin() + values.size() / 2;
+  std::nth_element(values.begin(), middle, values.end());
+  return *middle;
+}
+
+std::string getBenchmarkName(const Result& result) {
+  return result.solverName + "/" + result.problemName + "/threads:" + std::to_string(result.nThreads);
+}
+
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::unique_ptr<SolverBase> createSolver(const std::string& solverName, const BenchmarkProblem& problem, size_t nThreads) {
+  const auto& ocp = problem.robotInterfacePtr->getOptimalControlProblem();
+  const auto& initializer = problem.robotInterfacePtr->getInitializer();
+
+  std::unique_ptr<SolverBase> solverPtr;
+  if (solverName == "SQP") {
+    auto settings = problem.sqpSettings;
+    settings.nThreads = nThreads;
+    settings.printSolverStatus = false;
+    settings.printSolverStatistics = false;
+    settings.printLinesearch = false;
+    solverPtr = std::make_unique<SqpSolver>(std::move(settings), ocp, initializer);
+  } else if (solverName == "IPM") {
+    auto settings = problem.ipmSettings;
+    settings.nThreads = nThreads;
+    settings.printSolverStatus = false;
+    settings.printSolverStatistics = false;
+    settings.printLinesearch = false;
+    solverPtr = std::make_unique<IpmSolver>(std::move(settings), ocp, initializer);
+  } else if (solverName == "SLP") {
+    auto settings = problem.slpSettings;
+    settings.nThreads = nThreads;
+    settings.printSolverStatus = false;
+    settings.printSolverStatistics = false;
+    settings.printLinesearch = false;
+    solverPtr = std::make_unique<SlpSolver>(std::move(settings), ocp, initializer);
+  } else if (solverName == "SLQ" || solverName == "ILQR") {
+    auto settings = problem.ddpSettings;
+    settings.algorithm_ = (solverName == "SLQ") ? ddp::Algorithm::SLQ : ddp::Algorithm::ILQR;
+    settings.nThreads_ = nThreads;
+    settings.displayInfo_ = false;
+    settings.displayShortSummary_ = false;
+    if (solverName == "SLQ") {
+      solverPtr = std::make_unique<SLQ>(std::move(settings), *problem.rolloutPtr, ocp, initializer);
+    } else {
+      solverPtr = std::make_unique<ILQR>(std::move(settings), *problem.rolloutPtr, ocp, initializer);
+    }
+  } else {
+    throw std::invalid_argument("[createSolver] Unknown solver: " + solverName);
+  }
+
+  auto referenceManagerPtr = problem.robotInterfacePtr->getReferenceManagerPtr();
+  if (referenceManagerPtr != nullptr) {
+    solverPtr->setReferenceManager(std::move(referenceManagerPtr));
+  }
+  return solverPtr;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+Result runBenchmark(const BenchmarkProblem& problem, const std::string& solverName, size_t nThreads, const Settings& settings) {
+  Result result;
+  result.problemName = problem.name;
+  result.solverName = solverName;
+  result.nThreads = nThreads;
+
+  try {
+    auto solverPtr = createSolver(solverName, problem, nThreads);
+    const auto solve = [&]() {
+      if (!settings.warmStart) {
+        solverPtr->reset();
+      }
+      solverPtr->run(problem.initTime, problem.initialState, problem.finalTime);
+    };
+
+    for (size_t i = 0; i < settings.numWarmupRuns; i++) {
+      solve();
+    }
+
+    // Measured runs
+    const bool wasTracing = trace::isEnabled();
+    trace::setEnabled(false);
+    RepeatedTimer timer;
+    std::vector<scalar_t> runTimes;
+    size_t totalIterations = 0;
+    allocation::AllocationCount totalAllocations;
+    for (size_t i = 0; i < settings.numRepetitions; i++) {
+      const auto allocationsBefore = allocation::getProcessAllocationCount();
+      timer.startTimer();
+      solve();
+      timer.endTimer();
+      totalAllocations += allocation::getProcessAllocationCount() - allocationsBefore;
+      runTimes.push_back(timer.getLastIntervalInMilliseconds());
+      totalIterations += solverPtr->getIterationsLog().size();
+    }
+    result.merit = solverPtr->getPerformanceIndeces().merit;
+
+    // Traced runs for the per-phase times
+    std::map<std::string, scalar_t> phaseTotalTimes;
+    if (settings.tracePhases) {
+      trace::setEnabled(true);
+      for (size_t i = 0; i < settings.numRepetitions; i++) {
+        trace::clear();
+        solve();
+        for (const auto& zone : trace::getZoneStatistics()) {
+          phaseTotalTimes[zone.name] += zone.total;
+        }
+      }
+    }
+    trace::setEnabled(wasTracing);
+
+    const auto numRepetitions = static_cast<scalar_t>(std::max<size_t>(settings.numRepetitions, 1));
+    result.numRepetitions = settings.numRepetitions;
+    result.medianTime = getMedian(runTimes);
+    if (!runTimes.empty()) {
+      result.minTime = *std::min_element(runTimes.begin(), runTimes.end());
+      result.maxTime = *std::max_element(runTimes.begin(), runTimes.end());
+    }
+    result.meanIterations = static_cast<scalar_t>(totalIterations) / numRepetitions;
+    result.hasAllocations = allocation::isTrackingEnabled();
+    result.meanAllocations = static_cast<scalar_t>(totalAllocations.count) / numRepetitions;
+    result.meanAllocatedBytes = static_cast<scalar_t>(totalAllocations.bytes) / numRepetitions;
+    for (const auto& phase : phaseTotalTimes) {
+      result.phaseTimes.emplace_back(phase.first, phase.second / numRepetitions);
+    }
+
+  } catch (const std::exception& e) {
+    result.error = e.what();
+  }
+
+  return result;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::vector<Result> runBenchmarks(const Settings& settings) {
+  const auto problemNames = settings.problems.empty() ? getProblemNames() : settings.problems;
+
+  std::vector<Result> results;
+  for (const auto& problemName : problemNames) {
+    const auto problemPtr = loadProblem(problemName, settings.libraryFolder);
+    for (const auto& solverName : settings.solvers) {
+      for (const auto nThreads : settings.nThreads) {
+        results.push_back(runBenchmark(*problemPtr, solverName, nThreads, settings));
+      }
+    }
+  }
+  return results;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void printResults(std::ostream& stream, const std::vector<Result>& results, bool printPhases) {
+  // reference time of each problem and solver for the speedup
+  std::map<std::string, std::pair<size_t, scalar_t>> referenceTimes;
+  for (const auto& result : results) {
+    if (result.error.empty()) {
+      const auto key = result.solverName + "/" + result.problemName;
+      auto it = referenceTimes.find(key);
+      if (it == referenceTimes.end() || result.nThreads < it->second.first) {
+        referenceTimes[key] = {result.nThreads, result.medianTime};
+      }
+    }
+  }
+
+  size_t nameWidth = 40;
+  for (const auto& result : results) {
+    nameWidth = std::max(nameWidth, getBenchmarkName(result).size() + 2);
+  }
+
+  const std::string separator(nameWidth + 78, '-');
+  stream << separator << "\n";
+  stream << std::left << std::setw(nameWidth) << "Benchmark" << std::right << std::setw(12) << "Time [ms]" << std::setw(12) << "Min [ms]"
+         << std::setw(12) << "Max [ms]" << std::setw(10) << "Iter" << std::setw(12) << "Allocs" << std::setw(12) << "Bytes"
+         << std::setw(8) << "Speedup"
+         << "\n";
+  stream << separator << "\n";
+
+  for (const auto& result : results) {
+    stream << std::left << std::setw(nameWidth) << getBenchmarkName(result) << std::right;
+    if (!result.error.empty()) {
+      stream << "ERROR: " << result.error << "\n";
+      continue;
+    }
+
+    const auto& reference = referenceTimes[result.solverName + "/" + result.problemName];
+    stream << std::fixed << std::setprecision(3) << std::setw(12) << result.medianTime << std::setw(12) << result.minTime << std::setw(12)
+           << result.maxTime << std::setprecision(1) << std::setw(10) << result.meanIterations;
+    if (result.hasAllocations) {
+      stream << std::setprecision(0) << std::setw(12) << result.meanAllocations << std::setw(12) << result.meanAllocatedBytes;
+    } else {
+      stream << std::setw(12) << "-" << std::setw(12) << "-";
+    }
+    stream << std::setprecision(2) << std::setw(7) << reference.second / result.medianTime << "x\n";
+
+    if (printPhases) {
+      for (const auto& phase : result.phaseTimes) {
+        stream << std::left << std::setw(nameWidth) << ("  " + phase.first) << std::right << std::setprecision(3) << std::setw(12)
+               << phase.second << "\n";
+      }
+    }
+  }
+  stream << separator << std::endl;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void writeCsv(std::ostream& stream, const std::vector<Result>& results) {
+  stream << "problem,solver,threads,phase,time_ms,min_ms,max_ms,iterations,allocations,bytes,merit,error\n";
+  for (const auto& result : results) {
+    stream << result.problemName << "," << result.solverName << "," << result.nThreads << ",total," << result.medianTime << ","
+           << result.minTime << "," << result.maxTime << "," << result.meanIterations << ",";
+    if (result.hasAllocations) {
+      stream << result.meanAllocations << "," << result.meanAllocatedBytes;
+    } else {
+      stream << ",";
+    }
+    std::string error = result.error;
+    std::replace(error.begin(), error.end(), ',', ';');
+    std::replace(error.begin(), error.end(), '\n', ' ');
+    stream << "," << result.merit << "," << error << "\n";
+
+    for (const auto& phase : result.phaseTimes) {
+      stream << result.problemName << "," << result.solverName << "," << result.nThreads << "," << phase.first << "," << phase.second
+             << ",,,,,,,\n";
+    }
+  }
+}
+
+}  // namespace benchmark
+}  // namespace ocs2
@@ -0,0 +1,151 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <ocs2_core/misc/AllocationTracking.h>
+#include <ocs2_core/misc/Trace.h>
+
+#include "ocs2_benchmarks/SolverBenchmark.h"
+
+using namespace ocs2;
+
+namespace {
+
+std::vector<std::string> splitList(const std::string& list) {
+  std::vector<std::string> items;
+  std::stringstream stream(list);
+  std::string item;
+  while (std::getline(stream, item, ',')) {
+    if (!item.empty()) {
+      items.push_back(item);
+    }
+  }
+  return items;
+}
+
+void printUsage(const char* programName) {
+  std::cerr << "Usage: " << programName << " [options]\n"
+            << "  --problems <list>      comma separated problems (default: all)\n"
+            << "  --solvers <list>       comma separated solvers out of SQP,IPM,SLP,SLQ,ILQR (default: all)\n"
+            << "  --threads <list>       comma separated number of threads (default: 1,2,4)\n"
+            << "  --repetitions <n>      measured runs per benchmark (default: 10)\n"
+            << "  --warmup <n>           runs before the measurement (default: 1)\n"
+            << "  --warm-start           warm start each run with the previous solution\n"
+            << "  --lib-folder <path>    folder of the auto-generated libraries (default: /tmp/ocs2_benchmarks)\n"
+            << "  --csv <file>           writes the results in CSV format\n"
+            << "  --trace <file>         saves the Chrome trace of the last benchmark\n"
+            << "  --no-phases            does not print the per-phase times, nor trace them unless --csv or --trace is given\n";
+}
+
+}  // unnamed namespace
+
+int main(int argc, char** argv) {
+  benchmark::Settings settings;
+  std::string csvFile;
+  std::string traceFile;
+  bool printPhases = true;
+
+  try {
+    for (int i = 1; i < argc; i++) {
+      const std::string arg = argv[i];
+      const auto nextArg = [&]() -> std::string {
+        if (i + 1 >= argc) {
+          throw std::invalid_argument("Missing value of " + arg);
+        }
+        return argv[++i];
+      };
+
+      if (arg == "--problems") {
+        settings.problems = splitList(nextArg());
+      } else if (arg == "--solvers") {
+        settings.solvers = splitList(nextArg());
+      } else if (arg == "--threads") {
+        settings.nThreads.clear();
+        for (const auto& n : splitList(nextArg())) {
+          settings.nThreads.push_back(std::stoul(n));
+          if (settings.nThreads.back() == 0) {
+            throw std::invalid_argument("The number of threads must be positive");
+          }
+        }
+      } else if (arg == "--repetitions") {
+        settings.numRepetitions = std::stoul(nextArg());
+      } else if (arg == "--warmup") {
+        settings.numWarmupRuns = std::stoul(nextArg());
+      } else if (arg == "--warm-start") {
+        settings.warmStart = true;
+      } else if (arg == "--lib-folder") {
+        settings.libraryFolder = nextArg();
+      } else if (arg == "--csv") {
+        csvFile = nextArg();
+      } else if (arg == "--trace") {
+        traceFile = nextArg();
+      } else if (arg == "--no-phases") {
+        printPhases = false;
+      } else {
+        printUsage(argv[0]);
+        return arg == "--help" ? 0 : 1;
+      }
+    }
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << "\n";
+    printUsage(argv[0]);
+    return 1;
+  }
+
+  settings.tracePhases = printPhases || !csvFile.empty() || !traceFile.empty();
+  if (!allocation::isTrackingEnabled()) {
+    std::cerr << "Allocations are not counted, build ocs2_core with -DOCS2_ALLOCATION_TRACKING=ON to count them.\n";
+  }
+
+  trace::setThreadName("benchmark");
+  const auto results = benchmark::runBenchmarks(settings);
+
+  benchmark::printResults(std::cout, results, printPhases);
+
+  if (!csvFile.empty()) {
+    std::ofstream csvStream(csvFile);
+    benchmark::writeCsv(csvStream, results);
+  }
+  if (!traceFile.empty()) {
+    trace::saveChromeTrace(traceFile);
+  }
+
+  for (const auto& result : results) {
+    if (!result.error.empty()) {
+      return 1;
+    }
+  }
+  return 0;
+}
@@ -22,6 +22,14 @@ list(APPEND OCS2_CXX_FLAGS
   ${OpenMP_CXX_FLAGS}
   )
 
+# Count heap allocations per solver phase and report allocations in steady-state iterations, see ocs2_core/misc/AllocationTracking.h
+option(OCS2_ALLOCATION_TRACKING "Hook the allocator to count heap allocations" OFF)
+if (OCS2_ALLOCATION_TRACKING)
+  list(APPEND OCS2_CXX_FLAGS
+    "-DOCS2_ALLOCATION_TRACKING"
+    )
+endif (OCS2_ALLOCATION_TRACKING)
+
 # Cpp standard version
 set(CMAKE_CXX_STANDARD 17)
 set(CMAKE_CXX_STANDARD_REQUIRED ON)
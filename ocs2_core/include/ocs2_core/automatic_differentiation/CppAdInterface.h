@@ -33,7 +33,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <Eigen/Core>
 
 // STL
+#include <map>
 #include <string>
+#include <utility>
+#include <vector>
 
 // CppAD
 #include <cppad/cg.hpp>
@@ -42,9 +45,12 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/Types.h>
 #include <ocs2_core/automatic_differentiation/CppAdSparsity.h>
 #include <ocs2_core/automatic_differentiation/Types.h>
+#include <ocs2_core/misc/SparseApproximation.h>
 
 namespace ocs2 {
 
+class CppAdModelBatch;
+
 class CppAdInterface {
  public:
   enum class ApproximationOrder { Zero, First, Second };
@@ -82,10 +88,14 @@ class CppAdInterface {
   CppAdInterface(ad_function_t adFunction, size_t variableDim, std::string modelName, std::string folderName = "/tmp/ocs2",
                  std::vector<std::string> compileFlags = {"-O3", "-g", "-march=native", "-mtune=native", "-ffast-math"});
 
-  ~CppAdInterface() = default;
+  /**
+   * Destructor. Unregisters the interface from a CppAdModelBatch that has not loaded its models yet.
+   */
+  ~CppAdInterface();
 
   /**
-   * Copy constructor. Models are reloaded if available.
+   * Copy constructor. Models are reloaded if available. If the models of rhs are still pending in a CppAdModelBatch, the copy is loaded
+   * by the same batch.
    */
   CppAdInterface(const CppAdInterface& rhs);
 
@@ -100,7 +110,8 @@ class CppAdInterface {
   void loadModels(bool verbose = true);
 
   /**
-   * Creates models, compiles them, and saves them to disk
+   * Creates models, compiles them, and saves them to disk. If a CppAdModelBatch is active on the calling thread, the compilation and the
+   * loading are deferred to it.
    *
    * @param approximationOrder : Order of derivatives to generate
    * @param verbose : Print out extra information
@@ -115,6 +126,30 @@ class CppAdInterface {
    */
   void loadModelsIfAvailable(ApproximationOrder approximationOrder = ApproximationOrder::Second, bool verbose = true);
 
+  /**
+   * Content-hashed variant of loadModelsIfAvailable. The function is taped to compute a hash over its operation graph, the dimensions,
+   * the approximation order, the compile flags, and the compiler version. The library on disk is only loaded if it was built from the
+   * same hash, otherwise the derivative sources are generated and compiled. Unlike loadModelsIfAvailable, a library of a modified
+   * function is never reused. If a CppAdModelBatch is active on the calling thread, the compilation and the loading are deferred to it.
+   *
+   * @param approximationOrder : Order of derivatives to generate
+   * @param verbose : Print out extra information
+   */
+  void loadModelsIfUpToDate(ApproximationOrder approximationOrder = ApproximationOrder::Second, bool verbose = true);
+
+  /**
+   * Creates the models of several interfaces with up to maxNumJobs compilations running concurrently. Taping and source generation
+   * run sequentially on the calling thread since CppAD taping is not thread-safe, while the previously generated libraries compile.
+   * If a CppAdModelBatch is active on the calling thread, the compilations are added to it instead and maxNumJobs is ignored.
+   *
+   * @param adInterfaces : Interfaces to build, with the order of derivatives to generate for each of them.
+   * @param maxNumJobs : Maximum number of concurrent compilations. Zero uses the number of hardware threads.
+   * @param useCache : Loads the libraries that are up to date (see loadModelsIfUpToDate) instead of recompiling them.
+   * @param verbose : Print out extra information
+   */
+  static void createModelsInParallel(const std::vector<std::pair<CppAdInterface*, ApproximationOrder>>& adInterfaces,
+                                     size_t maxNumJobs = 0, bool useCache = true, bool verbose = true);
+
   /**
    * @param x : input vector of size variableDim
    * @param p : parameter vector of size parameterDim
@@ -165,12 +200,138 @@ class CppAdInterface {
    */
   matrix_t getHessian(const vector_t& w, const vector_t& x, const vector_t& p = vector_t(0)) const;
 
+  /**
+   * In-place evaluation of the function value. The output has to be preallocated with size rangeDim.
+   * Does not allocate memory once the thread-local scratch buffers are warmed up.
+   *
+   * @param x : input vector of size variableDim
+   * @param p : parameter vector of size parameterDim
+   * @param [out] value : y = f(x,p)
+   */
+  void getFunctionValue(const Eigen::Ref<const vector_t>& x, const Eigen::Ref<const vector_t>& p, Eigen::Ref<vector_t> value) const;
+
+  /**
+   * In-place evaluation of the Jacobian. The output has to be preallocated with size rangeDim x variableDim.
+   *
+   * @param x : input vector of size variableDim
+   * @param p : parameter vector of size parameterDim
+   * @param [out] jacobian : d/dx( f(x,p) )
+   */
+  void getJacobian(const Eigen::Ref<const vector_t>& x, const Eigen::Ref<const vector_t>& p, Eigen::Ref<matrix_t> jacobian) const;
+
+  /**
+   * In-place evaluation of the Gauss-Newton approximation. The outputs have to be preallocated with sizes variableDim and
+   * variableDim x variableDim.
+   *
+   * @param x : input vector of size variableDim
+   * @param p : parameter vector of size parameterDim
+   * @param [out] f : 0.5 * |y|^2
+   * @param [out] dfdx : dy/dx' * y
+   * @param [out] dfdxx : dy/dx' * dy/dx
+   */
+  void getGaussNewtonApproximation(const Eigen::Ref<const vector_t>& x, const Eigen::Ref<const vector_t>& p, scalar_t& f,
+                                   Eigen::Ref<vector_t> dfdx, Eigen::Ref<matrix_t> dfdxx) const;
+
+  /**
+   * In-place evaluation of the weighted hessian. The output has to be preallocated with size variableDim x variableDim.
+   *
+   * @param w: vector of weights of size rangeDim
+   * @param x : input vector of size variableDim
+   * @param p : parameter vector of size parameterDim
+   * @param [out] hessian : dd/dxdx(sum_i  w_i*f_i(x,p) )
+   */
+  void getHessian(const Eigen::Ref<const vector_t>& w, const Eigen::Ref<const vector_t>& x, const Eigen::Ref<const vector_t>& p,
+                  Eigen::Ref<matrix_t> hessian) const;
+
+  /**
+   * Adds a lane variant of the function value and the Jacobian to the library, which evaluates numLanes points at once. Its C source is
+   * derived from the generated scalar source by replacing the scalars with GCC vector types of numLanes doubles, such that every
+   * operation acts on all points. The inputs and outputs are stored as structure of arrays (entry i of lane l at i * numLanes + l), e.g.
+   * 4 lanes fill an AVX2 register and 8 lanes an AVX-512 register. The batched evaluations use the lane variant for each full block of
+   * numLanes points. Sources which contain conditionals, atomic functions or are split into several functions are not translated, the
+   * library then has no lane variant.
+   * Only takes effect for models created afterwards. The default 0 (or 1) disables the lane variant.
+   *
+   * @param numLanes : Number of points evaluated at once, 0, 1, 2, 4, 8 or 16.
+   */
+  void setNumLanes(size_t numLanes);
+
+  /** Number of points evaluated at once by the lane variant of the loaded library, zero if the library does not contain one. */
+  size_t getNumLanes() const { return laneFunctions_.numLanes; }
+
+  /**
+   * Batched evaluation of the function value at N points.
+   *
+   * @param X : inputs stored column-wise, size variableDim x N
+   * @param P : parameters stored column-wise, size parameterDim x N
+   * @param [out] values : preallocated output of size rangeDim x N, column k holds f(X.col(k), P.col(k))
+   */
+  void getFunctionValueBatch(const Eigen::Ref<const matrix_t>& X, const Eigen::Ref<const matrix_t>& P, Eigen::Ref<matrix_t> values) const;
+
+  /**
+   * Batched evaluation of the Jacobian at N points.
+   *
+   * @param X : inputs stored column-wise, size variableDim x N
+   * @param P : parameters stored column-wise, size parameterDim x N
+   * @param [out] jacobians : preallocated output of size (N * rangeDim) x variableDim. The k-th block of rangeDim rows holds the
+   *                          Jacobian at (X.col(k), P.col(k)).
+   */
+  void getJacobianBatch(const Eigen::Ref<const matrix_t>& X, const Eigen::Ref<const matrix_t>& P, Eigen::Ref<matrix_t> jacobians) const;
+
+  /**
+   * Jacobian in compressed row storage. The sparsity pattern is only set if the matrix does not have it yet, e.g. on the first call.
+   * Afterwards only the non-zero values are written. The matrix must not be pruned or modified structurally by the caller.
+   *
+   * @param x : input vector of size variableDim
+   * @param p : parameter vector of size parameterDim
+   * @param [out] jacobian : d/dx( f(x,p) ) of size rangeDim x variableDim
+   */
+  void getSparseJacobian(const Eigen::Ref<const vector_t>& x, const Eigen::Ref<const vector_t>& p, sparse_matrix_t& jacobian) const;
+
+  /**
+   * Weighted hessian in compressed row storage. Both triangles are stored. The same pattern rules as in getSparseJacobian apply.
+   *
+   * @param w: vector of weights of size rangeDim
+   * @param x : input vector of size variableDim
+   * @param p : parameter vector of size parameterDim
+   * @param [out] hessian : dd/dxdx(sum_i  w_i*f_i(x,p) ) of size variableDim x variableDim
+   */
+  void getSparseHessian(const Eigen::Ref<const vector_t>& w, const Eigen::Ref<const vector_t>& x, const Eigen::Ref<const vector_t>& p,
+                        sparse_matrix_t& hessian) const;
+
+  /** Sparsity pattern of the Jacobian w.r.t. the variables, with all values set to zero. */
+  const sparse_matrix_t& getJacobianSparsityPattern() const { return jacobianPattern_; }
+
+  /** Sparsity pattern of the Hessian w.r.t. the variables (both triangles), with all values set to zero. */
+  const sparse_matrix_t& getHessianSparsityPattern() const { return hessianPattern_; }
+
+  /** Size of the variables x */
+  size_t getVariableDim() const { return variableDim_; }
+
+  /** Size of the parameters p */
+  size_t getParameterDim() const { return parameterDim_; }
+
+  /** Size of the output y. Only valid once the models are created or loaded. */
+  size_t getRangeDim() const { return rangeDim_; }
+
  private:
   /**
    * Defines library folder names
    */
   void setFolderNames();
 
+  /**
+   * Concatenates the variables and parameters into a thread-local buffer. Without parameters x is used directly.
+   * @return view on [x; p], valid until the next call from the same thread
+   */
+  CppAD::cg::ArrayView<const scalar_t> concatenateInput(const Eigen::Ref<const vector_t>& x, const Eigen::Ref<const vector_t>& p) const;
+
+  /**
+   * Packs the columns [firstColumn, firstColumn + numLanes) of X and P into the thread-local input buffer of the lane variant.
+   * @return pointer to the lane input, valid until the next call from the same thread
+   */
+  const scalar_t* packLanes(const Eigen::Ref<const matrix_t>& X, const Eigen::Ref<const matrix_t>& P, Eigen::Index firstColumn) const;
+
   /**
    * Creates folders on disk
    */
@@ -182,6 +343,62 @@ class CppAdInterface {
    */
   bool isLibraryAvailable() const;
 
+  /**
+   * Checks if the library on disk was built from the given content hash.
+   */
+  bool isLibraryUpToDate(const std::string& contentHash) const;
+
+  /**
+   * Tapes the function and optimizes the operation sequence. Sets the range dimension.
+   * @param [out] fun : taped function
+   */
+  void tapeFunction(ad_fun_t& fun);
+
+  /**
+   * Generates the C sources of the model library.
+   * @param approximationOrder : Order of derivatives to generate
+   * @param fun : taped function, see tapeFunction
+   * @return map from file names to the source code
+   */
+  std::map<std::string, std::string> generateSources(ApproximationOrder approximationOrder, ad_fun_t& fun) const;
+
+  /**
+   * Translates the generated scalar sources of the model into the lane variant, see setNumLanes.
+   * @param sources : generated sources of the library
+   * @return C source of the lane variant, empty if the scalar sources can not be translated
+   */
+  std::string generateLaneSource(const std::map<std::string, std::string>& sources) const;
+
+  /**
+   * Hash over the operation graph of the taped function, the dimensions, the approximation order, the number of lanes, the compile
+   * flags and the compiler version. It is computed without generating the derivative sources.
+   * @param fun : taped function, see tapeFunction
+   * @param approximationOrder : Order of derivatives to generate
+   */
+  std::string getContentHash(ad_fun_t& fun, ApproximationOrder approximationOrder) const;
+
+  /**
+   * Compiles the sources to the temporary library name and stores the content hash next to it.
+   * Only touches files on disk, hence libraries of different models can be compiled concurrently.
+   */
+  void compileLibrary(const std::map<std::string, std::string>& sources, const std::string& contentHash, bool verbose) const;
+
+  /**
+   * Loads the library created by compileLibrary and renames it and its content hash to the library name.
+   */
+  void loadCompiledLibrary(bool verbose);
+
+  /**
+   * Renames the library created by compileLibrary and its content hash to the library name.
+   */
+  static void publishCompiledLibrary(const std::string& libraryName, const std::string& tmpName, bool verbose);
+
+  /**
+   * Tapes the function and registers its compilation to the batch. An up-to-date library is loaded right away.
+   * @param useCache : Loads the library if it is up to date instead of recompiling it.
+   */
+  void addToModelBatch(CppAdModelBatch& modelBatch, ApproximationOrder approximationOrder, bool useCache, bool verbose);
+
   /**
    * Creates a random temporary folder name
    * @return folder name
@@ -203,10 +420,15 @@ class CppAdInterface {
   void setApproximationOrder(ApproximationOrder approximationOrder, CppAD::cg::ModelCSourceGen<scalar_t>& sourceGen, ad_fun_t& fun) const;
 
   /**
-   * Stores the sparisty nonzeros
+   * Stores the sparisty nonzeros and the compressed row patterns of the generated derivatives
    */
   void setSparsityNonzeros();
 
+  /**
+   * Loads the entry points of the lane variant if the library contains one
+   */
+  void loadLaneFunctions();
+
   /**
    * Creates sparsity pattern for the Jacobian that will be generated
    * @param fun : taped ad function
@@ -232,6 +454,24 @@ class CppAdInterface {
   size_t rangeDim_ = 0;
   size_t nnzJacobian_ = 0;
   size_t nnzHessian_ = 0;
+  size_t numLanes_ = 0;
+
+  /** Entry points of the lane variant in the loaded library, see setNumLanes */
+  struct LaneFunctions {
+    size_t numLanes = 0;
+    void (*forwardZero)(const scalar_t* xp, scalar_t* values) = nullptr;
+    void (*sparseJacobian)(const scalar_t* xp, scalar_t* sparseJacobian) = nullptr;
+    std::vector<size_t> jacobianRows;  // row of each Jacobian non-zero, in the order of the output
+    std::vector<size_t> jacobianCols;  // column of each Jacobian non-zero, in the order of the output
+  };
+  LaneFunctions laneFunctions_;
+
+  // Compressed row patterns, with the index of the model output for each stored non-zero
+  sparse_matrix_t jacobianPattern_;
+  sparse_matrix_t hessianPattern_;
+  std::vector<size_t> jacobianPatternToModel_;
+  std::vector<size_t> hessianPatternToModel_;
+  bool isJacobianPatternInModelOrder_ = false;
 
   // Names
   std::string modelName_;
@@ -240,6 +480,10 @@ class CppAdInterface {
   std::string tmpName_;
   std::string tmpFolder_;
   std::string libraryName_;
+
+  // The batch that loads the models, if they are still pending
+  CppAdModelBatch* pendingModelBatchPtr_ = nullptr;
+  friend class CppAdModelBatch;
 };
 
 }  // namespace ocs2
@@ -0,0 +1,113 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <future>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <ocs2_core/thread_support/ThreadPool.h>
+
+namespace ocs2 {
+
+class CppAdInterface;
+
+/**
+ * Compiles the models of all CppAdInterfaces that are created on the calling thread while the batch exists, with up to maxNumJobs
+ * compilations running concurrently. A robot interface creates one batch around the setup of its optimal control problem, such that the
+ * libraries of all its dynamics, cost, and constraint classes compile together instead of one AD class after the other:
+ *
+ *   CppAdModelBatch modelBatch;
+ *   problem.dynamicsPtr.reset(new MyDynamicsAD(...));
+ *   problem.equalityConstraintPtr->add("myConstraint", std::make_unique<MyConstraintCppAd>(...));
+ *   modelBatch.finish();
+ *
+ * Taping and source generation still run in createModels(), loadModelsIfUpToDate(), and createModelsInParallel(), since the taped
+ * functions may refer to objects on the stack of the calling constructor. Up-to-date libraries are loaded right away. Only the compilation
+ * and the loading of the compiled libraries are deferred, such models are not available before finish() returns. Copies of an interface
+ * taken in the meantime are loaded by finish() as well.
+ *
+ * The batch and the interfaces registered to it should only be used from the thread that created the batch.
+ */
+class CppAdModelBatch {
+ public:
+  /**
+   * Constructor. Activates the batch on the calling thread.
+   *
+   * @param maxNumJobs : Maximum number of concurrent compilations. Zero uses the number of hardware threads.
+   */
+  explicit CppAdModelBatch(size_t maxNumJobs = 0);
+
+  /**
+   * Destructor. Waits for the running compilations and deactivates the batch. The models that are not loaded by finish() stay
+   * unavailable.
+   */
+  ~CppAdModelBatch();
+
+  CppAdModelBatch(const CppAdModelBatch&) = delete;
+  CppAdModelBatch& operator=(const CppAdModelBatch&) = delete;
+
+  /**
+   * Waits for all compilations and loads the models of the registered interfaces. Rethrows the first compilation error after all
+   * compilations have finished. The batch stays active, models registered afterwards are handled by the next call.
+   */
+  void finish();
+
+  /** The batch that is active on the calling thread, or nullptr. */
+  static CppAdModelBatch* getActiveBatch();
+
+ private:
+  friend class CppAdInterface;
+
+  struct Entry {
+    CppAdInterface* adInterfacePtr;  // nullptr once the interface is destroyed
+    bool isCompiled;
+    bool verbose;
+    std::shared_future<void> compileJob;  // only valid if isCompiled
+    std::string libraryName;              // to publish the library of a destroyed interface
+    std::string tmpName;
+  };
+
+  /** Compiles the sources of the interface on the batch threads. The library is loaded by finish(). */
+  void addCompilation(CppAdInterface& adInterface, std::map<std::string, std::string> sources, std::string contentHash, bool verbose);
+
+  /** Loads the library of the interface in finish(), after the libraries registered earlier are in place. */
+  void addLoad(CppAdInterface& adInterface, bool verbose);
+
+  /** Called by the destructor of a registered interface. Waits for its compilation, which is then only published by finish(). */
+  void remove(CppAdInterface& adInterface);
+
+  ThreadPool compilePool_;
+  std::vector<Entry> entries_;
+  CppAdModelBatch* previousBatchPtr_;
+};
+
+}  // namespace ocs2
@@ -49,7 +49,7 @@ class StateConstraintCppAd : public StateConstraint {
    * @param parameterDim : parameter vector dimension, set to 0 if getParameters() is not used.
    * @param modelName : Name of the generate model library.
    * @param modelFolder : Folder where the model library files are saved.
-   * @param recompileLibraries : If true, always compile the model library, else try to load existing library if available.
+   * @param recompileLibraries : If true, always compile the model library, else load the existing library if it is up to date.
    * @param verbose : Print information.
    */
   void initialize(size_t stateDim, size_t parameterDim, const std::string& modelName, const std::string& modelFolder = "/tmp/ocs2",
@@ -73,6 +73,12 @@ class StateConstraintCppAd : public StateConstraint {
 
  private:
   std::unique_ptr<ocs2::CppAdInterface> adInterfacePtr_;
+
+  // Sparse derivatives, reused between the calls such that their patterns are allocated only once. Like the other members of the
+  // optimal control problem, each worker thread evaluates its own copy of the constraint.
+  mutable sparse_matrix_t jacobian_;
+  mutable sparse_matrix_t hessian_;
+  mutable vector_t hessianWeights_;
 };
 
 }  // namespace ocs2
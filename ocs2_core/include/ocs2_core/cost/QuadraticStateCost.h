@@ -53,15 +53,25 @@ class QuadraticStateCost : public StateCost {
                                                                  const TargetTrajectories& targetTrajectories,
                                                                  const PreComputation&) const final;
 
+  /** Adds the cost term quadratic approximation in place */
+  void addQuadraticApproximation(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories, const PreComputation&,
+                                 ScalarFunctionQuadraticApproximation& approximation) const final;
+
  protected:
   QuadraticStateCost(const QuadraticStateCost& rhs) = default;
 
-  /** Computes the state deviation for the nominal state.
+  /** Computes the state deviation for the nominal state. The deviation is written to the given vector, which keeps its memory between
+   * the calls.
    * This method can be overwritten if desiredTrajectory has a different dimensions. */
-  virtual vector_t getStateDeviation(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories) const;
+  virtual void getStateDeviation(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories,
+                                 vector_t& stateDeviation) const;
 
  private:
   matrix_t Q_;
+
+  /** Workspace of the deviation and gradient */
+  mutable vector_t stateDeviation_;
+  mutable vector_t stateGradient_;
 };
 
 }  // namespace ocs2
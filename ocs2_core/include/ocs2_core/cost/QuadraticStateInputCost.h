@@ -58,18 +58,30 @@ class QuadraticStateInputCost : public StateInputCost {
                                                                  const TargetTrajectories& targetTrajectories,
                                                                  const PreComputation&) const final;
 
+  /** Adds the cost term quadratic approximation in place */
+  void addQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input, const TargetTrajectories& targetTrajectories,
+                                 const PreComputation&, ScalarFunctionQuadraticApproximation& approximation) const final;
+
  protected:
   QuadraticStateInputCost(const QuadraticStateInputCost& rhs) = default;
 
-  /** Computes the state-input deviation pair around the nominal state and input.
+  /** Computes the state-input deviation pair around the nominal state and input. The deviations are written to the given vectors,
+   * which keep their memory between the calls.
    * This method can be overwritten if desiredTrajectory has a different dimensions. */
-  virtual std::pair<vector_t, vector_t> getStateInputDeviation(scalar_t time, const vector_t& state, const vector_t& input,
-                                                               const TargetTrajectories& targetTrajectories) const;
+  virtual void getStateInputDeviation(scalar_t time, const vector_t& state, const vector_t& input,
+                                      const TargetTrajectories& targetTrajectories, vector_t& stateDeviation,
+                                      vector_t& inputDeviation) const;
 
  private:
   matrix_t Q_;
   matrix_t R_;
   matrix_t P_;
+
+  /** Workspace of the deviations and gradients */
+  mutable vector_t stateDeviation_;
+  mutable vector_t inputDeviation_;
+  mutable vector_t stateGradient_;
+  mutable vector_t inputGradient_;
 };
 
 }  // namespace ocs2
@@ -56,6 +56,18 @@ class StateCost {
                                                                          const TargetTrajectories& targetTrajectories,
                                                                          const PreComputation& preComp) const = 0;
 
+  /**
+   * Adds the cost term quadratic approximation to the state derivatives of the given approximation, the input derivatives are not
+   * touched. The default implementation adds getQuadraticApproximation(), terms that override it write in place without allocating.
+   */
+  virtual void addQuadraticApproximation(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories,
+                                         const PreComputation& preComp, ScalarFunctionQuadraticApproximation& approximation) const {
+    const auto costTermApproximation = getQuadraticApproximation(time, state, targetTrajectories, preComp);
+    approximation.f += costTermApproximation.f;
+    approximation.dfdx += costTermApproximation.dfdx;
+    approximation.dfdxx += costTermApproximation.dfdxx;
+  }
+
  protected:
   StateCost(const StateCost& rhs) = default;
 };
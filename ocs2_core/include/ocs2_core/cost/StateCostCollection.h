@@ -59,6 +59,13 @@ class StateCostCollection : public Collection<StateCost> {
                                                                          const TargetTrajectories& targetTrajectories,
                                                                          const PreComputation& preComp) const;
 
+  /**
+   * Adds the state-only cost quadratic approximation of the active terms to the state derivatives of the given approximation, see
+   * StateCost::addQuadraticApproximation.
+   */
+  virtual void addQuadraticApproximation(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories,
+                                         const PreComputation& preComp, ScalarFunctionQuadraticApproximation& approximation) const;
+
  protected:
   /** Copy constructor */
   StateCostCollection(const StateCostCollection& other);
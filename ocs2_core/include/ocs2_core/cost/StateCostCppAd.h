@@ -49,7 +49,7 @@ class StateCostCppAd : public StateCost {
    * @param parameterDim : parameter vector dimension, set to 0 if getParameters() is not used.
    * @param modelName : Name of the generate model library.
    * @param modelFolder : Folder where the model library files are saved.
-   * @param recompileLibraries : If true, always compile the model library, else try to load existing library if available.
+   * @param recompileLibraries : If true, always compile the model library, else load the existing library if it is up to date.
    * @param verbose : Print information.
    */
   void initialize(size_t stateDim, size_t parameterDim, const std::string& modelName, const std::string& modelFolder = "/tmp/ocs2",
@@ -56,6 +56,10 @@ class LinearSystemDynamics : public SystemDynamicsBase {
 
   VectorFunctionLinearApproximation linearApproximation(scalar_t t, const vector_t& x, const vector_t& u, const PreComputation&) override;
 
+  /** Writes the approximations in place */
+  void linearApproximationBatch(size_t numPoints, const scalar_array_t& t, const vector_array_t& x, const vector_array_t& u,
+                                std::vector<VectorFunctionLinearApproximation>& approximations) override;
+
   VectorFunctionLinearApproximation jumpMapLinearApproximation(scalar_t t, const vector_t& x, const PreComputation&) override;
 
  protected:
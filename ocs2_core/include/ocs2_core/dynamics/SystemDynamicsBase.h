@@ -122,6 +122,28 @@ class SystemDynamicsBase : public ControlledSystemBase {
    */
   VectorFunctionLinearApproximation linearApproximation(scalar_t t, const vector_t& x, const vector_t& u);
 
+  /**
+   * Number of points that linearApproximationBatch() evaluates at once, e.g. the SIMD lanes of a generated model.
+   *
+   * @return One if the points are evaluated one by one.
+   */
+  virtual size_t getNumLanes() const { return 1; }
+
+  /**
+   * Computes the flow map linear approximations at several points, see linearApproximation(t, x, u).
+   *
+   * @note The default implementation evaluates the points one by one and assigns the approximations by value. Overrides write into the
+   *       storage of the approximations, such that it is reused between the calls. Only the first numPoints entries of the arrays are used.
+   *
+   * @param [in] numPoints: The number of points.
+   * @param [in] t: The times of the points.
+   * @param [in] x: The states of the points.
+   * @param [in] u: The inputs of the points.
+   * @param [out] approximations: The state time derivative linear approximations of the points.
+   */
+  virtual void linearApproximationBatch(size_t numPoints, const scalar_array_t& t, const vector_array_t& x, const vector_array_t& u,
+                                        std::vector<VectorFunctionLinearApproximation>& approximations);
+
   /** Computes the jump map linear approximation.
    *
    * @note This method updates the internal preComputation with the requestPreJump() callback and
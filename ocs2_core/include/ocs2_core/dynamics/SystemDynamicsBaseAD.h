@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <algorithm>
+
 #include <ocs2_core/automatic_differentiation/CppAdInterface.h>
 #include <ocs2_core/automatic_differentiation/Types.h>
 #include <ocs2_core/dynamics/SystemDynamicsBase.h>
@@ -57,11 +59,12 @@ class SystemDynamicsBaseAD : public SystemDynamicsBase {
    * @param inputDim : input vector dimension.
    * @param modelName : name of the generate model library
    * @param modelFolder : folder to save the model library files to
-   * @param recompileLibraries : If true, always compile the model library, else try to load existing library if available.
+   * @param recompileLibraries : If true, always compile the model library, else load the existing library if it is up to date.
    * @param verbose : print information.
+   * @param numLanes : Number of points at which linearApproximationBatch evaluates the flow map at once, see CppAdInterface::setNumLanes.
    */
   void initialize(size_t stateDim, size_t inputDim, const std::string& modelName, const std::string& modelFolder = "/tmp/ocs2",
-                  bool recompileLibraries = true, bool verbose = true);
+                  bool recompileLibraries = true, bool verbose = true, size_t numLanes = 0);
 
   vector_t computeFlowMap(scalar_t t, const vector_t& x, const vector_t& u, const PreComputation& preComputation) final;
 
@@ -74,6 +77,11 @@ class SystemDynamicsBaseAD : public SystemDynamicsBase {
 
   VectorFunctionLinearApproximation jumpMapLinearApproximation(scalar_t t, const vector_t& x, const PreComputation& preComputation) final;
 
+  size_t getNumLanes() const final { return std::max(flowMapADInterfacePtr_->getNumLanes(), size_t(1)); }
+
+  void linearApproximationBatch(size_t numPoints, const scalar_array_t& t, const vector_array_t& x, const vector_array_t& u,
+                                std::vector<VectorFunctionLinearApproximation>& approximations) final;
+
   VectorFunctionLinearApproximation guardSurfacesLinearApproximation(scalar_t t, const vector_t& x, const vector_t& u) final;
 
   /** @note: Requires linear approximation to be called before */
@@ -179,6 +187,12 @@ class SystemDynamicsBaseAD : public SystemDynamicsBase {
   matrix_t flowJacobian_;
   matrix_t jumpJacobian_;
   matrix_t guardJacobian_;
+
+  /** Points and results of linearApproximationBatch, stored column-wise */
+  matrix_t batchTimeStateInputs_;
+  matrix_t batchParameters_;
+  matrix_t batchFlowMaps_;
+  matrix_t batchJacobians_;
 };
 
 }  // namespace ocs2
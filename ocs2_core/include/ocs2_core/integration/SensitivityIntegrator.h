@@ -87,4 +87,41 @@ using DynamicsSensitivityDiscretizer =
  */
 DynamicsSensitivityDiscretizer selectDynamicsSensitivityDiscretization(SensitivityIntegratorType integratorType);
 
+/**
+ * Intervals whose dynamics are discretized together, such that the stages of all intervals are evaluated by a single call to
+ * SystemDynamicsBase::linearApproximationBatch. The arrays only grow, such that the memory is reused between the calls.
+ */
+struct SensitivityDiscretizationBlock {
+  /** Sets the number of intervals in the block */
+  void resize(size_t numIntervals);
+
+  size_t size = 0;
+  scalar_array_t t;   // starting times of the intervals
+  scalar_array_t dt;  // durations of the intervals
+  vector_array_t x;   // starting states x_{k}
+  vector_array_t u;   // inputs u_{k}, assumed constant over the intervals
+
+  // Discrete approximations of the form x_{k+1} = A_{k} * dx_{k} + B_{k} * du_{k} + b_{k}
+  std::vector<VectorFunctionLinearApproximation> dynamics;
+
+  // Workspace of the stages
+  scalar_array_t stageTime;
+  vector_array_t stageState;
+  std::vector<std::vector<VectorFunctionLinearApproximation>> stageApproximations;
+  matrix_t stageSensitivity;
+};
+
+/**
+ * A function handle to compute the linear approximations of the discretized system's flowmap of a block of intervals.
+ *
+ * @param system : system to be discretized
+ * @param block : intervals to be discretized, receives the discrete approximations in block.dynamics
+ */
+using DynamicsSensitivityBlockDiscretizer = std::function<void(SystemDynamicsBase&, SensitivityDiscretizationBlock&)>;
+
+/**
+ * Select available block integrator based on enum
+ */
+DynamicsSensitivityBlockDiscretizer selectDynamicsSensitivityBlockDiscretization(SensitivityIntegratorType integratorType);
+
 }  // namespace ocs2
\ No newline at end of file
@@ -31,6 +31,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/Types.h>
 #include <ocs2_core/dynamics/SystemDynamicsBase.h>
+#include <ocs2_core/integration/SensitivityIntegrator.h>
 
 namespace ocs2 {
 
@@ -76,4 +77,19 @@ vector_t rk4Discretization(SystemDynamicsBase& system, scalar_t t, const vector_
 VectorFunctionLinearApproximation rk4SensitivityDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u,
                                                                scalar_t dt);
 
+/**
+ * Block variant of eulerSensitivityDiscretization, see SensitivityDiscretizationBlock.
+ */
+void eulerSensitivityDiscretizationBlock(SystemDynamicsBase& system, SensitivityDiscretizationBlock& block);
+
+/**
+ * Block variant of rk2SensitivityDiscretization, see SensitivityDiscretizationBlock.
+ */
+void rk2SensitivityDiscretizationBlock(SystemDynamicsBase& system, SensitivityDiscretizationBlock& block);
+
+/**
+ * Block variant of rk4SensitivityDiscretization, see SensitivityDiscretizationBlock.
+ */
+void rk4SensitivityDiscretizationBlock(SystemDynamicsBase& system, SensitivityDiscretizationBlock& block);
+
 }  // namespace ocs2
\ No newline at end of file
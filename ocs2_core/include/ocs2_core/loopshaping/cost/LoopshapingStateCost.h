@@ -56,6 +56,15 @@ class LoopshapingStateCost final : public StateCostCollection {
                                                                  const TargetTrajectories& targetTrajectories,
                                                                  const PreComputation& preComp) const override;
 
+  /** The loopshaping cost is only computed by value */
+  void addQuadraticApproximation(scalar_t t, const vector_t& x, const TargetTrajectories& targetTrajectories, const PreComputation& preComp,
+                                 ScalarFunctionQuadraticApproximation& approximation) const override {
+    const auto cost = getQuadraticApproximation(t, x, targetTrajectories, preComp);
+    approximation.f += cost.f;
+    approximation.dfdx += cost.dfdx;
+    approximation.dfdxx += cost.dfdxx;
+  }
+
  private:
   LoopshapingStateCost(const LoopshapingStateCost& other) = default;
 
@@ -0,0 +1,184 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <utility>
+
+namespace ocs2 {
+namespace allocation {
+
+/** Number and total size of heap allocations. */
+struct AllocationCount {
+  size_t count = 0;
+  size_t bytes = 0;
+};
+
+inline AllocationCount operator-(const AllocationCount& lhs, const AllocationCount& rhs) {
+  return {lhs.count - rhs.count, lhs.bytes - rhs.bytes};
+}
+
+inline AllocationCount& operator+=(AllocationCount& lhs, const AllocationCount& rhs) {
+  lhs.count += rhs.count;
+  lhs.bytes += rhs.bytes;
+  return lhs;
+}
+
+/** Reaction to a heap allocation where none is allowed, i.e. inside a NoAllocationScope or a steady-state solver phase. */
+enum class Policy {
+  /** Only count the violation */
+  Ignore,
+  /** Count the violation and print it to std::cerr (with a backtrace for a NoAllocationScope) */
+  Log,
+  /** Print the violation and abort the process */
+  Abort
+};
+
+/** Threads whose allocations are counted by a PhaseAllocationCounter */
+enum class CountingScope {
+  /** All threads, for phases that run on worker threads */
+  Process,
+  /** Only the calling thread, for phases that run concurrently to other work, e.g. the policy evaluation of an MRT */
+  CallingThread
+};
+
+/**
+ * Whether heap allocations are counted. Counting requires ocs2_core to be built with the CMake option OCS2_ALLOCATION_TRACKING, which
+ * hooks the allocator of the process: on glibc the C allocator is interposed, which also covers the global operator new and Eigen's
+ * aligned_malloc, elsewhere the global operator new is replaced. Without the option, all counts stay zero and the scopes are no-ops.
+ *
+ * @note On glibc, the interposition requires libocs2_core to precede libc in the symbol lookup order, which holds when the executable
+ * links ocs2_core directly. This function checks that the hook is active.
+ */
+bool isTrackingEnabled();
+
+/** Sets the reaction to violations, Policy::Ignore by default. Thread-safe. */
+void setPolicy(Policy policy);
+
+/** Gets the reaction to violations. */
+Policy getPolicy();
+
+/** Allocations of all threads since the start of the process. */
+AllocationCount getProcessAllocationCount();
+
+/** Allocations of the calling thread since its start. */
+AllocationCount getThreadAllocationCount();
+
+/** Number of violations of all threads since the start of the process. */
+size_t getNumViolations();
+
+/**
+ * Forbids heap allocations on the calling thread for its lifetime, e.g. around a real-time policy evaluation. Each allocation inside the
+ * scope is a violation, reported immediately from within the allocator such that Policy::Abort stops at the offending call. Scopes can
+ * be nested. If ocs2_core is additionally compiled with EIGEN_RUNTIME_NO_MALLOC (and assertions), Eigen asserts on its own allocations
+ * inside the scope. Eigen's flag is process-wide, so that option is only suited for single-threaded debugging.
+ */
+class NoAllocationScope {
+ public:
+  NoAllocationScope();
+  ~NoAllocationScope();
+
+  NoAllocationScope(const NoAllocationScope&) = delete;
+  NoAllocationScope& operator=(const NoAllocationScope&) = delete;
+
+ private:
+  bool wasEigenMallocAllowed_ = true;
+};
+
+/**
+ * Counts the allocations of a repeatedly executed phase, e.g. the LQ approximation of a solver iteration, between start() and end().
+ * Statistics are collected for all measured intervals, analogous to benchmark::RepeatedTimer.
+ */
+class PhaseAllocationCounter {
+ public:
+  /**
+   * Constructor
+   * @param [in] name : Name of the phase, used in the violation report.
+   * @param [in] scope : Threads whose allocations are counted.
+   */
+  explicit PhaseAllocationCounter(std::string name, CountingScope scope = CountingScope::Process) : name_(std::move(name)), scope_(scope) {}
+
+  /** Reset the statistics. */
+  void reset() {
+    numIntervals_ = 0;
+    numAllocatingIntervals_ = 0;
+    total_ = AllocationCount();
+    last_ = AllocationCount();
+  }
+
+  /** Start counting an interval. */
+  void start() { startCount_ = getCount(); }
+
+  /**
+   * Stop counting an interval.
+   * @param [in] steadyState : If true, the phase is expected to run without allocations and any allocation is reported as a violation.
+   */
+  void end(bool steadyState = false);
+
+  /** Name of the phase */
+  const std::string& getName() const { return name_; }
+
+  /** Number of intervals that were counted */
+  size_t getNumIntervals() const { return numIntervals_; }
+
+  /** Number of intervals that allocated */
+  size_t getNumAllocatingIntervals() const { return numAllocatingIntervals_; }
+
+  /** Allocations of all intervals */
+  const AllocationCount& getTotal() const { return total_; }
+
+  /** Allocations of the last interval */
+  const AllocationCount& getLast() const { return last_; }
+
+  /** Average number of allocations per interval */
+  double getAverageCount() const { return numIntervals_ > 0 ? static_cast<double>(total_.count) / numIntervals_ : 0.0; }
+
+  /** Average number of allocated bytes per interval */
+  double getAverageBytes() const { return numIntervals_ > 0 ? static_cast<double>(total_.bytes) / numIntervals_ : 0.0; }
+
+ private:
+  AllocationCount getCount() const { return scope_ == CountingScope::Process ? getProcessAllocationCount() : getThreadAllocationCount(); }
+
+  std::string name_;
+  CountingScope scope_;
+  size_t numIntervals_ = 0;
+  size_t numAllocatingIntervals_ = 0;
+  AllocationCount total_;
+  AllocationCount last_;
+  AllocationCount startCount_;
+};
+
+/** Prints the average allocations per interval of the phase, as used in the benchmarking information of the solvers. */
+std::ostream& operator<<(std::ostream& stream, const PhaseAllocationCounter& counter);
+
+}  // namespace allocation
+}  // namespace ocs2
@@ -115,6 +115,34 @@ int findIntervalInTimeArray(const std::vector<SCALAR>& timeArray, SCALAR time) {
   }
 }
 
+/**
+ * Same as findIntervalInTimeArray, but searches linearly from the interval of a previous query instead of bisecting the whole array.
+ * The lookup is therefore amortized O(1) for monotonic enquiry times.
+ *
+ * @tparam SCALAR : numerical type of time
+ * @param timeArray : sorted time array to perform the lookup in
+ * @param time : enquiry time
+ * @param hint : interval of a previous query, any value is valid
+ * @return interval between [-1, size(timeArray)-1]
+ */
+template <typename SCALAR = double>
+int findIntervalInTimeArray(const std::vector<SCALAR>& timeArray, SCALAR time, int hint) {
+  if (timeArray.empty()) {
+    return 0;
+  }
+
+  // the interval is the last index with timeArray[index] < time
+  const auto size = static_cast<int>(timeArray.size());
+  int index = std::max(-1, std::min(hint, size - 1));
+  while (index + 1 < size && timeArray[index + 1] < time) {
+    ++index;
+  }
+  while (index >= 0 && timeArray[index] >= time) {
+    --index;
+  }
+  return index;
+}
+
 /**
  * Same as findIntervalInTimeArray except for 1 rule:
  * if t = t0, a 0 is returned instead of -1
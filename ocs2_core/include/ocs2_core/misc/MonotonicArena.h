@@ -0,0 +1,100 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "ocs2_core/Types.h"
+
+namespace ocs2 {
+
+/**
+ * A monotonic buffer for scratch matrices and vectors that only live until the next reset, e.g. the temporaries of one solver iteration.
+ * Allocations hand out consecutive slices of a single block and are never freed individually. If the block is exhausted, the allocation
+ * is served from an overflow chunk and the next reset() grows the block to the peak usage. After a warm-up iteration, allocating from
+ * the arena does not touch the heap anymore.
+ *
+ * The arena is not thread-safe. Use one arena per worker thread.
+ *
+ * \code{.cpp}
+ * arena.reset();
+ * auto R_Pu = arena.allocateMatrix(R.rows(), Pu.cols());
+ * R_Pu.noalias() = R * Pu;
+ * \endcode
+ */
+class MonotonicArena {
+ public:
+  using matrix_map_t = Eigen::Map<matrix_t, Eigen::Aligned16>;
+  using vector_map_t = Eigen::Map<vector_t, Eigen::Aligned16>;
+
+  /**
+   * Constructor
+   * @param [in] initialCapacity : Initial number of scalars in the block.
+   */
+  explicit MonotonicArena(size_t initialCapacity = 0);
+
+  MonotonicArena(const MonotonicArena&) = delete;
+  MonotonicArena& operator=(const MonotonicArena&) = delete;
+  MonotonicArena(MonotonicArena&&) = default;
+  MonotonicArena& operator=(MonotonicArena&&) = default;
+  ~MonotonicArena() = default;
+
+  /** Allocates an uninitialized rows x cols matrix, valid until the next reset. */
+  matrix_map_t allocateMatrix(Eigen::Index rows, Eigen::Index cols) { return matrix_map_t(allocate(rows * cols), rows, cols); }
+
+  /** Allocates an uninitialized vector of the given size, valid until the next reset. */
+  vector_map_t allocateVector(Eigen::Index size) { return vector_map_t(allocate(size), size); }
+
+  /** Releases all allocations at once. If the block overflowed since the last reset, it is grown to the peak usage. */
+  void reset();
+
+  /** Number of scalars that can be allocated without touching the heap. */
+  size_t capacity() const { return capacity_; }
+
+  /** Number of scalars allocated since the last reset, including the alignment padding. */
+  size_t size() const { return size_; }
+
+ private:
+  scalar_t* allocate(Eigen::Index size);
+
+  struct AlignedDeleter {
+    void operator()(scalar_t* ptr) const { Eigen::internal::aligned_free(ptr); }
+  };
+  using buffer_t = std::unique_ptr<scalar_t[], AlignedDeleter>;
+  static buffer_t makeBuffer(size_t size);
+
+  buffer_t block_;
+  size_t capacity_ = 0;
+  size_t size_ = 0;
+  std::vector<buffer_t> overflowChunks_;
+};
+
+}  // namespace ocs2
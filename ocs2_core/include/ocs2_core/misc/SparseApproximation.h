@@ -0,0 +1,116 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <Eigen/SparseCore>
+
+#include <ocs2_core/Types.h>
+
+namespace ocs2 {
+
+/** Compressed row storage matrix, used for the sparse outputs of the auto-differentiated models. */
+using sparse_matrix_t = Eigen::SparseMatrix<scalar_t, Eigen::RowMajor>;
+
+/**
+ * Adds the state and input columns of a sparse Jacobian to a linear approximation. Only the non-zeros are visited, the members of the
+ * approximation have to be sized already. Columns outside of the state and input blocks (e.g. time) are ignored.
+ *
+ * approximation.dfdx += J(:, stateOffset : stateOffset + nx)
+ * approximation.dfdu += J(:, inputOffset : inputOffset + nu)
+ *
+ * @param [in] jacobian : Sparse Jacobian of the vector function.
+ * @param [in] stateOffset : Column of the first state variable in the Jacobian.
+ * @param [in] inputOffset : Column of the first input variable in the Jacobian. Pass -1 when there are no inputs.
+ * @param [in, out] approximation : Linear approximation with sizes nv x nx and nv x nu.
+ */
+void addSparseJacobian(const sparse_matrix_t& jacobian, int stateOffset, int inputOffset,
+                       VectorFunctionLinearApproximation& approximation);
+
+/** Adds the state and input columns of a sparse Jacobian to the first order terms of a quadratic approximation. */
+void addSparseJacobian(const sparse_matrix_t& jacobian, int stateOffset, int inputOffset,
+                       VectorFunctionQuadraticApproximation& approximation);
+
+/**
+ * Adds the Gauss-Newton approximation of 0.5 * |f|^2 to a quadratic approximation by iterating over the pairs of non-zeros in each row
+ * of the sparse Jacobian J. This replaces the dense products J' * f and J' * J. The members of the approximation have to be sized already.
+ *
+ * approximation.f += 0.5 * |f|^2
+ * approximation.dfdx += Jx' * f,  approximation.dfdu += Ju' * f
+ * approximation.dfdxx += Jx' * Jx,  approximation.dfdux += Ju' * Jx,  approximation.dfduu += Ju' * Ju
+ *
+ * @param [in] f : Value of the vector function.
+ * @param [in] jacobian : Sparse Jacobian of the vector function.
+ * @param [in] stateOffset : Column of the first state variable in the Jacobian.
+ * @param [in] inputOffset : Column of the first input variable in the Jacobian. Pass -1 when there are no inputs.
+ * @param [in, out] approximation : Quadratic approximation.
+ */
+void addSparseGaussNewtonApproximation(const vector_t& f, const sparse_matrix_t& jacobian, int stateOffset, int inputOffset,
+                                       ScalarFunctionQuadraticApproximation& approximation);
+
+/**
+ * Adds the state and input blocks of a sparse symmetric Hessian, stored with both triangles, to a quadratic approximation.
+ *
+ * approximation.dfdxx += H_xx,  approximation.dfdux += H_ux,  approximation.dfduu += H_uu
+ *
+ * @param [in] hessian : Sparse Hessian of the scalar function.
+ * @param [in] stateOffset : Row/column of the first state variable in the Hessian.
+ * @param [in] inputOffset : Row/column of the first input variable in the Hessian. Pass -1 when there are no inputs.
+ * @param [in, out] approximation : Quadratic approximation.
+ */
+void addSparseHessian(const sparse_matrix_t& hessian, int stateOffset, int inputOffset,
+                      ScalarFunctionQuadraticApproximation& approximation);
+
+/**
+ * Adds the state and input blocks of a sparse symmetric Hessian, stored with both triangles, to the given second order terms.
+ *
+ * dfdxx += H_xx,  dfdux += H_ux,  dfduu += H_uu
+ *
+ * @param [in] hessian : Sparse Hessian of the scalar function.
+ * @param [in] stateOffset : Row/column of the first state variable in the Hessian.
+ * @param [in] inputOffset : Row/column of the first input variable in the Hessian.
+ * @param [in, out] dfdxx : State Hessian of size nx x nx.
+ * @param [in, out] dfdux : Input-state Hessian of size nu x nx.
+ * @param [in, out] dfduu : Input Hessian of size nu x nu.
+ */
+void addSparseHessian(const sparse_matrix_t& hessian, int stateOffset, int inputOffset, matrix_t& dfdxx, matrix_t& dfdux,
+                      matrix_t& dfduu);
+
+/**
+ * Adds the state block of a sparse symmetric Hessian, stored with both triangles, to a state Hessian.
+ *
+ * dfdxx += H_xx
+ *
+ * @param [in] hessian : Sparse Hessian of the scalar function.
+ * @param [in] stateOffset : Row/column of the first state variable in the Hessian.
+ * @param [in, out] dfdxx : State Hessian of size nx x nx.
+ */
+void addSparseHessian(const sparse_matrix_t& hessian, int stateOffset, matrix_t& dfdxx);
+
+}  // namespace ocs2
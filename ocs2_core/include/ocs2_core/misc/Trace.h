@@ -0,0 +1,155 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "ocs2_core/Types.h"
+
+namespace ocs2 {
+namespace trace {
+
+/** A timed zone as recorded by one thread. */
+struct Event {
+  /** Zone name, must be a string with static storage duration */
+  const char* name = nullptr;
+  /** Start time since the tracer epoch [ns] */
+  int64_t startTime = 0;
+  /** Duration [ns] */
+  int64_t duration = 0;
+  /** Nesting depth of the zone within its thread */
+  int depth = 0;
+};
+
+/** Duration statistics of a zone [ms]. */
+struct ZoneStatistics {
+  std::string name;
+  /** Index of the thread that recorded the zone, -1 if the statistics are accumulated over all threads */
+  int threadIndex = -1;
+  size_t count = 0;
+  scalar_t total = 0.0;
+  scalar_t median = 0.0;
+  scalar_t p99 = 0.0;
+  scalar_t max = 0.0;
+};
+
+namespace detail {
+extern std::atomic_bool isTracingEnabled;
+int64_t beginZone();
+void endZone(const char* name, int64_t startTime);
+}  // namespace detail
+
+/**
+ * Enables or disables the recording of zones. Tracing is disabled by default, in which case a zone costs a single relaxed atomic load.
+ */
+void setEnabled(bool enabled);
+
+/** Whether zones are recorded. */
+inline bool isEnabled() {
+  return detail::isTracingEnabled.load(std::memory_order_relaxed);
+}
+
+/**
+ * Discards the recorded events of all threads. Can be called while other threads are recording.
+ */
+void clear();
+
+/**
+ * Names the calling thread in the exported trace, e.g. "mpc" or "worker 2". Does not allocate the event buffer of the thread.
+ */
+void setThreadName(const std::string& name);
+
+/**
+ * Copies the events recorded by each thread. Every thread records into its own ring buffer of fixed size, such that only the latest
+ * events are kept. Recording is lock-free, the copy of a thread's buffer drops the events that were overwritten while copying.
+ * The buffer of a terminated thread is kept until its events were copied once (or discarded by clear()). Afterwards, it is reused with
+ * the same thread index by the next thread that records a zone, which drops the remaining events of the terminated thread.
+ *
+ * @return events per thread, indexed by the thread index
+ */
+std::vector<std::vector<Event>> getEvents();
+
+/**
+ * Computes the duration statistics of the recorded zones.
+ * @param [in] perThread : If true, the statistics are computed separately for each thread (e.g. per worker of a ThreadPool).
+ * @return statistics, sorted by zone name and thread index
+ */
+std::vector<ZoneStatistics> getZoneStatistics(bool perThread = false);
+
+/** Writes the recorded events in the Chrome trace event format, which can be opened in chrome://tracing or Perfetto. */
+void writeChromeTrace(std::ostream& stream);
+
+/** Saves the recorded events in the Chrome trace event format to the given file. */
+void saveChromeTrace(const std::string& fileName);
+
+/**
+ * Records the time between its construction and destruction as an event of the calling thread.
+ */
+class ScopedZone {
+ public:
+  /** @param [in] name : Zone name, must be a string with static storage duration, e.g. a string literal. */
+  explicit ScopedZone(const char* name) : name_(isEnabled() ? name : nullptr) {
+    if (name_ != nullptr) {
+      startTime_ = detail::beginZone();
+    }
+  }
+
+  ~ScopedZone() {
+    if (name_ != nullptr) {
+      detail::endZone(name_, startTime_);
+    }
+  }
+
+  ScopedZone(const ScopedZone&) = delete;
+  ScopedZone& operator=(const ScopedZone&) = delete;
+
+ private:
+  const char* name_;
+  int64_t startTime_ = 0;
+};
+
+#define OCS2_TRACE_CONCAT_IMPL(A, B) A##B
+#define OCS2_TRACE_CONCAT(A, B) OCS2_TRACE_CONCAT_IMPL(A, B)
+
+/**
+ * Traces the enclosing scope
+ *
+ * \code{.cpp}
+ * OCS2_TRACE_ZONE("SqpSolver::solveQp");
+ * \endcode
+ */
+#define OCS2_TRACE_ZONE(NAME) const ::ocs2::trace::ScopedZone OCS2_TRACE_CONCAT(ocs2TraceZone, __LINE__)(NAME)
+
+}  // namespace trace
+}  // namespace ocs2
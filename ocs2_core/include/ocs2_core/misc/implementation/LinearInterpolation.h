@@ -66,13 +66,9 @@ const Data& stdAccessFun(const std::vector<Data, Alloc>& vec, size_t ind) {
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-inline index_alpha_t timeSegment(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray) {
-  // corner cases (no time set OR single time element)
-  if (timeArray.size() <= 1) {
-    return {0, scalar_t(1.0)};
-  }
-
-  const int index = lookup::findIntervalInTimeArray(timeArray, enquiryTime);
+namespace detail {
+/** Computes the interpolation coefficient of the enquiry time given its interval in the time array (with at least 2 elements). */
+inline index_alpha_t intervalToTimeSegment(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray, int index) {
   const auto lastInterval = static_cast<int>(timeArray.size() - 1);
   if (index >= 0) {
     if (index < lastInterval) {
@@ -103,6 +99,33 @@ inline index_alpha_t timeSegment(scalar_t enquiryTime, const std::vector<scalar_
     return {0, scalar_t(1.0)};
   }
 }
+}  // namespace detail
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+inline index_alpha_t timeSegment(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray) {
+  // corner cases (no time set OR single time element)
+  if (timeArray.size() <= 1) {
+    return {0, scalar_t(1.0)};
+  }
+
+  const int index = lookup::findIntervalInTimeArray(timeArray, enquiryTime);
+  return detail::intervalToTimeSegment(enquiryTime, timeArray, index);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+inline index_alpha_t timeSegment(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray, int& interval) {
+  // corner cases (no time set OR single time element)
+  if (timeArray.size() <= 1) {
+    return {0, scalar_t(1.0)};
+  }
+
+  interval = lookup::findIntervalInTimeArray(timeArray, enquiryTime, interval);
+  return detail::intervalToTimeSegment(enquiryTime, timeArray, interval);
+}
 
 /******************************************************************************************************/
 /******************************************************************************************************/
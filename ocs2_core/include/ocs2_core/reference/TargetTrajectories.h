@@ -52,6 +52,10 @@ struct TargetTrajectories {
   vector_t getDesiredState(scalar_t time) const;
   vector_t getDesiredInput(scalar_t time) const;
 
+  /** Same as getDesiredState(time) and getDesiredInput(time), the result is written to the given vector without reallocating it */
+  void getDesiredState(scalar_t time, vector_t& desiredState) const;
+  void getDesiredInput(scalar_t time, vector_t& desiredInput) const;
+
   scalar_array_t timeTrajectory;
   vector_array_t stateTrajectory;
   vector_array_t inputTrajectory;
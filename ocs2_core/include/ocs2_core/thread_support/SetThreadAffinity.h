@@ -0,0 +1,142 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <pthread.h>
+#include <exception>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ocs2 {
+
+/**
+ * Parses a list of CPUs in the Linux cpulist format, e.g. "0-3,8,10-11".
+ *
+ * @param [in] cpuList: The list of CPUs. An empty string results in an empty set.
+ * @return The sorted CPU indices.
+ */
+std::vector<int> parseCpuList(const std::string& cpuList);
+
+/**
+ * Gets the CPU sets of the workers of a solver from its settings.
+ *
+ * @param [in] threadAffinity: The CPUs of all workers in cpulist format. Empty for no pinning.
+ * @param [in] workerThreadAffinity: Optional CPUs per worker index in cpulist format. A non-empty entry overrides threadAffinity.
+ * @param [in] numWorkers: The number of workers.
+ * @return The CPU set of each worker index. An empty set means that the worker is not pinned.
+ */
+std::vector<std::vector<int>> getWorkerCpuSets(const std::string& threadAffinity, const std::vector<std::string>& workerThreadAffinity,
+                                               size_t numWorkers);
+
+/**
+ * Pins the input thread to the given set of CPUs. An empty set leaves the affinity unchanged.
+ *
+ * @param [in] cpus: The CPU indices the thread is allowed to run on.
+ * @param [in] thread: A reference to the thread.
+ * @return true if the affinity was set.
+ */
+bool setThreadAffinity(const std::vector<int>& cpus, pthread_t thread);
+
+/**
+ * Pins the input thread to the given set of CPUs. An empty set leaves the affinity unchanged.
+ *
+ * @param [in] cpus: The CPU indices the thread is allowed to run on.
+ * @param [in] thread: A reference to the thread.
+ * @return true if the affinity was set.
+ */
+inline bool setThreadAffinity(const std::vector<int>& cpus, std::thread& thread) {
+  return setThreadAffinity(cpus, thread.native_handle());
+}
+
+/**
+ * Pins the thread this function is called from to the given set of CPUs. An empty set leaves the affinity unchanged.
+ *
+ * @param [in] cpus: The CPU indices the thread is allowed to run on.
+ * @return true if the affinity was set.
+ */
+inline bool setThisThreadAffinity(const std::vector<int>& cpus) {
+  return setThreadAffinity(cpus, pthread_self());
+}
+
+/**
+ * Pins the thread that constructs the object to the given set of CPUs and restores its previous affinity on destruction. An empty set
+ * leaves the affinity unchanged.
+ */
+class ScopedThisThreadAffinity {
+ public:
+  /**
+   * Constructor
+   *
+   * @param [in] cpus: The CPU indices the calling thread is allowed to run on while the object lives.
+   */
+  explicit ScopedThisThreadAffinity(const std::vector<int>& cpus);
+
+  /** Restores the previous affinity of the thread. */
+  ~ScopedThisThreadAffinity();
+
+  ScopedThisThreadAffinity(const ScopedThisThreadAffinity&) = delete;
+  ScopedThisThreadAffinity& operator=(const ScopedThisThreadAffinity&) = delete;
+
+ private:
+  bool isPinned_ = false;
+  cpu_set_t previousCpuSet_;
+};
+
+/**
+ * Runs a function in a temporary thread pinned to the given CPUs and waits for its completion. Under the default first-touch policy of
+ * Linux, the memory allocated and first written by the function is placed on the NUMA node of these CPUs. This is used to create the
+ * worker specific copies of the problem close to the worker that uses them. An empty set runs the function in the calling thread.
+ *
+ * @param [in] cpus: The CPU indices.
+ * @param [in] function: The function to run.
+ */
+template <typename Functor>
+void runOnCpus(const std::vector<int>& cpus, Functor&& function) {
+  if (cpus.empty()) {
+    function();
+  } else {
+    std::exception_ptr exceptionPtr;
+    std::thread pinnedThread([&] {
+      setThisThreadAffinity(cpus);
+      try {
+        function();
+      } catch (...) {
+        exceptionPtr = std::current_exception();
+      }
+    });
+    pinnedThread.join();
+    if (exceptionPtr) {
+      std::rethrow_exception(exceptionPtr);
+    }
+  }
+}
+
+}  // namespace ocs2
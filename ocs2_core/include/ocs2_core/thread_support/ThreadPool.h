@@ -29,7 +29,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <atomic>
 #include <condition_variable>
+#include <cstdint>
+#include <exception>
 #include <future>
 #include <mutex>
 #include <queue>
@@ -48,8 +51,11 @@ class ThreadPool {
    *
    * @param [in] nThreads: Number of threads to launch in the pool
    * @param [in] priority: The worker thread priority
+   * @param [in] cpuAffinity: The CPUs each worker index is pinned to. The entry at index nThreads (if given) belongs to the calling
+   *                          thread of runParallel and parallelFor, which is pinned to it for the duration of these calls.
+   *                          Missing or empty entries leave the affinity unchanged.
    */
-  explicit ThreadPool(size_t nThreads = 1, int priority = 0);
+  explicit ThreadPool(size_t nThreads = 1, int priority = 0, std::vector<std::vector<int>> cpuAffinity = {});
 
   /**
    * Destructor
@@ -80,15 +86,46 @@ class ThreadPool {
    */
   void runParallel(std::function<void(int)> taskFunction, int N);
 
+  /**
+   * Helper function to run taskFunction(workerIndex, i) for every index i in [begin, end) on the calling thread and the pool workers.
+   * The range is cut into chunks of grain consecutive indices. Every participant starts on an equal share of the chunks and, once its
+   * own share is exhausted, steals half of the remaining chunks of another participant. No memory is allocated and no lock is taken
+   * per chunk, which makes it the preferred way of distributing the nodes of a horizon over the pool.
+   * - The calling thread participates with ID = nThreads.
+   * - The pool workers participate with ID in [0, nThreads-1].
+   *
+   * @note This is a blocking operation, returns when all indices are processed. An exception thrown by taskFunction is rethrown in
+   * the calling thread once all participants have stopped, the remaining indices are then skipped.
+   * @warning Must not be called from inside a task running on the same pool.
+   *
+   * @tparam Functor: The callable type with signature void(int workerIndex, int i).
+   * @param [in] begin: first index of the range.
+   * @param [in] end: one past the last index of the range.
+   * @param [in] grain: number of consecutive indices executed per chunk.
+   * @param [in] taskFunction: task function to run for every index.
+   */
+  template <typename Functor>
+  void parallelFor(int begin, int end, int grain, Functor&& taskFunction);
+
   /** Get the number of threads. */
   size_t numThreads() const { return workerThreads_.size(); }
 
+  /** Get the CPUs the given worker index is pinned to, an empty set if it is not pinned. The calling thread has index nThreads. */
+  const std::vector<int>& getCpuAffinity(size_t workerIndex) const { return cpuAffinity_[workerIndex]; }
+
  private:
   struct TaskBase;
 
   template <typename Functor>
   struct Task;
 
+  struct ParallelForJob;
+
+  /** Range of not yet executed chunks [first, last) of one participant, packed with an ABA tag into a single atomic word. */
+  struct alignas(64) ChunkRange {
+    std::atomic<uint64_t> packedRange{0};
+  };
+
   /**
    * Thread worker loop
    *
@@ -103,12 +140,41 @@ class ThreadPool {
    */
   void runTask(std::unique_ptr<TaskBase> taskPtr);
 
+  /**
+   * Distributes the chunks of a parallelFor job, wakes up the workers and blocks until the job is completed.
+   *
+   * @param [in] job: The job description, owned by the caller of parallelFor.
+   */
+  void runParallelFor(ParallelForJob& job);
+
+  /**
+   * Executes chunks of the job, first from the participant's own range and then stolen from the other participants, until no chunk is
+   * left.
+   *
+   * @param [in] job: The current job.
+   * @param [in] participantIndex: The index of the executing participant (worker index or nThreads for the calling thread).
+   */
+  void executeParallelFor(ParallelForJob& job, int participantIndex);
+
+  /** Takes the first chunk of the participant's own range. Returns false if the range is empty. */
+  bool popChunk(int participantIndex, uint64_t& chunk);
+
+  /** Steals the upper half of another participant's range. The first stolen chunk is returned, the rest is kept in the own range. */
+  bool stealChunk(int participantIndex, uint64_t& chunk);
+
   bool stop_{false};  //!< flag telling all threads to stop, protected by taskQueueLock_
 
   std::queue<std::unique_ptr<TaskBase>> taskQueue_;  // protected by taskQueueLock_
   std::condition_variable taskQueueCondition_;
   std::mutex taskQueueLock_;
 
+  ParallelForJob* parallelForJobPtr_{nullptr};  // protected by taskQueueLock_
+  size_t parallelForGeneration_{0};             // protected by taskQueueLock_
+  std::condition_variable parallelForDoneCondition_;
+  std::mutex parallelForLock_;  //!< serializes parallelFor calls from different threads
+  std::unique_ptr<ChunkRange[]> chunkRanges_;  //!< one range per participant (nThreads + 1)
+
+  std::vector<std::vector<int>> cpuAffinity_;  //!< CPUs per worker index (nThreads + 1)
   std::vector<std::thread> workerThreads_;
 };
 
@@ -136,6 +202,24 @@ struct ThreadPool::Task final : public ThreadPool::TaskBase {
   std::packaged_task<ReturnType(int)> packagedTask;
 };
 
+/**
+ * Type-erased description of a parallelFor call. It lives on the stack of the calling thread for the duration of the call.
+ */
+struct ThreadPool::ParallelForJob {
+  using Invoker = void (*)(void* functorPtr, int workerIndex, int first, int last);
+
+  Invoker invoke = nullptr;    //!< runs the functor over the indices [first, last)
+  void* functorPtr = nullptr;  //!< the user functor
+  int begin = 0;
+  int end = 0;
+  int grain = 1;
+  uint64_t numChunks = 0;
+
+  int numActiveWorkers = 0;  // protected by taskQueueLock_
+  std::atomic_bool hasException{false};
+  std::exception_ptr exceptionPtr;  // written once, by the participant setting hasException
+};
+
 /**************************************************************************************************/
 /**************************************************************************************************/
 /**************************************************************************************************/
@@ -154,4 +238,26 @@ std::future<typename std::result_of<Functor(int)>::type> ThreadPool::run(Functor
   return future;
 }
 
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+template <typename Functor>
+void ThreadPool::parallelFor(int begin, int end, int grain, Functor&& taskFunction) {
+  using FunctorType = typename std::remove_reference<Functor>::type;
+
+  ParallelForJob job;
+  job.invoke = [](void* functorPtr, int workerIndex, int first, int last) {
+    auto& functor = *static_cast<FunctorType*>(functorPtr);
+    for (int i = first; i < last; ++i) {
+      functor(workerIndex, i);
+    }
+  };
+  job.functorPtr = const_cast<void*>(static_cast<const void*>(std::addressof(taskFunction)));
+  job.begin = begin;
+  job.end = end;
+  job.grain = grain;
+
+  runParallelFor(job);
+}
+
 }  // namespace ocs2
@@ -29,10 +29,243 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/automatic_differentiation/CppAdInterface.h>
 
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <thread>
+
 #include <boost/filesystem.hpp>
 
+#include <ocs2_core/automatic_differentiation/CppAdModelBatch.h>
+#include <ocs2_core/misc/Trace.h>
+#include <ocs2_core/thread_support/ThreadPool.h>
+
 namespace ocs2 {
 
+namespace {
+/** Scratch memory of the in-place evaluations, one set per thread such that concurrent calls on a shared interface are safe. */
+struct ScratchBuffers {
+  std::vector<scalar_t> xp;
+  std::vector<scalar_t> values;
+  std::vector<scalar_t> sparseValues;
+};
+
+ScratchBuffers& getScratchBuffers() {
+  thread_local ScratchBuffers scratchBuffers;
+  return scratchBuffers;
+}
+
+/**
+ * Creates the compressed row pattern for the (row, col) non-zeros returned by the generated model.
+ * @param [out] pattern : pattern with all values set to zero.
+ * @param [out] patternToModel : index of the model non-zero for each stored non-zero of the pattern.
+ * @param [in] symmetric : Stores each entry in both triangles. Entries that appear in both triangles of the model output are taken once.
+ */
+void createCompressedPattern(const std::vector<size_t>& rows, const std::vector<size_t>& cols, size_t numRows, size_t numCols,
+                             bool symmetric, sparse_matrix_t& pattern, std::vector<size_t>& patternToModel) {
+  using triplet_t = Eigen::Triplet<scalar_t>;
+  std::vector<triplet_t> triplets;
+  triplets.reserve(2 * rows.size());
+  std::set<std::pair<size_t, size_t>> visited;
+  for (size_t i = 0; i < rows.size(); i++) {
+    // The model index is stored shifted by one in the values, such that explicit zeros can not occur.
+    const scalar_t modelIndex = static_cast<scalar_t>(i + 1);
+    if (symmetric) {
+      const auto upper = std::make_pair(std::min(rows[i], cols[i]), std::max(rows[i], cols[i]));
+      if (!visited.insert(upper).second) {
+        continue;
+      }
+      triplets.emplace_back(upper.first, upper.second, modelIndex);
+      if (upper.first != upper.second) {
+        triplets.emplace_back(upper.second, upper.first, modelIndex);
+      }
+    } else {
+      triplets.emplace_back(rows[i], cols[i], modelIndex);
+    }
+  }
+
+  pattern.resize(numRows, numCols);
+  pattern.setFromTriplets(triplets.begin(), triplets.end());
+  pattern.makeCompressed();
+
+  patternToModel.resize(pattern.nonZeros());
+  for (Eigen::Index k = 0; k < pattern.nonZeros(); k++) {
+    patternToModel[k] = static_cast<size_t>(pattern.valuePtr()[k]) - 1;
+    pattern.valuePtr()[k] = 0.0;
+  }
+}
+
+/** Checks if the matrix has the dimensions and the same structural non-zeros as the pattern. */
+bool hasPattern(const sparse_matrix_t& matrix, const sparse_matrix_t& pattern) {
+  if (!matrix.isCompressed() || matrix.rows() != pattern.rows() || matrix.cols() != pattern.cols() ||
+      matrix.nonZeros() != pattern.nonZeros()) {
+    return false;
+  }
+  return std::equal(pattern.outerIndexPtr(), pattern.outerIndexPtr() + pattern.outerSize() + 1, matrix.outerIndexPtr()) &&
+         std::equal(pattern.innerIndexPtr(), pattern.innerIndexPtr() + pattern.nonZeros(), matrix.innerIndexPtr());
+}
+
+/** Collects the sources that DynamicModelLibraryProcessor would compile, without compiling them. */
+class LibrarySourceCollector : public CppAD::cg::ModelLibraryProcessor<scalar_t> {
+ public:
+  using CppAD::cg::ModelLibraryProcessor<scalar_t>::ModelLibraryProcessor;
+
+  std::map<std::string, std::string> collect(CppAD::cg::ModelCSourceGen<scalar_t>& sourceGen) {
+    std::map<std::string, std::string> sources = getSources(sourceGen);
+    const auto& librarySources = getLibrarySources();
+    sources.insert(librarySources.begin(), librarySources.end());
+    const auto& customSources = modelLibraryHelper_->getCustomSources();
+    sources.insert(customSources.begin(), customSources.end());
+    return sources;
+  }
+};
+
+/** Trims the whitespace at both ends */
+std::string trim(const std::string& str) {
+  const auto first = str.find_first_not_of(" \t\r");
+  const auto last = str.find_last_not_of(" \t\r");
+  return (first == std::string::npos) ? std::string() : str.substr(first, last - first + 1);
+}
+
+/**
+ * Translates the right-hand side of a generated assignment to the lane variant, see CppAdInterface::setNumLanes. The expression may only
+ * contain numbers, arithmetic operators, the arrays x, v and the output array, and the math functions below.
+ * @return false if the expression contains anything else
+ */
+bool translateExpressionToLanes(const std::string& expression, const std::string& outputName, std::set<std::string>& mathFunctions,
+                                std::string& laneExpression) {
+  static const std::set<std::string> supportedMathFunctions{"acos", "asin", "atan", "cos",  "cosh", "erf",  "exp",  "fabs",
+                                                            "log",  "pow",  "sin",  "sinh", "sqrt", "tan",  "tanh"};
+  size_t i = 0;
+  while (i < expression.size()) {
+    const char c = expression[i];
+    if (std::isdigit(c) || c == '.') {
+      // Number, possibly with an exponent
+      const size_t begin = i;
+      while (i < expression.size() && (std::isdigit(expression[i]) || expression[i] == '.')) {
+        i++;
+      }
+      if (i < expression.size() && (expression[i] == 'e' || expression[i] == 'E')) {
+        i++;
+        if (i < expression.size() && (expression[i] == '+' || expression[i] == '-')) {
+          i++;
+        }
+        while (i < expression.size() && std::isdigit(expression[i])) {
+          i++;
+        }
+      }
+      laneExpression.append(expression, begin, i - begin);
+    } else if (std::isalpha(c) || c == '_') {
+      const size_t begin = i;
+      while (i < expression.size() && (std::isalnum(expression[i]) || expression[i] == '_')) {
+        i++;
+      }
+      const std::string name = expression.substr(begin, i - begin);
+      const char next = (i < expression.size()) ? expression[i] : '\0';
+      if (next == '[' && (name == "x" || name == "v" || name == outputName)) {
+        laneExpression += name;
+      } else if (next == '(' && supportedMathFunctions.count(name) > 0) {
+        mathFunctions.insert(name);
+        laneExpression += "ocs2_lane_" + name;
+      } else {
+        return false;
+      }
+    } else if (std::string(" +-*/(),[]").find(c) != std::string::npos) {
+      laneExpression += c;
+      i++;
+    } else {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Translates the body of a generated scalar function to the lane variant. Only straight-line code is accepted, i.e. the declaration of
+ * the auxiliary variables v followed by assignments to v and to the output array.
+ * @param [in] source : generated C source
+ * @param [in] functionName : name of the generated function
+ * @param [in] outputName : name of the output array in the generated function
+ * @param [out] mathFunctions : math functions used by the body
+ * @param [out] laneBody : translated body, without the declarations of the input and output arrays
+ * @return false if the source contains anything else
+ */
+bool translateToLanes(const std::string& source, const std::string& functionName, const std::string& outputName,
+                      std::set<std::string>& mathFunctions, std::string& laneBody) {
+  const auto signature = source.find("void " + functionName + "(");
+  const auto bodyBegin = (signature == std::string::npos) ? std::string::npos : source.find('{', signature);
+  if (bodyBegin == std::string::npos) {
+    return false;
+  }
+
+  std::istringstream body(source.substr(bodyBegin + 1));
+  std::string line;
+  while (std::getline(body, line)) {
+    const auto statement = trim(line);
+    if (statement == "}") {
+      return true;
+    }
+    if (statement.empty() || statement.compare(0, 2, "//") == 0 || statement == "const double* x = in[0];" ||
+        statement == "double* " + outputName + " = out[0];") {
+      continue;
+    }
+    if (statement.compare(0, 9, "double v[") == 0) {
+      laneBody += "   ocs2_lane_t " + statement.substr(7) + "\n";
+      continue;
+    }
+
+    // Assignment "name[index] = expression;", scalar constants are broadcast to all lanes
+    const auto assignment = statement.find(" = ");
+    if (assignment == std::string::npos || statement.back() != ';') {
+      return false;
+    }
+    const auto lhs = statement.substr(0, assignment);
+    const auto bracket = lhs.find('[');
+    const auto lhsName = lhs.substr(0, bracket);
+    if (bracket == std::string::npos || lhs.back() != ']' || (lhsName != "v" && lhsName != outputName) ||
+        lhs.find_first_not_of("0123456789", bracket + 1) != lhs.size() - 1) {
+      return false;
+    }
+    std::string laneExpression;
+    if (!translateExpressionToLanes(statement.substr(assignment + 3, statement.size() - assignment - 4), outputName, mathFunctions,
+                                    laneExpression)) {
+      return false;
+    }
+    laneBody += "   " + lhs + " = ocs2_lane_zero + (" + laneExpression + ");\n";
+  }
+  return false;  // end of the function not found
+}
+
+/** 64 bit FNV-1a hash, which is stable across platforms and standard library implementations. */
+void hashCombine(const std::string& data, uint64_t& hash) {
+  for (const unsigned char c : data) {
+    hash ^= c;
+    hash *= 1099511628211ULL;
+  }
+  // Separator such that the boundaries between the strings are part of the hash
+  hash ^= 0xFF;
+  hash *= 1099511628211ULL;
+}
+
+/** Version string of the compiler, which is only queried once per executable. */
+const std::string& getCompilerVersion(const std::string& compilerPath) {
+  static std::mutex versionMutex;
+  static std::map<std::string, std::string> versions;
+  std::lock_guard<std::mutex> lock(versionMutex);
+  auto it = versions.find(compilerPath);
+  if (it == versions.end()) {
+    std::string version;
+    CppAD::cg::system::callExecutable(compilerPath, {"--version"}, &version);
+    it = versions.emplace(compilerPath, std::move(version)).first;
+  }
+  return it->second;
+}
+}  // unnamed namespace
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -60,7 +293,11 @@ CppAdInterface::CppAdInterface(ad_function_t adFunction, size_t variableDim, std
 /******************************************************************************************************/
 CppAdInterface::CppAdInterface(const CppAdInterface& rhs)
     : CppAdInterface(rhs.adFunction_, rhs.variableDim_, rhs.parameterDim_, rhs.modelName_, rhs.folderName_, rhs.compileFlags_) {
-  if (isLibraryAvailable()) {
+  numLanes_ = rhs.numLanes_;
+  if (rhs.pendingModelBatchPtr_ != nullptr) {
+    // The library on disk may still be outdated
+    rhs.pendingModelBatchPtr_->addLoad(*this, false);
+  } else if (isLibraryAvailable()) {
     loadModels(false);
   }
 }
@@ -68,61 +305,34 @@ CppAdInterface::CppAdInterface(const CppAdInterface& rhs)
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-void CppAdInterface::createModels(ApproximationOrder approximationOrder, bool verbose) {
-  createFolderStructure();
-
-  // set and declare independent variables and start tape recording
-  ad_vector_t xp(variableDim_ + parameterDim_);
-  xp.setOnes();  // Ones are better than zero, to prevent devision by zero in taping
-  CppAD::Independent(xp);
-
-  // Split in variables and parameters
-  ad_vector_t x = xp.segment(0, variableDim_);
-  ad_vector_t p = xp.segment(variableDim_, parameterDim_);
-  // dependent variable vector
-  ad_vector_t y;
-  // the model equation
-  adFunction_(x, p, y);
-  rangeDim_ = y.rows();
-  // create f: xp -> y and stop tape recording
-  ad_fun_t fun(xp, y);
-  // Optimize the operation sequence
-  fun.optimize();
-
-  // generates source code
-  CppAD::cg::ModelCSourceGen<scalar_t> sourceGen(fun, modelName_);
-  setApproximationOrder(approximationOrder, sourceGen, fun);
-
-  // Compiler objects, compile to temporary shared library file to avoid interference between processes
-  CppAD::cg::ModelLibraryCSourceGen<scalar_t> libraryCSourceGen(sourceGen);
-  CppAD::cg::GccCompiler<scalar_t> gccCompiler;
-  CppAD::cg::DynamicModelLibraryProcessor<scalar_t> libraryProcessor(libraryCSourceGen, libraryName_ + tmpName_);
-  setCompilerOptions(gccCompiler);
-
-  if (verbose) {
-    std::cerr << "[CppAdInterface] Compiling Shared Library: "
-              << libraryName_ + tmpName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION << std::endl;
+CppAdInterface::~CppAdInterface() {
+  if (pendingModelBatchPtr_ != nullptr) {
+    pendingModelBatchPtr_->remove(*this);
   }
+}
 
-  // Compile and store the library
-  dynamicLib_ = libraryProcessor.createDynamicLibrary(gccCompiler);
-  model_ = dynamicLib_->model(modelName_);
-
-  setSparsityNonzeros();
-
-  // Rename generated library after loading
-  if (verbose) {
-    std::cerr << "[CppAdInterface] Renaming " << libraryName_ + tmpName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION << " to "
-              << libraryName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION << std::endl;
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::createModels(ApproximationOrder approximationOrder, bool verbose) {
+  OCS2_TRACE_ZONE("CppAdInterface::createModels");
+  if (auto* modelBatchPtr = CppAdModelBatch::getActiveBatch()) {
+    addToModelBatch(*modelBatchPtr, approximationOrder, false, verbose);
+    return;
   }
-  boost::filesystem::rename(libraryName_ + tmpName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION,
-                            libraryName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION);
+  createFolderStructure();
+  ad_fun_t fun;
+  tapeFunction(fun);
+  const auto contentHash = getContentHash(fun, approximationOrder);
+  compileLibrary(generateSources(approximationOrder, fun), contentHash, verbose);
+  loadCompiledLibrary(verbose);
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 void CppAdInterface::loadModels(bool verbose) {
+  OCS2_TRACE_ZONE("CppAdInterface::loadModels");
   if (verbose) {
     std::cerr << "[CppAdInterface] Loading Shared Library: " << libraryName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION
               << std::endl;
@@ -132,6 +342,7 @@ void CppAdInterface::loadModels(bool verbose) {
   rangeDim_ = model_->Range();
 
   setSparsityNonzeros();
+  loadLaneFunctions();
 }
 
 /******************************************************************************************************/
@@ -148,14 +359,132 @@ void CppAdInterface::loadModelsIfAvailable(ApproximationOrder approximationOrder
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-vector_t CppAdInterface::getFunctionValue(const vector_t& x, const vector_t& p) const {
-  vector_t xp(variableDim_ + parameterDim_);
-  xp << x, p;
+void CppAdInterface::loadModelsIfUpToDate(ApproximationOrder approximationOrder, bool verbose) {
+  OCS2_TRACE_ZONE("CppAdInterface::loadModelsIfUpToDate");
+  if (auto* modelBatchPtr = CppAdModelBatch::getActiveBatch()) {
+    addToModelBatch(*modelBatchPtr, approximationOrder, true, verbose);
+    return;
+  }
+  createFolderStructure();
+  ad_fun_t fun;
+  tapeFunction(fun);
+  const auto contentHash = getContentHash(fun, approximationOrder);
+  if (isLibraryUpToDate(contentHash)) {
+    loadModels(verbose);
+  } else {
+    compileLibrary(generateSources(approximationOrder, fun), contentHash, verbose);
+    loadCompiledLibrary(verbose);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::createModelsInParallel(const std::vector<std::pair<CppAdInterface*, ApproximationOrder>>& adInterfaces,
+                                            size_t maxNumJobs, bool useCache, bool verbose) {
+  OCS2_TRACE_ZONE("CppAdInterface::createModelsInParallel");
+  if (auto* modelBatchPtr = CppAdModelBatch::getActiveBatch()) {
+    for (const auto& adInterface : adInterfaces) {
+      adInterface.first->addToModelBatch(*modelBatchPtr, adInterface.second, useCache, verbose);
+    }
+    return;
+  }
+
+  if (maxNumJobs == 0) {
+    maxNumJobs = std::max(1U, std::thread::hardware_concurrency());
+  }
+  // No more threads than models
+  maxNumJobs = std::min(maxNumJobs, std::max<size_t>(adInterfaces.size(), 1));
+  ThreadPool compilePool(maxNumJobs);
+
+  std::vector<std::future<void>> compileJobs;
+  std::vector<bool> isCompiled(adInterfaces.size(), false);
+  compileJobs.reserve(adInterfaces.size());
+  for (size_t i = 0; i < adInterfaces.size(); i++) {
+    CppAdInterface* adInterface = adInterfaces[i].first;
+    adInterface->createFolderStructure();
+    ad_fun_t fun;
+    adInterface->tapeFunction(fun);
+    auto contentHash = adInterface->getContentHash(fun, adInterfaces[i].second);
+    if (!useCache || !adInterface->isLibraryUpToDate(contentHash)) {
+      isCompiled[i] = true;
+      auto sources = adInterface->generateSources(adInterfaces[i].second, fun);
+      compileJobs.push_back(
+          compilePool.run([adInterface, sources = std::move(sources), contentHash = std::move(contentHash), verbose](int) {
+            adInterface->compileLibrary(sources, contentHash, verbose);
+          }));
+    }
+  }
+
+  // Rethrows the first compilation error
+  for (auto& compileJob : compileJobs) {
+    compileJob.get();
+  }
+
+  for (size_t i = 0; i < adInterfaces.size(); i++) {
+    if (isCompiled[i]) {
+      adInterfaces[i].first->loadCompiledLibrary(verbose);
+    } else {
+      adInterfaces[i].first->loadModels(verbose);
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::loadCompiledLibrary(bool verbose) {
+  const std::string libraryExtension = CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION;
+
+  // Load before renaming, the dynamic loader would return the handle of an earlier library loaded from the final path
+  dynamicLib_.reset(new CppAD::cg::LinuxDynamicLib<scalar_t>(libraryName_ + tmpName_ + libraryExtension));
+  model_ = dynamicLib_->model(modelName_);
+  rangeDim_ = model_->Range();
+
+  setSparsityNonzeros();
+  loadLaneFunctions();
+
+  // Rename generated library after loading
+  publishCompiledLibrary(libraryName_, tmpName_, verbose);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::publishCompiledLibrary(const std::string& libraryName, const std::string& tmpName, bool verbose) {
+  const std::string libraryExtension = CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION;
 
-  vector_t functionValue(model_->Range());
+  // The hash is renamed last, such that a new library with an old hash is recompiled by other processes rather than an old library with
+  // a new hash being loaded.
+  if (verbose) {
+    std::cerr << "[CppAdInterface] Renaming " << libraryName + tmpName + libraryExtension << " to " << libraryName + libraryExtension
+              << std::endl;
+  }
+  boost::filesystem::rename(libraryName + tmpName + libraryExtension, libraryName + libraryExtension);
+  boost::filesystem::rename(libraryName + tmpName + ".hash", libraryName + ".hash");
+}
 
-  model_->ForwardZero(xp, functionValue);
-  assert(functionValue.allFinite());
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::addToModelBatch(CppAdModelBatch& modelBatch, ApproximationOrder approximationOrder, bool useCache, bool verbose) {
+  createFolderStructure();
+  ad_fun_t fun;
+  tapeFunction(fun);
+  auto contentHash = getContentHash(fun, approximationOrder);
+  if (useCache && isLibraryUpToDate(contentHash)) {
+    loadModels(verbose);
+  } else {
+    modelBatch.addCompilation(*this, generateSources(approximationOrder, fun), std::move(contentHash), verbose);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+vector_t CppAdInterface::getFunctionValue(const vector_t& x, const vector_t& p) const {
+  vector_t functionValue(rangeDim_);
+  getFunctionValue(x, p, functionValue);
   return functionValue;
 }
 
@@ -163,12 +492,63 @@ vector_t CppAdInterface::getFunctionValue(const vector_t& x, const vector_t& p)
 /******************************************************************************************************/
 /******************************************************************************************************/
 matrix_t CppAdInterface::getJacobian(const vector_t& x, const vector_t& p) const {
-  // Concatenate input
-  vector_t xp(variableDim_ + parameterDim_);
-  xp << x, p;
-  CppAD::cg::ArrayView<scalar_t> xpArrayView(xp.data(), xp.size());
+  matrix_t jacobian(rangeDim_, variableDim_);
+  getJacobian(x, p, jacobian);
+  return jacobian;
+}
 
-  std::vector<scalar_t> sparseJacobian(nnzJacobian_);
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ScalarFunctionQuadraticApproximation CppAdInterface::getGaussNewtonApproximation(const vector_t& x, const vector_t& p) const {
+  ScalarFunctionQuadraticApproximation gnApprox;
+  gnApprox.dfdx.resize(variableDim_);
+  gnApprox.dfdxx.resize(variableDim_, variableDim_);
+  getGaussNewtonApproximation(x, p, gnApprox.f, gnApprox.dfdx, gnApprox.dfdxx);
+  return gnApprox;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+matrix_t CppAdInterface::getHessian(size_t outputIndex, const vector_t& x, const vector_t& p) const {
+  vector_t w = vector_t::Zero(rangeDim_);
+  w[outputIndex] = 1.0;
+
+  return getHessian(w, x, p);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+matrix_t CppAdInterface::getHessian(const vector_t& w, const vector_t& x, const vector_t& p) const {
+  matrix_t hessian(variableDim_, variableDim_);
+  getHessian(w, x, p, hessian);
+  return hessian;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::getFunctionValue(const Eigen::Ref<const vector_t>& x, const Eigen::Ref<const vector_t>& p,
+                                      Eigen::Ref<vector_t> value) const {
+  assert(value.size() == rangeDim_);
+  const auto xpArrayView = concatenateInput(x, p);
+  model_->ForwardZero(xpArrayView, CppAD::cg::ArrayView<scalar_t>(value.data(), value.size()));
+  assert(value.allFinite());
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::getJacobian(const Eigen::Ref<const vector_t>& x, const Eigen::Ref<const vector_t>& p,
+                                 Eigen::Ref<matrix_t> jacobian) const {
+  assert(jacobian.rows() == rangeDim_);
+  assert(jacobian.cols() == variableDim_);
+  const auto xpArrayView = concatenateInput(x, p);
+
+  auto& sparseJacobian = getScratchBuffers().sparseValues;
+  sparseJacobian.resize(nnzJacobian_);
   CppAD::cg::ArrayView<scalar_t> sparseJacobianArrayView(sparseJacobian);
   size_t const* rows;
   size_t const* cols;
@@ -177,42 +557,44 @@ matrix_t CppAdInterface::getJacobian(const vector_t& x, const vector_t& p) const
 
   // Write sparse elements into Eigen type. Only jacobian w.r.t. variables was requested, so cols should not contain elements corresponding
   // to parameters.
-  matrix_t jacobian = matrix_t::Zero(model_->Range(), variableDim_);
+  jacobian.setZero();
   for (size_t i = 0; i < nnzJacobian_; i++) {
     jacobian(rows[i], cols[i]) = sparseJacobian[i];
   }
 
   assert(jacobian.allFinite());
-  return jacobian;
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-ScalarFunctionQuadraticApproximation CppAdInterface::getGaussNewtonApproximation(const vector_t& x, const vector_t& p) const {
-  // Concatenate input
-  vector_t xp(variableDim_ + parameterDim_);
-  xp << x, p;
-  CppAD::cg::ArrayView<scalar_t> xpArrayView(xp.data(), xp.size());
-
-  ScalarFunctionQuadraticApproximation gnApprox;
+void CppAdInterface::getGaussNewtonApproximation(const Eigen::Ref<const vector_t>& x, const Eigen::Ref<const vector_t>& p, scalar_t& f,
+                                                 Eigen::Ref<vector_t> dfdx, Eigen::Ref<matrix_t> dfdxx) const {
+  assert(dfdx.size() == variableDim_);
+  assert(dfdxx.rows() == variableDim_);
+  assert(dfdxx.cols() == variableDim_);
+  const auto xpArrayView = concatenateInput(x, p);
+  auto& scratch = getScratchBuffers();
 
   // Zero order
-  vector_t valueVector(model_->Range());
-  model_->ForwardZero(xp, valueVector);
-  gnApprox.f = 0.5 * valueVector.squaredNorm();
+  scratch.values.resize(rangeDim_);
+  CppAD::cg::ArrayView<scalar_t> valueArrayView(scratch.values);
+  model_->ForwardZero(xpArrayView, valueArrayView);
+  const Eigen::Map<const vector_t> valueVector(scratch.values.data(), rangeDim_);
+  f = 0.5 * valueVector.squaredNorm();
 
   // Jacobian
-  std::vector<scalar_t> sparseJacobian(nnzJacobian_);
+  auto& sparseJacobian = scratch.sparseValues;
+  sparseJacobian.resize(nnzJacobian_);
   CppAD::cg::ArrayView<scalar_t> sparseJacobianArrayView(sparseJacobian);
   size_t const* rows;
   size_t const* cols;
   model_->SparseJacobian(xpArrayView, sparseJacobianArrayView, &rows, &cols);
 
   // Sparse evaluation of J' * f
-  gnApprox.dfdx.setZero(variableDim_);
+  dfdx.setZero();
   for (size_t i = 0; i < nnzJacobian_; i++) {
-    gnApprox.dfdx(cols[i]) += sparseJacobian[i] * valueVector(rows[i]);
+    dfdx(cols[i]) += sparseJacobian[i] * valueVector(rows[i]);
   }
 
   /*
@@ -221,48 +603,37 @@ ScalarFunctionQuadraticApproximation CppAdInterface::getGaussNewtonApproximation
    * Because the sparse elements are ordered first by row, then by column, we process J row-by-row.
    * For each row of J, we add the non-zero pairs (i, j) to H(i, j).
    */
-  gnApprox.dfdxx.setZero(variableDim_, variableDim_);
+  dfdxx.setZero();
   for (size_t i = 0; i < nnzJacobian_; ++i) {
     const size_t row_i = rows[i];
     const size_t col_i = cols[i];
     const scalar_t v_i = sparseJacobian[i];
     // Diagonal element always exists:
-    gnApprox.dfdxx(col_i, col_i) += v_i * v_i;
+    dfdxx(col_i, col_i) += v_i * v_i;
     // Process off-diagonals
-    size_t j = i + 1;
-    while (rows[j] == row_i) {
+    for (size_t j = i + 1; j < nnzJacobian_ && rows[j] == row_i; ++j) {
       const size_t col_j = cols[j];
-      gnApprox.dfdxx(col_j, col_i) += v_i * sparseJacobian[j];
-      gnApprox.dfdxx(col_i, col_j) = gnApprox.dfdxx(col_j, col_i);  // Maintain symmetry as we go.
-      ++j;
+      dfdxx(col_j, col_i) += v_i * sparseJacobian[j];
+      dfdxx(col_i, col_j) = dfdxx(col_j, col_i);  // Maintain symmetry as we go.
     }
   }
 
-  assert(gnApprox.dfdx.allFinite());
-  assert(gnApprox.dfdxx.allFinite());
-  return gnApprox;
-}
-
-/******************************************************************************************************/
-/******************************************************************************************************/
-/******************************************************************************************************/
-matrix_t CppAdInterface::getHessian(size_t outputIndex, const vector_t& x, const vector_t& p) const {
-  vector_t w = vector_t::Zero(rangeDim_);
-  w[outputIndex] = 1.0;
-
-  return getHessian(w, x, p);
+  assert(dfdx.allFinite());
+  assert(dfdxx.allFinite());
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-matrix_t CppAdInterface::getHessian(const vector_t& w, const vector_t& x, const vector_t& p) const {
-  // Concatenate input
-  vector_t xp(variableDim_ + parameterDim_);
-  xp << x, p;
-  CppAD::cg::ArrayView<const scalar_t> xpArrayView(xp.data(), xp.size());
+void CppAdInterface::getHessian(const Eigen::Ref<const vector_t>& w, const Eigen::Ref<const vector_t>& x,
+                                const Eigen::Ref<const vector_t>& p, Eigen::Ref<matrix_t> hessian) const {
+  assert(w.size() == rangeDim_);
+  assert(hessian.rows() == variableDim_);
+  assert(hessian.cols() == variableDim_);
+  const auto xpArrayView = concatenateInput(x, p);
 
-  std::vector<scalar_t> sparseHessian(nnzHessian_);
+  auto& sparseHessian = getScratchBuffers().sparseValues;
+  sparseHessian.resize(nnzHessian_);
   CppAD::cg::ArrayView<scalar_t> sparseHessianArrayView(sparseHessian);
   size_t const* rows;
   size_t const* cols;
@@ -273,7 +644,7 @@ matrix_t CppAdInterface::getHessian(const vector_t& w, const vector_t& x, const
   model_->SparseHessian(xpArrayView, wArrayView, sparseHessianArrayView, &rows, &cols);
 
   // Fills upper triangular sparsity of hessian w.r.t variables.
-  matrix_t hessian = matrix_t::Zero(variableDim_, variableDim_);
+  hessian.setZero();
   for (size_t i = 0; i < nnzHessian_; i++) {
     hessian(rows[i], cols[i]) = sparseHessian[i];
   }
@@ -282,7 +653,183 @@ matrix_t CppAdInterface::getHessian(const vector_t& w, const vector_t& x, const
   hessian.template triangularView<Eigen::StrictlyLower>() = hessian.template triangularView<Eigen::StrictlyUpper>().transpose();
 
   assert(hessian.allFinite());
-  return hessian;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::setNumLanes(size_t numLanes) {
+  if (numLanes > 16 || (numLanes & (numLanes - 1)) != 0) {
+    throw std::runtime_error("[CppAdInterface] The number of lanes must be 0, 1, 2, 4, 8 or 16, got " + std::to_string(numLanes));
+  }
+  numLanes_ = numLanes;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::getFunctionValueBatch(const Eigen::Ref<const matrix_t>& X, const Eigen::Ref<const matrix_t>& P,
+                                           Eigen::Ref<matrix_t> values) const {
+  OCS2_TRACE_ZONE("CppAdInterface::getFunctionValueBatch");
+  assert(X.rows() == variableDim_);
+  assert(P.rows() == parameterDim_);
+  assert(P.cols() == X.cols() || parameterDim_ == 0);
+  assert(values.rows() == rangeDim_);
+  assert(values.cols() == X.cols());
+
+  Eigen::Index k = 0;
+  if (laneFunctions_.forwardZero != nullptr) {
+    const auto numLanes = static_cast<Eigen::Index>(laneFunctions_.numLanes);
+    auto& laneValues = getScratchBuffers().values;
+    laneValues.resize(numLanes * rangeDim_);
+    for (; k + numLanes <= X.cols(); k += numLanes) {
+      laneFunctions_.forwardZero(packLanes(X, P, k), laneValues.data());
+      values.middleCols(k, numLanes) = Eigen::Map<const matrix_t>(laneValues.data(), numLanes, rangeDim_).transpose();
+    }
+  }
+
+  // Remaining points are evaluated one by one
+  const vector_t noParameters(0);
+  for (; k < X.cols(); ++k) {
+    if (parameterDim_ > 0) {
+      getFunctionValue(X.col(k), P.col(k), values.col(k));
+    } else {
+      getFunctionValue(X.col(k), noParameters, values.col(k));
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::getJacobianBatch(const Eigen::Ref<const matrix_t>& X, const Eigen::Ref<const matrix_t>& P,
+                                      Eigen::Ref<matrix_t> jacobians) const {
+  OCS2_TRACE_ZONE("CppAdInterface::getJacobianBatch");
+  assert(X.rows() == variableDim_);
+  assert(P.rows() == parameterDim_);
+  assert(P.cols() == X.cols() || parameterDim_ == 0);
+  assert(jacobians.rows() == X.cols() * rangeDim_);
+  assert(jacobians.cols() == variableDim_);
+
+  Eigen::Index k = 0;
+  if (laneFunctions_.sparseJacobian != nullptr) {
+    const auto numLanes = static_cast<Eigen::Index>(laneFunctions_.numLanes);
+    const size_t nnz = laneFunctions_.jacobianRows.size();
+    auto& laneJacobian = getScratchBuffers().sparseValues;
+    laneJacobian.resize(numLanes * nnz);
+    for (; k + numLanes <= X.cols(); k += numLanes) {
+      laneFunctions_.sparseJacobian(packLanes(X, P, k), laneJacobian.data());
+
+      // Non-zero i of lane l is stored at i * numLanes + l
+      jacobians.middleRows(k * rangeDim_, numLanes * rangeDim_).setZero();
+      for (size_t i = 0; i < nnz; i++) {
+        const auto row = static_cast<Eigen::Index>(laneFunctions_.jacobianRows[i]);
+        const auto col = static_cast<Eigen::Index>(laneFunctions_.jacobianCols[i]);
+        for (Eigen::Index l = 0; l < numLanes; l++) {
+          jacobians((k + l) * rangeDim_ + row, col) = laneJacobian[i * numLanes + l];
+        }
+      }
+    }
+  }
+
+  // Remaining points are evaluated one by one
+  const vector_t noParameters(0);
+  for (; k < X.cols(); ++k) {
+    auto jacobian = jacobians.middleRows(k * rangeDim_, rangeDim_);
+    if (parameterDim_ > 0) {
+      getJacobian(X.col(k), P.col(k), jacobian);
+    } else {
+      getJacobian(X.col(k), noParameters, jacobian);
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::getSparseJacobian(const Eigen::Ref<const vector_t>& x, const Eigen::Ref<const vector_t>& p,
+                                       sparse_matrix_t& jacobian) const {
+  if (!hasPattern(jacobian, jacobianPattern_)) {
+    jacobian = jacobianPattern_;
+  }
+  const auto xpArrayView = concatenateInput(x, p);
+  size_t const* rows;
+  size_t const* cols;
+
+  if (isJacobianPatternInModelOrder_) {
+    // The model output is already in compressed row order, write the values in place.
+    CppAD::cg::ArrayView<scalar_t> valuesArrayView(jacobian.valuePtr(), jacobian.nonZeros());
+    model_->SparseJacobian(xpArrayView, valuesArrayView, &rows, &cols);
+  } else {
+    auto& sparseJacobian = getScratchBuffers().sparseValues;
+    sparseJacobian.resize(nnzJacobian_);
+    CppAD::cg::ArrayView<scalar_t> sparseJacobianArrayView(sparseJacobian);
+    model_->SparseJacobian(xpArrayView, sparseJacobianArrayView, &rows, &cols);
+    for (size_t k = 0; k < jacobianPatternToModel_.size(); k++) {
+      jacobian.valuePtr()[k] = sparseJacobian[jacobianPatternToModel_[k]];
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::getSparseHessian(const Eigen::Ref<const vector_t>& w, const Eigen::Ref<const vector_t>& x,
+                                      const Eigen::Ref<const vector_t>& p, sparse_matrix_t& hessian) const {
+  assert(w.size() == rangeDim_);
+  if (!hasPattern(hessian, hessianPattern_)) {
+    hessian = hessianPattern_;
+  }
+  const auto xpArrayView = concatenateInput(x, p);
+
+  auto& sparseHessian = getScratchBuffers().sparseValues;
+  sparseHessian.resize(nnzHessian_);
+  CppAD::cg::ArrayView<scalar_t> sparseHessianArrayView(sparseHessian);
+  CppAD::cg::ArrayView<const scalar_t> wArrayView(w.data(), w.size());
+  size_t const* rows;
+  size_t const* cols;
+  model_->SparseHessian(xpArrayView, wArrayView, sparseHessianArrayView, &rows, &cols);
+
+  for (size_t k = 0; k < hessianPatternToModel_.size(); k++) {
+    hessian.valuePtr()[k] = sparseHessian[hessianPatternToModel_[k]];
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+CppAD::cg::ArrayView<const scalar_t> CppAdInterface::concatenateInput(const Eigen::Ref<const vector_t>& x,
+                                                                      const Eigen::Ref<const vector_t>& p) const {
+  assert(x.size() == variableDim_);
+  assert(p.size() == parameterDim_);
+  if (parameterDim_ == 0) {
+    return CppAD::cg::ArrayView<const scalar_t>(x.data(), x.size());
+  }
+
+  // Resizing only reallocates when the buffer grows, hence this is allocation free after the first call.
+  auto& xp = getScratchBuffers().xp;
+  xp.resize(variableDim_ + parameterDim_);
+  std::copy(x.data(), x.data() + variableDim_, xp.data());
+  std::copy(p.data(), p.data() + parameterDim_, xp.data() + variableDim_);
+  return CppAD::cg::ArrayView<const scalar_t>(xp.data(), xp.size());
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+const scalar_t* CppAdInterface::packLanes(const Eigen::Ref<const matrix_t>& X, const Eigen::Ref<const matrix_t>& P,
+                                          Eigen::Index firstColumn) const {
+  const auto numLanes = static_cast<Eigen::Index>(laneFunctions_.numLanes);
+  auto& laneInput = getScratchBuffers().xp;
+  laneInput.resize(numLanes * (variableDim_ + parameterDim_));
+
+  // Entry i of lane l is stored at i * numLanes + l, i.e. the transpose of the column-major block
+  Eigen::Map<matrix_t>(laneInput.data(), numLanes, variableDim_) = X.middleCols(firstColumn, numLanes).transpose();
+  if (parameterDim_ > 0) {
+    Eigen::Map<matrix_t>(laneInput.data() + numLanes * variableDim_, numLanes, parameterDim_) =
+        P.middleCols(firstColumn, numLanes).transpose();
+  }
+  return laneInput.data();
 }
 
 /******************************************************************************************************/
@@ -306,6 +853,172 @@ bool CppAdInterface::isLibraryAvailable() const {
   return boost::filesystem::exists(libraryName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION);
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool CppAdInterface::isLibraryUpToDate(const std::string& contentHash) const {
+  if (!isLibraryAvailable()) {
+    return false;
+  }
+  std::ifstream hashFile(libraryName_ + ".hash");
+  std::string libraryHash;
+  return static_cast<bool>(hashFile >> libraryHash) && libraryHash == contentHash;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::tapeFunction(ad_fun_t& fun) {
+  OCS2_TRACE_ZONE("CppAdInterface::tapeFunction");
+  // set and declare independent variables and start tape recording
+  ad_vector_t xp(variableDim_ + parameterDim_);
+  xp.setOnes();  // Ones are better than zero, to prevent devision by zero in taping
+  CppAD::Independent(xp);
+
+  // Split in variables and parameters
+  ad_vector_t x = xp.segment(0, variableDim_);
+  ad_vector_t p = xp.segment(variableDim_, parameterDim_);
+  // dependent variable vector
+  ad_vector_t y;
+  // the model equation
+  adFunction_(x, p, y);
+  rangeDim_ = y.rows();
+  // create f: xp -> y and stop tape recording
+  fun.Dependent(xp, y);
+  // Optimize the operation sequence
+  fun.optimize();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::map<std::string, std::string> CppAdInterface::generateSources(ApproximationOrder approximationOrder, ad_fun_t& fun) const {
+  OCS2_TRACE_ZONE("CppAdInterface::generateSources");
+  // generates source code
+  CppAD::cg::ModelCSourceGen<scalar_t> sourceGen(fun, modelName_);
+  setApproximationOrder(approximationOrder, sourceGen, fun);
+  CppAD::cg::ModelLibraryCSourceGen<scalar_t> libraryCSourceGen(sourceGen);
+
+  auto sources = LibrarySourceCollector(libraryCSourceGen).collect(sourceGen);
+  if (numLanes_ > 1) {
+    auto laneSource = generateLaneSource(sources);
+    if (!laneSource.empty()) {
+      sources.emplace(modelName_ + "_lanes.c", std::move(laneSource));
+    }
+  }
+  return sources;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::string CppAdInterface::generateLaneSource(const std::map<std::string, std::string>& sources) const {
+  OCS2_TRACE_ZONE("CppAdInterface::generateLaneSource");
+  std::set<std::string> mathFunctions;
+  std::string functions;
+  for (const auto& output : {std::make_pair("forward_zero", "y"), std::make_pair("sparse_jacobian", "jac")}) {
+    const auto sourceIt = sources.find(modelName_ + "_" + output.first + ".c");
+    if (sourceIt == sources.end()) {
+      continue;
+    }
+    std::string laneFunction;
+    if (!translateToLanes(sourceIt->second, modelName_ + "_" + output.first, output.second, mathFunctions, laneFunction)) {
+      return "";
+    }
+    functions += "\nvoid " + modelName_ + "_lanes_" + output.first + "(double const* in, double* out) {\n";
+    functions += "   const ocs2_lane_t* x = (const ocs2_lane_t*)in;\n";
+    functions += std::string("   ocs2_lane_t* ") + output.second + " = (ocs2_lane_t*)out;\n";
+    functions += laneFunction + "}\n";
+  }
+
+  const std::string numLanes = std::to_string(numLanes_);
+  std::string laneSource = "#include <math.h>\n\n";
+  laneSource += "typedef double ocs2_lane_t __attribute__((vector_size(" + std::to_string(numLanes_ * sizeof(scalar_t)) +
+                "), aligned(sizeof(double)), may_alias));\n";
+  laneSource += "static const ocs2_lane_t ocs2_lane_zero = {0};\n\n";
+  // Math functions are evaluated lane by lane, the arguments may be scalar constants
+  for (const auto& f : mathFunctions) {
+    if (f == "pow") {
+      laneSource += "static inline ocs2_lane_t ocs2_lane_pow_(ocs2_lane_t a, ocs2_lane_t b) {\n";
+      laneSource += "   ocs2_lane_t r;\n   for (int l = 0; l < " + numLanes + "; l++) r[l] = pow(a[l], b[l]);\n   return r;\n}\n";
+      laneSource += "#define ocs2_lane_pow(a, b) ocs2_lane_pow_(ocs2_lane_zero + (a), ocs2_lane_zero + (b))\n";
+    } else {
+      laneSource += "static inline ocs2_lane_t ocs2_lane_" + f + "_(ocs2_lane_t a) {\n";
+      laneSource += "   ocs2_lane_t r;\n   for (int l = 0; l < " + numLanes + "; l++) r[l] = " + f + "(a[l]);\n   return r;\n}\n";
+      laneSource += "#define ocs2_lane_" + f + "(a) ocs2_lane_" + f + "_(ocs2_lane_zero + (a))\n";
+    }
+  }
+  laneSource += "\nunsigned long " + modelName_ + "_lanes(void) {\n   return " + numLanes + ";\n}\n";
+  return laneSource + functions;
+}
+
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::string CppAdInterface::getContentHash(ad_fun_t& fun, ApproximationOrder approximationOrder) const {
+  OCS2_TRACE_ZONE("CppAdInterface::getContentHash");
+  CppAD::cg::GccCompiler<scalar_t> gccCompiler;
+  setCompilerOptions(gccCompiler);
+
+  // The operation graph of the taped function, printed as the C code of a zero order forward sweep. Unlike the derivative sources,
+  // this is cheap to generate. The derivatives are fully defined by the graph and the approximation order.
+  CppAD::cg::CodeHandler<scalar_t> codeHandler;
+  CppAD::vector<CppAD::cg::CG<scalar_t>> independentVariables(fun.Domain());
+  codeHandler.makeVariables(independentVariables);
+  CppAD::vector<CppAD::cg::CG<scalar_t>> dependentVariables = fun.Forward(0, independentVariables);
+  CppAD::cg::LanguageC<scalar_t> languageC("double");
+  CppAD::cg::LangCDefaultVariableNameGenerator<scalar_t> nameGenerator;
+  std::ostringstream operationGraph;
+  codeHandler.generateCode(operationGraph, languageC, dependentVariables, nameGenerator);
+
+  uint64_t hash = 14695981039346656037ULL;
+  hashCombine(operationGraph.str(), hash);
+  hashCombine(modelName_, hash);
+  for (const auto dim : {variableDim_, parameterDim_, rangeDim_, numLanes_, static_cast<size_t>(approximationOrder)}) {
+    hashCombine(std::to_string(dim), hash);
+  }
+  for (const auto& flag : gccCompiler.getCompileFlags()) {
+    hashCombine(flag, hash);
+  }
+  for (const auto& flag : gccCompiler.getCompileLibFlags()) {
+    hashCombine(flag, hash);
+  }
+  hashCombine(getCompilerVersion(gccCompiler.getCompilerPath()), hash);
+
+  std::ostringstream hashString;
+  hashString << std::hex << std::setw(16) << std::setfill('0') << hash;
+  return hashString.str();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::compileLibrary(const std::map<std::string, std::string>& sources, const std::string& contentHash,
+                                    bool verbose) const {
+  OCS2_TRACE_ZONE("CppAdInterface::compileLibrary");
+  const std::string libraryExtension = CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION;
+
+  // Compile to temporary shared library file to avoid interference between processes
+  CppAD::cg::GccCompiler<scalar_t> gccCompiler;
+  setCompilerOptions(gccCompiler);
+
+  if (verbose) {
+    std::cerr << "[CppAdInterface] Compiling Shared Library: " << libraryName_ + tmpName_ + libraryExtension << std::endl;
+  }
+  try {
+    gccCompiler.compileSources(sources, true);
+    gccCompiler.buildDynamic(libraryName_ + tmpName_ + libraryExtension);
+  } catch (...) {
+    gccCompiler.cleanup();
+    throw;
+  }
+  gccCompiler.cleanup();
+
+  std::ofstream hashFile(libraryName_ + tmpName_ + ".hash");
+  hashFile << contentHash << std::endl;
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -328,12 +1041,20 @@ std::string CppAdInterface::getUniqueTemporaryName() const {
 /******************************************************************************************************/
 void CppAdInterface::setCompilerOptions(CppAD::cg::GccCompiler<scalar_t>& compiler) const {
   if (!compileFlags_.empty()) {
-    // Set compile flags and add required flags for dynamic compilation
-    auto compileFlags = compileFlags_;
+    // Set compile flags and add required flags for dynamic compilation. The sources are compiled with the same flags, otherwise the vector
+    // width of the lane variant is limited to the baseline instruction set.
+    compiler.setCompileFlags(compileFlags_);
     compiler.setCompileLibFlags(compileFlags_);
     compiler.addCompileLibFlag("-shared");
     compiler.addCompileLibFlag("-rdynamic");
   }
+#if defined(__GLIBC__) && defined(__x86_64__)
+  if (numLanes_ > 1) {
+    // With -ffast-math, the per-lane math functions of the lane variant are vectorized into calls to the vector math library of glibc
+    compiler.addLinkFlag("--no-as-needed");
+    compiler.addLinkFlag("-lmvec");
+  }
+#endif
 
   compiler.setTemporaryFolder(tmpFolder_);
 
@@ -367,11 +1088,41 @@ void CppAdInterface::setApproximationOrder(ApproximationOrder approximationOrder
 /******************************************************************************************************/
 /******************************************************************************************************/
 void CppAdInterface::setSparsityNonzeros() {
+  std::vector<size_t> rows;
+  std::vector<size_t> cols;
   if (model_->isJacobianSparsityAvailable()) {
     nnzJacobian_ = cppad_sparsity::getNumberOfNonZeros(model_->JacobianSparsitySet());
+    model_->JacobianSparsity(rows, cols);
+    createCompressedPattern(rows, cols, rangeDim_, variableDim_, false, jacobianPattern_, jacobianPatternToModel_);
+    isJacobianPatternInModelOrder_ = (jacobianPatternToModel_.size() == nnzJacobian_);
+    for (size_t k = 0; k < jacobianPatternToModel_.size(); k++) {
+      isJacobianPatternInModelOrder_ = isJacobianPatternInModelOrder_ && (jacobianPatternToModel_[k] == k);
+    }
   }
   if (model_->isHessianSparsityAvailable()) {
     nnzHessian_ = cppad_sparsity::getNumberOfNonZeros(model_->HessianSparsitySet());
+    model_->HessianSparsity(rows, cols);
+    createCompressedPattern(rows, cols, variableDim_, variableDim_, true, hessianPattern_, hessianPatternToModel_);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::loadLaneFunctions() {
+  laneFunctions_ = LaneFunctions();
+  using lane_count_t = unsigned long (*)();
+  const auto laneCount = reinterpret_cast<lane_count_t>(dynamicLib_->loadFunction(modelName_ + "_lanes", false));
+  if (laneCount == nullptr) {
+    return;
+  }
+  laneFunctions_.numLanes = laneCount();
+  laneFunctions_.forwardZero = reinterpret_cast<decltype(laneFunctions_.forwardZero)>(
+      dynamicLib_->loadFunction(modelName_ + "_lanes_forward_zero", false));
+  laneFunctions_.sparseJacobian = reinterpret_cast<decltype(laneFunctions_.sparseJacobian)>(
+      dynamicLib_->loadFunction(modelName_ + "_lanes_sparse_jacobian", false));
+  if (laneFunctions_.sparseJacobian != nullptr) {
+    model_->JacobianSparsity(laneFunctions_.jacobianRows, laneFunctions_.jacobianCols);
   }
 }
 
@@ -0,0 +1,156 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <ocs2_core/automatic_differentiation/CppAdModelBatch.h>
+
+#include <algorithm>
+#include <exception>
+#include <thread>
+
+#include <ocs2_core/automatic_differentiation/CppAdInterface.h>
+#include <ocs2_core/misc/Trace.h>
+
+namespace ocs2 {
+
+namespace {
+thread_local CppAdModelBatch* activeBatchPtr = nullptr;
+
+size_t getNumJobs(size_t maxNumJobs) {
+  return maxNumJobs > 0 ? maxNumJobs : std::max(1U, std::thread::hardware_concurrency());
+}
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+CppAdModelBatch::CppAdModelBatch(size_t maxNumJobs) : compilePool_(getNumJobs(maxNumJobs)), previousBatchPtr_(activeBatchPtr) {
+  activeBatchPtr = this;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+CppAdModelBatch::~CppAdModelBatch() {
+  for (auto& entry : entries_) {
+    if (entry.isCompiled) {
+      entry.compileJob.wait();
+    }
+    if (entry.adInterfacePtr != nullptr) {
+      entry.adInterfacePtr->pendingModelBatchPtr_ = nullptr;
+    }
+  }
+  activeBatchPtr = previousBatchPtr_;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+CppAdModelBatch* CppAdModelBatch::getActiveBatch() {
+  return activeBatchPtr;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdModelBatch::addCompilation(CppAdInterface& adInterface, std::map<std::string, std::string> sources, std::string contentHash,
+                                     bool verbose) {
+  auto compileJob = compilePool_.run([&adInterface, sources = std::move(sources), contentHash = std::move(contentHash), verbose](int) {
+    adInterface.compileLibrary(sources, contentHash, verbose);
+  });
+  entries_.push_back({&adInterface, true, verbose, compileJob.share(), adInterface.libraryName_, adInterface.tmpName_});
+  adInterface.pendingModelBatchPtr_ = this;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdModelBatch::addLoad(CppAdInterface& adInterface, bool verbose) {
+  entries_.push_back({&adInterface, false, verbose, {}, {}, {}});
+  adInterface.pendingModelBatchPtr_ = this;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdModelBatch::remove(CppAdInterface& adInterface) {
+  for (auto& entry : entries_) {
+    if (entry.adInterfacePtr == &adInterface) {
+      // the compilation refers to the interface
+      if (entry.isCompiled) {
+        entry.compileJob.wait();
+      }
+      entry.adInterfacePtr = nullptr;
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdModelBatch::finish() {
+  OCS2_TRACE_ZONE("CppAdModelBatch::finish");
+  std::exception_ptr compileError;
+  for (auto& entry : entries_) {
+    if (entry.isCompiled) {
+      try {
+        entry.compileJob.get();
+      } catch (...) {
+        if (!compileError) {
+          compileError = std::current_exception();
+        }
+      }
+    }
+  }
+
+  // Copies are registered after the interface they are copied from, hence they load the library after it is renamed.
+  auto entries = std::move(entries_);
+  entries_.clear();
+  for (auto& entry : entries) {
+    if (entry.adInterfacePtr != nullptr) {
+      entry.adInterfacePtr->pendingModelBatchPtr_ = nullptr;
+    }
+  }
+  if (compileError) {
+    std::rethrow_exception(compileError);
+  }
+
+  for (auto& entry : entries) {
+    if (entry.adInterfacePtr == nullptr) {
+      if (entry.isCompiled) {
+        CppAdInterface::publishCompiledLibrary(entry.libraryName, entry.tmpName, entry.verbose);
+      }
+    } else if (entry.isCompiled) {
+      entry.adInterfacePtr->loadCompiledLibrary(entry.verbose);
+    } else {
+      entry.adInterfacePtr->loadModels(entry.verbose);
+    }
+  }
+}
+
+}  // namespace ocs2
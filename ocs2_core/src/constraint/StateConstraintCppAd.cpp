@@ -54,7 +54,7 @@ void StateConstraintCppAd::initialize(size_t stateDim, size_t parameterDim, cons
   if (recompileLibraries) {
     adInterfacePtr_->createModels(orderCppAd, verbose);
   } else {
-    adInterfacePtr_->loadModelsIfAvailable(orderCppAd, verbose);
+    adInterfacePtr_->loadModelsIfUpToDate(orderCppAd, verbose);
   }
 }
 
@@ -86,8 +86,9 @@ VectorFunctionLinearApproximation StateConstraintCppAd::getLinearApproximation(s
   tapedTimeState << time, state;
 
   constraint.f = adInterfacePtr_->getFunctionValue(tapedTimeState, params);
-  const matrix_t J = adInterfacePtr_->getJacobian(tapedTimeState, params);
-  constraint.dfdx = J.rightCols(stateDim);
+  adInterfacePtr_->getSparseJacobian(tapedTimeState, params, jacobian_);
+  constraint.dfdx.setZero(jacobian_.rows(), stateDim);
+  addSparseJacobian(jacobian_, 1, -1, constraint);
 
   return constraint;
 }
@@ -109,16 +110,22 @@ VectorFunctionQuadraticApproximation StateConstraintCppAd::getQuadraticApproxima
   tapedTimeState << time, state;
 
   constraint.f = adInterfacePtr_->getFunctionValue(tapedTimeState, params);
-  const matrix_t J = adInterfacePtr_->getJacobian(tapedTimeState, params);
-  constraint.dfdx = J.rightCols(stateDim);
+  adInterfacePtr_->getSparseJacobian(tapedTimeState, params, jacobian_);
+  constraint.dfdx.setZero(jacobian_.rows(), stateDim);
+  addSparseJacobian(jacobian_, 1, -1, constraint);
 
   const size_t numConstraints = constraint.f.rows();
   constraint.dfdxx.resize(numConstraints);
   constraint.dfdux.resize(numConstraints);
   constraint.dfduu.resize(numConstraints);
+  hessianWeights_.setZero(numConstraints);
   for (int i = 0; i < numConstraints; i++) {
-    const matrix_t H = adInterfacePtr_->getHessian(i, tapedTimeState, params);
-    constraint.dfdxx[i] = H.bottomRightCorner(stateDim, stateDim);
+    hessianWeights_(i) = 1.0;
+    adInterfacePtr_->getSparseHessian(hessianWeights_, tapedTimeState, params, hessian_);
+    hessianWeights_(i) = 0.0;
+
+    constraint.dfdxx[i].setZero(stateDim, stateDim);
+    addSparseHessian(hessian_, 1, constraint.dfdxx[i]);
   }
 
   return constraint;
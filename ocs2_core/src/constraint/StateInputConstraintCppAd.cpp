@@ -55,7 +55,7 @@ void StateInputConstraintCppAd::initialize(size_t stateDim, size_t inputDim, siz
   if (recompileLibraries) {
     adInterfacePtr_->createModels(orderCppAd, verbose);
   } else {
-    adInterfacePtr_->loadModelsIfAvailable(orderCppAd, verbose);
+    adInterfacePtr_->loadModelsIfUpToDate(orderCppAd, verbose);
   }
 }
 
@@ -90,9 +90,10 @@ VectorFunctionLinearApproximation StateInputConstraintCppAd::getLinearApproximat
   tapedTimeStateInput << time, state, input;
 
   constraint.f = adInterfacePtr_->getFunctionValue(tapedTimeStateInput, params);
-  const matrix_t J = adInterfacePtr_->getJacobian(tapedTimeStateInput, params);
-  constraint.dfdx = J.middleCols(1, stateDim);
-  constraint.dfdu = J.rightCols(inputDim);
+  adInterfacePtr_->getSparseJacobian(tapedTimeStateInput, params, jacobian_);
+  constraint.dfdx.setZero(jacobian_.rows(), stateDim);
+  constraint.dfdu.setZero(jacobian_.rows(), inputDim);
+  addSparseJacobian(jacobian_, 1, 1 + stateDim, constraint);
 
   return constraint;
 }
@@ -116,19 +117,25 @@ VectorFunctionQuadraticApproximation StateInputConstraintCppAd::getQuadraticAppr
   tapedTimeStateInput << time, state, input;
 
   constraint.f = adInterfacePtr_->getFunctionValue(tapedTimeStateInput, params);
-  const matrix_t J = adInterfacePtr_->getJacobian(tapedTimeStateInput, params);
-  constraint.dfdx = J.middleCols(1, stateDim);
-  constraint.dfdu = J.rightCols(inputDim);
+  adInterfacePtr_->getSparseJacobian(tapedTimeStateInput, params, jacobian_);
+  constraint.dfdx.setZero(jacobian_.rows(), stateDim);
+  constraint.dfdu.setZero(jacobian_.rows(), inputDim);
+  addSparseJacobian(jacobian_, 1, 1 + stateDim, constraint);
 
   const size_t numConstraints = constraint.f.rows();
   constraint.dfdxx.resize(numConstraints);
   constraint.dfdux.resize(numConstraints);
   constraint.dfduu.resize(numConstraints);
+  hessianWeights_.setZero(numConstraints);
   for (int i = 0; i < numConstraints; i++) {
-    const matrix_t H = adInterfacePtr_->getHessian(i, tapedTimeStateInput, params);
-    constraint.dfdxx[i] = H.block(1, 1, stateDim, stateDim);
-    constraint.dfdux[i] = H.block(1 + stateDim, 1, inputDim, stateDim);
-    constraint.dfduu[i] = H.bottomRightCorner(inputDim, inputDim);
+    hessianWeights_(i) = 1.0;
+    adInterfacePtr_->getSparseHessian(hessianWeights_, tapedTimeStateInput, params, hessian_);
+    hessianWeights_(i) = 0.0;
+
+    constraint.dfdxx[i].setZero(stateDim, stateDim);
+    constraint.dfdux[i].setZero(inputDim, stateDim);
+    constraint.dfduu[i].setZero(inputDim, inputDim);
+    addSparseHessian(hessian_, 1, 1 + stateDim, constraint.dfdxx[i], constraint.dfdux[i], constraint.dfduu[i]);
   }
 
   return constraint;
@@ -48,8 +48,8 @@ QuadraticStateCost* QuadraticStateCost::clone() const {
 /******************************************************************************************************/
 scalar_t QuadraticStateCost::getValue(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories,
                                       const PreComputation&) const {
-  const vector_t xDeviation = getStateDeviation(time, state, targetTrajectories);
-  return 0.5 * xDeviation.dot(Q_ * xDeviation);
+  getStateDeviation(time, state, targetTrajectories, stateDeviation_);
+  return 0.5 * stateDeviation_.dot(Q_ * stateDeviation_);
 }
 
 /******************************************************************************************************/
@@ -57,21 +57,31 @@ scalar_t QuadraticStateCost::getValue(scalar_t time, const vector_t& state, cons
 /******************************************************************************************************/
 ScalarFunctionQuadraticApproximation QuadraticStateCost::getQuadraticApproximation(scalar_t time, const vector_t& state,
                                                                                    const TargetTrajectories& targetTrajectories,
-                                                                                   const PreComputation&) const {
-  const vector_t xDeviation = getStateDeviation(time, state, targetTrajectories);
-
-  ScalarFunctionQuadraticApproximation Phi;
-  Phi.dfdxx = Q_;
-  Phi.dfdx.noalias() = Q_ * xDeviation;
-  Phi.f = 0.5 * xDeviation.dot(Phi.dfdx);
+                                                                                   const PreComputation& preComp) const {
+  auto Phi = ScalarFunctionQuadraticApproximation::Zero(state.size());
+  addQuadraticApproximation(time, state, targetTrajectories, preComp, Phi);
   return Phi;
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-vector_t QuadraticStateCost::getStateDeviation(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories) const {
-  return state - targetTrajectories.getDesiredState(time);
+void QuadraticStateCost::addQuadraticApproximation(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories,
+                                                   const PreComputation&, ScalarFunctionQuadraticApproximation& Phi) const {
+  getStateDeviation(time, state, targetTrajectories, stateDeviation_);
+  stateGradient_.noalias() = Q_ * stateDeviation_;
+  Phi.f += 0.5 * stateDeviation_.dot(stateGradient_);
+  Phi.dfdx += stateGradient_;
+  Phi.dfdxx += Q_;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void QuadraticStateCost::getStateDeviation(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories,
+                                           vector_t& stateDeviation) const {
+  targetTrajectories.getDesiredState(time, stateDeviation);
+  stateDeviation = state - stateDeviation;
 }
 
 }  // namespace ocs2
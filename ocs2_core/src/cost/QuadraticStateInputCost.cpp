@@ -54,14 +54,13 @@ QuadraticStateInputCost* QuadraticStateInputCost::clone() const {
 /******************************************************************************************************/
 scalar_t QuadraticStateInputCost::getValue(scalar_t time, const vector_t& state, const vector_t& input,
                                            const TargetTrajectories& targetTrajectories, const PreComputation&) const {
-  vector_t stateDeviation, inputDeviation;
-  std::tie(stateDeviation, inputDeviation) = getStateInputDeviation(time, state, input, targetTrajectories);
+  getStateInputDeviation(time, state, input, targetTrajectories, stateDeviation_, inputDeviation_);
 
   if (P_.size() == 0) {
-    return 0.5 * stateDeviation.dot(Q_ * stateDeviation) + 0.5 * inputDeviation.dot(R_ * inputDeviation);
+    return 0.5 * stateDeviation_.dot(Q_ * stateDeviation_) + 0.5 * inputDeviation_.dot(R_ * inputDeviation_);
   } else {
-    return 0.5 * stateDeviation.dot(Q_ * stateDeviation) + 0.5 * inputDeviation.dot(R_ * inputDeviation) +
-           inputDeviation.dot(P_ * stateDeviation);
+    return 0.5 * stateDeviation_.dot(Q_ * stateDeviation_) + 0.5 * inputDeviation_.dot(R_ * inputDeviation_) +
+           inputDeviation_.dot(P_ * stateDeviation_);
   }
 }
 
@@ -71,39 +70,47 @@ scalar_t QuadraticStateInputCost::getValue(scalar_t time, const vector_t& state,
 ScalarFunctionQuadraticApproximation QuadraticStateInputCost::getQuadraticApproximation(scalar_t time, const vector_t& state,
                                                                                         const vector_t& input,
                                                                                         const TargetTrajectories& targetTrajectories,
-                                                                                        const PreComputation&) const {
-  vector_t stateDeviation, inputDeviation;
-  std::tie(stateDeviation, inputDeviation) = getStateInputDeviation(time, state, input, targetTrajectories);
-
-  ScalarFunctionQuadraticApproximation L;
-  L.dfdxx = Q_;
-  L.dfduu = R_;
-  L.dfdx.noalias() = Q_ * stateDeviation;
-  L.dfdu.noalias() = R_ * inputDeviation;
-  L.f = 0.5 * stateDeviation.dot(L.dfdx) + 0.5 * inputDeviation.dot(L.dfdu);
+                                                                                        const PreComputation& preComp) const {
+  auto L = ScalarFunctionQuadraticApproximation::Zero(state.size(), input.size());
+  addQuadraticApproximation(time, state, input, targetTrajectories, preComp, L);
+  return L;
+}
 
-  if (P_.size() == 0) {
-    L.dfdux.setZero(input.size(), state.size());
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void QuadraticStateInputCost::addQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                        const TargetTrajectories& targetTrajectories, const PreComputation&,
+                                                        ScalarFunctionQuadraticApproximation& L) const {
+  getStateInputDeviation(time, state, input, targetTrajectories, stateDeviation_, inputDeviation_);
+
+  stateGradient_.noalias() = Q_ * stateDeviation_;
+  inputGradient_.noalias() = R_ * inputDeviation_;
+  L.f += 0.5 * stateDeviation_.dot(stateGradient_) + 0.5 * inputDeviation_.dot(inputGradient_);
+  L.dfdx += stateGradient_;
+  L.dfdu += inputGradient_;
+  L.dfdxx += Q_;
+  L.dfduu += R_;
 
-  } else {
-    const vector_t pDeviation = P_ * stateDeviation;
-    L.f += inputDeviation.dot(pDeviation);
-    L.dfdu += pDeviation;
-    L.dfdx.noalias() += P_.transpose() * inputDeviation;
-    L.dfdux = P_;
+  if (P_.size() > 0) {
+    inputGradient_.noalias() = P_ * stateDeviation_;
+    L.f += inputDeviation_.dot(inputGradient_);
+    L.dfdu += inputGradient_;
+    L.dfdx.noalias() += P_.transpose() * inputDeviation_;
+    L.dfdux += P_;
   }
-
-  return L;
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-std::pair<vector_t, vector_t> QuadraticStateInputCost::getStateInputDeviation(scalar_t time, const vector_t& state, const vector_t& input,
-                                                                              const TargetTrajectories& targetTrajectories) const {
-  const vector_t stateDeviation = state - targetTrajectories.getDesiredState(time);
-  const vector_t inputDeviation = input - targetTrajectories.getDesiredInput(time);
-  return {stateDeviation, inputDeviation};
+void QuadraticStateInputCost::getStateInputDeviation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                     const TargetTrajectories& targetTrajectories, vector_t& stateDeviation,
+                                                     vector_t& inputDeviation) const {
+  targetTrajectories.getDesiredState(time, stateDeviation);
+  stateDeviation = state - stateDeviation;
+  targetTrajectories.getDesiredInput(time, inputDeviation);
+  inputDeviation = input - inputDeviation;
 }
 
 }  // namespace ocs2
@@ -93,4 +93,17 @@ ScalarFunctionQuadraticApproximation StateCostCollection::getQuadraticApproximat
   return cost;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void StateCostCollection::addQuadraticApproximation(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories,
+                                                    const PreComputation& preComp,
+                                                    ScalarFunctionQuadraticApproximation& approximation) const {
+  for (const auto& costTerm : this->terms_) {
+    if (costTerm->isActive(time)) {
+      costTerm->addQuadraticApproximation(time, state, targetTrajectories, preComp, approximation);
+    }
+  }
+}
+
 }  // namespace ocs2
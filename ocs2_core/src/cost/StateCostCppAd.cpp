@@ -48,7 +48,7 @@ void StateCostCppAd::initialize(size_t stateDim, size_t parameterDim, const std:
   if (recompileLibraries) {
     adInterfacePtr_->createModels(ocs2::CppAdInterface::ApproximationOrder::Second, verbose);
   } else {
-    adInterfacePtr_->loadModelsIfAvailable(ocs2::CppAdInterface::ApproximationOrder::Second, verbose);
+    adInterfacePtr_->loadModelsIfUpToDate(ocs2::CppAdInterface::ApproximationOrder::Second, verbose);
   }
 }
 
@@ -86,4 +86,17 @@ ScalarFunctionQuadraticApproximation StateInputCostCollection::getQuadraticAppro
   return cost;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void StateInputCostCollection::addQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                         const TargetTrajectories& targetTrajectories, const PreComputation& preComp,
+                                                         ScalarFunctionQuadraticApproximation& approximation) const {
+  for (const auto& costTerm : this->terms_) {
+    if (costTerm->isActive(time)) {
+      costTerm->addQuadraticApproximation(time, state, input, targetTrajectories, preComp, approximation);
+    }
+  }
+}
+
 }  // namespace ocs2
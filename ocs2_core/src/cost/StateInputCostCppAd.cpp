@@ -49,7 +49,7 @@ void StateInputCostCppAd::initialize(size_t stateDim, size_t inputDim, size_t pa
   if (recompileLibraries) {
     adInterfacePtr_->createModels(ocs2::CppAdInterface::ApproximationOrder::Second, verbose);
   } else {
-    adInterfacePtr_->loadModelsIfAvailable(ocs2::CppAdInterface::ApproximationOrder::Second, verbose);
+    adInterfacePtr_->loadModelsIfUpToDate(ocs2::CppAdInterface::ApproximationOrder::Second, verbose);
   }
 }
 
@@ -48,7 +48,7 @@ void StateInputCostGaussNewtonAd::initialize(size_t stateDim, size_t inputDim, s
   if (recompileLibraries) {
     adInterfacePtr_->createModels(ocs2::CppAdInterface::ApproximationOrder::First, verbose);
   } else {
-    adInterfacePtr_->loadModelsIfAvailable(ocs2::CppAdInterface::ApproximationOrder::First, verbose);
+    adInterfacePtr_->loadModelsIfUpToDate(ocs2::CppAdInterface::ApproximationOrder::First, verbose);
   }
 }
 
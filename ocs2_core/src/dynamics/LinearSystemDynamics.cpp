@@ -77,6 +77,21 @@ VectorFunctionLinearApproximation LinearSystemDynamics::linearApproximation(scal
   return approximation;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void LinearSystemDynamics::linearApproximationBatch(size_t numPoints, const scalar_array_t& t, const vector_array_t& x,
+                                                    const vector_array_t& u,
+                                                    std::vector<VectorFunctionLinearApproximation>& approximations) {
+  for (size_t k = 0; k < numPoints; k++) {
+    preCompPtr_->request(Request::Dynamics + Request::Approximation, t[k], x[k], u[k]);
+    approximations[k].f.noalias() = A_ * x[k];
+    approximations[k].f.noalias() += B_ * u[k];
+    approximations[k].dfdx = A_;
+    approximations[k].dfdu = B_;
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -50,6 +50,16 @@ VectorFunctionLinearApproximation SystemDynamicsBase::linearApproximation(scalar
   return linearApproximation(t, x, u, *preCompPtr_);
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void SystemDynamicsBase::linearApproximationBatch(size_t numPoints, const scalar_array_t& t, const vector_array_t& x,
+                                                  const vector_array_t& u, std::vector<VectorFunctionLinearApproximation>& approximations) {
+  for (size_t k = 0; k < numPoints; k++) {
+    approximations[k] = linearApproximation(t[k], x[k], u[k]);
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -54,7 +54,7 @@ SystemDynamicsBaseAD::SystemDynamicsBaseAD(const SystemDynamicsBaseAD& rhs)
 /******************************************************************************************************/
 /******************************************************************************************************/
 void SystemDynamicsBaseAD::initialize(size_t stateDim, size_t inputDim, const std::string& modelName, const std::string& modelFolder,
-                                      bool recompileLibraries, bool verbose) {
+                                      bool recompileLibraries, bool verbose, size_t numLanes) {
   tapedTimeStateInput_.resize(1 + stateDim + inputDim);
   tapedTimeState_.resize(1 + stateDim);
 
@@ -66,6 +66,7 @@ void SystemDynamicsBaseAD::initialize(size_t stateDim, size_t inputDim, const st
   };
   flowMapADInterfacePtr_.reset(
       new CppAdInterface(flowMap, 1 + stateDim + inputDim, getNumFlowMapParameters(), modelName + "_flow_map", modelFolder));
+  flowMapADInterfacePtr_->setNumLanes(numLanes);
 
   auto jumpMap = [this, stateDim](const ad_vector_t& x, const ad_vector_t& p, ad_vector_t& y) {
     const ad_scalar_t time = x(0);
@@ -82,15 +83,10 @@ void SystemDynamicsBaseAD::initialize(size_t stateDim, size_t inputDim, const st
   guardSurfacesADInterfacePtr_.reset(
       new CppAdInterface(guardSurfaces, 1 + stateDim, getNumGuardSurfacesParameters(), modelName + "_guard_surfaces", modelFolder));
 
-  if (recompileLibraries) {
-    flowMapADInterfacePtr_->createModels(CppAdInterface::ApproximationOrder::First, verbose);
-    jumpMapADInterfacePtr_->createModels(CppAdInterface::ApproximationOrder::First, verbose);
-    guardSurfacesADInterfacePtr_->createModels(CppAdInterface::ApproximationOrder::First, verbose);
-  } else {
-    flowMapADInterfacePtr_->loadModelsIfAvailable(CppAdInterface::ApproximationOrder::First, verbose);
-    jumpMapADInterfacePtr_->loadModelsIfAvailable(CppAdInterface::ApproximationOrder::First, verbose);
-    guardSurfacesADInterfacePtr_->loadModelsIfAvailable(CppAdInterface::ApproximationOrder::First, verbose);
-  }
+  CppAdInterface::createModelsInParallel({{flowMapADInterfacePtr_.get(), CppAdInterface::ApproximationOrder::First},
+                                          {jumpMapADInterfacePtr_.get(), CppAdInterface::ApproximationOrder::First},
+                                          {guardSurfacesADInterfacePtr_.get(), CppAdInterface::ApproximationOrder::First}},
+                                         0, !recompileLibraries, verbose);
 }
 
 /******************************************************************************************************/
@@ -127,7 +123,8 @@ VectorFunctionLinearApproximation SystemDynamicsBaseAD::linearApproximation(scal
                                                                             const PreComputation& preComputation) {
   tapedTimeStateInput_ << t, x, u;
   const vector_t parameters = getFlowMapParameters(t, preComputation);
-  flowJacobian_ = flowMapADInterfacePtr_->getJacobian(tapedTimeStateInput_, parameters);
+  flowJacobian_.resize(flowMapADInterfacePtr_->getRangeDim(), tapedTimeStateInput_.size());
+  flowMapADInterfacePtr_->getJacobian(tapedTimeStateInput_, parameters, flowJacobian_);
 
   VectorFunctionLinearApproximation approximation;
   approximation.dfdx = flowJacobian_.middleCols(1, x.rows());
@@ -136,6 +133,39 @@ VectorFunctionLinearApproximation SystemDynamicsBaseAD::linearApproximation(scal
   return approximation;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void SystemDynamicsBaseAD::linearApproximationBatch(size_t numPoints, const scalar_array_t& t, const vector_array_t& x,
+                                                    const vector_array_t& u,
+                                                    std::vector<VectorFunctionLinearApproximation>& approximations) {
+  // Without lanes, the batch functions evaluate the points one by one, still writing into the batch storage
+  const auto numPointsIndex = static_cast<Eigen::Index>(numPoints);
+  const auto stateDim = x.front().size();
+  const auto inputDim = u.front().size();
+  batchTimeStateInputs_.resize(1 + stateDim + inputDim, numPointsIndex);
+  batchParameters_.resize(getNumFlowMapParameters(), numPointsIndex);
+  for (size_t k = 0; k < numPoints; k++) {
+    preCompPtr_->request(Request::Dynamics + Request::Approximation, t[k], x[k], u[k]);
+    batchTimeStateInputs_.col(k) << t[k], x[k], u[k];
+    if (batchParameters_.rows() > 0) {
+      batchParameters_.col(k) = getFlowMapParameters(t[k], *preCompPtr_);
+    }
+  }
+
+  batchFlowMaps_.resize(stateDim, numPointsIndex);
+  batchJacobians_.resize(numPointsIndex * stateDim, batchTimeStateInputs_.rows());
+  flowMapADInterfacePtr_->getFunctionValueBatch(batchTimeStateInputs_, batchParameters_, batchFlowMaps_);
+  flowMapADInterfacePtr_->getJacobianBatch(batchTimeStateInputs_, batchParameters_, batchJacobians_);
+
+  for (size_t k = 0; k < numPoints; k++) {
+    const auto jacobian = batchJacobians_.middleRows(k * stateDim, stateDim);
+    approximations[k].f = batchFlowMaps_.col(k);
+    approximations[k].dfdx = jacobian.middleCols(1, stateDim);
+    approximations[k].dfdu = jacobian.rightCols(inputDim);
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -143,7 +173,8 @@ VectorFunctionLinearApproximation SystemDynamicsBaseAD::jumpMapLinearApproximati
                                                                                    const PreComputation& preComputation) {
   tapedTimeState_ << t, x;
   const vector_t parameters = getJumpMapParameters(t, preComputation);
-  jumpJacobian_ = jumpMapADInterfacePtr_->getJacobian(tapedTimeState_, parameters);
+  jumpJacobian_.resize(jumpMapADInterfacePtr_->getRangeDim(), tapedTimeState_.size());
+  jumpMapADInterfacePtr_->getJacobian(tapedTimeState_, parameters, jumpJacobian_);
 
   VectorFunctionLinearApproximation approximation;
   approximation.dfdx = jumpJacobian_.rightCols(x.rows());
@@ -158,7 +189,8 @@ VectorFunctionLinearApproximation SystemDynamicsBaseAD::jumpMapLinearApproximati
 VectorFunctionLinearApproximation SystemDynamicsBaseAD::guardSurfacesLinearApproximation(scalar_t t, const vector_t& x, const vector_t& u) {
   tapedTimeState_ << t, x;
   const vector_t parameters = getGuardSurfacesParameters(t);
-  guardJacobian_ = guardSurfacesADInterfacePtr_->getJacobian(tapedTimeState_, parameters);
+  guardJacobian_.resize(guardSurfacesADInterfacePtr_->getRangeDim(), tapedTimeState_.size());
+  guardSurfacesADInterfacePtr_->getJacobian(tapedTimeState_, parameters, guardJacobian_);
 
   VectorFunctionLinearApproximation approximation;
   approximation.dfdx = guardJacobian_.rightCols(x.rows());
@@ -67,6 +67,45 @@ DynamicsSensitivityDiscretizer selectDynamicsSensitivityDiscretization(Sensitivi
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void SensitivityDiscretizationBlock::resize(size_t numIntervals) {
+  size = numIntervals;
+  const auto grow = [numIntervals](auto& array) {
+    if (array.size() < numIntervals) {
+      array.resize(numIntervals);
+    }
+  };
+  grow(t);
+  grow(dt);
+  grow(x);
+  grow(u);
+  grow(dynamics);
+  grow(stageTime);
+  grow(stageState);
+  stageApproximations.resize(3);
+  for (auto& approximations : stageApproximations) {
+    grow(approximations);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+DynamicsSensitivityBlockDiscretizer selectDynamicsSensitivityBlockDiscretization(SensitivityIntegratorType integratorType) {
+  switch (integratorType) {
+    case SensitivityIntegratorType::EULER:
+      return eulerSensitivityDiscretizationBlock;
+    case SensitivityIntegratorType::RK2:
+      return rk2SensitivityDiscretizationBlock;
+    case SensitivityIntegratorType::RK4:
+      return rk4SensitivityDiscretizationBlock;
+    default:
+      throw std::runtime_error("Integrator of type " + sensitivity_integrator::toString(integratorType) + " not supported.");
+  }
+}
+
 namespace sensitivity_integrator {
 
 /******************************************************************************************************/
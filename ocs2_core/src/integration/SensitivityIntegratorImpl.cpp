@@ -168,4 +168,105 @@ VectorFunctionLinearApproximation rk4SensitivityDiscretization(SystemDynamicsBas
   return k1;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void eulerSensitivityDiscretizationBlock(SystemDynamicsBase& system, SensitivityDiscretizationBlock& block) {
+  // System evaluations
+  auto& k1 = block.dynamics;
+  system.linearApproximationBatch(block.size, block.t, block.x, block.u, k1);
+
+  // Assemble discrete approximations, see eulerSensitivityDiscretization
+  for (size_t i = 0; i < block.size; i++) {
+    const scalar_t dt = block.dt[i];
+    k1[i].dfdx *= dt;
+    k1[i].dfdx.diagonal().array() += 1.0;  // plus Identity()
+    k1[i].dfdu *= dt;
+    k1[i].f = block.x[i] + dt * k1[i].f;
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void rk2SensitivityDiscretizationBlock(SystemDynamicsBase& system, SensitivityDiscretizationBlock& block) {
+  auto& k1 = block.dynamics;
+  auto& k2 = block.stageApproximations[0];
+  auto& sensitivity = block.stageSensitivity;
+
+  // System evaluations, each stage of all intervals at once
+  system.linearApproximationBatch(block.size, block.t, block.x, block.u, k1);
+  for (size_t i = 0; i < block.size; i++) {
+    block.stageTime[i] = block.t[i] + block.dt[i];
+    block.stageState[i] = block.x[i] + block.dt[i] * k1[i].f;
+  }
+  system.linearApproximationBatch(block.size, block.stageTime, block.stageState, block.u, k2);
+
+  // Sensitivities and assembly, see rk2SensitivityDiscretization
+  for (size_t i = 0; i < block.size; i++) {
+    const scalar_t dt = block.dt[i];
+    const scalar_t dt_halve = dt / 2.0;
+    k2[i].dfdu.noalias() += dt * k2[i].dfdx * k1[i].dfdu;
+    sensitivity.noalias() = dt * k2[i].dfdx * k1[i].dfdx;
+    k2[i].dfdx += sensitivity;
+
+    k1[i].dfdx = dt_halve * k1[i].dfdx + dt_halve * k2[i].dfdx;
+    k1[i].dfdx.diagonal().array() += 1.0;  // plus Identity()
+    k1[i].dfdu = dt_halve * k1[i].dfdu + dt_halve * k2[i].dfdu;
+    k1[i].f = block.x[i] + dt_halve * k1[i].f + dt_halve * k2[i].f;
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void rk4SensitivityDiscretizationBlock(SystemDynamicsBase& system, SensitivityDiscretizationBlock& block) {
+  auto& k1 = block.dynamics;
+  auto& k2 = block.stageApproximations[0];
+  auto& k3 = block.stageApproximations[1];
+  auto& k4 = block.stageApproximations[2];
+  auto& sensitivity = block.stageSensitivity;
+
+  // System evaluations, each stage of all intervals at once
+  system.linearApproximationBatch(block.size, block.t, block.x, block.u, k1);
+  for (size_t i = 0; i < block.size; i++) {
+    block.stageTime[i] = block.t[i] + block.dt[i] / 2.0;
+    block.stageState[i] = block.x[i] + (block.dt[i] / 2.0) * k1[i].f;
+  }
+  system.linearApproximationBatch(block.size, block.stageTime, block.stageState, block.u, k2);
+  for (size_t i = 0; i < block.size; i++) {
+    block.stageState[i] = block.x[i] + (block.dt[i] / 2.0) * k2[i].f;
+  }
+  system.linearApproximationBatch(block.size, block.stageTime, block.stageState, block.u, k3);
+  for (size_t i = 0; i < block.size; i++) {
+    block.stageTime[i] = block.t[i] + block.dt[i];
+    block.stageState[i] = block.x[i] + block.dt[i] * k3[i].f;
+  }
+  system.linearApproximationBatch(block.size, block.stageTime, block.stageState, block.u, k4);
+
+  // Sensitivities and assembly, see rk4SensitivityDiscretization
+  for (size_t i = 0; i < block.size; i++) {
+    const scalar_t dt = block.dt[i];
+    const scalar_t dt_halve = dt / 2.0;
+    const scalar_t dt_sixth = dt / 6.0;
+    const scalar_t dt_third = dt / 3.0;
+
+    k2[i].dfdu.noalias() += dt_halve * k2[i].dfdx * k1[i].dfdu;
+    k3[i].dfdu.noalias() += dt_halve * k3[i].dfdx * k2[i].dfdu;
+    k4[i].dfdu.noalias() += dt * k4[i].dfdx * k3[i].dfdu;
+
+    sensitivity.noalias() = dt_halve * k2[i].dfdx * k1[i].dfdx;
+    k2[i].dfdx += sensitivity;
+    sensitivity.noalias() = dt_halve * k3[i].dfdx * k2[i].dfdx;
+    k3[i].dfdx += sensitivity;
+    sensitivity.noalias() = dt * k4[i].dfdx * k3[i].dfdx;
+    k4[i].dfdx += sensitivity;
+
+    k1[i].dfdx = dt_sixth * k1[i].dfdx + dt_third * k2[i].dfdx + dt_third * k3[i].dfdx + dt_sixth * k4[i].dfdx;
+    k1[i].dfdx.diagonal().array() += 1.0;  // plus Identity()
+    k1[i].dfdu = dt_sixth * k1[i].dfdu + dt_third * k2[i].dfdu + dt_third * k3[i].dfdu + dt_sixth * k4[i].dfdu;
+    k1[i].f = block.x[i] + dt_sixth * k1[i].f + dt_third * k2[i].f + dt_third * k3[i].f + dt_sixth * k4[i].f;
+  }
+}
+
 }  // namespace ocs2
\ No newline at end of file
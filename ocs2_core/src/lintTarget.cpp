@@ -4,6 +4,7 @@
 
 // Automatic Differentation
 #include <ocs2_core/automatic_differentiation/CppAdInterface.h>
+#include <ocs2_core/automatic_differentiation/CppAdModelBatch.h>
 #include <ocs2_core/automatic_differentiation/CppAdSparsity.h>
 #include <ocs2_core/automatic_differentiation/FiniteDifferenceMethods.h>
 
@@ -61,6 +62,7 @@
 #include <ocs2_core/loopshaping/Loopshaping.h>
 
 // Misc
+#include <ocs2_core/misc/AllocationTracking.h>
 #include <ocs2_core/misc/Benchmark.h>
 #include <ocs2_core/misc/CommandLine.h>
 // #include <ocs2_core/misc/LTI_Equations.h>
@@ -68,10 +70,14 @@
 #include <ocs2_core/misc/LinearInterpolation.h>
 #include <ocs2_core/misc/LoadData.h>
 #include <ocs2_core/misc/Lookup.h>
+#include <ocs2_core/misc/MonotonicArena.h>
+#include <ocs2_core/misc/SparseApproximation.h>
+#include <ocs2_core/misc/Trace.h>
 #include <ocs2_core/misc/randomMatrices.h>
 
 // thread_support
 #include <ocs2_core/thread_support/BufferedValue.h>
+#include <ocs2_core/thread_support/SetThreadAffinity.h>
 #include <ocs2_core/thread_support/SetThreadPriority.h>
 #include <ocs2_core/thread_support/Synchronized.h>
 #include <ocs2_core/thread_support/ThreadPool.h>
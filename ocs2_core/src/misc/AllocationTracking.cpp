@@ -0,0 +1,317 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_core/misc/AllocationTracking.h"
+
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <tuple>
+
+#if defined(__GLIBC__)
+#include <execinfo.h>
+#include <unistd.h>
+#endif
+
+#ifdef EIGEN_RUNTIME_NO_MALLOC
+#include <Eigen/Core>
+#endif
+
+namespace ocs2 {
+namespace allocation {
+
+namespace {
+std::atomic<size_t> processAllocationCount{0};
+std::atomic<size_t> processAllocatedBytes{0};
+std::atomic<size_t> numViolations{0};
+std::atomic<Policy> violationPolicy{Policy::Ignore};
+
+/** Per-thread counters. Trivial and constant-initialized, such that the allocator hook can use them before any constructor ran. */
+struct ThreadState {
+  size_t count;
+  size_t bytes;
+  int noAllocationDepth;
+  /** Set while a violation is reported, such that allocations of the report itself are not reported again */
+  bool isReporting;
+};
+#if defined(__GNUC__)
+// The initial-exec model avoids that the first access of a thread calls into the allocator.
+thread_local ThreadState threadState __attribute__((tls_model("initial-exec"))) = {0, 0, 0, false};
+#else
+thread_local ThreadState threadState = {0, 0, 0, false};
+#endif
+
+/** Reports an allocation inside a NoAllocationScope from within the allocator, hence without allocating. */
+void reportScopeViolation(size_t size) {
+  numViolations.fetch_add(1, std::memory_order_relaxed);
+  const auto policy = violationPolicy.load(std::memory_order_relaxed);
+  if (policy == Policy::Ignore) {
+    return;
+  }
+
+  char message[128];
+  const int length =
+      std::snprintf(message, sizeof(message), "[AllocationTracking] Allocation of %zu bytes inside a NoAllocationScope\n", size);
+#if defined(__GLIBC__)
+  std::ignore = ::write(STDERR_FILENO, message, static_cast<size_t>(length));
+  void* frames[32];
+  const int numFrames = ::backtrace(frames, 32);
+  ::backtrace_symbols_fd(frames, numFrames, STDERR_FILENO);
+#else
+  std::fwrite(message, 1, static_cast<size_t>(length), stderr);
+#endif
+
+  if (policy == Policy::Abort) {
+    std::abort();
+  }
+}
+
+inline void recordAllocation(size_t size) {
+  processAllocationCount.fetch_add(1, std::memory_order_relaxed);
+  processAllocatedBytes.fetch_add(size, std::memory_order_relaxed);
+  auto& state = threadState;
+  ++state.count;
+  state.bytes += size;
+  if (state.noAllocationDepth > 0 && !state.isReporting) {
+    state.isReporting = true;
+    reportScopeViolation(size);
+    state.isReporting = false;
+  }
+}
+
+/** Reports an allocating steady-state phase. */
+void reportPhaseViolation(const std::string& phaseName, const AllocationCount& allocations) {
+  numViolations.fetch_add(1, std::memory_order_relaxed);
+  const auto policy = violationPolicy.load(std::memory_order_relaxed);
+  if (policy == Policy::Ignore) {
+    return;
+  }
+
+  auto& state = threadState;
+  const bool wasReporting = state.isReporting;
+  state.isReporting = true;
+  std::cerr << "[AllocationTracking] Steady-state phase '" << phaseName << "' made " << allocations.count << " allocations ("
+            << allocations.bytes << " bytes)" << std::endl;
+  state.isReporting = wasReporting;
+
+  if (policy == Policy::Abort) {
+    std::abort();
+  }
+}
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool isTrackingEnabled() {
+#ifdef OCS2_ALLOCATION_TRACKING
+  static const bool isHookActive = [] {
+    const auto countBefore = threadState.count;
+    void* volatile ptr = std::malloc(1);
+    std::free(ptr);
+    return threadState.count != countBefore;
+  }();
+  return isHookActive;
+#else
+  return false;
+#endif
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void setPolicy(Policy policy) {
+  violationPolicy.store(policy, std::memory_order_relaxed);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+Policy getPolicy() {
+  return violationPolicy.load(std::memory_order_relaxed);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+AllocationCount getProcessAllocationCount() {
+  return {processAllocationCount.load(std::memory_order_relaxed), processAllocatedBytes.load(std::memory_order_relaxed)};
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+AllocationCount getThreadAllocationCount() {
+  return {threadState.count, threadState.bytes};
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+size_t getNumViolations() {
+  return numViolations.load(std::memory_order_relaxed);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+NoAllocationScope::NoAllocationScope() {
+  ++threadState.noAllocationDepth;
+#ifdef EIGEN_RUNTIME_NO_MALLOC
+  wasEigenMallocAllowed_ = Eigen::internal::is_malloc_allowed();
+  Eigen::internal::set_is_malloc_allowed(false);
+#endif
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+NoAllocationScope::~NoAllocationScope() {
+#ifdef EIGEN_RUNTIME_NO_MALLOC
+  Eigen::internal::set_is_malloc_allowed(wasEigenMallocAllowed_);
+#endif
+  --threadState.noAllocationDepth;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PhaseAllocationCounter::end(bool steadyState) {
+  last_ = getCount() - startCount_;
+  total_ += last_;
+  ++numIntervals_;
+  if (last_.count > 0) {
+    ++numAllocatingIntervals_;
+    if (steadyState) {
+      reportPhaseViolation(name_, last_);
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::ostream& operator<<(std::ostream& stream, const PhaseAllocationCounter& counter) {
+  stream << counter.getName() << " :\t" << counter.getAverageCount() << " [allocations] \t" << counter.getAverageBytes() << " [bytes] \t("
+         << counter.getNumAllocatingIntervals() << " of " << counter.getNumIntervals() << " intervals allocated)";
+  return stream;
+}
+
+}  // namespace allocation
+}  // namespace ocs2
+
+#ifdef OCS2_ALLOCATION_TRACKING
+#if defined(__GLIBC__)
+/*
+ * Interposes the allocating functions of the C allocator and forwards them to glibc. The global operator new of libstdc++ and Eigen's
+ * aligned_malloc both allocate through malloc, hence they are counted as well. Deallocation is left untouched.
+ */
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t num, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+void* __libc_memalign(size_t alignment, size_t size);
+
+void* malloc(size_t size) noexcept {
+  ocs2::allocation::recordAllocation(size);
+  return __libc_malloc(size);
+}
+
+void* calloc(size_t num, size_t size) noexcept {
+  ocs2::allocation::recordAllocation(num * size);
+  return __libc_calloc(num, size);
+}
+
+void* realloc(void* ptr, size_t size) noexcept {
+  ocs2::allocation::recordAllocation(size);
+  return __libc_realloc(ptr, size);
+}
+
+void* memalign(size_t alignment, size_t size) noexcept {
+  ocs2::allocation::recordAllocation(size);
+  return __libc_memalign(alignment, size);
+}
+
+void* aligned_alloc(size_t alignment, size_t size) noexcept {
+  ocs2::allocation::recordAllocation(size);
+  return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void** memptr, size_t alignment, size_t size) noexcept {
+  if (alignment % sizeof(void*) != 0 || (alignment & (alignment - 1)) != 0) {
+    return EINVAL;
+  }
+  ocs2::allocation::recordAllocation(size);
+  void* ptr = __libc_memalign(alignment, size);
+  if (ptr == nullptr) {
+    return ENOMEM;
+  }
+  *memptr = ptr;
+  return 0;
+}
+}  // extern "C"
+
+#else
+/*
+ * Replaces the global operator new. Eigen allocates through std::malloc and is not counted on this platform.
+ */
+namespace {
+void* countedAllocate(std::size_t size) {
+  ocs2::allocation::recordAllocation(size);
+  void* ptr = std::malloc(size == 0 ? 1 : size);
+  if (ptr == nullptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+}  // unnamed namespace
+
+void* operator new(std::size_t size) {
+  return countedAllocate(size);
+}
+void* operator new[](std::size_t size) {
+  return countedAllocate(size);
+}
+void operator delete(void* ptr) noexcept {
+  std::free(ptr);
+}
+void operator delete[](void* ptr) noexcept {
+  std::free(ptr);
+}
+void operator delete(void* ptr, std::size_t) noexcept {
+  std::free(ptr);
+}
+void operator delete[](void* ptr, std::size_t) noexcept {
+  std::free(ptr);
+}
+#endif
+#endif
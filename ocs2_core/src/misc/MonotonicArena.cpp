@@ -0,0 +1,88 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_core/misc/MonotonicArena.h"
+
+namespace ocs2 {
+
+namespace {
+// Allocations are padded to 16 bytes such that every slice is aligned like the block
+constexpr size_t alignmentInScalars = 16 / sizeof(scalar_t);
+
+size_t padToAlignment(size_t size) {
+  return (size + alignmentInScalars - 1) / alignmentInScalars * alignmentInScalars;
+}
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+MonotonicArena::MonotonicArena(size_t initialCapacity) : capacity_(padToAlignment(initialCapacity)) {
+  block_ = makeBuffer(capacity_);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MonotonicArena::reset() {
+  if (!overflowChunks_.empty()) {
+    overflowChunks_.clear();
+    capacity_ = size_;
+    block_ = makeBuffer(capacity_);
+  }
+  size_ = 0;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+scalar_t* MonotonicArena::allocate(Eigen::Index size) {
+  const size_t paddedSize = padToAlignment(static_cast<size_t>(size));
+  const size_t offset = size_;
+  size_ += paddedSize;
+
+  if (overflowChunks_.empty() && size_ <= capacity_) {
+    return block_.get() + offset;
+  } else {
+    overflowChunks_.push_back(makeBuffer(paddedSize));
+    return overflowChunks_.back().get();
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+MonotonicArena::buffer_t MonotonicArena::makeBuffer(size_t size) {
+  if (size == 0) {
+    return buffer_t();
+  }
+  return buffer_t(static_cast<scalar_t*>(Eigen::internal::aligned_malloc(size * sizeof(scalar_t))));
+}
+
+}  // namespace ocs2
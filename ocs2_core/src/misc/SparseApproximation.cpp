@@ -0,0 +1,185 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <ocs2_core/misc/SparseApproximation.h>
+
+namespace ocs2 {
+
+namespace {
+/** Maps a column of the sparse matrix to the index within a block of variables, returns -1 if the column is outside of the block. */
+inline int blockIndex(int col, int offset, int dim) {
+  const int index = col - offset;
+  return (index >= 0 && index < dim) ? index : -1;
+}
+
+/** Implementation of addSparseJacobian on the Jacobian blocks. */
+void addSparseJacobianImpl(const sparse_matrix_t& jacobian, int stateOffset, int inputOffset, matrix_t& dfdx, matrix_t& dfdu) {
+  const int nx = dfdx.cols();
+  const int nu = (inputOffset < 0) ? 0 : dfdu.cols();
+  assert(dfdx.rows() == jacobian.rows());
+
+  for (int row = 0; row < jacobian.outerSize(); ++row) {
+    for (sparse_matrix_t::InnerIterator it(jacobian, row); it; ++it) {
+      const int stateIndex = blockIndex(it.col(), stateOffset, nx);
+      if (stateIndex >= 0) {
+        dfdx(row, stateIndex) += it.value();
+        continue;
+      }
+      const int inputIndex = blockIndex(it.col(), inputOffset, nu);
+      if (inputIndex >= 0) {
+        dfdu(row, inputIndex) += it.value();
+      }
+    }
+  }
+}
+
+/** Implementation of addSparseHessian on the Hessian blocks. */
+void addSparseHessianImpl(const sparse_matrix_t& hessian, int stateOffset, int inputOffset, matrix_t& dfdxx, matrix_t& dfdux,
+                          matrix_t& dfduu) {
+  const int nx = dfdxx.rows();
+  const int nu = (inputOffset < 0) ? 0 : dfduu.rows();
+
+  for (int row = 0; row < hessian.outerSize(); ++row) {
+    const int stateRow = blockIndex(row, stateOffset, nx);
+    const int inputRow = blockIndex(row, inputOffset, nu);
+    if (stateRow < 0 && inputRow < 0) {
+      continue;
+    }
+    for (sparse_matrix_t::InnerIterator it(hessian, row); it; ++it) {
+      const int stateCol = blockIndex(it.col(), stateOffset, nx);
+      if (stateRow >= 0 && stateCol >= 0) {
+        dfdxx(stateRow, stateCol) += it.value();
+      } else if (inputRow >= 0 && stateCol >= 0) {
+        dfdux(inputRow, stateCol) += it.value();
+      } else if (inputRow >= 0) {
+        const int inputCol = blockIndex(it.col(), inputOffset, nu);
+        if (inputCol >= 0) {
+          dfduu(inputRow, inputCol) += it.value();
+        }
+      }
+    }
+  }
+}
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void addSparseJacobian(const sparse_matrix_t& jacobian, int stateOffset, int inputOffset,
+                       VectorFunctionLinearApproximation& approximation) {
+  addSparseJacobianImpl(jacobian, stateOffset, inputOffset, approximation.dfdx, approximation.dfdu);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void addSparseJacobian(const sparse_matrix_t& jacobian, int stateOffset, int inputOffset,
+                       VectorFunctionQuadraticApproximation& approximation) {
+  addSparseJacobianImpl(jacobian, stateOffset, inputOffset, approximation.dfdx, approximation.dfdu);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void addSparseGaussNewtonApproximation(const vector_t& f, const sparse_matrix_t& jacobian, int stateOffset, int inputOffset,
+                                       ScalarFunctionQuadraticApproximation& approximation) {
+  const int nx = approximation.dfdx.size();
+  const int nu = (inputOffset < 0) ? 0 : approximation.dfdu.size();
+  assert(f.size() == jacobian.rows());
+
+  // Adds value to the entry (colA, colB) of J' * J. Only the lower block triangle (xx, ux, uu) is stored in the approximation.
+  auto addToHessian = [&](int colA, int colB, scalar_t value) {
+    const int stateA = blockIndex(colA, stateOffset, nx);
+    const int stateB = blockIndex(colB, stateOffset, nx);
+    const int inputA = blockIndex(colA, inputOffset, nu);
+    const int inputB = blockIndex(colB, inputOffset, nu);
+    if (stateA >= 0 && stateB >= 0) {
+      approximation.dfdxx(stateA, stateB) += value;
+    } else if (inputA >= 0 && stateB >= 0) {
+      approximation.dfdux(inputA, stateB) += value;
+    } else if (inputA >= 0 && inputB >= 0) {
+      approximation.dfduu(inputA, inputB) += value;
+    }
+  };
+
+  approximation.f += 0.5 * f.squaredNorm();
+
+  const auto* outerIndex = jacobian.outerIndexPtr();
+  const auto* innerIndex = jacobian.innerIndexPtr();
+  const auto* values = jacobian.valuePtr();
+  for (int row = 0; row < jacobian.outerSize(); ++row) {
+    for (auto a = outerIndex[row]; a < outerIndex[row + 1]; ++a) {
+      const int colA = innerIndex[a];
+      const scalar_t valueA = values[a];
+
+      // Gradient
+      const int stateIndex = blockIndex(colA, stateOffset, nx);
+      const int inputIndex = blockIndex(colA, inputOffset, nu);
+      if (stateIndex >= 0) {
+        approximation.dfdx(stateIndex) += valueA * f(row);
+      } else if (inputIndex >= 0) {
+        approximation.dfdu(inputIndex) += valueA * f(row);
+      }
+
+      // Hessian: diagonal once, off-diagonal pairs in both orders
+      addToHessian(colA, colA, valueA * valueA);
+      for (auto b = a + 1; b < outerIndex[row + 1]; ++b) {
+        const scalar_t product = valueA * values[b];
+        addToHessian(colA, innerIndex[b], product);
+        addToHessian(innerIndex[b], colA, product);
+      }
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void addSparseHessian(const sparse_matrix_t& hessian, int stateOffset, int inputOffset,
+                      ScalarFunctionQuadraticApproximation& approximation) {
+  addSparseHessianImpl(hessian, stateOffset, inputOffset, approximation.dfdxx, approximation.dfdux, approximation.dfduu);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void addSparseHessian(const sparse_matrix_t& hessian, int stateOffset, int inputOffset, matrix_t& dfdxx, matrix_t& dfdux,
+                      matrix_t& dfduu) {
+  addSparseHessianImpl(hessian, stateOffset, inputOffset, dfdxx, dfdux, dfduu);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void addSparseHessian(const sparse_matrix_t& hessian, int stateOffset, matrix_t& dfdxx) {
+  matrix_t emptyMatrix;  // no inputs, not accessed and not allocated
+  addSparseHessianImpl(hessian, stateOffset, -1, dfdxx, emptyMatrix, emptyMatrix);
+}
+
+}  // namespace ocs2
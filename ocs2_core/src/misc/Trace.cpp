@@ -0,0 +1,378 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_core/misc/Trace.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+
+namespace ocs2 {
+namespace trace {
+
+namespace {
+/** Number of events kept per thread */
+constexpr size_t bufferCapacity = 1 << 14;
+
+/**
+ * Storage of one event. The fields are written by the owning thread while other threads may read them, hence they are atomics. The
+ * sequence number is odd while the slot is written and 2 * (n + 1) once it holds the event n, such that a reader detects torn events.
+ */
+struct EventSlot {
+  std::atomic<uint64_t> sequence{0};
+  std::atomic<const char*> name{nullptr};
+  std::atomic<int64_t> startTime{0};
+  std::atomic<int64_t> duration{0};
+  std::atomic<int> depth{0};
+};
+
+/** Single-producer ring buffer of one thread. Only the owning thread writes events, any thread may read them. */
+struct ThreadBuffer {
+  explicit ThreadBuffer(int index) : threadIndex(index), events(bufferCapacity) {}
+
+  const int threadIndex;
+  std::vector<EventSlot> events;
+  /** Number of events written so far, the event n is stored at n % bufferCapacity */
+  std::atomic<uint64_t> head{0};
+  /** Events before this index are discarded */
+  std::atomic<uint64_t> tail{0};
+  /** Current nesting depth, only accessed by the owning thread */
+  int depth = 0;
+  /** Whether the owning thread terminated, guarded by the registry mutex */
+  bool isRetired = false;
+  /** Whether the events of the terminated thread were exported or discarded, guarded by the registry mutex */
+  bool isExported = false;
+};
+
+struct Registry {
+  std::mutex mutex;
+  std::vector<std::shared_ptr<ThreadBuffer>> threadBuffers;
+  std::map<int, std::string> threadNames;
+};
+
+/**
+ * The registry keeps the buffers of terminated threads alive, such that their events can still be exported. Once exported, the buffer is
+ * handed to the next thread that records, such that the memory is bounded by the number of threads that run at the same time.
+ */
+Registry& getRegistry() {
+  static Registry registry;
+  return registry;
+}
+
+const std::chrono::steady_clock::time_point& getEpoch() {
+  static const auto epoch = std::chrono::steady_clock::now();
+  return epoch;
+}
+
+int64_t now() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - getEpoch()).count();
+}
+
+/** Tracing state of the calling thread. The buffer is created and registered on the first zone of the thread. */
+struct ThreadState {
+  ~ThreadState() {
+    if (buffer != nullptr) {
+      auto& registry = getRegistry();
+      std::lock_guard<std::mutex> lock(registry.mutex);
+      buffer->isRetired = true;
+      buffer->isExported = buffer->head.load(std::memory_order_relaxed) == buffer->tail.load(std::memory_order_relaxed);
+    }
+  }
+
+  std::shared_ptr<ThreadBuffer> buffer;
+  std::string name;
+};
+
+ThreadState& getThreadState() {
+  thread_local ThreadState threadState;
+  return threadState;
+}
+
+ThreadBuffer& getThreadBuffer() {
+  auto& threadState = getThreadState();
+  if (threadState.buffer == nullptr) {
+    auto& registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    // Recycle the buffer of a terminated thread whose events were exported, otherwise allocate a new one
+    const auto recycled = std::find_if(registry.threadBuffers.begin(), registry.threadBuffers.end(),
+                                       [](const std::shared_ptr<ThreadBuffer>& b) { return b->isRetired && b->isExported; });
+    if (recycled != registry.threadBuffers.end()) {
+      threadState.buffer = *recycled;
+      threadState.buffer->isRetired = false;
+      threadState.buffer->isExported = false;
+      threadState.buffer->depth = 0;
+      // The event numbers continue, such that the sequence numbers of the slots stay unique
+      threadState.buffer->tail.store(threadState.buffer->head.load(std::memory_order_relaxed), std::memory_order_relaxed);
+      registry.threadNames.erase(threadState.buffer->threadIndex);
+    } else {
+      const auto threadIndex = static_cast<int>(registry.threadBuffers.size());
+      registry.threadBuffers.push_back(std::make_shared<ThreadBuffer>(threadIndex));
+      threadState.buffer = registry.threadBuffers.back();
+    }
+    if (!threadState.name.empty()) {
+      registry.threadNames[threadState.buffer->threadIndex] = threadState.name;
+    }
+  }
+  return *threadState.buffer;
+}
+
+/**
+ * Reads the event n from its slot.
+ * @return false if the slot does not hold the event n, e.g. because the owning thread overwrote it or is writing it.
+ */
+bool readEvent(const EventSlot& slot, uint64_t n, Event& event) {
+  const uint64_t sequence = 2 * (n + 1);
+  if (slot.sequence.load(std::memory_order_acquire) != sequence) {
+    return false;
+  }
+  event.name = slot.name.load(std::memory_order_relaxed);
+  event.startTime = slot.startTime.load(std::memory_order_relaxed);
+  event.duration = slot.duration.load(std::memory_order_relaxed);
+  event.depth = slot.depth.load(std::memory_order_relaxed);
+  // The fields must be read before the sequence number is checked again
+  std::atomic_thread_fence(std::memory_order_acquire);
+  return slot.sequence.load(std::memory_order_relaxed) == sequence;
+}
+
+/** Copies the events that are neither cleared nor overwritten. */
+std::vector<Event> copyEvents(const ThreadBuffer& threadBuffer) {
+  const uint64_t head = threadBuffer.head.load(std::memory_order_acquire);
+  const uint64_t tail = threadBuffer.tail.load(std::memory_order_relaxed);
+  const uint64_t begin = std::max(tail, (head > bufferCapacity) ? head - bufferCapacity : 0);
+
+  // Events that the owning thread overwrites while copying are dropped. These are always the oldest ones, such that the copy stays a
+  // contiguous sequence of events.
+  std::vector<Event> events;
+  events.reserve(head - std::min(begin, head));
+  Event event;
+  for (uint64_t n = begin; n < head; n++) {
+    if (readEvent(threadBuffer.events[n % bufferCapacity], n, event)) {
+      events.push_back(event);
+    } else {
+      events.clear();
+    }
+  }
+  return events;
+}
+
+/** Nearest-rank percentile of sorted durations [ms]. */
+scalar_t percentile(const std::vector<int64_t>& sortedDurations, scalar_t fraction) {
+  const auto rank = static_cast<size_t>(std::ceil(fraction * sortedDurations.size()));
+  return 1e-6 * sortedDurations[std::max<size_t>(rank, 1) - 1];
+}
+
+ZoneStatistics computeStatistics(std::string name, int threadIndex, std::vector<int64_t>& durations) {
+  std::sort(durations.begin(), durations.end());
+  ZoneStatistics statistics;
+  statistics.name = std::move(name);
+  statistics.threadIndex = threadIndex;
+  statistics.count = durations.size();
+  for (const auto duration : durations) {
+    statistics.total += 1e-6 * duration;
+  }
+  statistics.median = percentile(durations, 0.5);
+  statistics.p99 = percentile(durations, 0.99);
+  statistics.max = 1e-6 * durations.back();
+  return statistics;
+}
+
+/** Escapes a string for JSON. */
+std::string escape(const std::string& text) {
+  std::string escaped;
+  escaped.reserve(text.size());
+  for (const char c : text) {
+    if (c == '"' || c == '\\') {
+      escaped.push_back('\\');
+    }
+    escaped.push_back(c);
+  }
+  return escaped;
+}
+}  // unnamed namespace
+
+namespace detail {
+std::atomic_bool isTracingEnabled{false};
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+int64_t beginZone() {
+  getThreadBuffer().depth++;
+  return now();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void endZone(const char* name, int64_t startTime) {
+  const int64_t endTime = now();
+  auto& threadBuffer = getThreadBuffer();
+  threadBuffer.depth--;
+
+  const uint64_t head = threadBuffer.head.load(std::memory_order_relaxed);
+  auto& slot = threadBuffer.events[head % bufferCapacity];
+  slot.sequence.store(2 * head + 1, std::memory_order_relaxed);
+  // Readers that see one of the fields below also see the odd sequence number
+  std::atomic_thread_fence(std::memory_order_release);
+  slot.name.store(name, std::memory_order_relaxed);
+  slot.startTime.store(startTime, std::memory_order_relaxed);
+  slot.duration.store(endTime - startTime, std::memory_order_relaxed);
+  slot.depth.store(threadBuffer.depth, std::memory_order_relaxed);
+  slot.sequence.store(2 * (head + 1), std::memory_order_release);
+  threadBuffer.head.store(head + 1, std::memory_order_release);
+}
+}  // namespace detail
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void setEnabled(bool enabled) {
+  getEpoch();  // initialize the epoch before the first zone
+  detail::isTracingEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void clear() {
+  auto& registry = getRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  for (auto& threadBuffer : registry.threadBuffers) {
+    threadBuffer->tail.store(threadBuffer->head.load(std::memory_order_acquire), std::memory_order_relaxed);
+    threadBuffer->isExported = threadBuffer->isRetired;
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void setThreadName(const std::string& name) {
+  // The name is only stored until the thread records its first zone, such that naming a thread does not allocate its buffer
+  auto& threadState = getThreadState();
+  threadState.name = name;
+  if (threadState.buffer != nullptr) {
+    auto& registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.threadNames[threadState.buffer->threadIndex] = name;
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::vector<std::vector<Event>> getEvents() {
+  auto& registry = getRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  std::vector<std::vector<Event>> events;
+  events.reserve(registry.threadBuffers.size());
+  for (const auto& threadBuffer : registry.threadBuffers) {
+    events.push_back(copyEvents(*threadBuffer));
+    threadBuffer->isExported = threadBuffer->isRetired;
+  }
+  return events;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::vector<ZoneStatistics> getZoneStatistics(bool perThread) {
+  const auto events = getEvents();
+
+  // Durations per (name, thread). Zones of the same name from different call sites are accumulated.
+  std::map<std::pair<std::string, int>, std::vector<int64_t>> durations;
+  for (size_t threadIndex = 0; threadIndex < events.size(); threadIndex++) {
+    for (const auto& event : events[threadIndex]) {
+      durations[{event.name, perThread ? static_cast<int>(threadIndex) : -1}].push_back(event.duration);
+    }
+  }
+
+  std::vector<ZoneStatistics> statistics;
+  statistics.reserve(durations.size());
+  for (auto& zone : durations) {
+    statistics.push_back(computeStatistics(zone.first.first, zone.first.second, zone.second));
+  }
+  return statistics;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void writeChromeTrace(std::ostream& stream) {
+  const auto events = getEvents();
+  std::map<int, std::string> threadNames;
+  {
+    auto& registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    threadNames = registry.threadNames;
+  }
+
+  const auto flags = stream.flags();
+  const auto precision = stream.precision();
+  stream << std::fixed << std::setprecision(3) << "{\"traceEvents\":[";
+  bool isFirst = true;
+  const auto separator = [&]() -> const char* {
+    const char* s = isFirst ? "\n" : ",\n";
+    isFirst = false;
+    return s;
+  };
+  for (const auto& threadName : threadNames) {
+    stream << separator() << R"({"name":"thread_name","ph":"M","pid":0,"tid":)" << threadName.first << R"(,"args":{"name":")"
+           << escape(threadName.second) << "\"}}";
+  }
+  for (size_t threadIndex = 0; threadIndex < events.size(); threadIndex++) {
+    for (const auto& event : events[threadIndex]) {
+      // Timestamps in microseconds
+      stream << separator() << R"({"name":")" << escape(event.name) << R"(","ph":"X","pid":0,"tid":)" << threadIndex
+             << ",\"ts\":" << 1e-3 * event.startTime << ",\"dur\":" << 1e-3 * event.duration << "}";
+    }
+  }
+  stream << "\n]}\n";
+  stream.flags(flags);
+  stream.precision(precision);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void saveChromeTrace(const std::string& fileName) {
+  std::ofstream file(fileName);
+  if (!file) {
+    throw std::runtime_error("[trace::saveChromeTrace] Could not open file: " + fileName);
+  }
+  writeChromeTrace(file);
+}
+
+}  // namespace trace
+}  // namespace ocs2
@@ -34,6 +34,25 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 namespace ocs2 {
 
+namespace {
+/** Same as LinearInterpolation::interpolate(time, timeArray, dataArray), but writes to value in place */
+void interpolate(scalar_t time, const scalar_array_t& timeArray, const vector_array_t& dataArray, vector_t& value) {
+  if (dataArray.size() > 1) {
+    const auto indexAlpha = LinearInterpolation::timeSegment(time, timeArray);
+    const scalar_t alpha = indexAlpha.second;
+    const auto& lhs = dataArray[indexAlpha.first];
+    const auto& rhs = dataArray[indexAlpha.first + 1];
+    if (lhs.size() == rhs.size()) {
+      value = alpha * lhs + (1.0 - alpha) * rhs;
+    } else {
+      value = (alpha > 0.5) ? lhs : rhs;
+    }
+  } else {
+    value = dataArray.front();
+  }
+}
+}  // unnamed namespace
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /***************************************************************************************************** */
@@ -74,23 +93,41 @@ bool TargetTrajectories::operator==(const TargetTrajectories& other) {
 /******************************************************************************************************/
 /***************************************************************************************************** */
 vector_t TargetTrajectories::getDesiredState(scalar_t time) const {
+  vector_t desiredState;
+  getDesiredState(time, desiredState);
+  return desiredState;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/***************************************************************************************************** */
+vector_t TargetTrajectories::getDesiredInput(scalar_t time) const {
+  vector_t desiredInput;
+  getDesiredInput(time, desiredInput);
+  return desiredInput;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/***************************************************************************************************** */
+void TargetTrajectories::getDesiredState(scalar_t time, vector_t& desiredState) const {
   if (this->empty()) {
     throw std::runtime_error("[TargetTrajectories] TargetTrajectories is empty!");
   } else {
-    return LinearInterpolation::interpolate(time, timeTrajectory, stateTrajectory);
+    interpolate(time, timeTrajectory, stateTrajectory, desiredState);
   }
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /***************************************************************************************************** */
-vector_t TargetTrajectories::getDesiredInput(scalar_t time) const {
+void TargetTrajectories::getDesiredInput(scalar_t time, vector_t& desiredInput) const {
   if (this->empty()) {
     throw std::runtime_error("[TargetTrajectories] TargetTrajectories is empty!");
   } else if (inputTrajectory.empty()) {
     throw std::runtime_error("[TargetTrajectories] TargetTrajectories does not have inputTrajectory!");
   } else {
-    return LinearInterpolation::interpolate(time, timeTrajectory, inputTrajectory);
+    interpolate(time, timeTrajectory, inputTrajectory, desiredInput);
   }
 }
 
@@ -0,0 +1,153 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_core/thread_support/SetThreadAffinity.h"
+
+#include <algorithm>
+#include <cctype>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+namespace ocs2 {
+
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+std::vector<int> parseCpuList(const std::string& cpuList) {
+  std::vector<int> cpus;
+  std::stringstream listStream(cpuList);
+  std::string item;
+  while (std::getline(listStream, item, ',')) {
+    item.erase(std::remove_if(item.begin(), item.end(), ::isspace), item.end());
+    if (item.empty()) {
+      continue;
+    }
+    try {
+      const auto dashPos = item.find('-');
+      if (dashPos == std::string::npos) {
+        cpus.push_back(std::stoi(item));
+      } else {
+        const int first = std::stoi(item.substr(0, dashPos));
+        const int last = std::stoi(item.substr(dashPos + 1));
+        for (int cpu = first; cpu <= last; ++cpu) {
+          cpus.push_back(cpu);
+        }
+      }
+    } catch (const std::logic_error&) {
+      throw std::invalid_argument("[parseCpuList] Invalid CPU list entry \"" + item + "\" in \"" + cpuList + "\".");
+    }
+    if (!cpus.empty() && cpus.back() < 0) {
+      throw std::invalid_argument("[parseCpuList] Negative CPU index in \"" + cpuList + "\".");
+    }
+  }
+
+  std::sort(cpus.begin(), cpus.end());
+  cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+  return cpus;
+}
+
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+std::vector<std::vector<int>> getWorkerCpuSets(const std::string& threadAffinity, const std::vector<std::string>& workerThreadAffinity,
+                                               size_t numWorkers) {
+  const auto poolCpus = parseCpuList(threadAffinity);
+  std::vector<std::vector<int>> workerCpus(numWorkers, poolCpus);
+  for (size_t i = 0; i < std::min(numWorkers, workerThreadAffinity.size()); ++i) {
+    auto cpus = parseCpuList(workerThreadAffinity[i]);
+    if (!cpus.empty()) {
+      workerCpus[i] = std::move(cpus);
+    }
+  }
+  return workerCpus;
+}
+
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+bool setThreadAffinity(const std::vector<int>& cpus, pthread_t thread) {
+  if (cpus.empty()) {
+    return false;
+  }
+
+  cpu_set_t cpuSet;
+  CPU_ZERO(&cpuSet);
+  for (const auto cpu : cpus) {
+    if (cpu < CPU_SETSIZE) {
+      CPU_SET(cpu, &cpuSet);
+    }
+  }
+
+  if (pthread_setaffinity_np(thread, sizeof(cpu_set_t), &cpuSet) != 0) {
+    std::cerr << "WARNING: Failed to set thread affinity (one possible reason could be "
+                 "that the requested CPUs are not available to this process.)"
+              << std::endl;
+    return false;
+  }
+  return true;
+}
+
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+ScopedThisThreadAffinity::ScopedThisThreadAffinity(const std::vector<int>& cpus) {
+  if (cpus.empty()) {
+    return;
+  }
+
+  CPU_ZERO(&previousCpuSet_);
+  if (pthread_getaffinity_np(pthread_self(), sizeof(cpu_set_t), &previousCpuSet_) != 0) {
+    return;
+  }
+
+  cpu_set_t cpuSet;
+  CPU_ZERO(&cpuSet);
+  for (const auto cpu : cpus) {
+    if (cpu < CPU_SETSIZE) {
+      CPU_SET(cpu, &cpuSet);
+    }
+  }
+
+  // nothing to do (and to restore) if the thread is already pinned to this set
+  if (!CPU_EQUAL(&cpuSet, &previousCpuSet_)) {
+    isPinned_ = setThisThreadAffinity(cpus);
+  }
+}
+
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+ScopedThisThreadAffinity::~ScopedThisThreadAffinity() {
+  if (isPinned_) {
+    pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &previousCpuSet_);
+  }
+}
+
+}  // namespace ocs2
@@ -27,19 +27,49 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 
+#include <ocs2_core/misc/Trace.h>
+#include <ocs2_core/thread_support/SetThreadAffinity.h>
 #include <ocs2_core/thread_support/SetThreadPriority.h>
 #include <ocs2_core/thread_support/ThreadPool.h>
 
+#include <algorithm>
+
 namespace ocs2 {
 
+namespace {
+/*
+ * A chunk range is packed as [tag (16 bits) | first (24 bits) | last (24 bits)]. The tag is incremented on every modification such that
+ * a thief holding an outdated copy of the range can never succeed with its compare-and-swap (ABA problem).
+ */
+constexpr uint64_t kChunkBits = 24;
+constexpr uint64_t kChunkMask = (uint64_t(1) << kChunkBits) - 1;
+constexpr uint64_t kTagMask = (uint64_t(1) << (64 - 2 * kChunkBits)) - 1;
+
+inline uint64_t packRange(uint64_t tag, uint64_t first, uint64_t last) {
+  return ((tag & kTagMask) << (2 * kChunkBits)) | (first << kChunkBits) | last;
+}
+inline uint64_t rangeTag(uint64_t packedRange) {
+  return packedRange >> (2 * kChunkBits);
+}
+inline uint64_t rangeFirst(uint64_t packedRange) {
+  return (packedRange >> kChunkBits) & kChunkMask;
+}
+inline uint64_t rangeLast(uint64_t packedRange) {
+  return packedRange & kChunkMask;
+}
+}  // unnamed namespace
+
 /**************************************************************************************************/
 /**************************************************************************************************/
 /**************************************************************************************************/
-ThreadPool::ThreadPool(size_t nThreads, int priority) {
+ThreadPool::ThreadPool(size_t nThreads, int priority, std::vector<std::vector<int>> cpuAffinity)
+    : chunkRanges_(new ChunkRange[nThreads + 1]), cpuAffinity_(std::move(cpuAffinity)) {
+  cpuAffinity_.resize(nThreads + 1);
   workerThreads_.reserve(nThreads);
   for (size_t i = 0; i < nThreads; i++) {
     workerThreads_.emplace_back(&ThreadPool::worker, this, i);
     setThreadPriority(priority, workerThreads_.back());
+    setThreadAffinity(cpuAffinity_[i], workerThreads_.back());
   }
 }
 
@@ -63,24 +93,44 @@ ThreadPool::~ThreadPool() {
 /**************************************************************************************************/
 /**************************************************************************************************/
 void ThreadPool::worker(int workerIndex) {
+  trace::setThreadName("ThreadPool worker " + std::to_string(workerIndex));
+  size_t lastParallelForGeneration = 0;
   while (true) {
     std::unique_ptr<ThreadPool::TaskBase> taskPtr;
+    ParallelForJob* jobPtr = nullptr;
     {
       std::unique_lock<std::mutex> lock(taskQueueLock_);
-      taskQueueCondition_.wait(lock, [this] { return !taskQueue_.empty() || stop_; });
+      const auto hasNewParallelForJob = [&] {
+        return parallelForJobPtr_ != nullptr && parallelForGeneration_ != lastParallelForGeneration;
+      };
+      taskQueueCondition_.wait(lock, [&] { return !taskQueue_.empty() || hasNewParallelForJob() || stop_; });
 
       // exit condition
       if (stop_) {
         break;
       }
 
-      // pop the first task
-      if (!taskQueue_.empty()) {
+      if (hasNewParallelForJob()) {
+        // join the parallelFor job
+        lastParallelForGeneration = parallelForGeneration_;
+        jobPtr = parallelForJobPtr_;
+        ++jobPtr->numActiveWorkers;
+      } else if (!taskQueue_.empty()) {
+        // pop the first task
         taskPtr = std::move(taskQueue_.front());
         taskQueue_.pop();
       }
     }
 
+    if (jobPtr != nullptr) {
+      executeParallelFor(*jobPtr, workerIndex);
+      // the job is owned by the calling thread, it must not be accessed after leaving
+      std::lock_guard<std::mutex> lock(taskQueueLock_);
+      if (--jobPtr->numActiveWorkers == 0) {
+        parallelForDoneCondition_.notify_all();
+      }
+    }
+
     if (taskPtr) {
       taskPtr->operator()(workerIndex);
     }
@@ -114,7 +164,10 @@ void ThreadPool::runParallel(std::function<void(int)> taskFunction, int N) {
 
   // Execute one instance in this thread.
   const auto workerId = static_cast<int>(numThreads());  // threadpool workers use ID 0 -> nThreads - 1
-  taskFunction(workerId);
+  {
+    ScopedThisThreadAffinity callingThreadAffinity(cpuAffinity_[workerId]);
+    taskFunction(workerId);
+  }
 
   // Wait for helpers to finish.
   for (auto&& fut : futures) {
@@ -122,4 +175,121 @@ void ThreadPool::runParallel(std::function<void(int)> taskFunction, int N) {
   }
 }
 
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+void ThreadPool::runParallelFor(ParallelForJob& job) {
+  if (job.end <= job.begin) {
+    return;
+  }
+
+  // chunking, the grain is increased if the number of chunks does not fit in the packed range
+  const auto numIndices = static_cast<uint64_t>(job.end - job.begin);
+  const auto minGrain = static_cast<int>((numIndices + kChunkMask - 1) / kChunkMask);
+  job.grain = std::max({job.grain, minGrain, 1});
+  job.numChunks = (numIndices + job.grain - 1) / job.grain;
+
+  std::lock_guard<std::mutex> parallelForLock(parallelForLock_);
+
+  // equal initial share of the chunks for every participant
+  const uint64_t numParticipants = numThreads() + 1;
+  for (uint64_t p = 0; p < numParticipants; ++p) {
+    auto& packedRange = chunkRanges_[p].packedRange;
+    const uint64_t first = job.numChunks * p / numParticipants;
+    const uint64_t last = job.numChunks * (p + 1) / numParticipants;
+    packedRange.store(packRange(rangeTag(packedRange.load(std::memory_order_relaxed)) + 1, first, last), std::memory_order_relaxed);
+  }
+
+  if (!workerThreads_.empty()) {
+    {
+      std::lock_guard<std::mutex> lock(taskQueueLock_);
+      parallelForJobPtr_ = &job;
+      ++parallelForGeneration_;
+    }
+    taskQueueCondition_.notify_all();
+  }
+
+  // Execute in this thread, threadpool workers use ID 0 -> nThreads - 1
+  {
+    ScopedThisThreadAffinity callingThreadAffinity(cpuAffinity_[numThreads()]);
+    executeParallelFor(job, static_cast<int>(numThreads()));
+  }
+
+  if (!workerThreads_.empty()) {
+    // No new workers can join, wait for the active ones to finish their chunks.
+    std::unique_lock<std::mutex> lock(taskQueueLock_);
+    parallelForJobPtr_ = nullptr;
+    parallelForDoneCondition_.wait(lock, [&job] { return job.numActiveWorkers == 0; });
+  }
+
+  if (job.exceptionPtr) {
+    std::rethrow_exception(job.exceptionPtr);
+  }
+}
+
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+void ThreadPool::executeParallelFor(ParallelForJob& job, int participantIndex) {
+  uint64_t chunk;
+  while (popChunk(participantIndex, chunk) || stealChunk(participantIndex, chunk)) {
+    if (job.hasException.load(std::memory_order_relaxed)) {
+      continue;  // drain the remaining chunks
+    }
+    const int first = job.begin + static_cast<int>(chunk) * job.grain;
+    const int last = std::min(first + job.grain, job.end);
+    try {
+      job.invoke(job.functorPtr, participantIndex, first, last);
+    } catch (...) {
+      if (!job.hasException.exchange(true)) {
+        job.exceptionPtr = std::current_exception();
+      }
+    }
+  }
+}
+
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+bool ThreadPool::popChunk(int participantIndex, uint64_t& chunk) {
+  auto& packedRange = chunkRanges_[participantIndex].packedRange;
+  uint64_t current = packedRange.load(std::memory_order_acquire);
+  while (rangeFirst(current) < rangeLast(current)) {
+    const uint64_t desired = packRange(rangeTag(current) + 1, rangeFirst(current) + 1, rangeLast(current));
+    if (packedRange.compare_exchange_weak(current, desired, std::memory_order_acq_rel, std::memory_order_acquire)) {
+      chunk = rangeFirst(current);
+      return true;
+    }
+  }
+  return false;
+}
+
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+bool ThreadPool::stealChunk(int participantIndex, uint64_t& chunk) {
+  const int numParticipants = static_cast<int>(numThreads()) + 1;
+  for (int offset = 1; offset < numParticipants; ++offset) {
+    auto& victimRange = chunkRanges_[(participantIndex + offset) % numParticipants].packedRange;
+    uint64_t current = victimRange.load(std::memory_order_acquire);
+    while (rangeFirst(current) < rangeLast(current)) {
+      // the victim keeps [first, middle), the thief takes [middle, last)
+      const uint64_t first = rangeFirst(current);
+      const uint64_t last = rangeLast(current);
+      const uint64_t middle = first + (last - first) / 2;
+      if (victimRange.compare_exchange_weak(current, packRange(rangeTag(current) + 1, first, middle), std::memory_order_acq_rel,
+                                            std::memory_order_acquire)) {
+        chunk = middle;
+        if (middle + 1 < last) {
+          // the own range is empty at this point, hence only modified by this thread
+          auto& ownRange = chunkRanges_[participantIndex].packedRange;
+          ownRange.store(packRange(rangeTag(ownRange.load(std::memory_order_relaxed)) + 1, middle + 1, last), std::memory_order_release);
+        }
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
 }  // namespace ocs2
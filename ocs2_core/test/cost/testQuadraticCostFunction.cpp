@@ -67,6 +67,21 @@ TEST_F(testQuadraticCost, StateInputCostApproximation) {
   EXPECT_TRUE(L.dfduu.isApprox(R_, PRECISION));
 }
 
+TEST_F(testQuadraticCost, StateInputCostAddApproximation) {
+  QuadraticStateInputCost costFunction(Q_, R_, P_);
+
+  const auto L = costFunction.getQuadraticApproximation(t_, x_, u_, targetTrajectories_, preComputation_);
+  auto sum = L;
+  costFunction.addQuadraticApproximation(t_, x_, u_, targetTrajectories_, preComputation_, sum);
+
+  EXPECT_NEAR(sum.f, 2.0 * L.f, PRECISION);
+  EXPECT_TRUE(sum.dfdx.isApprox(2.0 * L.dfdx, PRECISION));
+  EXPECT_TRUE(sum.dfdu.isApprox(2.0 * L.dfdu, PRECISION));
+  EXPECT_TRUE(sum.dfdxx.isApprox(2.0 * L.dfdxx, PRECISION));
+  EXPECT_TRUE(sum.dfdux.isApprox(2.0 * L.dfdux, PRECISION));
+  EXPECT_TRUE(sum.dfduu.isApprox(2.0 * L.dfduu, PRECISION));
+}
+
 TEST_F(testQuadraticCost, StateInputCostClone) {
   QuadraticStateInputCost costFunction(Q_, R_, P_);
   auto costFunctionClone = std::unique_ptr<StateInputCost>(costFunction.clone());
@@ -94,6 +109,23 @@ TEST_F(testQuadraticCost, StateCostApproximation) {
   EXPECT_TRUE(Phi.dfdxx.isApprox(Qf_, PRECISION));
 }
 
+TEST_F(testQuadraticCost, StateCostAddApproximation) {
+  QuadraticStateCost costFunction(Qf_);
+
+  const auto Phi = costFunction.getQuadraticApproximation(t_, x_, targetTrajectories_, preComputation_);
+  auto sum = ScalarFunctionQuadraticApproximation::Zero(x_.size(), u_.size());
+  sum.dfdu.setOnes();
+  costFunction.addQuadraticApproximation(t_, x_, targetTrajectories_, preComputation_, sum);
+  costFunction.addQuadraticApproximation(t_, x_, targetTrajectories_, preComputation_, sum);
+
+  EXPECT_NEAR(sum.f, 2.0 * Phi.f, PRECISION);
+  EXPECT_TRUE(sum.dfdx.isApprox(2.0 * Phi.dfdx, PRECISION));
+  EXPECT_TRUE(sum.dfdxx.isApprox(2.0 * Phi.dfdxx, PRECISION));
+  // The input derivatives are not touched
+  EXPECT_TRUE(sum.dfdu.isOnes());
+  EXPECT_TRUE(sum.dfduu.isZero());
+}
+
 TEST_F(testQuadraticCost, StateCostClone) {
   QuadraticStateCost costFunction(Qf_);
   auto costFunctionClone = std::unique_ptr<StateCost>(costFunction.clone());
@@ -2,6 +2,13 @@
 
 #include <gtest/gtest.h>
 
+#include <fstream>
+#include <memory>
+
+#include <boost/filesystem.hpp>
+
+#include <ocs2_core/automatic_differentiation/CppAdModelBatch.h>
+
 #include "commonFixture.h"
 
 using namespace ocs2;
@@ -60,3 +67,269 @@ TEST_F(CppAdInterfaceParameterizedFixture, loadIfAvailable) {
   ASSERT_TRUE(gnApproximation.dfdx.isApprox(testJacobian(x, p).transpose() * testFun(x, p)));
   ASSERT_TRUE(gnApproximation.dfdxx.isApprox(testJacobian(x, p).transpose() * testJacobian(x, p)));
 }
+
+TEST_F(CppAdInterfaceParameterizedFixture, inPlaceEvaluation) {
+  ocs2::CppAdInterface adInterface(funImpl, variableDim_, parameterDim_, "testModelInPlace");
+
+  adInterface.createModels(ocs2::CppAdInterface::ApproximationOrder::Second, false);
+  ASSERT_EQ(adInterface.getRangeDim(), rangeDim_);
+  vector_t x = vector_t::Random(variableDim_);
+  vector_t p = vector_t::Random(parameterDim_);
+
+  // Write into blocks of larger buffers to check the strided outputs
+  vector_t value = vector_t::Zero(rangeDim_ + 1);
+  adInterface.getFunctionValue(x, p, value.head(rangeDim_));
+  ASSERT_TRUE(value.head(rangeDim_).isApprox(testFun(x, p)));
+
+  matrix_t jacobian = matrix_t::Constant(rangeDim_ + 1, variableDim_ + 1, 1.0);
+  adInterface.getJacobian(x, p, jacobian.topLeftCorner(rangeDim_, variableDim_));
+  ASSERT_TRUE(jacobian.topLeftCorner(rangeDim_, variableDim_).isApprox(testJacobian(x, p)));
+  ASSERT_DOUBLE_EQ(jacobian(rangeDim_, variableDim_), 1.0);
+
+  const vector_t w = vector_t::Unit(rangeDim_, 1);
+  matrix_t hessian(variableDim_, variableDim_);
+  adInterface.getHessian(w, x, p, hessian);
+  ASSERT_TRUE(hessian.isApprox(testHessian(1, x, p)));
+
+  scalar_t f;
+  vector_t dfdx(variableDim_);
+  matrix_t dfdxx(variableDim_, variableDim_);
+  adInterface.getGaussNewtonApproximation(x, p, f, dfdx, dfdxx);
+  ASSERT_DOUBLE_EQ(f, 0.5 * testFun(x, p).squaredNorm());
+  ASSERT_TRUE(dfdx.isApprox(testJacobian(x, p).transpose() * testFun(x, p)));
+  ASSERT_TRUE(dfdxx.isApprox(testJacobian(x, p).transpose() * testJacobian(x, p)));
+}
+
+TEST_F(CppAdInterfaceParameterizedFixture, batchEvaluation) {
+  ocs2::CppAdInterface adInterface(funImpl, variableDim_, parameterDim_, "testModelBatch");
+
+  adInterface.createModels(ocs2::CppAdInterface::ApproximationOrder::First, false);
+  const int numPoints = 5;
+  const matrix_t X = matrix_t::Random(variableDim_, numPoints);
+  const matrix_t P = matrix_t::Random(parameterDim_, numPoints);
+
+  matrix_t values(rangeDim_, numPoints);
+  matrix_t jacobians(numPoints * rangeDim_, variableDim_);
+  adInterface.getFunctionValueBatch(X, P, values);
+  adInterface.getJacobianBatch(X, P, jacobians);
+
+  for (int k = 0; k < numPoints; ++k) {
+    ASSERT_TRUE(values.col(k).isApprox(testFun(X.col(k), P.col(k))));
+    ASSERT_TRUE(jacobians.middleRows(k * rangeDim_, rangeDim_).isApprox(testJacobian(X.col(k), P.col(k))));
+  }
+}
+
+TEST_F(CppAdInterfaceParameterizedFixture, laneEvaluation) {
+  ocs2::CppAdInterface adInterface(funImpl, variableDim_, parameterDim_, "testModelLanes");
+  adInterface.setNumLanes(4);
+
+  adInterface.createModels(ocs2::CppAdInterface::ApproximationOrder::First, false);
+  ASSERT_EQ(adInterface.getNumLanes(), 4);
+
+  // One full block of lanes and two points evaluated one by one
+  const int numPoints = 6;
+  const matrix_t X = matrix_t::Random(variableDim_, numPoints);
+  const matrix_t P = matrix_t::Random(parameterDim_, numPoints);
+
+  matrix_t values(rangeDim_, numPoints);
+  matrix_t jacobians(numPoints * rangeDim_, variableDim_);
+  adInterface.getFunctionValueBatch(X, P, values);
+  adInterface.getJacobianBatch(X, P, jacobians);
+
+  for (int k = 0; k < numPoints; ++k) {
+    ASSERT_TRUE(values.col(k).isApprox(testFun(X.col(k), P.col(k))));
+    ASSERT_TRUE(jacobians.middleRows(k * rangeDim_, rangeDim_).isApprox(testJacobian(X.col(k), P.col(k))));
+  }
+
+  // The lane model is reloaded with the library
+  ocs2::CppAdInterface copiedInterface(adInterface);
+  ASSERT_EQ(copiedInterface.getNumLanes(), 4);
+}
+
+TEST_F(CppAdInterfaceNoParameterFixture, batchEvaluation) {
+  ocs2::CppAdInterface adInterface(funImpl, variableDim_, "testModelBatchWithoutParameters");
+
+  adInterface.createModels(ocs2::CppAdInterface::ApproximationOrder::First, false);
+  const int numPoints = 3;
+  const matrix_t X = matrix_t::Random(variableDim_, numPoints);
+
+  matrix_t values(rangeDim_, numPoints);
+  matrix_t jacobians(numPoints * rangeDim_, variableDim_);
+  adInterface.getFunctionValueBatch(X, matrix_t(0, numPoints), values);
+  adInterface.getJacobianBatch(X, matrix_t(0, numPoints), jacobians);
+
+  for (int k = 0; k < numPoints; ++k) {
+    ASSERT_TRUE(values.col(k).isApprox(testFun(X.col(k))));
+    ASSERT_TRUE(jacobians.middleRows(k * rangeDim_, rangeDim_).isApprox(testJacobian(X.col(k))));
+  }
+}
+
+TEST_F(CppAdInterfaceParameterizedFixture, sparseEvaluation) {
+  ocs2::CppAdInterface adInterface(funImpl, variableDim_, parameterDim_, "testModelSparse");
+
+  adInterface.createModels(ocs2::CppAdInterface::ApproximationOrder::Second, false);
+  vector_t x = vector_t::Random(variableDim_);
+  vector_t p = vector_t::Random(parameterDim_);
+
+  // y(1) does not depend on p, all variable entries of the Jacobian and the Hessian are structurally non-zero
+  ASSERT_EQ(adInterface.getJacobianSparsityPattern().nonZeros(), rangeDim_ * variableDim_);
+  ASSERT_EQ(adInterface.getHessianSparsityPattern().nonZeros(), variableDim_ * variableDim_);
+
+  sparse_matrix_t jacobian;
+  adInterface.getSparseJacobian(x, p, jacobian);
+  ASSERT_TRUE(matrix_t(jacobian).isApprox(testJacobian(x, p)));
+
+  // Second call reuses the pattern
+  const auto* valuePtr = jacobian.valuePtr();
+  x.setRandom();
+  adInterface.getSparseJacobian(x, p, jacobian);
+  ASSERT_EQ(jacobian.valuePtr(), valuePtr);
+  ASSERT_TRUE(matrix_t(jacobian).isApprox(testJacobian(x, p)));
+
+  const vector_t w = (vector_t(rangeDim_) << 0.3, -2.0).finished();
+  sparse_matrix_t hessian;
+  adInterface.getSparseHessian(w, x, p, hessian);
+  ASSERT_TRUE(matrix_t(hessian).isApprox(w(0) * testHessian(0, x, p) + w(1) * testHessian(1, x, p)));
+}
+
+TEST(testCppAdInterface, sparseJacobianWithOtherPattern) {
+  // diagonal Jacobian
+  auto diagonalFun = [](const ad_vector_t& x, const ad_vector_t& p, ad_vector_t& y) { y = x.cwiseProduct(x); };
+  ocs2::CppAdInterface adInterface(diagonalFun, 2, 0, "testModelSparsePattern");
+  adInterface.createModels(ocs2::CppAdInterface::ApproximationOrder::First, false);
+  const vector_t x = (vector_t(2) << 1.0, 2.0).finished();
+  const vector_t p(0);
+
+  // anti-diagonal matrix with the same number of non-zeros
+  sparse_matrix_t jacobian(2, 2);
+  jacobian.insert(0, 1) = 1.0;
+  jacobian.insert(1, 0) = 1.0;
+  jacobian.makeCompressed();
+
+  adInterface.getSparseJacobian(x, p, jacobian);
+  ASSERT_TRUE(matrix_t(jacobian).isApprox(matrix_t(2.0 * x.asDiagonal())));
+}
+
+TEST_F(CppAdInterfaceParameterizedFixture, loadIfUpToDate) {
+  // A stale library of a different function under the same name must not be reused
+  auto otherFun = [](const ad_vector_t& x, const ad_vector_t& p, ad_vector_t& y) { y = x.head(2) + x.head(2); };
+  ocs2::CppAdInterface staleInterface(otherFun, variableDim_, parameterDim_, "testModelLoadIfUpToDate");
+  staleInterface.createModels(ocs2::CppAdInterface::ApproximationOrder::Second, false);
+
+  ocs2::CppAdInterface adInterface(funImpl, variableDim_, parameterDim_, "testModelLoadIfUpToDate");
+  adInterface.loadModelsIfUpToDate(ocs2::CppAdInterface::ApproximationOrder::Second, false);
+  vector_t x = vector_t::Random(variableDim_);
+  vector_t p = vector_t::Random(parameterDim_);
+  ASSERT_TRUE(adInterface.getFunctionValue(x, p).isApprox(testFun(x, p)));
+  ASSERT_TRUE(adInterface.getJacobian(x, p).isApprox(testJacobian(x, p)));
+
+  // Unchanged library is loaded without recompilation
+  const auto libraryPath = boost::filesystem::path("/tmp/ocs2/testModelLoadIfUpToDate/cppad_generated/testModelLoadIfUpToDate_lib.so");
+  const auto writeTime = boost::filesystem::last_write_time(libraryPath);
+  ocs2::CppAdInterface cachedInterface(funImpl, variableDim_, parameterDim_, "testModelLoadIfUpToDate");
+  cachedInterface.loadModelsIfUpToDate(ocs2::CppAdInterface::ApproximationOrder::Second, false);
+  ASSERT_EQ(boost::filesystem::last_write_time(libraryPath), writeTime);
+  ASSERT_TRUE(cachedInterface.getHessian(1, x, p).isApprox(testHessian(1, x, p)));
+
+  // The approximation order is part of the hash
+  auto readHash = [] {
+    std::ifstream hashFile("/tmp/ocs2/testModelLoadIfUpToDate/cppad_generated/testModelLoadIfUpToDate_lib.hash");
+    std::string hash;
+    hashFile >> hash;
+    return hash;
+  };
+  const auto secondOrderHash = readHash();
+  ocs2::CppAdInterface firstOrderInterface(funImpl, variableDim_, parameterDim_, "testModelLoadIfUpToDate");
+  firstOrderInterface.loadModelsIfUpToDate(ocs2::CppAdInterface::ApproximationOrder::First, false);
+  ASSERT_FALSE(secondOrderHash.empty());
+  ASSERT_NE(readHash(), secondOrderHash);
+  ASSERT_TRUE(firstOrderInterface.getJacobian(x, p).isApprox(testJacobian(x, p)));
+}
+
+TEST_F(CppAdInterfaceParameterizedFixture, createModelsInParallel) {
+  ocs2::CppAdInterface firstInterface(funImpl, variableDim_, parameterDim_, "testModelParallelFirst");
+  ocs2::CppAdInterface secondInterface(funImpl, variableDim_, parameterDim_, "testModelParallelSecond");
+  ocs2::CppAdInterface::createModelsInParallel({{&firstInterface, ocs2::CppAdInterface::ApproximationOrder::Second},
+                                                {&secondInterface, ocs2::CppAdInterface::ApproximationOrder::First}},
+                                               2, false, false);
+
+  vector_t x = vector_t::Random(variableDim_);
+  vector_t p = vector_t::Random(parameterDim_);
+  ASSERT_TRUE(firstInterface.getHessian(0, x, p).isApprox(testHessian(0, x, p)));
+  ASSERT_TRUE(secondInterface.getJacobian(x, p).isApprox(testJacobian(x, p)));
+}
+
+TEST_F(CppAdInterfaceParameterizedFixture, modelBatch) {
+  ocs2::CppAdInterface firstInterface(funImpl, variableDim_, parameterDim_, "testModelBatchFirst");
+  std::unique_ptr<ocs2::CppAdInterface> copiedInterfacePtr;
+  {
+    ocs2::CppAdModelBatch modelBatch(2);
+    ASSERT_EQ(ocs2::CppAdModelBatch::getActiveBatch(), &modelBatch);
+    firstInterface.createModels(ocs2::CppAdInterface::ApproximationOrder::Second, false);
+    {
+      // The copy of a pending interface is loaded by the batch, also if the original is destroyed before
+      ocs2::CppAdInterface secondInterface(funImpl, variableDim_, parameterDim_, "testModelBatchSecond");
+      ocs2::CppAdInterface::createModelsInParallel({{&secondInterface, ocs2::CppAdInterface::ApproximationOrder::First}}, 0, false,
+                                                   false);
+      copiedInterfacePtr.reset(new ocs2::CppAdInterface(secondInterface));
+    }
+    modelBatch.finish();
+  }
+  ASSERT_EQ(ocs2::CppAdModelBatch::getActiveBatch(), nullptr);
+
+  vector_t x = vector_t::Random(variableDim_);
+  vector_t p = vector_t::Random(parameterDim_);
+  ASSERT_TRUE(firstInterface.getHessian(0, x, p).isApprox(testHessian(0, x, p)));
+  ASSERT_TRUE(copiedInterfacePtr->getJacobian(x, p).isApprox(testJacobian(x, p)));
+}
+
+TEST(testCppAdInterface, laneEvaluationWithMathFunctions) {
+  auto fun = [](const ad_vector_t& x, const ad_vector_t& p, ad_vector_t& y) {
+    y.resize(2);
+    y(0) = sin(x(0)) * cos(x(1)) + exp(-x(0) * x(0));
+    y(1) = pow(x(1), 3) + sqrt(1.0 + x(0) * x(0)) + tanh(x(1));
+  };
+  auto testFun = [](const vector_t& x) {
+    return (vector_t(2) << std::sin(x(0)) * std::cos(x(1)) + std::exp(-x(0) * x(0)),
+            std::pow(x(1), 3) + std::sqrt(1.0 + x(0) * x(0)) + std::tanh(x(1)))
+        .finished();
+  };
+  ocs2::CppAdInterface adInterface(fun, 2, 0, "testModelLanesMath");
+  adInterface.setNumLanes(8);
+  adInterface.createModels(ocs2::CppAdInterface::ApproximationOrder::First, false);
+  ASSERT_EQ(adInterface.getNumLanes(), 8);
+
+  const int numPoints = 8;
+  const matrix_t X = matrix_t::Random(2, numPoints);
+  const matrix_t P(0, numPoints);
+  matrix_t values(2, numPoints);
+  matrix_t jacobians(numPoints * 2, 2);
+  adInterface.getFunctionValueBatch(X, P, values);
+  adInterface.getJacobianBatch(X, P, jacobians);
+
+  const vector_t p(0);
+  for (int k = 0; k < numPoints; ++k) {
+    ASSERT_TRUE(values.col(k).isApprox(testFun(X.col(k))));
+    ASSERT_TRUE(jacobians.middleRows(k * 2, 2).isApprox(adInterface.getJacobian(X.col(k), p)));
+  }
+}
+
+TEST(testCppAdInterface, laneEvaluationWithConditional) {
+  // Conditional expressions are not translated, the batched evaluations fall back to the scalar model
+  auto fun = [](const ad_vector_t& x, const ad_vector_t& p, ad_vector_t& y) {
+    y.resize(1);
+    y(0) = CppAD::CondExpLt(x(0), ad_scalar_t(0.0), -x(0) * x(1), x(0) * x(1));
+  };
+  ocs2::CppAdInterface adInterface(fun, 2, 0, "testModelLanesConditional");
+  adInterface.setNumLanes(4);
+  adInterface.createModels(ocs2::CppAdInterface::ApproximationOrder::First, false);
+  ASSERT_EQ(adInterface.getNumLanes(), 0);
+
+  const matrix_t X = matrix_t::Random(2, 4);
+  const matrix_t P(0, 4);
+  matrix_t values(1, 4);
+  adInterface.getFunctionValueBatch(X, P, values);
+  for (int k = 0; k < 4; ++k) {
+    ASSERT_DOUBLE_EQ(values(0, k), std::abs(X(0, k)) * X(1, k));
+  }
+}
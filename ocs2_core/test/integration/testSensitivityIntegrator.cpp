@@ -35,6 +35,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/control/FeedforwardController.h>
 #include <ocs2_core/dynamics/LinearSystemDynamics.h>
 #include <ocs2_core/dynamics/SystemDynamicsBase.h>
+#include <ocs2_core/dynamics/SystemDynamicsBaseAD.h>
 
 namespace {
 std::unique_ptr<ocs2::LinearSystemDynamics> getSystem() {
@@ -45,6 +46,21 @@ std::unique_ptr<ocs2::LinearSystemDynamics> getSystem() {
   B << 1, 0;
   return std::make_unique<ocs2::LinearSystemDynamics>(std::move(A), std::move(B));
 }
+
+/** Damped pendulum with a time-varying torque, of which the flow map is evaluated at 4 points at once */
+class PendulumDynamics final : public ocs2::SystemDynamicsBaseAD {
+ public:
+  PendulumDynamics() { initialize(2, 1, "testPendulumLanes", "/tmp/ocs2", true, false, 4); }
+  PendulumDynamics* clone() const override { return new PendulumDynamics(*this); }
+
+ protected:
+  ocs2::ad_vector_t systemFlowMap(ocs2::ad_scalar_t time, const ocs2::ad_vector_t& state, const ocs2::ad_vector_t& input,
+                                  const ocs2::ad_vector_t& parameters) const override {
+    ocs2::ad_vector_t stateDerivative(2);
+    stateDerivative << state(1), -9.81 * sin(state(0)) - 0.1 * state(1) + input(0) * cos(time);
+    return stateDerivative;
+  }
+};
 }  // namespace
 
 TEST(test_sensitivity_integrator, eulerSensitivity) {
@@ -210,3 +226,32 @@ TEST(test_sensitivity_integrator, vsBoostRK4) {
   // Check
   ASSERT_TRUE(rk4ForwardDynamics.isApprox(boostRk4ForwardDynamics));
 }
+
+TEST(test_sensitivity_integrator, blockSensitivity) {
+  PendulumDynamics system;
+  ASSERT_EQ(system.getNumLanes(), 4);
+
+  // One block of lanes and two intervals evaluated one by one
+  const size_t numIntervals = 6;
+  ocs2::SensitivityDiscretizationBlock block;
+  block.resize(numIntervals);
+  for (size_t i = 0; i < numIntervals; i++) {
+    block.t[i] = 0.1 * i;
+    block.dt[i] = 0.05 + 0.01 * i;
+    block.x[i] = ocs2::vector_t::Random(2);
+    block.u[i] = ocs2::vector_t::Random(1);
+  }
+
+  using ocs2::SensitivityIntegratorType;
+  for (const auto type : {SensitivityIntegratorType::EULER, SensitivityIntegratorType::RK2, SensitivityIntegratorType::RK4}) {
+    auto sensitivityDiscretization = ocs2::selectDynamicsSensitivityDiscretization(type);
+    auto blockSensitivityDiscretization = ocs2::selectDynamicsSensitivityBlockDiscretization(type);
+    blockSensitivityDiscretization(system, block);
+    for (size_t i = 0; i < numIntervals; i++) {
+      const auto linearizedDynamics = sensitivityDiscretization(system, block.t[i], block.x[i], block.u[i], block.dt[i]);
+      ASSERT_TRUE(block.dynamics[i].f.isApprox(linearizedDynamics.f)) << ocs2::sensitivity_integrator::toString(type);
+      ASSERT_TRUE(block.dynamics[i].dfdx.isApprox(linearizedDynamics.dfdx)) << ocs2::sensitivity_integrator::toString(type);
+      ASSERT_TRUE(block.dynamics[i].dfdu.isApprox(linearizedDynamics.dfdu)) << ocs2::sensitivity_integrator::toString(type);
+    }
+  }
+}
@@ -0,0 +1,115 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#include "ocs2_core/Types.h"
+#include "ocs2_core/misc/AllocationTracking.h"
+#include "ocs2_core/misc/MonotonicArena.h"
+
+using namespace ocs2;
+
+TEST(testAllocationTracking, phaseCounter) {
+  allocation::PhaseAllocationCounter counter("test phase");
+  ASSERT_EQ(counter.getName(), "test phase");
+
+  MonotonicArena arena(64);
+  for (int i = 0; i < 3; ++i) {
+    counter.start();
+    arena.reset();
+    arena.allocateVector(16).setZero();
+    counter.end();
+  }
+  ASSERT_EQ(counter.getNumIntervals(), 3);
+  ASSERT_EQ(counter.getNumAllocatingIntervals(), 0);
+  ASSERT_EQ(counter.getTotal().count, 0);
+
+  counter.start();
+  const vector_t v = vector_t::Ones(100);
+  counter.end();
+  ASSERT_EQ(counter.getNumIntervals(), 4);
+  if (allocation::isTrackingEnabled()) {
+    ASSERT_EQ(counter.getNumAllocatingIntervals(), 1);
+    ASSERT_GE(counter.getLast().count, 1);
+    ASSERT_GE(counter.getLast().bytes, 100 * sizeof(scalar_t));
+  } else {
+    ASSERT_EQ(counter.getTotal().count, 0);
+  }
+
+  counter.reset();
+  ASSERT_EQ(counter.getNumIntervals(), 0);
+  ASSERT_EQ(counter.getAverageCount(), 0.0);
+}
+
+TEST(testAllocationTracking, violations) {
+  allocation::setPolicy(allocation::Policy::Ignore);
+  const size_t numViolationsBefore = allocation::getNumViolations();
+
+  // Fixed-size Eigen types and preallocated buffers do not allocate
+  vector_t buffer = vector_t::Zero(10);
+  {
+    allocation::NoAllocationScope noAllocation;
+    buffer.setConstant(2.0);
+    buffer.array() += 1.0;
+  }
+  ASSERT_EQ(allocation::getNumViolations(), numViolationsBefore);
+
+  {
+    allocation::NoAllocationScope noAllocation;
+    std::vector<int> values(10, 1);
+    ASSERT_EQ(values.size(), 10);
+  }
+  allocation::PhaseAllocationCounter counter("steady state");
+  counter.start();
+  const vector_t v = vector_t::Ones(100);
+  counter.end(true);
+
+  const size_t expectedViolations = allocation::isTrackingEnabled() ? 2 : 0;
+  ASSERT_EQ(allocation::getNumViolations(), numViolationsBefore + expectedViolations);
+}
+
+TEST(testAllocationTracking, callingThreadScope) {
+  allocation::PhaseAllocationCounter processCounter("process", allocation::CountingScope::Process);
+  allocation::PhaseAllocationCounter threadCounter("thread", allocation::CountingScope::CallingThread);
+
+  processCounter.start();
+  threadCounter.start();
+  std::thread worker([] { const vector_t v = vector_t::Ones(100); });
+  worker.join();
+  threadCounter.end();
+  processCounter.end();
+
+  ASSERT_LT(threadCounter.getTotal().bytes, 100 * sizeof(scalar_t));
+  if (allocation::isTrackingEnabled()) {
+    ASSERT_GE(processCounter.getTotal().bytes, 100 * sizeof(scalar_t));
+  }
+}
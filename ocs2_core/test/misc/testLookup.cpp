@@ -104,6 +104,19 @@ TEST(testLookup, findIntervalInTimeArray) {
   ASSERT_EQ(findIntervalInTimeArray(timeArrayEmpty, 1.0), 0);
 }
 
+TEST(testLookup, findIntervalInTimeArrayWithHint) {
+  // same result as the bisection for any hint
+  const std::vector<double> timeArrays[] = {{-1.0, 2.0, 3.0}, {-1.0, 2.0, 2.0, 2.0, 3.0}, {1.0}, {}};
+  const std::vector<double> queryTimes{-2.0, -1.0, 0.0, 1.0, 1.9, 2.0, 2.1, 2.5, 3.0, 4.0};
+  for (const auto& timeArray : timeArrays) {
+    for (const auto time : queryTimes) {
+      for (int hint = -3; hint < 8; hint++) {
+        ASSERT_EQ(findIntervalInTimeArray(timeArray, time, hint), findIntervalInTimeArray(timeArray, time));
+      }
+    }
+  }
+}
+
 TEST(testLookup, findActiveIntervalInTimeArray) {
   // Normal case
   std::vector<double> timeArray{-1.0, 2.0, 3.0};
@@ -0,0 +1,98 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+
+#include "ocs2_core/misc/MonotonicArena.h"
+
+using namespace ocs2;
+
+TEST(testMonotonicArena, allocateWithinCapacity) {
+  MonotonicArena arena(100);
+  ASSERT_GE(arena.capacity(), 100);
+
+  auto A = arena.allocateMatrix(3, 5);
+  auto b = arena.allocateVector(7);
+  ASSERT_EQ(A.rows(), 3);
+  ASSERT_EQ(A.cols(), 5);
+  ASSERT_EQ(b.size(), 7);
+  ASSERT_EQ(reinterpret_cast<std::uintptr_t>(A.data()) % 16, 0);
+  ASSERT_EQ(reinterpret_cast<std::uintptr_t>(b.data()) % 16, 0);
+
+  // slices do not overlap
+  A.setConstant(1.0);
+  b.setConstant(2.0);
+  ASSERT_TRUE((A.array() == 1.0).all());
+  ASSERT_TRUE(b.data() >= A.data() + A.size());
+
+  // the memory is reused after a reset
+  const scalar_t* firstSlice = A.data();
+  arena.reset();
+  ASSERT_EQ(arena.size(), 0);
+  auto C = arena.allocateMatrix(2, 2);
+  ASSERT_EQ(C.data(), firstSlice);
+}
+
+TEST(testMonotonicArena, growsToPeakUsage) {
+  MonotonicArena arena;
+  ASSERT_EQ(arena.capacity(), 0);
+
+  // overflow allocations are valid until the reset
+  auto A = arena.allocateMatrix(4, 4);
+  auto B = arena.allocateMatrix(4, 4);
+  A.setIdentity();
+  B.setConstant(3.0);
+  const matrix_t AB = A * B;
+  ASSERT_TRUE(AB.isApprox(matrix_t::Constant(4, 4, 3.0)));
+  const size_t peakUsage = arena.size();
+
+  // the block holds all allocations of the previous cycle
+  arena.reset();
+  ASSERT_EQ(arena.capacity(), peakUsage);
+  const scalar_t* blockStart = arena.allocateMatrix(4, 4).data();
+  const scalar_t* secondSlice = arena.allocateMatrix(4, 4).data();
+  ASSERT_EQ(arena.size(), peakUsage);
+  ASSERT_EQ(secondSlice, blockStart + 16);
+
+  // capacity is kept if no overflow occurred
+  arena.reset();
+  ASSERT_EQ(arena.capacity(), peakUsage);
+}
+
+TEST(testMonotonicArena, paddingAndEmptyAllocations) {
+  MonotonicArena arena(16);
+  auto a = arena.allocateVector(3);
+  auto empty = arena.allocateVector(0);
+  auto b = arena.allocateVector(1);
+  ASSERT_EQ(empty.size(), 0);
+  ASSERT_EQ(reinterpret_cast<std::uintptr_t>(b.data()) % 16, 0);
+  ASSERT_TRUE(b.data() >= a.data() + a.size());
+}
@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+
+#include <ocs2_core/misc/SparseApproximation.h>
+
+using namespace ocs2;
+
+namespace {
+sparse_matrix_t getRandomSparseMatrix(int rows, int cols) {
+  matrix_t dense = matrix_t::Random(rows, cols);
+  dense = (dense.array().abs() > 0.5).select(dense, 0.0);
+  return dense.sparseView();
+}
+}  // namespace
+
+TEST(testSparseApproximation, addSparseJacobian) {
+  const int nv = 4, nx = 5, nu = 3;
+  // Columns: [t, x, u]
+  const sparse_matrix_t J = getRandomSparseMatrix(nv, 1 + nx + nu);
+  const matrix_t denseJ(J);
+
+  auto approximation = VectorFunctionLinearApproximation::Zero(nv, nx, nu);
+  approximation.dfdx.setOnes();
+  addSparseJacobian(J, 1, 1 + nx, approximation);
+  EXPECT_TRUE(approximation.dfdx.isApprox(matrix_t::Ones(nv, nx) + denseJ.middleCols(1, nx)));
+  EXPECT_TRUE(approximation.dfdu.isApprox(denseJ.rightCols(nu)));
+
+  // Without inputs
+  auto stateOnly = VectorFunctionLinearApproximation::Zero(nv, nx);
+  addSparseJacobian(J, 1, -1, stateOnly);
+  EXPECT_TRUE(stateOnly.dfdx.isApprox(denseJ.middleCols(1, nx)));
+}
+
+TEST(testSparseApproximation, addSparseGaussNewtonApproximation) {
+  const int nv = 6, nx = 4, nu = 2;
+  const sparse_matrix_t J = getRandomSparseMatrix(nv, 1 + nx + nu);
+  const matrix_t Jx = matrix_t(J).middleCols(1, nx);
+  const matrix_t Ju = matrix_t(J).rightCols(nu);
+  const vector_t f = vector_t::Random(nv);
+
+  auto approximation = ScalarFunctionQuadraticApproximation::Zero(nx, nu);
+  addSparseGaussNewtonApproximation(f, J, 1, 1 + nx, approximation);
+  EXPECT_DOUBLE_EQ(approximation.f, 0.5 * f.squaredNorm());
+  EXPECT_TRUE(approximation.dfdx.isApprox(Jx.transpose() * f));
+  EXPECT_TRUE(approximation.dfdu.isApprox(Ju.transpose() * f));
+  EXPECT_TRUE(approximation.dfdxx.isApprox(Jx.transpose() * Jx));
+  EXPECT_TRUE(approximation.dfdux.isApprox(Ju.transpose() * Jx));
+  EXPECT_TRUE(approximation.dfduu.isApprox(Ju.transpose() * Ju));
+}
+
+TEST(testSparseApproximation, addSparseHessian) {
+  const int nx = 4, nu = 3;
+  const matrix_t A = matrix_t(getRandomSparseMatrix(1 + nx + nu, 1 + nx + nu));
+  const matrix_t denseH = A + A.transpose();
+  const sparse_matrix_t H = denseH.sparseView();
+
+  auto approximation = ScalarFunctionQuadraticApproximation::Zero(nx, nu);
+  addSparseHessian(H, 1, 1 + nx, approximation);
+  EXPECT_TRUE(approximation.dfdxx.isApprox(denseH.block(1, 1, nx, nx)));
+  EXPECT_TRUE(approximation.dfdux.isApprox(denseH.block(1 + nx, 1, nu, nx)));
+  EXPECT_TRUE(approximation.dfduu.isApprox(denseH.bottomRightCorner(nu, nu)));
+}
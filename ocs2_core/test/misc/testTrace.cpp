@@ -0,0 +1,165 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <sstream>
+#include <thread>
+
+#include <ocs2_core/misc/Trace.h>
+
+using namespace ocs2;
+
+namespace {
+void tracedWork(int numIterations) {
+  for (int i = 0; i < numIterations; i++) {
+    OCS2_TRACE_ZONE("testTrace::outer");
+    OCS2_TRACE_ZONE("testTrace::inner");
+  }
+}
+
+const trace::ZoneStatistics* findZone(const std::vector<trace::ZoneStatistics>& statistics, const std::string& name, int threadIndex) {
+  for (const auto& zone : statistics) {
+    if (zone.name == name && zone.threadIndex == threadIndex) {
+      return &zone;
+    }
+  }
+  return nullptr;
+}
+}  // unnamed namespace
+
+TEST(testTrace, disabled) {
+  trace::setEnabled(false);
+  trace::clear();
+  tracedWork(10);
+  EXPECT_TRUE(trace::getZoneStatistics().empty());
+}
+
+TEST(testTrace, statistics) {
+  trace::setEnabled(true);
+  trace::clear();
+  tracedWork(10);
+  std::thread worker([] { tracedWork(5); });
+  worker.join();
+  trace::setEnabled(false);
+
+  const auto statistics = trace::getZoneStatistics();
+  ASSERT_EQ(statistics.size(), 2);
+  const auto* outer = findZone(statistics, "testTrace::outer", -1);
+  const auto* inner = findZone(statistics, "testTrace::inner", -1);
+  ASSERT_NE(outer, nullptr);
+  ASSERT_NE(inner, nullptr);
+  EXPECT_EQ(outer->count, 15);
+  EXPECT_LE(outer->median, outer->p99);
+  EXPECT_LE(outer->p99, outer->max);
+  EXPECT_LE(outer->max, outer->total);
+  EXPECT_LE(inner->total, outer->total);
+
+  // The zones are nested
+  const auto events = trace::getEvents();
+  for (const auto& threadEvents : events) {
+    for (const auto& event : threadEvents) {
+      EXPECT_EQ(event.depth, std::string(event.name) == "testTrace::outer" ? 0 : 1);
+    }
+  }
+
+  const auto perThreadStatistics = trace::getZoneStatistics(true);
+  ASSERT_EQ(perThreadStatistics.size(), 4);
+  size_t outerCount = 0;
+  for (const auto& zone : perThreadStatistics) {
+    EXPECT_GE(zone.threadIndex, 0);
+    outerCount += (zone.name == "testTrace::outer") ? zone.count : 0;
+  }
+  EXPECT_EQ(outerCount, 15);
+}
+
+TEST(testTrace, ringBufferOverflow) {
+  trace::setEnabled(true);
+  trace::clear();
+  std::thread worker([] { tracedWork(100000); });
+  worker.join();
+  trace::setEnabled(false);
+
+  // Only the latest events are kept
+  const auto statistics = trace::getZoneStatistics();
+  ASSERT_EQ(statistics.size(), 2);
+  EXPECT_LT(statistics[0].count + statistics[1].count, 200000);
+  EXPECT_GT(statistics[0].count, 0);
+}
+
+TEST(testTrace, recycledThreadBuffer) {
+  const auto countEvents = [](const std::vector<std::vector<trace::Event>>& events) {
+    size_t numEvents = 0;
+    for (const auto& threadEvents : events) {
+      numEvents += threadEvents.size();
+    }
+    return numEvents;
+  };
+
+  trace::setEnabled(true);
+  trace::clear();
+  std::thread first([] { tracedWork(3); });
+  first.join();
+
+  // The events of a terminated thread are kept until they are exported
+  auto events = trace::getEvents();
+  const auto numThreads = events.size();
+  EXPECT_EQ(countEvents(events), 6);
+
+  // Afterwards, the buffer is reused by the next thread
+  std::thread second([] { tracedWork(2); });
+  second.join();
+  events = trace::getEvents();
+  EXPECT_EQ(events.size(), numThreads);
+  EXPECT_EQ(countEvents(events), 4);
+
+  // A buffer whose events were not exported is not reused, the events of both threads are kept
+  std::thread third([] { tracedWork(1); });
+  third.join();
+  std::thread fourth([] { tracedWork(1); });
+  fourth.join();
+  trace::setEnabled(false);
+  EXPECT_EQ(countEvents(trace::getEvents()), 4);
+}
+
+TEST(testTrace, concurrentReader) {
+  trace::setEnabled(true);
+  trace::clear();
+  std::atomic_bool isDone{false};
+  std::thread worker([&] {
+    tracedWork(200000);
+    isDone = true;
+  });
+
+  // The worker overwrites its ring buffer while the events are copied, none of the copied events may be torn
+  size_t numCopies = 0;
+  while (!isDone || numCopies == 0) {
+    for (const auto& threadEvents : trace::getEvents()) {
+      int64_t previousEndTime = 0;
+      for (const auto& event : threadEvents) {
+        ASSERT_NE(event.name, nullptr);
+        ASSERT_EQ(event.depth, std::string(event.name) == "testTrace::outer" ? 0 : 1);
+        ASSERT_GE(event.duration, 0);
+        // Events are recorded at the end of their zone
+        ASSERT_GE(event.startTime + event.duration, previousEndTime);
+        previousEndTime = event.startTime + event.duration;
+      }
+    }
+    numCopies++;
+  }
+  worker.join();
+  trace::setEnabled(false);
+}
+
+TEST(testTrace, chromeTrace) {
+  trace::setEnabled(true);
+  trace::clear();
+  trace::setThreadName("test \"main\"");
+  tracedWork(2);
+  trace::setEnabled(false);
+
+  std::ostringstream stream;
+  trace::writeChromeTrace(stream);
+  const auto json = stream.str();
+  EXPECT_EQ(json.find("{\"traceEvents\":["), 0);
+  EXPECT_NE(json.find(R"("name":"testTrace::outer","ph":"X")"), std::string::npos);
+  EXPECT_NE(json.find(R"("name":"test \"main\"")"), std::string::npos);
+}
@@ -0,0 +1,97 @@
+#include <sched.h>
+
+#include <gtest/gtest.h>
+
+#include <ocs2_core/thread_support/SetThreadAffinity.h>
+#include <ocs2_core/thread_support/ThreadPool.h>
+
+using namespace ocs2;
+
+namespace {
+/** Returns the CPUs the calling thread is allowed to run on as reported by the kernel. */
+std::vector<int> getThisThreadCpus() {
+  cpu_set_t cpuSet;
+  CPU_ZERO(&cpuSet);
+  if (sched_getaffinity(0, sizeof(cpu_set_t), &cpuSet) != 0) {
+    return {};
+  }
+  std::vector<int> cpus;
+  for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+    if (CPU_ISSET(cpu, &cpuSet)) {
+      cpus.push_back(cpu);
+    }
+  }
+  return cpus;
+}
+}  // unnamed namespace
+
+TEST(testSetThreadAffinity, parseCpuList) {
+  EXPECT_TRUE(parseCpuList("").empty());
+  EXPECT_EQ(parseCpuList("3"), std::vector<int>({3}));
+  EXPECT_EQ(parseCpuList("0-3,8"), std::vector<int>({0, 1, 2, 3, 8}));
+  EXPECT_EQ(parseCpuList(" 10-11, 2,2 "), std::vector<int>({2, 10, 11}));
+  EXPECT_THROW(parseCpuList("a-b"), std::invalid_argument);
+}
+
+TEST(testSetThreadAffinity, getWorkerCpuSets) {
+  const auto workerCpus = getWorkerCpuSets("0-1", {"", "4"}, 3);
+  ASSERT_EQ(workerCpus.size(), 3);
+  EXPECT_EQ(workerCpus[0], std::vector<int>({0, 1}));
+  EXPECT_EQ(workerCpus[1], std::vector<int>({4}));
+  EXPECT_EQ(workerCpus[2], std::vector<int>({0, 1}));
+
+  const auto unpinned = getWorkerCpuSets("", {}, 2);
+  ASSERT_EQ(unpinned.size(), 2);
+  EXPECT_TRUE(unpinned[0].empty());
+  EXPECT_TRUE(unpinned[1].empty());
+}
+
+TEST(testSetThreadAffinity, threadPoolAffinity) {
+  const auto allowedCpus = getThisThreadCpus();
+  ASSERT_FALSE(allowedCpus.empty());
+  const std::vector<int> workerCpus{allowedCpus.front()};
+  const std::vector<int> callerCpus{allowedCpus.back()};
+
+  ThreadPool pool(1, 0, {workerCpus, callerCpus});
+  EXPECT_EQ(pool.getCpuAffinity(0), workerCpus);
+  EXPECT_EQ(pool.getCpuAffinity(1), callerCpus);
+
+  // the worker is pinned
+  EXPECT_EQ(pool.run([](int) { return getThisThreadCpus(); }).get(), workerCpus);
+
+  // the calling thread is pinned for the duration of runParallel and restored afterwards
+  std::vector<int> cpusInTask;
+  pool.runParallel([&](int) { cpusInTask = getThisThreadCpus(); }, 1);
+  EXPECT_EQ(cpusInTask, callerCpus);
+  EXPECT_EQ(getThisThreadCpus(), allowedCpus);
+
+  // same for parallelFor, without workers all indices run on the calling thread
+  ThreadPool callerOnlyPool(0, 0, {callerCpus});
+  cpusInTask.clear();
+  callerOnlyPool.parallelFor(0, 10, 1, [&](int, int) { cpusInTask = getThisThreadCpus(); });
+  EXPECT_EQ(cpusInTask, callerCpus);
+  EXPECT_EQ(getThisThreadCpus(), allowedCpus);
+}
+
+TEST(testSetThreadAffinity, scopedThisThreadAffinity) {
+  const auto allowedCpus = getThisThreadCpus();
+  ASSERT_FALSE(allowedCpus.empty());
+  {
+    ScopedThisThreadAffinity scopedAffinity({allowedCpus.back()});
+    EXPECT_EQ(getThisThreadCpus(), std::vector<int>({allowedCpus.back()}));
+  }
+  EXPECT_EQ(getThisThreadCpus(), allowedCpus);
+
+  {  // an empty set leaves the affinity unchanged
+    ScopedThisThreadAffinity scopedAffinity({});
+    EXPECT_EQ(getThisThreadCpus(), allowedCpus);
+  }
+}
+
+TEST(testSetThreadAffinity, runOnCpus) {
+  int value = 0;
+  runOnCpus({0}, [&] { value = 1; });
+  EXPECT_EQ(value, 1);
+
+  EXPECT_THROW(runOnCpus({0}, [] { throw std::runtime_error("exception"); }), std::runtime_error);
+}
@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 #include <ocs2_core/thread_support/ThreadPool.h>
 
+#include <numeric>
+
 using namespace ocs2;
 
 TEST(testThreadPool, testCanExecuteTask) {
@@ -121,3 +123,65 @@ TEST(testThreadPool, testMoveOnlyTask) {
 
   EXPECT_EQ(result.get(), 3.14);
 }
+
+TEST(testThreadPool, testParallelFor) {
+  ThreadPool pool(3);
+  constexpr int N = 1000;
+  std::vector<std::atomic_int> visits(N);
+  for (auto& v : visits) {
+    v = 0;
+  }
+
+  pool.parallelFor(0, N, 7, [&](int workerId, int i) {
+    EXPECT_GE(workerId, 0);
+    EXPECT_LE(workerId, pool.numThreads());
+    visits[i]++;
+  });
+
+  for (int i = 0; i < N; ++i) {
+    EXPECT_EQ(visits[i], 1) << "index " << i;
+  }
+}
+
+TEST(testThreadPool, testParallelForNoThreads) {
+  ThreadPool pool(0);
+  int sum = 0;
+
+  pool.parallelFor(10, 20, 1, [&](int workerId, int i) {
+    EXPECT_EQ(workerId, 0);
+    sum += i;
+  });
+
+  EXPECT_EQ(sum, 145);
+}
+
+TEST(testThreadPool, testParallelForRepeated) {
+  ThreadPool pool(4);
+  std::vector<int> perWorkerSum(pool.numThreads() + 1);
+
+  int expectedSum = 0;
+  for (int iter = 0; iter < 200; ++iter) {
+    const int N = iter % 13;
+    pool.parallelFor(0, N, 1, [&](int workerId, int i) { perWorkerSum[workerId] += i; });
+    expectedSum += N * (N - 1) / 2;
+  }
+
+  EXPECT_EQ(std::accumulate(perWorkerSum.begin(), perWorkerSum.end(), 0), expectedSum);
+}
+
+TEST(testThreadPool, testParallelForPropagateException) {
+  ThreadPool pool(2);
+
+  EXPECT_THROW(pool.parallelFor(0, 100, 1,
+                                [](int, int i) {
+                                  if (i == 42) {
+                                    throw std::string("exception");
+                                  }
+                                }),
+               std::string);
+
+  // pool is still usable
+  std::atomic_int counter{0};
+  pool.parallelFor(0, 100, 1, [&](int, int) { counter++; });
+  EXPECT_EQ(counter, 100);
+}
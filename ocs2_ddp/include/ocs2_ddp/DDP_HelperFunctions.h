@@ -127,6 +127,27 @@ scalar_t computeControllerUpdateIS(const LinearController& controller);
  */
 void incrementController(scalar_t stepLength, const LinearController& unoptimizedController, LinearController& controller);
 
+/**
+ * Computes the controller of a time step from the solution of the projected Riccati equation:
+ * gain = -CmProjected + Qu * projectedKm, bias = nominalInput - gain * nominalState, and deltaBias = -EvProjected + Qu * projectedLv.
+ * If the state and projected input dimensions are listed in fixed_size::supported_dimensions_t, the computation uses fixed-size Eigen
+ * types.
+ *
+ * @param [in] nominalState: The nominal state.
+ * @param [in] nominalInput: The nominal input.
+ * @param [in] EvProjected: The feedforward term of the state-input equality constraint projection.
+ * @param [in] CmProjected: The feedback term of the state-input equality constraint projection.
+ * @param [in] Qu: The projection matrix to the null space of the state-input equality constraints.
+ * @param [in] projectedKm: The projected feedback controller.
+ * @param [in] projectedLv: The projected feedforward controller.
+ * @param [out] gain: The feedback gain.
+ * @param [out] bias: The bias of the controller.
+ * @param [out] deltaBias: The update of the bias.
+ */
+void computeController(const vector_t& nominalState, const vector_t& nominalInput, const vector_t& EvProjected, const matrix_t& CmProjected,
+                       const matrix_t& Qu, const matrix_t& projectedKm, const vector_t& projectedLv, matrix_t& gain, vector_t& bias,
+                       vector_t& deltaBias);
+
 /**
  * Retrieve time and post event trajectories of the current partition from the entire time and post event trajectories.
  * The resulting time and event indics are normalized to start integration from back.
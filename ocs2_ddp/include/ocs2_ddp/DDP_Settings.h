@@ -30,6 +30,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #pragma once
 
 #include <string>
+#include <vector>
 
 #include <ocs2_core/Types.h>
 #include <ocs2_core/integration/Integrator.h>
@@ -68,6 +69,16 @@ struct Settings {
   size_t nThreads_ = 1;
   /** Priority of threads used in the multi-threading scheme. */
   int threadPriority_ = 99;
+  /** CPUs of the threads used in the multi-threading scheme in cpulist format, e.g. "0-3,8". Empty to not pin the threads. */
+  std::string threadAffinity_;
+  /** CPUs per worker index in cpulist format. A non-empty entry overrides threadAffinity_. */
+  std::vector<std::string> workerThreadAffinity_;
+  /**
+   * If true, the multi-threaded ILQR backward pass computes the value function at the partition boundaries from the current LQ
+   * approximation instead of interpolating the previous iteration's value function. It also allows the first iteration to run in parallel.
+   * Only the line search with the DIAGONAL_SHIFT Hessian correction is supported, the setting is ignored for the other strategies.
+   */
+  bool exactParallelRiccati_ = false;
 
   /** Maximum number of iterations of DDP. */
   size_t maxNumIterations_ = 15;
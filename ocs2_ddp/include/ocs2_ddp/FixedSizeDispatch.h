@@ -0,0 +1,151 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <memory>
+#include <tuple>
+
+#include <ocs2_core/Types.h>
+
+namespace ocs2 {
+namespace fixed_size {
+
+/** A pair of compile-time state and (projected) input dimensions. Eigen::Dynamic stands for the runtime-sized variant. */
+template <int NX, int NU>
+struct Dimensions {
+  static constexpr int stateDim = NX;
+  static constexpr int inputDim = NU;
+};
+
+/**
+ * The dimensions for which the DDP kernels are instantiated with fixed-size Eigen types. The input dimension refers to the dimension
+ * of the projected input, i.e. the input dimension minus the number of active state-input equality constraints. Extend this list to add
+ * a specialization for a new system.
+ *
+ * - 12/4: the quadrotor, which has no equality constraints.
+ * - 24/12 and 24/10: the legged robot in stance and with two legs in swing (e.g. trot). It has 24 inputs and 3 equality constraints per
+ *   stance leg and 4 per swing leg, thus 12 - (number of swing legs) projected inputs.
+ */
+using supported_dimensions_t = std::tuple<Dimensions<12, 4>, Dimensions<24, 12>, Dimensions<24, 10>>;
+
+/** A view of a runtime-sized matrix with compile-time dimensions. */
+template <int Rows, int Cols>
+using matrix_map_t = Eigen::Map<Eigen::Matrix<scalar_t, Rows, Cols>>;
+
+/** A constant view of a runtime-sized matrix with compile-time dimensions. */
+template <int Rows, int Cols>
+using const_matrix_map_t = Eigen::Map<const Eigen::Matrix<scalar_t, Rows, Cols>>;
+
+/**
+ * Views a runtime-sized matrix as a matrix with compile-time dimensions. The runtime size should match the compile-time one.
+ */
+template <int Rows, int Cols>
+const_matrix_map_t<Rows, Cols> view(const matrix_t& m) {
+  return const_matrix_map_t<Rows, Cols>(m.data(), m.rows(), m.cols());
+}
+
+/**
+ * Views a runtime-sized vector as a vector with compile-time dimension. The runtime size should match the compile-time one.
+ */
+template <int Rows>
+const_matrix_map_t<Rows, 1> view(const vector_t& v) {
+  return const_matrix_map_t<Rows, 1>(v.data(), v.size(), 1);
+}
+
+/**
+ * Resizes a matrix and views it as a matrix with compile-time dimensions.
+ */
+template <int Rows, int Cols>
+matrix_map_t<Rows, Cols> resizeAndView(matrix_t& m, Eigen::Index rows, Eigen::Index cols) {
+  m.resize(rows, cols);
+  return matrix_map_t<Rows, Cols>(m.data(), rows, cols);
+}
+
+/**
+ * Resizes a vector and views it as a vector with compile-time dimension.
+ */
+template <int Rows>
+matrix_map_t<Rows, 1> resizeAndView(vector_t& v, Eigen::Index rows) {
+  v.resize(rows);
+  return matrix_map_t<Rows, 1>(v.data(), rows, 1);
+}
+
+/**
+ * Holds a Workspace<NX, NU> for each of the supported dimensions. The workspaces are allocated on the heap at their first use, since a
+ * fixed-size workspace of the larger systems takes several kilobytes.
+ */
+template <template <int, int> class Workspace, typename DimensionsList = supported_dimensions_t>
+class WorkspaceCache;
+
+template <template <int, int> class Workspace, typename... Dims>
+class WorkspaceCache<Workspace, std::tuple<Dims...>> {
+ public:
+  /** Gets the workspace of the given Dimensions. */
+  template <typename D>
+  Workspace<D::stateDim, D::inputDim>& get(D /* dimensions */) {
+    auto& workspacePtr = std::get<std::unique_ptr<Workspace<D::stateDim, D::inputDim>>>(workspacePtrs_);
+    if (workspacePtr == nullptr) {
+      workspacePtr.reset(new Workspace<D::stateDim, D::inputDim>());
+    }
+    return *workspacePtr;
+  }
+
+ private:
+  std::tuple<std::unique_ptr<Workspace<Dims::stateDim, Dims::inputDim>>...> workspacePtrs_;
+};
+
+namespace detail {
+template <typename Function, typename... Dims>
+bool dispatch(int stateDim, int inputDim, Function& function, std::tuple<Dims...>* /* list of dimensions */) {
+  return ((stateDim == Dims::stateDim && inputDim == Dims::inputDim ? (function(Dims{}), true) : false) || ...);
+}
+}  // namespace detail
+
+/**
+ * Calls function with the supported fixed-size Dimensions that match the runtime dimensions, e.g.
+ *
+ *   const bool isDispatched = fixed_size::dispatch(nx, nu, [&](auto dims) {
+ *     using dims_t = decltype(dims);
+ *     kernel<dims_t::stateDim, dims_t::inputDim>(...);
+ *   });
+ *
+ * @param [in] stateDim: The runtime state dimension.
+ * @param [in] inputDim: The runtime (projected) input dimension.
+ * @param [in] function: A callable taking a Dimensions object.
+ * @return Whether a matching fixed-size specialization exists. If false, function is not called and the caller should fall back to its
+ * dynamic-size implementation.
+ */
+template <typename Function>
+bool dispatch(int stateDim, int inputDim, Function&& function) {
+  return detail::dispatch(stateDim, inputDim, function, static_cast<supported_dimensions_t*>(nullptr));
+}
+
+}  // namespace fixed_size
+}  // namespace ocs2
@@ -33,6 +33,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/control/LinearController.h>
 #include <ocs2_core/dynamics/SystemDynamicsBase.h>
 #include <ocs2_core/initialization/Initializer.h>
+#include <ocs2_core/misc/AllocationTracking.h>
 #include <ocs2_core/misc/Benchmark.h>
 #include <ocs2_core/misc/LinearInterpolation.h>
 #include <ocs2_core/misc/Numerics.h>
@@ -125,6 +126,19 @@ class GaussNewtonDDP : public SolverBase {
     threadPool_.runParallel([&](int) { taskFunction(); }, N);
   }
 
+  /**
+   * Helper to run taskFunction(workerIndex, i) for every index i in [begin, end) in parallel (blocking). The indices are distributed
+   * over the threads by work-stealing, workerIndex is in [0, nThreads-1] and can be used to index the worker specific resources.
+   *
+   * @param [in] begin: first index.
+   * @param [in] end: one past the last index.
+   * @param [in] taskFunction: task function with signature void(size_t workerIndex, int i).
+   */
+  template <typename Functor>
+  void parallelFor(int begin, int end, Functor&& taskFunction) {
+    threadPool_.parallelFor(begin, end, 1, std::forward<Functor>(taskFunction));
+  }
+
   /**
    * Takes the following steps: (1) Computes the Hessian of the Hamiltonian (i.e., Hm) (2) Based on Hm, it calculates
    * the range space and the null space projections of the input-state equality constraints. (3) Based on these two
@@ -193,6 +207,17 @@ class GaussNewtonDDP : public SolverBase {
   virtual void riccatiEquationsWorker(size_t workerIndex, const std::pair<int, int>& partitionInterval,
                                       const ScalarFunctionQuadraticApproximation& finalValueFunction) = 0;
 
+  /**
+   * Computes the final value function of each partition of the parallel Riccati backward pass. The default implementation interpolates
+   * the value function of the previous iteration, therefore it is not available in the first iteration.
+   *
+   * @param [in] partitionIntervals: The partitions of the time trajectory in the form of [first, last).
+   * @param [in,out] finalValueFunctionOfEachPartition: The final value function of each partition. The last element should be set.
+   * @return Whether the final value functions are computed. If false, the Riccati equations are solved sequentially.
+   */
+  virtual bool computePartitionFinalValueFunctions(const std::vector<std::pair<int, int>>& partitionIntervals,
+                                                   std::vector<ScalarFunctionQuadraticApproximation>& finalValueFunctionOfEachPartition);
+
  private:
   /**
    * Get the State Input Equality Constraint Lagrangian Impl object
@@ -351,7 +376,6 @@ class GaussNewtonDDP : public SolverBase {
 
   // multi-threading helper variables
   std::atomic_size_t nextTaskId_{0};
-  std::atomic_size_t nextTimeIndex_{0};
 
   scalar_t initTime_ = 0.0;
   scalar_t finalTime_ = 0.0;
@@ -400,6 +424,12 @@ class GaussNewtonDDP : public SolverBase {
   benchmark::RepeatedTimer computeControllerTimer_;
   benchmark::RepeatedTimer searchStrategyTimer_;
   benchmark::RepeatedTimer totalDualSolutionTimer_;
+
+  // allocation tracking, all iterations but the first of a run are expected not to allocate
+  allocation::PhaseAllocationCounter linearQuadraticApproximationAllocations_{"LQ Approximation"};
+  allocation::PhaseAllocationCounter backwardPassAllocations_{"Backward Pass"};
+  allocation::PhaseAllocationCounter computeControllerAllocations_{"Compute Controller"};
+  allocation::PhaseAllocationCounter primalDualStepAllocations_{"Primal-Dual Step"};
 };
 
 }  // namespace ocs2
@@ -34,6 +34,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "GaussNewtonDDP.h"
 #include "riccati_equations/DiscreteTimeRiccatiEquations.h"
+#include "riccati_equations/RiccatiSegment.h"
 
 namespace ocs2 {
 
@@ -64,6 +65,9 @@ class ILQR : public GaussNewtonDDP {
   void riccatiEquationsWorker(size_t workerIndex, const std::pair<int, int>& partitionInterval,
                               const ScalarFunctionQuadraticApproximation& finalValueFunction) override;
 
+  bool computePartitionFinalValueFunctions(const std::vector<std::pair<int, int>>& partitionIntervals,
+                                           std::vector<ScalarFunctionQuadraticApproximation>& finalValueFunctionOfEachPartition) override;
+
   void calculateControllerWorker(size_t timeIndex, const PrimalDataContainer& primalData, const DualDataContainer& dualData,
                                  LinearController& dstController) override;
 
@@ -85,6 +89,17 @@ class ILQR : public GaussNewtonDDP {
   void discreteLQWorker(SystemDynamicsBase& system, scalar_t time, const vector_t& state, const vector_t& input, scalar_t timeStep,
                         const ModelData& continuousTimeModelData, ModelData& modelData);
 
+  /**
+   * Condenses the LQ approximation of a partition to a single Riccati segment which maps the value function at the end of the partition
+   * to its start. The nodes are projected with the value-function-independent Hamiltonian Hessian. The result is exact if the Riccati
+   * modification does not depend on the value function, i.e. for the line search with the diagonal shift of the Hessian, which only
+   * adds the constant deltaQm.
+   *
+   * @param [in] partitionInterval: The partition in the form of [first, last).
+   * @return The Riccati segment of the partition.
+   */
+  RiccatiSegment computePartitionRiccatiSegment(const std::pair<int, int>& partitionInterval) const;
+
   /****************
    *** Variables **
    ****************/
@@ -93,6 +108,7 @@ class ILQR : public GaussNewtonDDP {
 
   DynamicsSensitivityDiscretizer sensitivityDiscretizer_;
   std::vector<std::unique_ptr<DiscreteTimeRiccatiEquations>> riccatiEquationsPtrStock_;
+  bool isParallelRiccatiExact_ = false;  // ddp::Settings::exactParallelRiccati_ for a modification that the segments reproduce
 };
 
 }  // namespace ocs2
@@ -92,6 +92,9 @@ class SLQ final : public GaussNewtonDDP {
   /****************
    *** Variables **
    ****************/
+  matrix_array_t projectedKmTrajectoryStock_;  // projected feedback
+  vector_array_t projectedLvTrajectoryStock_;  // projected feedforward
+
   std::vector<std::shared_ptr<ContinuousTimeRiccatiEquations>> riccatiEquationsPtrStock_;
   std::vector<std::unique_ptr<IntegratorBase>> riccatiIntegratorPtrStock_;
   vector_array2_t allSsTrajectoryStock_;
@@ -35,27 +35,34 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/Types.h>
 #include <ocs2_core/model_data/ModelData.h>
 
+#include "ocs2_ddp/FixedSizeDispatch.h"
 #include "ocs2_ddp/riccati_equations/RiccatiModification.h"
 
 namespace ocs2 {
 
 /**
- * Data cache for discrete-time Riccati equation
+ * Workspace of the discrete-time Riccati equation. NX and NU are the compile-time state and projected input dimensions or Eigen::Dynamic.
  */
-struct DiscreteTimeRiccatiData {
-  vector_t Sm_projectedHv_;
-  matrix_t Sm_projectedAm_;
-  matrix_t Sm_projectedBm_;
-  vector_t Sv_plus_Sm_projectedHv_;
-
-  matrix_t projectedHm_;
-  matrix_t projectedGm_;
-  vector_t projectedGv_;
-
-  matrix_t projectedKm_T_projectedGm_;
-  matrix_t projectedHm_projectedKm_;
-  vector_t projectedHm_projectedLv_;
+template <int NX, int NU>
+struct DiscreteTimeRiccatiWorkspace {
+  Eigen::Matrix<scalar_t, NX, 1> Sm_projectedHv_;
+  Eigen::Matrix<scalar_t, NX, NX> Sm_projectedAm_;
+  Eigen::Matrix<scalar_t, NX, NU> Sm_projectedBm_;
+  Eigen::Matrix<scalar_t, NX, 1> Sv_plus_Sm_projectedHv_;
+
+  Eigen::Matrix<scalar_t, NU, NU> projectedHm_;
+  Eigen::Matrix<scalar_t, NU, NX> projectedGm_;
+  Eigen::Matrix<scalar_t, NU, 1> projectedGv_;
+
+  Eigen::Matrix<scalar_t, NX, NX> projectedKm_T_projectedGm_;
+  Eigen::Matrix<scalar_t, NU, NX> projectedHm_projectedKm_;
+  Eigen::Matrix<scalar_t, NU, 1> projectedHm_projectedLv_;
+};
 
+/**
+ * Data cache for discrete-time Riccati equation
+ */
+struct DiscreteTimeRiccatiData : public DiscreteTimeRiccatiWorkspace<Eigen::Dynamic, Eigen::Dynamic> {
   // risk sensitive data
   vector_t Sigma_Sv_;
   matrix_t I_minus_Sm_Sigma_;
@@ -109,7 +116,8 @@ class DiscreteTimeRiccatiEquations {
 
  private:
   /**
-   * Computes one step Riccati difference equations for ILQR formulation.
+   * Computes one step Riccati difference equations for ILQR formulation. The computation is carried out on views with compile-time
+   * dimensions NX and NU, which should either match the runtime dimensions or be Eigen::Dynamic.
    *
    * @param [in] projectedModelData: The projected model data.
    * @param [in] riccatiModification: The RiccatiModification.
@@ -123,9 +131,10 @@ class DiscreteTimeRiccatiEquations {
    * @param [out] Sv: The current Riccati vector.
    * @param [out] s: The current Riccati scalar.
    */
+  template <int NX, int NU>
   void computeMapILQR(const ModelData& projectedModelData, const riccati_modification::Data& riccatiModification, const matrix_t& SmNext,
-                      const vector_t& SvNext, const scalar_t& sNext, DiscreteTimeRiccatiData& dreCache, matrix_t& projectedKm,
-                      vector_t& projectedLv, matrix_t& Sm, vector_t& Sv, scalar_t& s) const;
+                      const vector_t& SvNext, const scalar_t& sNext, DiscreteTimeRiccatiWorkspace<NX, NU>& dreCache,
+                      matrix_t& projectedKm, vector_t& projectedLv, matrix_t& Sm, vector_t& Sv, scalar_t& s) const;
 
   /**
    * Computes one step Riccati difference equations for ILEG formulation.
@@ -152,6 +161,7 @@ class DiscreteTimeRiccatiEquations {
   scalar_t riskSensitiveCoeff_ = 0.0;
 
   DiscreteTimeRiccatiData discreteTimeRiccatiData_;
+  fixed_size::WorkspaceCache<DiscreteTimeRiccatiWorkspace> fixedSizeRiccatiWorkspaces_;
 };
 
 }  // namespace ocs2
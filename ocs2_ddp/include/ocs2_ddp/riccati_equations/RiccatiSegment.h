@@ -0,0 +1,99 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <ocs2_core/Types.h>
+#include <ocs2_core/model_data/ModelData.h>
+
+#include "ocs2_ddp/riccati_equations/RiccatiModification.h"
+
+namespace ocs2 {
+
+/**
+ * The conditional value function of a discrete-time LQ segment [i, j]. It is the minimum cost of steering the state from x_i to x_j
+ * through the segment, expressed in its dual form
+ *
+ * V(x_i, x_j) = max_lambda { 0.5 x_i' J x_i + eta' x_i + c + lambda' (x_j - A x_i - b) - 0.5 lambda' C lambda }.
+ *
+ * Consecutive segments are combined with an associative operator, which allows the Riccati backward pass of a long horizon to be
+ * computed as independent pieces that are later stitched together.
+ */
+struct RiccatiSegment {
+  matrix_t A;
+  vector_t b;
+  matrix_t C;
+  matrix_t J;
+  vector_t eta;
+  scalar_t c = 0.0;
+};
+
+/**
+ * Returns the segment of zero length, the neutral element of combineRiccatiSegments.
+ *
+ * @param [in] stateDim: The state dimension.
+ */
+RiccatiSegment identityRiccatiSegment(size_t stateDim);
+
+/**
+ * Constructs the segment of a single intermediate time step from its projected LQ approximation. The cost cross term is eliminated
+ * with the inverse of the projected input Hessian, therefore the projection should not be normalized by the value function.
+ *
+ * @param [in] projectedModelData: The projected discrete-time LQ approximation.
+ * @param [in] riccatiModification: The Riccati modification terms. Only deltaQm is taken into account.
+ */
+RiccatiSegment stageRiccatiSegment(const ModelData& projectedModelData, const riccati_modification::Data& riccatiModification);
+
+/**
+ * Constructs the segment of an event, i.e. the input-free jump map from the pre-event to the post-event state.
+ *
+ * @param [in] jumpModelData: The LQ approximation of the jump map and the pre-jump cost.
+ */
+RiccatiSegment eventRiccatiSegment(const ModelData& jumpModelData);
+
+/**
+ * Combines two consecutive segments [i, j] and [j, k] to the segment [i, k].
+ *
+ * @param [in] first: The earlier segment [i, j].
+ * @param [in] second: The later segment [j, k].
+ * @return The segment [i, k].
+ */
+RiccatiSegment combineRiccatiSegments(const RiccatiSegment& first, const RiccatiSegment& second);
+
+/**
+ * Propagates the value function at the end of the segment to its start.
+ *
+ * @param [in] segment: The segment [i, j].
+ * @param [in] valueFunction: The value function at j.
+ * @return The value function at i.
+ */
+ScalarFunctionQuadraticApproximation applyRiccatiSegment(const RiccatiSegment& segment,
+                                                         const ScalarFunctionQuadraticApproximation& valueFunction);
+
+}  // namespace ocs2
@@ -29,7 +29,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <atomic>
+#include <condition_variable>
 #include <functional>
+#include <mutex>
 #include <utility>
 #include <vector>
 
@@ -48,6 +51,10 @@ namespace ocs2 {
 /**
  * Line search strategy: The class computes the nominal controller and the nominal trajectories as well the corresponding performance
  * indices. It line-searches on the feedforward parts of the controller and chooses the largest acceptable step-size.
+ *
+ * The step lengths are evaluated in parallel. The first batch is evaluated speculatively while the rollout of the zero step length
+ * (the baseline of the Armijo condition) is running. As soon as a step length is accepted, the evaluations of the smaller step lengths
+ * are cancelled.
  */
 class LineSearchStrategy final : public SearchStrategyBase {
  public:
@@ -96,8 +103,22 @@ class LineSearchStrategy final : public SearchStrategyBase {
   /** number of line search iterations (the if statements order is important) */
   size_t maxNumOfSearches() const;
 
-  /** Computes the solution on a thread and a given stepLength  */
-  void computeSolution(size_t taskId, scalar_t stepLength, search_strategy::Solution& solution);
+  /**
+   * Computes the solution on a thread and a given stepLength. The computation is cancelled as soon as a larger step length is accepted.
+   *
+   * @return false if the computation is cancelled.
+   */
+  bool computeSolution(size_t taskId, scalar_t stepLength, search_strategy::Solution& solution);
+
+  /**
+   * Computes the solution for the zero step length and records it as the baseline of the line search.
+   *
+   * @return false if the rollout of the unoptimized controller fails.
+   */
+  bool baselineTask(const size_t taskId);
+
+  /** Aborts the rollouts of the other threads which are evaluating a step length smaller than the given one. */
+  void cancelSmallerStepLengths(const size_t taskId, scalar_t stepLength);
 
   /**
    * Defines line search task on a thread with various learning rates and choose the largest acceptable step-size.
@@ -130,7 +151,13 @@ class LineSearchStrategy final : public SearchStrategyBase {
   std::atomic_size_t nextTaskId_{0};
   std::atomic_size_t alphaExpNext_{0};
   std::vector<bool> alphaProcessed_;
+  std::vector<std::atomic<scalar_t>> workersStepLength_;  // the step length under evaluation on each thread
   std::mutex lineSearchResultMutex_;
+
+  // baseline, guarded by lineSearchResultMutex_
+  enum class BaselineStatus { Pending, Ready, Failed };
+  BaselineStatus baselineStatus_ = BaselineStatus::Pending;
+  std::condition_variable baselineReadyCondition_;
   mutable std::mutex outputDisplayGuardMutex_;
 };
 
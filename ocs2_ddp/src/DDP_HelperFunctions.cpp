@@ -38,6 +38,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_oc/approximate_model/ChangeOfInputVariables.h>
 #include <ocs2_oc/approximate_model/LinearQuadraticApproximator.h>
 
+#include "ocs2_ddp/FixedSizeDispatch.h"
+
 namespace ocs2 {
 
 namespace {
@@ -56,6 +58,27 @@ void copySegment(const LinearInterpolation::index_alpha_t& indexAlpha0, const Li
     outputTrajectory.back() = LinearInterpolation::interpolate(indexAlpha1, inputTrajectory);
   }
 }
+
+/** Computes the controller of a time step on views with compile-time state (NX) and projected input (NP) dimensions. */
+template <int NX, int NP>
+void computeControllerImpl(const vector_t& nominalState, const vector_t& nominalInput, const vector_t& EvProjected,
+                           const matrix_t& CmProjected, const matrix_t& Qu, const matrix_t& projectedKm, const vector_t& projectedLv,
+                           matrix_t& gain, vector_t& bias, vector_t& deltaBias) {
+  const auto nu = nominalInput.size();
+  const auto nx = nominalState.size();
+  auto gainView = fixed_size::resizeAndView<Eigen::Dynamic, NX>(gain, nu, nx);
+  const auto QuView = fixed_size::view<Eigen::Dynamic, NP>(Qu);
+
+  // feedback gains
+  gainView = -fixed_size::view<Eigen::Dynamic, NX>(CmProjected);
+  gainView.noalias() += QuView * fixed_size::view<NP, NX>(projectedKm);
+
+  // bias input
+  bias = nominalInput;
+  bias.noalias() -= gainView * fixed_size::view<NX>(nominalState);
+  deltaBias = -EvProjected;
+  deltaBias.noalias() += QuView * fixed_size::view<NP>(projectedLv);
+}
 }  // unnamed namespace
 
 /******************************************************************************************************/
@@ -303,6 +326,24 @@ void incrementController(scalar_t stepLength, const LinearController& unoptimize
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void computeController(const vector_t& nominalState, const vector_t& nominalInput, const vector_t& EvProjected, const matrix_t& CmProjected,
+                       const matrix_t& Qu, const matrix_t& projectedKm, const vector_t& projectedLv, matrix_t& gain, vector_t& bias,
+                       vector_t& deltaBias) {
+  auto computeControllerForDimensions = [&](auto dims) {
+    using dims_t = decltype(dims);
+    computeControllerImpl<dims_t::stateDim, dims_t::inputDim>(nominalState, nominalInput, EvProjected, CmProjected, Qu, projectedKm,
+                                                              projectedLv, gain, bias, deltaBias);
+  };
+
+  // fixed-size kernel if the dimensions are supported, otherwise the dynamic-size one
+  if (!fixed_size::dispatch(nominalState.size(), Qu.cols(), computeControllerForDimensions)) {
+    computeControllerForDimensions(fixed_size::Dimensions<Eigen::Dynamic, Eigen::Dynamic>{});
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
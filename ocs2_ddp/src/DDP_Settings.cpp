@@ -69,6 +69,9 @@ Settings loadSettings(const std::string& filename, const std::string& fieldName,
 
   loadData::loadPtreeValue(pt, settings.nThreads_, fieldName + ".nThreads", verbose);
   loadData::loadPtreeValue(pt, settings.threadPriority_, fieldName + ".threadPriority", verbose);
+  loadData::loadPtreeValue(pt, settings.threadAffinity_, fieldName + ".threadAffinity", verbose);
+  loadData::loadStdVector(filename, fieldName + ".workerThreadAffinity", settings.workerThreadAffinity_, verbose);
+  loadData::loadPtreeValue(pt, settings.exactParallelRiccati_, fieldName + ".exactParallelRiccati", verbose);
 
   loadData::loadPtreeValue(pt, settings.maxNumIterations_, fieldName + ".maxNumIterations", verbose);
   loadData::loadPtreeValue(pt, settings.minRelCost_, fieldName + ".minRelCost", verbose);
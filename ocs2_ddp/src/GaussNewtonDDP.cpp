@@ -35,6 +35,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/control/FeedforwardController.h>
 #include <ocs2_core/integration/TrapezoidalIntegration.h>
 #include <ocs2_core/misc/LinearAlgebra.h>
+#include <ocs2_core/misc/Trace.h>
+#include <ocs2_core/thread_support/SetThreadAffinity.h>
 
 #include <ocs2_oc/oc_problem/OptimalControlProblemHelperFunction.h>
 #include <ocs2_oc/rollout/InitializerRollout.h>
@@ -53,7 +55,9 @@ namespace ocs2 {
 /******************************************************************************************************/
 GaussNewtonDDP::GaussNewtonDDP(ddp::Settings ddpSettings, const RolloutBase& rollout, const OptimalControlProblem& optimalControlProblem,
                                const Initializer& initializer)
-    : ddpSettings_(std::move(ddpSettings)), threadPool_(std::max(ddpSettings_.nThreads_, size_t(1)) - 1, ddpSettings_.threadPriority_) {
+    : ddpSettings_(std::move(ddpSettings)),
+      threadPool_(std::max(ddpSettings_.nThreads_, size_t(1)) - 1, ddpSettings_.threadPriority_,
+                  getWorkerCpuSets(ddpSettings_.threadAffinity_, ddpSettings_.workerThreadAffinity_, ddpSettings_.nThreads_)) {
   Eigen::setNbThreads(1);  // no multithreading within Eigen.
   Eigen::initParallel();
 
@@ -77,12 +81,15 @@ GaussNewtonDDP::GaussNewtonDDP(ddp::Settings ddpSettings, const RolloutBase& rol
   // initializer Rollout
   initializerRolloutPtr_.reset(new InitializerRollout(initializer, rollout.settings()));
 
-  // initialize rollout and OCP instances for multi-thread compuation
+  // initialize rollout and OCP instances for multi-thread compuation. The copies are created on the CPUs of the worker such that they
+  // are allocated on its NUMA node (first-touch).
   optimalControlProblemStock_.reserve(ddpSettings_.nThreads_);
   dynamicsForwardRolloutPtrStock_.reserve(ddpSettings_.nThreads_);
   for (size_t i = 0; i < ddpSettings_.nThreads_; i++) {
-    optimalControlProblemStock_.push_back(optimalControlProblem);
-    dynamicsForwardRolloutPtrStock_.emplace_back(rollout.clone());
+    runOnCpus(threadPool_.getCpuAffinity(i), [&] {
+      optimalControlProblemStock_.push_back(optimalControlProblem);
+      dynamicsForwardRolloutPtrStock_.emplace_back(rollout.clone());
+    });
   }  // end of i loop
 
   // search strategy method
@@ -162,6 +169,13 @@ std::string GaussNewtonDDP::getBenchmarkingInfo() const {
                << searchStrategyTotal / benchmarkTotal * 100 << "%)\n";
     infoStream << "\tDual Solution      :\t" << totalDualSolutionTimer_.getAverageInMilliseconds() << " [ms] \t\t("
                << dualSolutionTotal / benchmarkTotal * 100 << "%)\n\n";
+    if (allocation::isTrackingEnabled()) {
+      infoStream << "DDP Allocations per iteration:\n";
+      infoStream << "\t" << linearQuadraticApproximationAllocations_ << "\n";
+      infoStream << "\t" << backwardPassAllocations_ << "\n";
+      infoStream << "\t" << computeControllerAllocations_ << "\n";
+      infoStream << "\t" << primalDualStepAllocations_ << "\n\n";
+    }
   }
   return infoStream.str();
 }
@@ -197,6 +211,10 @@ void GaussNewtonDDP::reset() {
   computeControllerTimer_.reset();
   searchStrategyTimer_.reset();
   totalDualSolutionTimer_.reset();
+  linearQuadraticApproximationAllocations_.reset();
+  backwardPassAllocations_.reset();
+  computeControllerAllocations_.reset();
+  primalDualStepAllocations_.reset();
 }
 
 /******************************************************************************************************/
@@ -514,6 +532,7 @@ scalar_t GaussNewtonDDP::calculateRolloutMerit(const PerformanceIndex& performan
 /******************************************************************************************************/
 /******************************************************************************************************/
 scalar_t GaussNewtonDDP::solveSequentialRiccatiEquationsImpl(const ScalarFunctionQuadraticApproximation& finalValueFunction) {
+  OCS2_TRACE_ZONE("GaussNewtonDDP::solveRiccatiEquations");
   // pre-allocate memory for dual solution
   const size_t outputN = nominalPrimalData_.primalSolution.timeTrajectory_.size();
   nominalDualData_.valueFunctionTrajectory.clear();
@@ -525,24 +544,18 @@ scalar_t GaussNewtonDDP::solveSequentialRiccatiEquationsImpl(const ScalarFunctio
   // [first1,last1), [first2(last1), last2).
   nominalDualData_.valueFunctionTrajectory.back() = finalValueFunction;
 
-  // solve it sequentially for the first iteration
-  if (totalNumIterations_ == 0) {
+  // do equal-time partitions based on available thread resource
+  const auto partitionIntervals = computePartitionIntervals(nominalPrimalData_.primalSolution.timeTrajectory_, ddpSettings_.nThreads_);
+
+  // hold the final value function of each partition
+  std::vector<ScalarFunctionQuadraticApproximation> finalValueFunctionOfEachPartition(partitionIntervals.size());
+  finalValueFunctionOfEachPartition.back() = finalValueFunction;
+
+  if (!computePartitionFinalValueFunctions(partitionIntervals, finalValueFunctionOfEachPartition)) {
+    // solve it sequentially, e.g. for the first iteration
     const std::pair<int, int> partitionInterval{0, outputN - 1};
     riccatiEquationsWorker(0, partitionInterval, finalValueFunction);
   } else {  // solve it in parallel
-    // do equal-time partitions based on available thread resource
-    const auto partitionIntervals = computePartitionIntervals(nominalPrimalData_.primalSolution.timeTrajectory_, ddpSettings_.nThreads_);
-
-    // hold the final value function of each partition
-    std::vector<ScalarFunctionQuadraticApproximation> finalValueFunctionOfEachPartition(partitionIntervals.size());
-    finalValueFunctionOfEachPartition.back() = finalValueFunction;
-    for (size_t i = 0; i < partitionIntervals.size() - 1; i++) {
-      const int startIndexOfNextPartition = partitionIntervals[i + 1].first;
-      const vector_t& xFinalUpdated = nominalPrimalData_.primalSolution.stateTrajectory_[startIndexOfNextPartition];
-      finalValueFunctionOfEachPartition[i] =
-          getValueFunctionFromCache(nominalPrimalData_.primalSolution.timeTrajectory_[startIndexOfNextPartition], xFinalUpdated);
-    }  // end of loop
-
     nextTaskId_ = 0;
     auto task = [this, &partitionIntervals, &finalValueFunctionOfEachPartition]() {
       const size_t taskId = nextTaskId_++;  // assign task ID (atomic)
@@ -582,27 +595,44 @@ scalar_t GaussNewtonDDP::solveSequentialRiccatiEquationsImpl(const ScalarFunctio
   return (finalTime_ - initTime_) / static_cast<scalar_t>(outputN);
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool GaussNewtonDDP::computePartitionFinalValueFunctions(
+    const std::vector<std::pair<int, int>>& partitionIntervals,
+    std::vector<ScalarFunctionQuadraticApproximation>& finalValueFunctionOfEachPartition) {
+  // the value function of the previous iteration is not available
+  if (totalNumIterations_ == 0) {
+    return false;
+  }
+
+  for (size_t i = 0; i < partitionIntervals.size() - 1; i++) {
+    const int startIndexOfNextPartition = partitionIntervals[i + 1].first;
+    const vector_t& xFinalUpdated = nominalPrimalData_.primalSolution.stateTrajectory_[startIndexOfNextPartition];
+    finalValueFunctionOfEachPartition[i] =
+        getValueFunctionFromCache(nominalPrimalData_.primalSolution.timeTrajectory_[startIndexOfNextPartition], xFinalUpdated);
+  }  // end of loop
+
+  return true;
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 void GaussNewtonDDP::calculateController() {
+  OCS2_TRACE_ZONE("GaussNewtonDDP::calculateController");
   const size_t N = nominalPrimalData_.primalSolution.timeTrajectory_.size();
 
-  unoptimizedController_.clear();
+  // the arrays are resized rather than cleared, such that the memory of the gains and biases is reused over the iterations
   unoptimizedController_.timeStamp_ = nominalPrimalData_.primalSolution.timeTrajectory_;
   unoptimizedController_.gainArray_.resize(N);
   unoptimizedController_.biasArray_.resize(N);
   unoptimizedController_.deltaBiasArray_.resize(N);
 
-  nextTimeIndex_ = 0;
-  auto task = [this, N] {
-    int timeIndex;
-    // get next time index (atomic)
-    while ((timeIndex = nextTimeIndex_++) < N) {
-      calculateControllerWorker(timeIndex, nominalPrimalData_, nominalDualData_, unoptimizedController_);
-    }
+  auto task = [this](size_t, int timeIndex) {
+    calculateControllerWorker(timeIndex, nominalPrimalData_, nominalDualData_, unoptimizedController_);
   };
-  runParallel(task, ddpSettings_.nThreads_);
+  parallelFor(0, static_cast<int>(N), task);
 
   // Since the controller for the last timestamp is invalid, if the last time is not the event time, use the control policy of the second to
   // last time for the last time
@@ -620,14 +650,16 @@ void GaussNewtonDDP::calculateController() {
   // checking the numerical stability of the controller parameters
   if (settings().checkNumericalStability_) {
     for (int timeIndex = 0; timeIndex < unoptimizedController_.size(); timeIndex++) {
-      std::stringstream errorDescription;
-      if (!unoptimizedController_.gainArray_[timeIndex].allFinite()) {
-        errorDescription << "Feedback gains are unstable!\n";
-      }
-      if (!unoptimizedController_.deltaBiasArray_[timeIndex].allFinite()) {
-        errorDescription << "Feedforward control is unstable!\n";
-      }
-      if (errorDescription.tellp() != 0) {
+      const bool gainIsFinite = unoptimizedController_.gainArray_[timeIndex].allFinite();
+      const bool deltaBiasIsFinite = unoptimizedController_.deltaBiasArray_[timeIndex].allFinite();
+      if (!gainIsFinite || !deltaBiasIsFinite) {
+        std::stringstream errorDescription;
+        if (!gainIsFinite) {
+          errorDescription << "Feedback gains are unstable!\n";
+        }
+        if (!deltaBiasIsFinite) {
+          errorDescription << "Feedforward control is unstable!\n";
+        }
         std::stringstream errorMessage;
         errorMessage << "At time " << unoptimizedController_.timeStamp_[timeIndex] << " [sec].\n" << errorDescription.str();
         throw std::runtime_error(errorMessage.str());
@@ -645,6 +677,7 @@ void GaussNewtonDDP::calculateController() {
 /******************************************************************************************************/
 /******************************************************************************************************/
 void GaussNewtonDDP::approximateOptimalControlProblem() {
+  OCS2_TRACE_ZONE("GaussNewtonDDP::approximateOptimalControlProblem");
   /*
    * compute and augment the LQ approximation of intermediate times
    */
@@ -659,46 +692,38 @@ void GaussNewtonDDP::approximateOptimalControlProblem() {
   nominalPrimalData_.modelDataEventTimes.clear();
   nominalPrimalData_.modelDataEventTimes.resize(NE);
   if (NE > 0) {
-    nextTimeIndex_ = 0;
-    nextTaskId_ = 0;
-    auto task = [this, NE]() {
-      const size_t taskId = nextTaskId_++;  // assign task ID (atomic)
-
-      // timeIndex is atomic
-      int timeIndex;
-      while ((timeIndex = nextTimeIndex_++) < NE) {
-        ModelData& modelData = nominalPrimalData_.modelDataEventTimes[timeIndex];
-        const size_t preEventIndex = nominalPrimalData_.primalSolution.postEventIndices_[timeIndex] - 1;
-        const auto& time = nominalPrimalData_.primalSolution.timeTrajectory_[preEventIndex];
-        const auto& state = nominalPrimalData_.primalSolution.stateTrajectory_[preEventIndex];
-        const auto& multiplier = nominalDualData_.dualSolution.preJumps[timeIndex];
-
-        // approximate LQ for the pre-event node
-        ocs2::approximatePreJumpLQ(optimalControlProblemStock_[taskId], time, state, multiplier, modelData);
-
-        // checking the numerical properties
-        if (ddpSettings_.checkNumericalStability_) {
-          const auto errSize = checkSize(modelData, state.rows(), 0);
-          if (!errSize.empty()) {
-            throw std::runtime_error("[GaussNewtonDDP::approximateOptimalControlProblem] Mismatch in dimensions at intermediate time: " +
-                                     std::to_string(time) + "\n" + errSize);
-          }
-          const std::string errProperties =
-              checkDynamicsProperties(modelData) + checkCostProperties(modelData) + checkConstraintProperties(modelData);
-          if (!errProperties.empty()) {
-            throw std::runtime_error("[GaussNewtonDDP::approximateOptimalControlProblem] Ill-posed problem at event time: " +
-                                     std::to_string(time) + "\n" + errProperties);
-          }
+    auto task = [this](size_t taskId, int timeIndex) {
+      ModelData& modelData = nominalPrimalData_.modelDataEventTimes[timeIndex];
+      const size_t preEventIndex = nominalPrimalData_.primalSolution.postEventIndices_[timeIndex] - 1;
+      const auto& time = nominalPrimalData_.primalSolution.timeTrajectory_[preEventIndex];
+      const auto& state = nominalPrimalData_.primalSolution.stateTrajectory_[preEventIndex];
+      const auto& multiplier = nominalDualData_.dualSolution.preJumps[timeIndex];
+
+      // approximate LQ for the pre-event node
+      ocs2::approximatePreJumpLQ(optimalControlProblemStock_[taskId], time, state, multiplier, modelData);
+
+      // checking the numerical properties
+      if (ddpSettings_.checkNumericalStability_) {
+        const auto errSize = checkSize(modelData, state.rows(), 0);
+        if (!errSize.empty()) {
+          throw std::runtime_error("[GaussNewtonDDP::approximateOptimalControlProblem] Mismatch in dimensions at intermediate time: " +
+                                   std::to_string(time) + "\n" + errSize);
         }
-
-        // shift Hessian
-        if (ddpSettings_.strategy_ == search_strategy::Type::LINE_SEARCH) {
-          hessian_correction::shiftHessian(ddpSettings_.lineSearch_.hessianCorrectionStrategy, modelData.cost.dfdxx,
-                                           ddpSettings_.lineSearch_.hessianCorrectionMultiple);
+        const std::string errProperties =
+            checkDynamicsProperties(modelData) + checkCostProperties(modelData) + checkConstraintProperties(modelData);
+        if (!errProperties.empty()) {
+          throw std::runtime_error("[GaussNewtonDDP::approximateOptimalControlProblem] Ill-posed problem at event time: " +
+                                   std::to_string(time) + "\n" + errProperties);
         }
       }
+
+      // shift Hessian
+      if (ddpSettings_.strategy_ == search_strategy::Type::LINE_SEARCH) {
+        hessian_correction::shiftHessian(ddpSettings_.lineSearch_.hessianCorrectionStrategy, modelData.cost.dfdxx,
+                                         ddpSettings_.lineSearch_.hessianCorrectionMultiple);
+      }
     };
-    runParallel(task, ddpSettings_.nThreads_);
+    parallelFor(0, static_cast<int>(NE), task);
   }
 
   /*
@@ -830,6 +855,7 @@ void GaussNewtonDDP::updateConstraintPenalties(scalar_t equalityConstraintsSSE)
 /******************************************************************************************************/
 /******************************************************************************************************/
 bool GaussNewtonDDP::initializePrimalSolution() {
+  OCS2_TRACE_ZONE("GaussNewtonDDP::initializePrimalSolution");
   try {
     // clear before starting to fill
     nominalPrimalData_.clear();
@@ -901,6 +927,7 @@ void GaussNewtonDDP::initializeDualSolutionAndMetrics() {
 /******************************************************************************************************/
 /******************************************************************************************************/
 void GaussNewtonDDP::takePrimalDualStep(scalar_t lqModelExpectedCost) {
+  OCS2_TRACE_ZONE("GaussNewtonDDP::takePrimalDualStep");
   // update primal: run search strategy and find the optimal stepLength
   searchStrategyTimer_.startTimer();
   scalar_t avgTimeStep;
@@ -978,6 +1005,7 @@ void GaussNewtonDDP::runImpl(scalar_t initTime, const vector_t& initState, scala
 /******************************************************************************************************/
 /******************************************************************************************************/
 void GaussNewtonDDP::runImpl(scalar_t initTime, const vector_t& initState, scalar_t finalTime) {
+  OCS2_TRACE_ZONE("GaussNewtonDDP::run");
   if (ddpSettings_.displayInfo_) {
     std::cerr << "\n++++++++++++++++++++++++++++++++++++++++++++++++++++++";
     std::cerr << "\n+++++++++++++ " + ddp::toAlgorithmName(ddpSettings_.algorithm_) + " solver is initialized ++++++++++++++";
@@ -1028,32 +1056,45 @@ void GaussNewtonDDP::runImpl(scalar_t initTime, const vector_t& initState, scala
 
   // DDP main loop
   while (true) {
+    OCS2_TRACE_ZONE("GaussNewtonDDP::iteration");
     if (ddpSettings_.displayInfo_) {
       std::cerr << "\n###################";
       std::cerr << "\n#### Iteration " << (totalNumIterations_ - initIteration);
       std::cerr << "\n###################\n";
     }
-
     // nominal --> nominal: constructs the LQ problem around the nominal trajectories
     linearQuadraticApproximationTimer_.startTimer();
+    linearQuadraticApproximationAllocations_.start();
     approximateOptimalControlProblem();
+    linearQuadraticApproximationAllocations_.end();
     linearQuadraticApproximationTimer_.endTimer();
 
     // nominal --> nominal: solves the LQ problem
     backwardPassTimer_.startTimer();
+    backwardPassAllocations_.start();
     avgTimeStepBP_ = solveSequentialRiccatiEquations(nominalPrimalData_.modelDataFinalTime.cost);
+    backwardPassAllocations_.end();
     backwardPassTimer_.endTimer();
 
     // calculate controller and store the result in unoptimizedController_
+    // Only the controller computation is expected to be allocation free after the first iteration, as long as the number of time steps
+    // does not grow. The other phases are counted but not reported, since the model approximations and the Riccati modifications return
+    // by value and the rollouts and the Riccati integration grow their trajectories with the adaptive time steps.
+    const bool controllerIsSteadyState =
+        totalNumIterations_ > initIteration && nominalPrimalData_.primalSolution.timeTrajectory_.size() <= unoptimizedController_.size();
     computeControllerTimer_.startTimer();
+    computeControllerAllocations_.start();
     calculateController();
+    computeControllerAllocations_.end(controllerIsSteadyState);
     computeControllerTimer_.endTimer();
 
     // the expected cost/merit calculated by the Riccati solution is not reliable
     const auto lqModelExpectedCost = initialSolutionExists ? nominalDualData_.valueFunctionTrajectory.front().f : performanceIndex_.merit;
 
     // nominal --> optimized: based on the current LQ solution updates the optimized primal and dual solutions
+    primalDualStepAllocations_.start();
     takePrimalDualStep(lqModelExpectedCost);
+    primalDualStepAllocations_.end();
 
     // iteration info
     ++totalNumIterations_;
@@ -28,6 +28,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 
 #include "ocs2_ddp/ILQR.h"
+#include "ocs2_ddp/DDP_HelperFunctions.h"
 #include <ocs2_ddp/riccati_equations/RiccatiTransversalityConditions.h>
 
 namespace ocs2 {
@@ -70,6 +71,11 @@ ILQR::ILQR(ddp::Settings ddpSettings, const RolloutBase& rollout, const OptimalC
     riccatiEquationsPtrStock_.back()->setRiskSensitiveCoefficient(settings().riskSensitiveCoeff_);
   }  // end of i loop
 
+  // The Riccati segments reproduce the serial backward pass only if the Riccati modification does not depend on the value function. It
+  // does for the Levenberg-Marquardt terms and for the Hessian corrections other than the diagonal shift.
+  isParallelRiccatiExact_ = settings().exactParallelRiccati_ && settings().strategy_ == search_strategy::Type::LINE_SEARCH &&
+                            settings().lineSearch_.hessianCorrectionStrategy == hessian_correction::Strategy::DIAGONAL_SHIFT;
+
   Eigen::initParallel();
 }
 
@@ -88,47 +94,40 @@ void ILQR::approximateIntermediateLQ(const DualSolution& dualSolution, PrimalDat
   modelDataTrajectory.clear();
   modelDataTrajectory.resize(timeTrajectory.size());
 
-  nextTimeIndex_ = 0;
-  nextTaskId_ = 0;
-  auto task = [&]() {
-    size_t taskId = nextTaskId_++;  // assign task ID (atomic)
-
-    ModelData continuousTimeModelData;
-
-    // get next time index is atomic
-    size_t timeIndex;
-    while ((timeIndex = nextTimeIndex_++) < timeTrajectory.size()) {
-      // approximate continuous LQ for the given time index
-      ocs2::approximateIntermediateLQ(optimalControlProblemStock_[taskId], timeTrajectory[timeIndex], stateTrajectory[timeIndex],
-                                      inputTrajectory[timeIndex], multiplierTrajectory[timeIndex], continuousTimeModelData);
-
-      // checking the numerical properties
-      if (settings().checkNumericalStability_) {
-        const auto errSize = checkSize(continuousTimeModelData, stateTrajectory[timeIndex].rows(), inputTrajectory[timeIndex].rows());
-        if (!errSize.empty()) {
-          throw std::runtime_error("[ILQR::approximateIntermediateLQ] Mismatch in dimensions at intermediate time: " +
-                                   std::to_string(timeTrajectory[timeIndex]) + "\n" + errSize);
-        }
-        const auto errProperties = checkDynamicsProperties(continuousTimeModelData) + checkCostProperties(continuousTimeModelData) +
-                                   checkConstraintProperties(continuousTimeModelData);
-        if (!errProperties.empty()) {
-          throw std::runtime_error("[ILQR::approximateIntermediateLQ] Ill-posed problem at intermediate time: " +
-                                   std::to_string(timeTrajectory[timeIndex]) + "\n" + errProperties);
-        }
-      }
+  std::vector<ModelData> continuousTimeModelDataStock(settings().nThreads_);
+  auto task = [&](size_t taskId, int timeIndex) {
+    ModelData& continuousTimeModelData = continuousTimeModelDataStock[taskId];
+
+    // approximate continuous LQ for the given time index
+    ocs2::approximateIntermediateLQ(optimalControlProblemStock_[taskId], timeTrajectory[timeIndex], stateTrajectory[timeIndex],
+                                    inputTrajectory[timeIndex], multiplierTrajectory[timeIndex], continuousTimeModelData);
 
-      // discretize LQ problem
-      const scalar_t timeStep = (timeIndex + 1 < timeTrajectory.size()) ? (timeTrajectory[timeIndex + 1] - timeTrajectory[timeIndex]) : 0.0;
-      if (!numerics::almost_eq(timeStep, 0.0)) {
-        discreteLQWorker(*optimalControlProblemStock_[taskId].dynamicsPtr, timeTrajectory[timeIndex], stateTrajectory[timeIndex],
-                         inputTrajectory[timeIndex], timeStep, continuousTimeModelData, modelDataTrajectory[timeIndex]);
-      } else {
-        modelDataTrajectory[timeIndex] = continuousTimeModelData;
+    // checking the numerical properties
+    if (settings().checkNumericalStability_) {
+      const auto errSize = checkSize(continuousTimeModelData, stateTrajectory[timeIndex].rows(), inputTrajectory[timeIndex].rows());
+      if (!errSize.empty()) {
+        throw std::runtime_error("[ILQR::approximateIntermediateLQ] Mismatch in dimensions at intermediate time: " +
+                                 std::to_string(timeTrajectory[timeIndex]) + "\n" + errSize);
       }
+      const auto errProperties = checkDynamicsProperties(continuousTimeModelData) + checkCostProperties(continuousTimeModelData) +
+                                 checkConstraintProperties(continuousTimeModelData);
+      if (!errProperties.empty()) {
+        throw std::runtime_error("[ILQR::approximateIntermediateLQ] Ill-posed problem at intermediate time: " +
+                                 std::to_string(timeTrajectory[timeIndex]) + "\n" + errProperties);
+      }
+    }
+
+    // discretize LQ problem
+    const scalar_t timeStep = (timeIndex + 1 < timeTrajectory.size()) ? (timeTrajectory[timeIndex + 1] - timeTrajectory[timeIndex]) : 0.0;
+    if (!numerics::almost_eq(timeStep, 0.0)) {
+      discreteLQWorker(*optimalControlProblemStock_[taskId].dynamicsPtr, timeTrajectory[timeIndex], stateTrajectory[timeIndex],
+                       inputTrajectory[timeIndex], timeStep, continuousTimeModelData, modelDataTrajectory[timeIndex]);
+    } else {
+      modelDataTrajectory[timeIndex] = continuousTimeModelData;
     }
   };
 
-  runParallel(task, settings().nThreads_);
+  parallelFor(0, static_cast<int>(timeTrajectory.size()), task);
 }
 
 /******************************************************************************************************/
@@ -169,15 +168,9 @@ void ILQR::calculateControllerWorker(size_t timeIndex, const PrimalDataContainer
 
   const auto& Qu = dualData.riccatiModificationTrajectory[timeIndex].constraintNullProjector_;
 
-  // feedback gains
-  dstController.gainArray_[timeIndex] = -CmProjected;
-  dstController.gainArray_[timeIndex].noalias() += Qu * projectedKmTrajectoryStock_[timeIndex];
-
-  // bias input
-  dstController.biasArray_[timeIndex] = nominalInput;
-  dstController.biasArray_[timeIndex].noalias() -= dstController.gainArray_[timeIndex] * nominalState;
-  dstController.deltaBiasArray_[timeIndex] = -EvProjected;
-  dstController.deltaBiasArray_[timeIndex].noalias() += Qu * projectedLvTrajectoryStock_[timeIndex];
+  computeController(nominalState, nominalInput, EvProjected, CmProjected, Qu, projectedKmTrajectoryStock_[timeIndex],
+                    projectedLvTrajectoryStock_[timeIndex], dstController.gainArray_[timeIndex], dstController.biasArray_[timeIndex],
+                    dstController.deltaBiasArray_[timeIndex]);
 }
 
 /******************************************************************************************************/
@@ -297,4 +290,67 @@ void ILQR::riccatiEquationsWorker(size_t workerIndex, const std::pair<int, int>&
     --curIndex;
   }  // while
 }
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool ILQR::computePartitionFinalValueFunctions(const std::vector<std::pair<int, int>>& partitionIntervals,
+                                               std::vector<ScalarFunctionQuadraticApproximation>& finalValueFunctionOfEachPartition) {
+  if (!isParallelRiccatiExact_) {
+    return GaussNewtonDDP::computePartitionFinalValueFunctions(partitionIntervals, finalValueFunctionOfEachPartition);
+  }
+
+  // condense all partitions except the first one
+  const int numPartitions = partitionIntervals.size();
+  std::vector<RiccatiSegment> partitionSegments(numPartitions);
+  parallelFor(1, numPartitions,
+              [&](size_t, int i) { partitionSegments[i] = computePartitionRiccatiSegment(partitionIntervals[i]); });
+
+  // propagate the final value function over the partitions
+  for (int i = numPartitions - 1; i > 0; i--) {
+    finalValueFunctionOfEachPartition[i - 1] = applyRiccatiSegment(partitionSegments[i], finalValueFunctionOfEachPartition[i]);
+  }
+
+  return true;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+RiccatiSegment ILQR::computePartitionRiccatiSegment(const std::pair<int, int>& partitionInterval) const {
+  // find all events belonging to the current partition
+  const auto& postEventIndices = nominalPrimalData_.primalSolution.postEventIndices_;
+  const auto firstEventItr = std::upper_bound(postEventIndices.begin(), postEventIndices.end(), partitionInterval.first);
+  const auto lastEventItr = std::upper_bound(postEventIndices.begin(), postEventIndices.end(), partitionInterval.second);
+
+  ModelData projectedModelData;
+  riccati_modification::Data riccatiModification;
+  RiccatiSegment segment = identityRiccatiSegment(nominalPrimalData_.modelDataTrajectory[partitionInterval.second].stateDim);
+
+  // same traversal as riccatiEquationsWorker
+  int curIndex = partitionInterval.second - 1;
+  auto nextEventItr = lastEventItr - 1;
+  const int stopIndex = partitionInterval.first;
+  while (curIndex >= stopIndex) {
+    const auto& curModelData = nominalPrimalData_.modelDataTrajectory[curIndex];
+    const matrix_t SmDummy = matrix_t::Zero(curModelData.stateDim, curModelData.stateDim);
+    computeProjectionAndRiccatiModification(curModelData, SmDummy, projectedModelData, riccatiModification);
+    segment = combineRiccatiSegments(stageRiccatiSegment(projectedModelData, riccatiModification), segment);
+
+    if (std::distance(firstEventItr, nextEventItr) >= 0 && curIndex == *nextEventItr) {
+      // move to pre-event index
+      --curIndex;
+
+      const int index = std::distance(postEventIndices.begin(), nextEventItr);
+      segment = combineRiccatiSegments(eventRiccatiSegment(nominalPrimalData_.modelDataEventTimes[index]), segment);
+
+      --nextEventItr;
+    }
+
+    --curIndex;
+  }  // while
+
+  return segment;
+}
+
 }  // namespace ocs2
@@ -87,38 +87,29 @@ void SLQ::approximateIntermediateLQ(const DualSolution& dualSolution, PrimalData
   modelDataTrajectory.clear();
   modelDataTrajectory.resize(timeTrajectory.size());
 
-  nextTimeIndex_ = 0;
-  nextTaskId_ = 0;
-  auto task = [&]() {
-    const size_t taskId = nextTaskId_++;  // assign task ID (atomic)
-
-    // get next time index is atomic
-    size_t timeIndex;
-    while ((timeIndex = nextTimeIndex_++) < timeTrajectory.size()) {
-      // approximate LQ for the given time index
-      ocs2::approximateIntermediateLQ(optimalControlProblemStock_[taskId], timeTrajectory[timeIndex], stateTrajectory[timeIndex],
-                                      inputTrajectory[timeIndex], multiplierTrajectory[timeIndex], modelDataTrajectory[timeIndex]);
-
-      // checking the numerical properties
-      if (settings().checkNumericalStability_) {
-        const auto errSize =
-            checkSize(modelDataTrajectory[timeIndex], stateTrajectory[timeIndex].rows(), inputTrajectory[timeIndex].rows());
-        if (!errSize.empty()) {
-          throw std::runtime_error("[SLQ::approximateIntermediateLQ] Mismatch in dimensions at intermediate time: " +
-                                   std::to_string(timeTrajectory[timeIndex]) + "\n" + errSize);
-        }
-        const std::string errProperties = checkDynamicsProperties(modelDataTrajectory[timeIndex]) +
-                                          checkCostProperties(modelDataTrajectory[timeIndex]) +
-                                          checkConstraintProperties(modelDataTrajectory[timeIndex]);
-        if (!errProperties.empty()) {
-          throw std::runtime_error("[SLQ::approximateIntermediateLQ] Ill-posed problem at intermediate time: " +
-                                   std::to_string(timeTrajectory[timeIndex]) + "\n" + errProperties);
-        }
+  auto task = [&](size_t taskId, int timeIndex) {
+    // approximate LQ for the given time index
+    ocs2::approximateIntermediateLQ(optimalControlProblemStock_[taskId], timeTrajectory[timeIndex], stateTrajectory[timeIndex],
+                                    inputTrajectory[timeIndex], multiplierTrajectory[timeIndex], modelDataTrajectory[timeIndex]);
+
+    // checking the numerical properties
+    if (settings().checkNumericalStability_) {
+      const auto errSize = checkSize(modelDataTrajectory[timeIndex], stateTrajectory[timeIndex].rows(), inputTrajectory[timeIndex].rows());
+      if (!errSize.empty()) {
+        throw std::runtime_error("[SLQ::approximateIntermediateLQ] Mismatch in dimensions at intermediate time: " +
+                                 std::to_string(timeTrajectory[timeIndex]) + "\n" + errSize);
       }
-    }  // end of while loop
+      const std::string errProperties = checkDynamicsProperties(modelDataTrajectory[timeIndex]) +
+                                        checkCostProperties(modelDataTrajectory[timeIndex]) +
+                                        checkConstraintProperties(modelDataTrajectory[timeIndex]);
+      if (!errProperties.empty()) {
+        throw std::runtime_error("[SLQ::approximateIntermediateLQ] Ill-posed problem at intermediate time: " +
+                                 std::to_string(timeTrajectory[timeIndex]) + "\n" + errProperties);
+      }
+    }
   };
 
-  runParallel(task, settings().nThreads_);
+  parallelFor(0, static_cast<int>(timeTrajectory.size()), task);
 }
 
 /******************************************************************************************************/
@@ -144,17 +135,21 @@ void SLQ::calculateControllerWorker(size_t timeIndex, const PrimalDataContainer&
   const matrix_t& CmProjected = dualData.projectedModelDataTrajectory[timeIndex].stateInputEqConstraint.dfdx;
   // projector
   const matrix_t& Qu = dualData.riccatiModificationTrajectory[timeIndex].constraintNullProjector_;
-  // deltaGm, projected feedback
-  matrix_t projectedKm = dualData.riccatiModificationTrajectory[timeIndex].deltaGm_;
-  // deltaGv, projected feedforward
-  vector_t projectedLv = dualData.riccatiModificationTrajectory[timeIndex].deltaGv_;
+  // deltaGm
+  const matrix_t& deltaGm = dualData.riccatiModificationTrajectory[timeIndex].deltaGm_;
+  // deltaGv
+  const vector_t& deltaGv = dualData.riccatiModificationTrajectory[timeIndex].deltaGv_;
+
+  // projected feedback and feedforward, stored in the members so that their memory is reused over the iterations
+  matrix_t& projectedKm = projectedKmTrajectoryStock_[timeIndex];
+  vector_t& projectedLv = projectedLvTrajectoryStock_[timeIndex];
 
   // projectedKm = projectedPm + projectedBm^t * Sm
-  projectedKm = -(projectedKm + projectedPm);
+  projectedKm = -(deltaGm + projectedPm);
   projectedKm.noalias() -= projectedBm.transpose() * dualData.valueFunctionTrajectory[timeIndex].dfdxx;
 
   // projectedLv = projectedRv + projectedBm^t * Sv
-  projectedLv = -(projectedLv + projectedRv);
+  projectedLv = -(deltaGv + projectedRv);
   projectedLv.noalias() -= projectedBm.transpose() * dualData.valueFunctionTrajectory[timeIndex].dfdx;
 
   // feedback gains
@@ -178,23 +173,18 @@ scalar_t SLQ::solveSequentialRiccatiEquations(const ScalarFunctionQuadraticAppro
 
   nominalDualData_.riccatiModificationTrajectory.resize(N);
   nominalDualData_.projectedModelDataTrajectory.resize(N);
+  projectedKmTrajectoryStock_.resize(N);
+  projectedLvTrajectoryStock_.resize(N);
 
   if (N > 0) {
     // perform the computeRiccatiModificationTerms for partition i
-    nextTimeIndex_ = 0;
-    nextTaskId_ = 0;
-    auto task = [this, N]() {
-      int timeIndex;
-      const matrix_t SmDummy = matrix_t::Zero(0, 0);
-
-      // get next time index is atomic
-      while ((timeIndex = nextTimeIndex_++) < N) {
-        computeProjectionAndRiccatiModification(nominalPrimalData_.modelDataTrajectory[timeIndex], SmDummy,
-                                                nominalDualData_.projectedModelDataTrajectory[timeIndex],
-                                                nominalDualData_.riccatiModificationTrajectory[timeIndex]);
-      }
+    const matrix_t SmDummy = matrix_t::Zero(0, 0);
+    auto task = [&](size_t, int timeIndex) {
+      computeProjectionAndRiccatiModification(nominalPrimalData_.modelDataTrajectory[timeIndex], SmDummy,
+                                              nominalDualData_.projectedModelDataTrajectory[timeIndex],
+                                              nominalDualData_.riccatiModificationTrajectory[timeIndex]);
     };
-    runParallel(task, settings().nThreads_);
+    parallelFor(0, static_cast<int>(N), task);
   }
 
   return solveSequentialRiccatiEquationsImpl(finalValueFunction);
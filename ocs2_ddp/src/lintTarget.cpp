@@ -1,5 +1,6 @@
 #include <ocs2_ddp/DDP_Data.h>
 #include <ocs2_ddp/DDP_Settings.h>
+#include <ocs2_ddp/FixedSizeDispatch.h>
 #include <ocs2_ddp/GaussNewtonDDP.h>
 
 #include <ocs2_ddp/ILQR.h>
@@ -11,6 +12,7 @@
 
 #include <ocs2_ddp/riccati_equations/RiccatiModification.h>
 #include <ocs2_ddp/riccati_equations/RiccatiModificationInterpolation.h>
+#include <ocs2_ddp/riccati_equations/RiccatiSegment.h>
 
 // dummy target for clang toolchain
 int main() {
@@ -54,83 +54,114 @@ void DiscreteTimeRiccatiEquations::computeMap(const ModelData& projectedModelDat
     computeMapILEG(projectedModelData, riccatiModification, SmNext, SvNext, sNext, discreteTimeRiccatiData_, projectedKm, projectedLv, Sm,
                    Sv, s);
   } else {
-    computeMapILQR(projectedModelData, riccatiModification, SmNext, SvNext, sNext, discreteTimeRiccatiData_, projectedKm, projectedLv, Sm,
-                   Sv, s);
+    // fixed-size kernel if the dimensions are supported, otherwise the dynamic-size one
+    const bool isFixedSize = fixed_size::dispatch(SmNext.rows(), projectedModelData.dynamics.dfdu.cols(), [&](auto dims) {
+      auto& workspace = fixedSizeRiccatiWorkspaces_.get(dims);
+      computeMapILQR(projectedModelData, riccatiModification, SmNext, SvNext, sNext, workspace, projectedKm, projectedLv, Sm, Sv, s);
+    });
+    if (!isFixedSize) {
+      computeMapILQR<Eigen::Dynamic, Eigen::Dynamic>(projectedModelData, riccatiModification, SmNext, SvNext, sNext,
+                                                     discreteTimeRiccatiData_, projectedKm, projectedLv, Sm, Sv, s);
+    }
   }
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
+template <int NX, int NU>
 void DiscreteTimeRiccatiEquations::computeMapILQR(const ModelData& projectedModelData,
                                                   const riccati_modification::Data& riccatiModification, const matrix_t& SmNext,
-                                                  const vector_t& SvNext, const scalar_t& sNext, DiscreteTimeRiccatiData& dreCache,
-                                                  matrix_t& projectedKm, vector_t& projectedLv, matrix_t& Sm, vector_t& Sv,
-                                                  scalar_t& s) const {
+                                                  const vector_t& SvNext, const scalar_t& sNext,
+                                                  DiscreteTimeRiccatiWorkspace<NX, NU>& dreCache, matrix_t& projectedKm,
+                                                  vector_t& projectedLv, matrix_t& Sm, vector_t& Sv, scalar_t& s) const {
+  const auto nx = SmNext.rows();
+  const auto nu = projectedModelData.dynamics.dfdu.cols();
+
+  // inputs
+  const auto SmNextView = fixed_size::view<NX, NX>(SmNext);
+  const auto SvNextView = fixed_size::view<NX>(SvNext);
+  const auto projectedHv = fixed_size::view<NX>(projectedModelData.dynamicsBias);
+  const auto projectedAm = fixed_size::view<NX, NX>(projectedModelData.dynamics.dfdx);
+  const auto projectedBm = fixed_size::view<NX, NU>(projectedModelData.dynamics.dfdu);
+  const auto projectedQm = fixed_size::view<NX, NX>(projectedModelData.cost.dfdxx);
+  const auto projectedQv = fixed_size::view<NX>(projectedModelData.cost.dfdx);
+  const auto projectedPm = fixed_size::view<NU, NX>(projectedModelData.cost.dfdux);
+  const auto projectedRv = fixed_size::view<NU>(projectedModelData.cost.dfdu);
+  const auto deltaQm = fixed_size::view<NX, NX>(riccatiModification.deltaQm_);
+  const auto deltaGm = fixed_size::view<NU, NX>(riccatiModification.deltaGm_);
+  const auto deltaGv = fixed_size::view<NU>(riccatiModification.deltaGv_);
+
+  // outputs
+  auto projectedKmView = fixed_size::resizeAndView<NU, NX>(projectedKm, nu, nx);
+  auto projectedLvView = fixed_size::resizeAndView<NU>(projectedLv, nu);
+  auto SmView = fixed_size::resizeAndView<NX, NX>(Sm, nx, nx);
+  auto SvView = fixed_size::resizeAndView<NX>(Sv, nx);
+
   // precomputation (1)
-  dreCache.Sm_projectedHv_.noalias() = SmNext * projectedModelData.dynamicsBias;
-  dreCache.Sm_projectedAm_.noalias() = SmNext * projectedModelData.dynamics.dfdx;
-  dreCache.Sm_projectedBm_.noalias() = SmNext * projectedModelData.dynamics.dfdu;
-  dreCache.Sv_plus_Sm_projectedHv_ = SvNext + dreCache.Sm_projectedHv_;
+  dreCache.Sm_projectedHv_.noalias() = SmNextView * projectedHv;
+  dreCache.Sm_projectedAm_.noalias() = SmNextView * projectedAm;
+  dreCache.Sm_projectedBm_.noalias() = SmNextView * projectedBm;
+  dreCache.Sv_plus_Sm_projectedHv_ = SvNextView + dreCache.Sm_projectedHv_;
 
   // projectedGm = projectedPm + projectedBm^T * Sm * projectedAm
-  dreCache.projectedGm_ = projectedModelData.cost.dfdux;
-  dreCache.projectedGm_.noalias() += projectedModelData.dynamics.dfdu.transpose() * dreCache.Sm_projectedAm_;
+  dreCache.projectedGm_ = projectedPm;
+  dreCache.projectedGm_.noalias() += projectedBm.transpose() * dreCache.Sm_projectedAm_;
 
   // projectedGv = projectedRv + projectedBm^T * (Sv + Sm * projectedHv)
-  dreCache.projectedGv_ = projectedModelData.cost.dfdu;
-  dreCache.projectedGv_.noalias() += projectedModelData.dynamics.dfdu.transpose() * dreCache.Sv_plus_Sm_projectedHv_;
+  dreCache.projectedGv_ = projectedRv;
+  dreCache.projectedGv_.noalias() += projectedBm.transpose() * dreCache.Sv_plus_Sm_projectedHv_;
 
   // projected feedback
-  projectedKm = -dreCache.projectedGm_ - riccatiModification.deltaGm_;
+  projectedKmView = -dreCache.projectedGm_ - deltaGm;
   // projected feedforward
-  projectedLv = -dreCache.projectedGv_ - riccatiModification.deltaGv_;
+  projectedLvView = -dreCache.projectedGv_ - deltaGv;
 
   // precomputation (2)
-  dreCache.projectedKm_T_projectedGm_.noalias() = projectedKm.transpose() * dreCache.projectedGm_;
+  dreCache.projectedKm_T_projectedGm_.noalias() = projectedKmView.transpose() * dreCache.projectedGm_;
   if (!reducedFormRiccati_) {
     // projectedHm
-    dreCache.projectedHm_ = projectedModelData.cost.dfduu;
-    dreCache.projectedHm_.noalias() += dreCache.Sm_projectedBm_.transpose() * projectedModelData.dynamics.dfdu;
+    dreCache.projectedHm_ = fixed_size::view<NU, NU>(projectedModelData.cost.dfduu);
+    dreCache.projectedHm_.noalias() += dreCache.Sm_projectedBm_.transpose() * projectedBm;
 
-    dreCache.projectedHm_projectedKm_.noalias() = dreCache.projectedHm_ * projectedKm;
-    dreCache.projectedHm_projectedLv_.noalias() = dreCache.projectedHm_ * projectedLv;
+    dreCache.projectedHm_projectedKm_.noalias() = dreCache.projectedHm_ * projectedKmView;
+    dreCache.projectedHm_projectedLv_.noalias() = dreCache.projectedHm_ * projectedLvView;
   }
 
   /*
    * Sm
    */
   // = Qm + deltaQm
-  Sm = projectedModelData.cost.dfdxx + riccatiModification.deltaQm_;
+  SmView = projectedQm + deltaQm;
   // += Am^T * Sm * Am
-  Sm.noalias() += dreCache.Sm_projectedAm_.transpose() * projectedModelData.dynamics.dfdx;
+  SmView.noalias() += dreCache.Sm_projectedAm_.transpose() * projectedAm;
   if (reducedFormRiccati_) {
     // += Km^T * Gm + Gm^T * Km
-    Sm += dreCache.projectedKm_T_projectedGm_;
+    SmView += dreCache.projectedKm_T_projectedGm_;
   } else {
     // += Km^T * Gm + Gm^T * Km
-    Sm += dreCache.projectedKm_T_projectedGm_ + dreCache.projectedKm_T_projectedGm_.transpose();
+    SmView += dreCache.projectedKm_T_projectedGm_ + dreCache.projectedKm_T_projectedGm_.transpose();
     // += Km^T * Hm * Km
-    Sm.noalias() += projectedKm.transpose() * dreCache.projectedHm_projectedKm_;
+    SmView.noalias() += projectedKmView.transpose() * dreCache.projectedHm_projectedKm_;
   }
 
   /*
    * Sv
    */
   // = Qv
-  Sv = projectedModelData.cost.dfdx;
+  SvView = projectedQv;
   // += Am^T * (Sv + Sm * Hv)
-  Sv.noalias() += projectedModelData.dynamics.dfdx.transpose() * dreCache.Sv_plus_Sm_projectedHv_;
+  SvView.noalias() += projectedAm.transpose() * dreCache.Sv_plus_Sm_projectedHv_;
   if (reducedFormRiccati_) {
     // += Gm^T * Lv
-    Sv.noalias() += dreCache.projectedGm_.transpose() * projectedLv;
+    SvView.noalias() += dreCache.projectedGm_.transpose() * projectedLvView;
   } else {
     // += Gm^T * Lv
-    Sv.noalias() += dreCache.projectedGm_.transpose() * projectedLv;
+    SvView.noalias() += dreCache.projectedGm_.transpose() * projectedLvView;
     // += Km^T * Gv
-    Sv.noalias() += projectedKm.transpose() * dreCache.projectedGv_;
+    SvView.noalias() += projectedKmView.transpose() * dreCache.projectedGv_;
     // Km^T * Hm * Lv
-    Sv.noalias() += dreCache.projectedHm_projectedKm_.transpose() * projectedLv;
+    SvView.noalias() += dreCache.projectedHm_projectedKm_.transpose() * projectedLvView;
   }
 
   /*
@@ -139,17 +170,17 @@ void DiscreteTimeRiccatiEquations::computeMapILQR(const ModelData& projectedMode
   // = s + q
   s = sNext + projectedModelData.cost.f;
   // += Hv^T * (Sv + Sm * Hv)
-  s += projectedModelData.dynamicsBias.dot(dreCache.Sv_plus_Sm_projectedHv_);
+  s += projectedHv.dot(dreCache.Sv_plus_Sm_projectedHv_);
   // -= 0.5 Hv^T * Sm * Hv
-  s -= 0.5 * projectedModelData.dynamicsBias.dot(dreCache.Sm_projectedHv_);
+  s -= 0.5 * projectedHv.dot(dreCache.Sm_projectedHv_);
   if (reducedFormRiccati_) {
     // += 0.5 Lv^T Gv
-    s += 0.5 * projectedLv.dot(dreCache.projectedGv_);
+    s += 0.5 * projectedLvView.dot(dreCache.projectedGv_);
   } else {
     // += Lv^T Gv
-    s += projectedLv.dot(dreCache.projectedGv_);
+    s += projectedLvView.dot(dreCache.projectedGv_);
     // += 0.5 Lv^T Hm Lv
-    s += 0.5 * projectedLv.dot(dreCache.projectedHm_projectedLv_);
+    s += 0.5 * projectedLvView.dot(dreCache.projectedHm_projectedLv_);
   }
 }
 
@@ -175,8 +206,9 @@ void DiscreteTimeRiccatiEquations::computeMapILEG(const ModelData& projectedMode
   dreCache.SvNextStochastic_.noalias() = dreCache.inv_I_minus_Sm_Sigma_ * SvNext;
   dreCache.sNextStochastic_ = sNext + riskSensitiveCoeff_ * Sv.dot(dreCache.Sigma_Sv_) - 0.5 / riskSensitiveCoeff_ * det_I_minus_Sm_Sigma_;
 
-  computeMapILQR(projectedModelData, riccatiModification, dreCache.SmNextStochastic_, dreCache.SvNextStochastic_, dreCache.sNextStochastic_,
-                 dreCache, projectedKm, projectedLv, Sm, Sv, s);
+  computeMapILQR<Eigen::Dynamic, Eigen::Dynamic>(projectedModelData, riccatiModification, dreCache.SmNextStochastic_,
+                                                 dreCache.SvNextStochastic_, dreCache.sNextStochastic_, dreCache, projectedKm, projectedLv,
+                                                 Sm, Sv, s);
 }
 
 }  // namespace ocs2
@@ -0,0 +1,151 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_ddp/riccati_equations/RiccatiSegment.h"
+
+#include <Eigen/Dense>
+
+namespace ocs2 {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+RiccatiSegment identityRiccatiSegment(size_t stateDim) {
+  RiccatiSegment segment;
+  segment.A.setIdentity(stateDim, stateDim);
+  segment.b.setZero(stateDim);
+  segment.C.setZero(stateDim, stateDim);
+  segment.J.setZero(stateDim, stateDim);
+  segment.eta.setZero(stateDim);
+  segment.c = 0.0;
+  return segment;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+RiccatiSegment stageRiccatiSegment(const ModelData& projectedModelData, const riccati_modification::Data& riccatiModification) {
+  const auto& Am = projectedModelData.dynamics.dfdx;
+  const auto& Bm = projectedModelData.dynamics.dfdu;
+  const auto& Hv = projectedModelData.dynamicsBias;
+  const auto& Pm = projectedModelData.cost.dfdux;
+  const auto& Rv = projectedModelData.cost.dfdu;
+
+  // eliminate the state-input cross term: u = v - inv(Rm) * (Pm * x + Rv)
+  const auto RmLdlt = projectedModelData.cost.dfduu.ldlt();
+  const matrix_t invRmPm = RmLdlt.solve(Pm);
+  const vector_t invRmRv = RmLdlt.solve(Rv);
+  const matrix_t invRmBmT = RmLdlt.solve(Bm.transpose());
+
+  RiccatiSegment segment;
+  segment.A = Am;
+  segment.A.noalias() -= Bm * invRmPm;
+  segment.b = Hv;
+  segment.b.noalias() -= Bm * invRmRv;
+  segment.C.noalias() = Bm * invRmBmT;
+  segment.J = projectedModelData.cost.dfdxx + riccatiModification.deltaQm_;
+  segment.J.noalias() -= Pm.transpose() * invRmPm;
+  segment.eta = projectedModelData.cost.dfdx;
+  segment.eta.noalias() -= Pm.transpose() * invRmRv;
+  segment.c = projectedModelData.cost.f - 0.5 * Rv.dot(invRmRv);
+  return segment;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+RiccatiSegment eventRiccatiSegment(const ModelData& jumpModelData) {
+  RiccatiSegment segment;
+  segment.A = jumpModelData.dynamics.dfdx;
+  segment.b = jumpModelData.dynamicsBias;
+  segment.C.setZero(segment.A.rows(), segment.A.rows());
+  segment.J = jumpModelData.cost.dfdxx;
+  segment.eta = jumpModelData.cost.dfdx;
+  segment.c = jumpModelData.cost.f;
+  return segment;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+RiccatiSegment combineRiccatiSegments(const RiccatiSegment& first, const RiccatiSegment& second) {
+  // N = inv(I + C1 * J2)
+  matrix_t IplusCJ = first.C * second.J;
+  IplusCJ.diagonal().array() += 1.0;
+  const auto lu = IplusCJ.partialPivLu();
+  const matrix_t NA = lu.solve(first.A);
+  const vector_t Nb = lu.solve(first.b);
+  const matrix_t NC = lu.solve(first.C);
+  const vector_t NCeta = NC * second.eta;
+
+  RiccatiSegment segment;
+  segment.A.noalias() = second.A * NA;
+  segment.b = second.b;
+  segment.b.noalias() += second.A * (Nb - NCeta);
+  segment.C = second.C;
+  segment.C.noalias() += second.A * NC * second.A.transpose();
+  segment.J = first.J;
+  segment.J.noalias() += NA.transpose() * second.J * first.A;
+  segment.eta = first.eta;
+  segment.eta.noalias() += NA.transpose() * (second.J * first.b + second.eta);
+  segment.c = first.c + second.c + Nb.dot(0.5 * second.J * first.b + second.eta) - 0.5 * second.eta.dot(NCeta);
+
+  // remove the round-off asymmetry
+  segment.C = 0.5 * (segment.C + segment.C.transpose()).eval();
+  segment.J = 0.5 * (segment.J + segment.J.transpose()).eval();
+  return segment;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ScalarFunctionQuadraticApproximation applyRiccatiSegment(const RiccatiSegment& segment,
+                                                         const ScalarFunctionQuadraticApproximation& valueFunction) {
+  const auto& Sm = valueFunction.dfdxx;
+  const auto& Sv = valueFunction.dfdx;
+
+  // N = inv(I + C * Sm)
+  matrix_t IplusCS = segment.C * Sm;
+  IplusCS.diagonal().array() += 1.0;
+  const auto lu = IplusCS.partialPivLu();
+  const matrix_t NA = lu.solve(segment.A);
+  const vector_t Nb = lu.solve(segment.b);
+  const vector_t NCSv = lu.solve(segment.C * Sv);
+
+  ScalarFunctionQuadraticApproximation result;
+  result.dfdxx = segment.J;
+  result.dfdxx.noalias() += NA.transpose() * Sm * segment.A;
+  result.dfdxx = 0.5 * (result.dfdxx + result.dfdxx.transpose()).eval();
+  result.dfdx = segment.eta;
+  result.dfdx.noalias() += NA.transpose() * (Sm * segment.b + Sv);
+  result.f = segment.c + valueFunction.f + Nb.dot(0.5 * Sm * segment.b + Sv) - 0.5 * Sv.dot(NCSv);
+  return result;
+}
+
+}  // namespace ocs2
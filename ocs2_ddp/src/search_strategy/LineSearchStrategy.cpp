@@ -51,6 +51,7 @@ LineSearchStrategy::LineSearchStrategy(search_strategy::Settings baseSettings, l
       threadPoolRef_(threadPoolRef),
       tempDualSolutions_(threadPoolRef.numThreads() + 1),
       workersSolution_(threadPoolRef.numThreads() + 1),
+      workersStepLength_(threadPoolRef.numThreads() + 1),
       rolloutRefStock_(std::move(rolloutRefStock)),
       optimalControlProblemRefStock_(std::move(optimalControlProblemRefStock)),
       meritFunc_(std::move(meritFunc)) {
@@ -85,7 +86,10 @@ size_t LineSearchStrategy::maxNumOfSearches() const {
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-void LineSearchStrategy::computeSolution(size_t taskId, scalar_t stepLength, search_strategy::Solution& solution) {
+bool LineSearchStrategy::computeSolution(size_t taskId, scalar_t stepLength, search_strategy::Solution& solution) {
+  // a larger step length is already accepted
+  const auto isCancelled = [&]() { return stepLength < bestStepSize_; };
+
   auto& problem = optimalControlProblemRefStock_[taskId];
   auto& rollout = rolloutRefStock_[taskId];
 
@@ -94,6 +98,9 @@ void LineSearchStrategy::computeSolution(size_t taskId, scalar_t stepLength, sea
   incrementController(stepLength, *lineSearchInputRef_.unoptimizedControllerPtr, getLinearController(solution.primalSolution));
   solution.avgTimeStep = rolloutTrajectory(rollout, lineSearchInputRef_.timePeriodPtr->first, *lineSearchInputRef_.initStatePtr,
                                            lineSearchInputRef_.timePeriodPtr->second, solution.primalSolution);
+  if (isCancelled()) {
+    return false;
+  }
 
   // adjust dual solution only if it is required
   const DualSolution* adjustedDualSolutionPtr = lineSearchInputRef_.dualSolutionPtr;
@@ -111,6 +118,9 @@ void LineSearchStrategy::computeSolution(size_t taskId, scalar_t stepLength, sea
 
   // initialize dual solution
   initializeDualSolution(problem, solution.primalSolution, *adjustedDualSolutionPtr, solution.dualSolution);
+  if (isCancelled()) {
+    return false;
+  }
 
   // compute problem metrics
   computeRolloutMetrics(problem, solution.primalSolution, solution.dualSolution, solution.problemMetrics);
@@ -126,6 +136,8 @@ void LineSearchStrategy::computeSolution(size_t taskId, scalar_t stepLength, sea
     infoDisplay << std::setw(4) << solution.performanceIndex << "\n\n";
     printString(infoDisplay.str());
   }
+
+  return true;
 }
 
 /******************************************************************************************************/
@@ -142,31 +154,21 @@ bool LineSearchStrategy::run(const std::pair<scalar_t, scalar_t>& timePeriod, co
   lineSearchInputRef_.modeSchedulePtr = &modeSchedule;
   bestSolutionRef_ = &solutionRef;
 
-  // perform a rollout with steplength zero.
-  constexpr size_t taskId = 0;
-  constexpr scalar_t stepLength = 0.0;
-  try {
-    computeSolution(taskId, stepLength, workersSolution_[taskId]);
-    baselineMerit_ = workersSolution_[taskId].performanceIndex.merit;
-    unoptimizedControllerUpdateIS_ = computeControllerUpdateIS(unoptimizedController);
-
-    // record solution
-    bestStepSize_ = stepLength;
-    swap(*bestSolutionRef_, workersSolution_[taskId]);
+  // reset the line search state
+  bestStepSize_ = 0.0;
+  baselineStatus_ = BaselineStatus::Pending;
+  unoptimizedControllerUpdateIS_ = computeControllerUpdateIS(unoptimizedController);
 
-  } catch (const std::exception& error) {
-    if (baseSettings_.displayInfo) {
-      printString("    [Thread " + std::to_string(taskId) + "] rollout with step length " + std::to_string(stepLength) +
-                  " is terminated: " + error.what() + '\n');
-    }
-    throw std::runtime_error("[SearchStrategy::run] DDP controller does not generate a stable rollout!");
-  }
-
-  // run workers
+  // run workers: the first task computes the baseline while the others speculatively start with the largest step lengths
   nextTaskId_ = 0;
   alphaExpNext_ = 0;
   alphaProcessed_ = std::vector<bool>(maxNumOfSearches(), false);
-  auto task = [&](int) { lineSearchTask(nextTaskId_++); };
+  auto task = [&](int) {
+    const size_t taskId = nextTaskId_++;  // assign task ID (atomic)
+    if (taskId > 0 || baselineTask(taskId)) {
+      lineSearchTask(taskId);
+    }
+  };
   threadPoolRef_.runParallel(task, threadPoolRef_.numThreads());
 
   // revitalize all integrators
@@ -174,6 +176,10 @@ bool LineSearchStrategy::run(const std::pair<scalar_t, scalar_t>& timePeriod, co
     rollout.reactivateRollout();
   }
 
+  if (baselineStatus_ == BaselineStatus::Failed) {
+    throw std::runtime_error("[SearchStrategy::run] DDP controller does not generate a stable rollout!");
+  }
+
   // display
   if (baseSettings_.displayInfo) {
     std::cerr << "The chosen step length is: " + std::to_string(bestStepSize_) << "\n";
@@ -182,6 +188,61 @@ bool LineSearchStrategy::run(const std::pair<scalar_t, scalar_t>& timePeriod, co
   return true;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool LineSearchStrategy::baselineTask(const size_t taskId) {
+  // perform a rollout with steplength zero.
+  constexpr scalar_t stepLength = 0.0;
+  workersStepLength_[taskId] = stepLength;
+
+  bool isSuccessful = true;
+  try {
+    computeSolution(taskId, stepLength, workersSolution_[taskId]);
+  } catch (const std::exception& error) {
+    if (baseSettings_.displayInfo) {
+      printString("    [Thread " + std::to_string(taskId) + "] rollout with step length " + std::to_string(stepLength) +
+                  " is terminated: " + error.what() + '\n');
+    }
+    isSuccessful = false;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(lineSearchResultMutex_);
+    if (isSuccessful) {
+      // record solution
+      baselineMerit_ = workersSolution_[taskId].performanceIndex.merit;
+      swap(*bestSolutionRef_, workersSolution_[taskId]);
+      baselineStatus_ = BaselineStatus::Ready;
+    } else {
+      baselineStatus_ = BaselineStatus::Failed;
+    }
+  }  // end lock
+  baselineReadyCondition_.notify_all();
+
+  // the speculative evaluations are useless without a baseline
+  if (!isSuccessful) {
+    for (RolloutBase& rollout : rolloutRefStock_) {
+      rollout.abortRollout();
+    }
+  }
+
+  return isSuccessful;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void LineSearchStrategy::cancelSmallerStepLengths(const size_t taskId, scalar_t stepLength) {
+  // the rollouts of a thread are only carried on with smaller step lengths, therefore a stale step length is also safe to cancel
+  const size_t numWorkers = std::min(workersStepLength_.size(), rolloutRefStock_.size());
+  for (size_t i = 0; i < numWorkers; i++) {
+    if (i != taskId && workersStepLength_[i] < stepLength) {
+      rolloutRefStock_[i].get().abortRollout();
+    }
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -211,13 +272,21 @@ void LineSearchStrategy::lineSearchTask(const size_t taskId) {
       break;
     }
 
+    workersStepLength_[taskId] = stepLength;
+    bool isCompleted = false;
     try {
-      computeSolution(taskId, stepLength, workersSolution_[taskId]);
+      isCompleted = computeSolution(taskId, stepLength, workersSolution_[taskId]);
+      if (!isCompleted && baseSettings_.displayInfo) {
+        printString("    [Thread " + std::to_string(taskId) + "] rollout with step length " + std::to_string(stepLength) +
+                    " is cancelled: A larger learning rate is already found!\n");
+      }
     } catch (const std::exception& error) {
       if (baseSettings_.displayInfo) {
         printString("    [Thread " + std::to_string(taskId) + "] rollout with step length " + std::to_string(stepLength) +
                     " is terminated: " + error.what() + '\n');
       }
+    }
+    if (!isCompleted) {
       workersSolution_[taskId].performanceIndex.merit = std::numeric_limits<scalar_t>::max();
       workersSolution_[taskId].performanceIndex.cost = std::numeric_limits<scalar_t>::max();
     }
@@ -225,7 +294,13 @@ void LineSearchStrategy::lineSearchTask(const size_t taskId) {
     // whether to accept the step or reject it
     bool terminateLinesearchTasks = false;
     {
-      std::lock_guard<std::mutex> lock(lineSearchResultMutex_);
+      std::unique_lock<std::mutex> lock(lineSearchResultMutex_);
+
+      // the speculatively evaluated step lengths wait for the baseline
+      baselineReadyCondition_.wait(lock, [this]() { return baselineStatus_ != BaselineStatus::Pending; });
+      if (baselineStatus_ == BaselineStatus::Failed) {
+        break;
+      }
 
       /*
        * based on the "Armijo backtracking" step length selection policy:
@@ -237,17 +312,15 @@ void LineSearchStrategy::lineSearchTask(const size_t taskId) {
       if (armijoCondition && stepLength > bestStepSize_) {  // save solution
         bestStepSize_ = stepLength;
         swap(*bestSolutionRef_, workersSolution_[taskId]);
+        cancelSmallerStepLengths(taskId, stepLength);
         terminateLinesearchTasks = std::all_of(alphaProcessed_.cbegin(), alphaProcessed_.cbegin() + alphaExp, [](bool f) { return f; });
       }
 
       alphaProcessed_[alphaExp] = true;
     }  // end lock
 
-    // kill other ongoing line search tasks
+    // all the larger step lengths are processed and the ongoing line search tasks are already cancelled
     if (terminateLinesearchTasks) {
-      for (RolloutBase& rollout : rolloutRefStock_) {
-        rollout.abortRollout();
-      }
       if (baseSettings_.displayInfo) {
         printString("    LS: interrupt other rollout's integrations.\n");
       }
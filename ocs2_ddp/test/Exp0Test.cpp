@@ -34,6 +34,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/control/FeedforwardController.h>
 #include <ocs2_core/initialization/DefaultInitializer.h>
+#include <ocs2_core/misc/AllocationTracking.h>
 #include <ocs2_oc/rollout/TimeTriggeredRollout.h>
 #include <ocs2_oc/test/EXP0.h>
 
@@ -294,6 +295,40 @@ TEST_F(Exp0, ddp_hamiltonian) {
   EXPECT_FALSE(dHdu3.isZero(precision)) << "MESSAGE for test 3: Derivative of Hamiltonian w.r.t. to u is zero: " << dHdu3.transpose();
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+TEST_F(Exp0, ddp_steady_state_allocations) {
+  // the controller computation must not allocate after the first iteration, which aborts the test with Policy::Abort. Without
+  // OCS2_ALLOCATION_TRACKING nothing is counted and the test only checks that the reporting does not interfere with the solver.
+  const auto policy = ocs2::allocation::getPolicy();
+  ocs2::allocation::setPolicy(ocs2::allocation::Policy::Abort);
+
+  // a fixed-step rollout keeps the number of time steps constant over the iterations
+  auto settings = rolloutSettings();
+  settings.integratorType = ocs2::IntegratorType::RK4;
+  ocs2::EXP0_System systemDynamics(referenceManagerPtr);
+  ocs2::TimeTriggeredRollout rollout(systemDynamics, settings);
+
+  for (const auto algorithm : {ocs2::ddp::Algorithm::SLQ, ocs2::ddp::Algorithm::ILQR}) {
+    const auto ddpSettings = getSettings(algorithm, 2, ocs2::search_strategy::Type::LINE_SEARCH);
+    std::unique_ptr<ocs2::GaussNewtonDDP> ddpPtr;
+    if (algorithm == ocs2::ddp::Algorithm::SLQ) {
+      ddpPtr.reset(new ocs2::SLQ(ddpSettings, rollout, problem, *initializerPtr));
+    } else {
+      ddpPtr.reset(new ocs2::ILQR(ddpSettings, rollout, problem, *initializerPtr));
+    }
+    ddpPtr->setReferenceManager(referenceManagerPtr);
+
+    const auto numViolations = ocs2::allocation::getNumViolations();
+    ddpPtr->run(startTime, initState, finalTime);
+    EXPECT_GT(ddpPtr->getNumIterations(), 1) << "MESSAGE: " << getTestName(ddpSettings) << ": no steady-state iteration was run!";
+    EXPECT_EQ(ocs2::allocation::getNumViolations(), numViolations) << "MESSAGE: " << getTestName(ddpSettings) << ": allocated!";
+  }
+
+  ocs2::allocation::setPolicy(policy);
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
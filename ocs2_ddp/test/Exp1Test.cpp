@@ -36,6 +36,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/initialization/DefaultInitializer.h>
 #include <ocs2_oc/rollout/TimeTriggeredRollout.h>
 #include <ocs2_oc/test/EXP1.h>
+#include <ocs2_oc/test/testProblemsGeneration.h>
 
 #include <ocs2_ddp/ILQR.h>
 #include <ocs2_ddp/SLQ.h>
@@ -259,6 +260,76 @@ TEST_P(Exp1, ILQR) {
   performanceIndexTest(ddpSettings, performanceIndex);
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+TEST_F(Exp1, ilqr_exactParallelRiccati) {
+  // dynamics and rollout
+  ocs2::EXP1_System systemDynamics(referenceManagerPtr);
+  ocs2::TimeTriggeredRollout rollout(systemDynamics, rolloutSettings());
+
+  auto runIteration = [&](const ocs2::ddp::Settings& ddpSettings) {
+    ocs2::ILQR ddp(ddpSettings, rollout, problem, *initializerPtr);
+    ddp.setReferenceManager(referenceManagerPtr);
+    ddp.run(startTime, initState, finalTime);
+    return ddp.getValueFunction(startTime, initState);
+  };
+
+  // the first iteration is solved sequentially in the single-thread case
+  auto ddpSettings = getSettings(ocs2::ddp::Algorithm::ILQR, 1, ocs2::search_strategy::Type::LINE_SEARCH);
+  ddpSettings.maxNumIterations_ = 1;
+  const auto sequentialValueFunction = runIteration(ddpSettings);
+
+  ddpSettings.nThreads_ = 3;
+  ddpSettings.exactParallelRiccati_ = true;
+  const auto parallelValueFunction = runIteration(ddpSettings);
+
+  constexpr ocs2::scalar_t tol = 1e-6;
+  EXPECT_TRUE(parallelValueFunction.dfdxx.isApprox(sequentialValueFunction.dfdxx, tol));
+  EXPECT_TRUE(parallelValueFunction.dfdx.isApprox(sequentialValueFunction.dfdx, tol));
+  EXPECT_NEAR(parallelValueFunction.f, sequentialValueFunction.f, tol * std::abs(sequentialValueFunction.f));
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+TEST_F(Exp1, ilqr_exactParallelRiccatiConstrained) {
+  // the state-input equality constraint u = -0.5 - 0.1 * x1 + 0.2 * x2 is projected out in the backward pass
+  ocs2::VectorFunctionLinearApproximation constraint;
+  constraint.f = ocs2::vector_t::Constant(1, 0.5);
+  constraint.dfdx = (ocs2::matrix_t(1, STATE_DIM) << 0.1, -0.2).finished();
+  constraint.dfdu = ocs2::matrix_t::Ones(1, INPUT_DIM);
+  auto constrainedProblem = problem;
+  constrainedProblem.equalityConstraintPtr->add("constraint", ocs2::getOcs2Constraints(constraint));
+
+  // dynamics and rollout
+  ocs2::EXP1_System systemDynamics(referenceManagerPtr);
+  ocs2::TimeTriggeredRollout rollout(systemDynamics, rolloutSettings());
+
+  auto runIteration = [&](const ocs2::ddp::Settings& ddpSettings) {
+    ocs2::ILQR ddp(ddpSettings, rollout, constrainedProblem, *initializerPtr);
+    ddp.setReferenceManager(referenceManagerPtr);
+    ddp.run(startTime, initState, finalTime);
+    return ddp.getValueFunction(startTime, initState);
+  };
+
+  // the first iteration is solved sequentially in the single-thread case. The diagonal shift of the Hessian is a non-zero Riccati
+  // modification, which the parallel pass reproduces.
+  auto ddpSettings = getSettings(ocs2::ddp::Algorithm::ILQR, 1, ocs2::search_strategy::Type::LINE_SEARCH);
+  ddpSettings.maxNumIterations_ = 1;
+  ddpSettings.lineSearch_.hessianCorrectionMultiple = 1e-2;
+  const auto sequentialValueFunction = runIteration(ddpSettings);
+
+  ddpSettings.nThreads_ = 3;
+  ddpSettings.exactParallelRiccati_ = true;
+  const auto parallelValueFunction = runIteration(ddpSettings);
+
+  constexpr ocs2::scalar_t tol = 1e-6;
+  EXPECT_TRUE(parallelValueFunction.dfdxx.isApprox(sequentialValueFunction.dfdxx, tol));
+  EXPECT_TRUE(parallelValueFunction.dfdx.isApprox(sequentialValueFunction.dfdx, tol));
+  EXPECT_NEAR(parallelValueFunction.f, sequentialValueFunction.f, tol * std::abs(sequentialValueFunction.f));
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -33,7 +33,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/misc/LinearAlgebra.h>
 #include <ocs2_core/misc/randomMatrices.h>
+#include <ocs2_ddp/FixedSizeDispatch.h>
 #include <ocs2_ddp/riccati_equations/ContinuousTimeRiccatiEquations.h>
+#include <ocs2_ddp/riccati_equations/DiscreteTimeRiccatiEquations.h>
 
 class RiccatiInitializer {
  public:
@@ -104,6 +106,71 @@ TEST(RiccatiTest, compareImplementations) {
   EXPECT_LE((dSdz_precompute - dSdz_noPrecompute).array().abs().maxCoeff(), 1e-9);
 }
 
+TEST(RiccatiTest, discreteTimeFixedSize) {
+  constexpr int STATE_DIM = 12;
+  constexpr int INPUT_DIM = 4;
+  // the padded problem has an extra decoupled state, therefore it is not dispatched to a fixed-size kernel
+  constexpr int PADDED_STATE_DIM = STATE_DIM + 1;
+
+  using ocs2::matrix_t;
+  using ocs2::vector_t;
+
+  ASSERT_TRUE(ocs2::fixed_size::dispatch(STATE_DIM, INPUT_DIM, [](auto) {}));
+  ASSERT_FALSE(ocs2::fixed_size::dispatch(PADDED_STATE_DIM, INPUT_DIM, [](auto) {}));
+
+  auto pad = [](const matrix_t& m, int extraRows, int extraCols, ocs2::scalar_t extraDiagonal) {
+    matrix_t padded = matrix_t::Zero(m.rows() + extraRows, m.cols() + extraCols);
+    padded.topLeftCorner(m.rows(), m.cols()) = m;
+    if (extraRows > 0 && extraCols > 0) {
+      padded.bottomRightCorner(extraRows, extraCols).diagonal().setConstant(extraDiagonal);
+    }
+    return padded;
+  };
+
+  RiccatiInitializer ri(STATE_DIM, INPUT_DIM);
+  const auto& projectedModelData = ri.projectedModelDataTrajectory.front();
+  auto riccatiModification = ri.riccatiModificationTrajectory.front();
+  riccatiModification.deltaGm_.setRandom();
+  riccatiModification.deltaGv_.setRandom();
+
+  auto paddedModelData = projectedModelData;
+  paddedModelData.stateDim = PADDED_STATE_DIM;
+  paddedModelData.dynamicsBias = pad(projectedModelData.dynamicsBias, 1, 0, 0.0);
+  paddedModelData.dynamics.dfdx = pad(projectedModelData.dynamics.dfdx, 1, 1, 0.5);
+  paddedModelData.dynamics.dfdu = pad(projectedModelData.dynamics.dfdu, 1, 0, 0.0);
+  paddedModelData.cost.dfdx = pad(projectedModelData.cost.dfdx, 1, 0, 0.0);
+  paddedModelData.cost.dfdxx = pad(projectedModelData.cost.dfdxx, 1, 1, 1.0);
+  paddedModelData.cost.dfdux = pad(projectedModelData.cost.dfdux, 0, 1, 0.0);
+  auto paddedRiccatiModification = riccatiModification;
+  paddedRiccatiModification.deltaQm_ = pad(riccatiModification.deltaQm_, 1, 1, 0.0);
+  paddedRiccatiModification.deltaGm_ = pad(riccatiModification.deltaGm_, 0, 1, 0.0);
+
+  const matrix_t SmNext = ocs2::LinearAlgebra::generateSPDmatrix<matrix_t>(STATE_DIM);
+  const vector_t SvNext = vector_t::Random(STATE_DIM);
+  const ocs2::scalar_t sNext = vector_t::Random(1)(0);
+
+  for (const bool reducedFormRiccati : {false, true}) {
+    ocs2::DiscreteTimeRiccatiEquations riccatiEquation(reducedFormRiccati);
+
+    matrix_t Km, Sm;
+    vector_t Lv, Sv;
+    ocs2::scalar_t s;
+    riccatiEquation.computeMap(projectedModelData, riccatiModification, SmNext, SvNext, sNext, Km, Lv, Sm, Sv, s);
+
+    matrix_t paddedKm, paddedSm;
+    vector_t paddedLv, paddedSv;
+    ocs2::scalar_t paddedS;
+    riccatiEquation.computeMap(paddedModelData, paddedRiccatiModification, pad(SmNext, 1, 1, 1.0), pad(SvNext, 1, 0, 0.0), sNext, paddedKm,
+                               paddedLv, paddedSm, paddedSv, paddedS);
+
+    EXPECT_TRUE(Km.isApprox(paddedKm.leftCols(STATE_DIM))) << "reducedFormRiccati: " << reducedFormRiccati;
+    EXPECT_TRUE(Lv.isApprox(paddedLv)) << "reducedFormRiccati: " << reducedFormRiccati;
+    EXPECT_TRUE(Sm.isApprox(paddedSm.topLeftCorner(STATE_DIM, STATE_DIM))) << "reducedFormRiccati: " << reducedFormRiccati;
+    EXPECT_TRUE(Sv.isApprox(paddedSv.head(STATE_DIM))) << "reducedFormRiccati: " << reducedFormRiccati;
+    EXPECT_NEAR(s, paddedS, 1e-9 * std::abs(s)) << "reducedFormRiccati: " << reducedFormRiccati;
+  }
+}
+
 TEST(RiccatiTest, testFlattenSMatrix) {
   const int stateDim = 4;
   using riccati_t = ocs2::ContinuousTimeRiccatiEquations;
@@ -28,10 +28,13 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 
 #include <iostream>
+#include <tuple>
+#include <vector>
 
 #include <gtest/gtest.h>
 
 #include <ocs2_ddp/DDP_HelperFunctions.h>
+#include <ocs2_ddp/FixedSizeDispatch.h>
 
 using namespace ocs2;
 
@@ -99,3 +102,50 @@ TEST(extractPrimalSolution, eventAtInitTime) {
   //  std::cerr << ">>>>>> Test 3\n" << PrimalSolutionTest3 << "\n";
   EXPECT_EQ(PrimalSolutionTest3.timeTrajectory_.size(), 1);
 }
+
+TEST(computeController, fixedSizeMatchesDynamicSize) {
+  // (state, input, projected input) dimensions: the quadrotor and the legged robot in stance and in trot
+  const std::vector<std::tuple<int, int, int>> dimensions{{12, 4, 4}, {24, 24, 12}, {24, 24, 10}};
+
+  for (const auto& dims : dimensions) {
+    const int nx = std::get<0>(dims);
+    const int nu = std::get<1>(dims);
+    const int np = std::get<2>(dims);
+    // the padded problem has an extra state without influence on the controller, therefore it is not dispatched to a fixed-size kernel
+    ASSERT_TRUE(fixed_size::dispatch(nx, np, [](auto) {}));
+    ASSERT_FALSE(fixed_size::dispatch(nx + 1, np, [](auto) {}));
+
+    const vector_t nominalState = vector_t::Random(nx);
+    const vector_t nominalInput = vector_t::Random(nu);
+    const vector_t EvProjected = vector_t::Random(nu);
+    const matrix_t CmProjected = matrix_t::Random(nu, nx);
+    const matrix_t Qu = matrix_t::Random(nu, np);
+    const matrix_t projectedKm = matrix_t::Random(np, nx);
+    const vector_t projectedLv = vector_t::Random(np);
+
+    matrix_t gain;
+    vector_t bias, deltaBias;
+    computeController(nominalState, nominalInput, EvProjected, CmProjected, Qu, projectedKm, projectedLv, gain, bias, deltaBias);
+
+    vector_t paddedNominalState(nx + 1);
+    paddedNominalState << nominalState, 1.0;
+    matrix_t paddedCmProjected = matrix_t::Zero(nu, nx + 1);
+    paddedCmProjected.leftCols(nx) = CmProjected;
+    matrix_t paddedProjectedKm = matrix_t::Zero(np, nx + 1);
+    paddedProjectedKm.leftCols(nx) = projectedKm;
+
+    matrix_t paddedGain;
+    vector_t paddedBias, paddedDeltaBias;
+    computeController(paddedNominalState, nominalInput, EvProjected, paddedCmProjected, Qu, paddedProjectedKm, projectedLv, paddedGain,
+                      paddedBias, paddedDeltaBias);
+
+    const matrix_t expectedGain = -CmProjected + Qu * projectedKm;
+    EXPECT_TRUE(gain.isApprox(expectedGain)) << "dimensions: " << nx << ", " << nu << ", " << np;
+    EXPECT_TRUE(gain.isApprox(paddedGain.leftCols(nx))) << "dimensions: " << nx << ", " << nu << ", " << np;
+    EXPECT_TRUE(paddedGain.rightCols(1).isZero()) << "dimensions: " << nx << ", " << nu << ", " << np;
+    EXPECT_TRUE(bias.isApprox(paddedBias)) << "dimensions: " << nx << ", " << nu << ", " << np;
+    EXPECT_TRUE(bias.isApprox(nominalInput - expectedGain * nominalState)) << "dimensions: " << nx << ", " << nu << ", " << np;
+    EXPECT_TRUE(deltaBias.isApprox(paddedDeltaBias)) << "dimensions: " << nx << ", " << nu << ", " << np;
+    EXPECT_TRUE(deltaBias.isApprox(-EvProjected + Qu * projectedLv)) << "dimensions: " << nx << ", " << nu << ", " << np;
+  }
+}
@@ -0,0 +1,198 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <ocs2_core/misc/LinearAlgebra.h>
+#include <ocs2_core/misc/randomMatrices.h>
+#include <ocs2_ddp/riccati_equations/RiccatiSegment.h>
+
+using namespace ocs2;
+
+namespace {
+
+ModelData getRandomModelData(int stateDim, int inputDim) {
+  ModelData modelData;
+  modelData.stateDim = stateDim;
+  modelData.inputDim = inputDim;
+  modelData.dynamics.dfdx = matrix_t::Identity(stateDim, stateDim) + 0.2 * matrix_t::Random(stateDim, stateDim);
+  modelData.dynamics.dfdu = matrix_t::Random(stateDim, inputDim);
+  modelData.dynamicsBias = vector_t::Random(stateDim);
+  modelData.cost.f = vector_t::Random(1)(0);
+  modelData.cost.dfdx = vector_t::Random(stateDim);
+  modelData.cost.dfdu = vector_t::Random(inputDim);
+  modelData.cost.dfduu = LinearAlgebra::generateSPDmatrix<matrix_t>(inputDim) + matrix_t::Identity(inputDim, inputDim);
+  modelData.cost.dfdux = 0.1 * matrix_t::Random(inputDim, stateDim);
+  modelData.cost.dfdxx = LinearAlgebra::generateSPDmatrix<matrix_t>(stateDim);
+  return modelData;
+}
+
+riccati_modification::Data getRiccatiModification(int stateDim) {
+  riccati_modification::Data riccatiModification;
+  riccatiModification.deltaQm_ = 0.1 * LinearAlgebra::generateSPDmatrix<matrix_t>(stateDim);
+  return riccatiModification;
+}
+
+/** The unconstrained discrete-time Riccati recursion, without assuming a normalized input Hessian. */
+ScalarFunctionQuadraticApproximation riccatiStep(const ModelData& modelData, const riccati_modification::Data& riccatiModification,
+                                                 const ScalarFunctionQuadraticApproximation& valueFunction) {
+  const auto& A = modelData.dynamics.dfdx;
+  const auto& B = modelData.dynamics.dfdu;
+  const auto& h = modelData.dynamicsBias;
+  const auto& S = valueFunction.dfdxx;
+  const vector_t Sv = valueFunction.dfdx + S * h;
+
+  const matrix_t H = modelData.cost.dfduu + B.transpose() * S * B;
+  const matrix_t G = modelData.cost.dfdux + B.transpose() * S * A;
+  const vector_t g = modelData.cost.dfdu + B.transpose() * Sv;
+  const matrix_t invHG = H.ldlt().solve(G);
+  const vector_t invHg = H.ldlt().solve(g);
+
+  ScalarFunctionQuadraticApproximation result;
+  result.dfdxx = modelData.cost.dfdxx + riccatiModification.deltaQm_ + A.transpose() * S * A - G.transpose() * invHG;
+  result.dfdx = modelData.cost.dfdx + A.transpose() * Sv - G.transpose() * invHg;
+  result.f = valueFunction.f + modelData.cost.f + h.dot(valueFunction.dfdx + 0.5 * S * h) - 0.5 * g.dot(invHg);
+  return result;
+}
+
+ScalarFunctionQuadraticApproximation eventStep(const ModelData& jumpModelData, const ScalarFunctionQuadraticApproximation& valueFunction) {
+  const auto& A = jumpModelData.dynamics.dfdx;
+  const auto& h = jumpModelData.dynamicsBias;
+  const auto& S = valueFunction.dfdxx;
+
+  ScalarFunctionQuadraticApproximation result;
+  result.dfdxx = jumpModelData.cost.dfdxx + A.transpose() * S * A;
+  result.dfdx = jumpModelData.cost.dfdx + A.transpose() * (valueFunction.dfdx + S * h);
+  result.f = valueFunction.f + jumpModelData.cost.f + h.dot(valueFunction.dfdx + 0.5 * S * h);
+  return result;
+}
+
+bool isApprox(const ScalarFunctionQuadraticApproximation& lhs, const ScalarFunctionQuadraticApproximation& rhs, scalar_t tol) {
+  return lhs.dfdxx.isApprox(rhs.dfdxx, tol) && lhs.dfdx.isApprox(rhs.dfdx, tol) && std::abs(lhs.f - rhs.f) < tol * (1.0 + std::abs(rhs.f));
+}
+
+}  // unnamed namespace
+
+class RiccatiSegmentTest : public testing::Test {
+ protected:
+  static constexpr int stateDim = 4;
+  static constexpr int inputDim = 2;
+  static constexpr int N = 20;
+  static constexpr int eventIndex = 8;  // the jump takes place between node 8 and 9
+  static constexpr scalar_t tol = 1e-8;
+
+  RiccatiSegmentTest() {
+    srand(0);
+    for (int k = 0; k < N; ++k) {
+      modelDataTrajectory.push_back(getRandomModelData(stateDim, inputDim));
+      riccatiModificationTrajectory.push_back(getRiccatiModification(stateDim));
+    }
+    jumpModelData = getRandomModelData(stateDim, 0);
+
+    finalValueFunction.dfdxx = LinearAlgebra::generateSPDmatrix<matrix_t>(stateDim);
+    finalValueFunction.dfdx = vector_t::Random(stateDim);
+    finalValueFunction.f = 1.0;
+
+    // reference value function by the backward recursion
+    valueFunctionTrajectory.resize(N + 1);
+    valueFunctionTrajectory[N] = finalValueFunction;
+    for (int k = N - 1; k >= 0; --k) {
+      valueFunctionTrajectory[k] =
+          (k == eventIndex) ? eventStep(jumpModelData, valueFunctionTrajectory[k + 1])
+                            : riccatiStep(modelDataTrajectory[k], riccatiModificationTrajectory[k], valueFunctionTrajectory[k + 1]);
+    }
+  }
+
+  RiccatiSegment getNodeSegment(int k) const {
+    return (k == eventIndex) ? eventRiccatiSegment(jumpModelData)
+                             : stageRiccatiSegment(modelDataTrajectory[k], riccatiModificationTrajectory[k]);
+  }
+
+  std::vector<ModelData> modelDataTrajectory;
+  std::vector<riccati_modification::Data> riccatiModificationTrajectory;
+  ModelData jumpModelData;
+  ScalarFunctionQuadraticApproximation finalValueFunction;
+  std::vector<ScalarFunctionQuadraticApproximation> valueFunctionTrajectory;
+};
+
+constexpr int RiccatiSegmentTest::stateDim;
+constexpr int RiccatiSegmentTest::inputDim;
+constexpr int RiccatiSegmentTest::N;
+constexpr int RiccatiSegmentTest::eventIndex;
+constexpr scalar_t RiccatiSegmentTest::tol;
+
+TEST_F(RiccatiSegmentTest, singleStep) {
+  for (int k = 0; k < N; ++k) {
+    const auto valueFunction = applyRiccatiSegment(getNodeSegment(k), valueFunctionTrajectory[k + 1]);
+    EXPECT_TRUE(isApprox(valueFunction, valueFunctionTrajectory[k], tol)) << "node: " << k;
+  }
+}
+
+TEST_F(RiccatiSegmentTest, identity) {
+  const auto identity = identityRiccatiSegment(stateDim);
+  EXPECT_TRUE(isApprox(applyRiccatiSegment(identity, finalValueFunction), finalValueFunction, tol));
+
+  const auto segment = getNodeSegment(0);
+  const auto combined = combineRiccatiSegments(segment, identity);
+  EXPECT_TRUE(combined.A.isApprox(segment.A, tol));
+  EXPECT_TRUE(combined.b.isApprox(segment.b, tol));
+  EXPECT_TRUE(combined.C.isApprox(segment.C, tol));
+  EXPECT_TRUE(combined.J.isApprox(segment.J, tol));
+  EXPECT_TRUE(combined.eta.isApprox(segment.eta, tol));
+  EXPECT_NEAR(combined.c, segment.c, tol);
+}
+
+TEST_F(RiccatiSegmentTest, backwardFolding) {
+  auto segment = identityRiccatiSegment(stateDim);
+  for (int k = N - 1; k >= 0; --k) {
+    segment = combineRiccatiSegments(getNodeSegment(k), segment);
+  }
+  EXPECT_TRUE(isApprox(applyRiccatiSegment(segment, finalValueFunction), valueFunctionTrajectory[0], tol));
+}
+
+TEST_F(RiccatiSegmentTest, partitions) {
+  const std::vector<int> partitionPoints{0, 5, 9, 14, N};
+  const int numPartitions = partitionPoints.size() - 1;
+
+  std::vector<RiccatiSegment> partitionSegments;
+  for (int i = 0; i < numPartitions; ++i) {
+    // forward folding to test the associativity
+    auto segment = identityRiccatiSegment(stateDim);
+    for (int k = partitionPoints[i]; k < partitionPoints[i + 1]; ++k) {
+      segment = combineRiccatiSegments(segment, getNodeSegment(k));
+    }
+    partitionSegments.push_back(segment);
+  }
+
+  auto valueFunction = finalValueFunction;
+  for (int i = numPartitions - 1; i >= 0; --i) {
+    valueFunction = applyRiccatiSegment(partitionSegments[i], valueFunction);
+    EXPECT_TRUE(isApprox(valueFunction, valueFunctionTrajectory[partitionPoints[i]], tol)) << "partition: " << i;
+  }
+}
@@ -64,7 +64,15 @@ struct Settings {
 
   // Discretization method
   scalar_t dt = 0.01;  // user-defined time discretization
+  // Non-uniform discretization: the step is dt at the initial time and around the events, and grows geometrically with dtGrowthRate
+  // away from them, up to dtMax. A growth rate of 1.0 gives the uniform discretization.
+  scalar_t dtGrowthRate = 1.0;
+  scalar_t dtMax = 0.1;
   SensitivityIntegratorType integratorType = SensitivityIntegratorType::RK2;
+  // Aligns the time discretization to the grid {k * dt}, such that consecutive MPC horizons share their nodes and the previous solution
+  // is shifted to the new horizon instead of interpolated. The number of nodes stays constant, which preserves the QP sparsity structure.
+  // It can not be combined with the non-uniform discretization (dtGrowthRate > 1.0), the solver throws in that case.
+  bool horizonShiftingWarmStart = false;
 
   // Barrier strategy of the primal-dual interior point method. Conventions follows Ipopt.
   scalar_t initialBarrierParameter = 1.0e-02;  // Initial value of the barrier parameter
@@ -95,6 +103,8 @@ struct Settings {
   // Threading
   size_t nThreads = 4;
   int threadPriority = 50;
+  std::string threadAffinity;                     // CPUs of the worker threads in cpulist format, e.g. "0-3,8". Empty to not pin them
+  std::vector<std::string> workerThreadAffinity;  // CPUs per worker index in cpulist format, a non-empty entry overrides threadAffinity
 };
 
 /**
@@ -33,6 +33,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <iostream>
 #include <numeric>
 
+#include <ocs2_core/misc/Trace.h>
+#include <ocs2_core/thread_support/SetThreadAffinity.h>
+
 #include <ocs2_oc/approximate_model/LinearQuadraticApproximator.h>
 #include <ocs2_oc/multiple_shooting/Helpers.h>
 #include <ocs2_oc/multiple_shooting/Initialization.h>
@@ -66,7 +69,8 @@ ipm::Settings rectifySettings(const OptimalControlProblem& ocp, ipm::Settings&&
 IpmSolver::IpmSolver(ipm::Settings settings, const OptimalControlProblem& optimalControlProblem, const Initializer& initializer)
     : settings_(rectifySettings(optimalControlProblem, std::move(settings))),
       hpipmInterface_(OcpSize(), settings_.hpipmSettings),
-      threadPool_(std::max(settings_.nThreads, size_t(1)) - 1, settings_.threadPriority) {
+      threadPool_(std::max(settings_.nThreads, size_t(1)) - 1, settings_.threadPriority,
+                  getWorkerCpuSets(settings_.threadAffinity, settings_.workerThreadAffinity, settings_.nThreads)) {
   Eigen::setNbThreads(1);  // No multithreading within Eigen.
   Eigen::initParallel();
 
@@ -74,9 +78,11 @@ IpmSolver::IpmSolver(ipm::Settings settings, const OptimalControlProblem& optima
   discretizer_ = selectDynamicsDiscretization(settings_.integratorType);
   sensitivityDiscretizer_ = selectDynamicsSensitivityDiscretization(settings_.integratorType);
 
-  // Clone objects to have one for each worker
+  // Clone objects to have one for each worker. The copies are created on the CPUs of the worker such that they are allocated on its
+  // NUMA node (first-touch).
+  ocpDefinitions_.reserve(settings_.nThreads);
   for (int w = 0; w < settings_.nThreads; w++) {
-    ocpDefinitions_.push_back(optimalControlProblem);
+    runOnCpus(threadPool_.getCpuAffinity(w), [&] { ocpDefinitions_.push_back(optimalControlProblem); });
   }
 
   // Operating points
@@ -201,6 +207,7 @@ MultiplierCollection IpmSolver::getIntermediateDualSolution(scalar_t time) const
 }
 
 void IpmSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t finalTime) {
+  OCS2_TRACE_ZONE("IpmSolver::run");
   if (settings_.printSolverStatus || settings_.printLinesearch) {
     std::cerr << "\n++++++++++++++++++++++++++++++++++++++++++++++++++++++";
     std::cerr << "\n+++++++++++++ IPM solver is initialized ++++++++++++++";
@@ -209,7 +216,8 @@ void IpmSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
 
   // Determine time discretization, taking into account event times.
   const auto& eventTimes = this->getReferenceManager().getModeSchedule().eventTimes;
-  const auto timeDiscretization = timeDiscretizationWithEvents(initTime, finalTime, settings_.dt, eventTimes);
+  const auto timeDiscretization = getTimeDiscretization(initTime, finalTime, settings_.dt, settings_.dtGrowthRate, settings_.dtMax,
+                                                        settings_.horizonShiftingWarmStart, eventTimes);
 
   // Initialize references
   for (auto& ocpDefinition : ocpDefinitions_) {
@@ -227,7 +235,11 @@ void IpmSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
     std::ignore = trajectorySpread(oldModeSchedule, newModeSchedule, primalSolution_);
   }
   vector_array_t x, u;
-  multiple_shooting::initializeStateInputTrajectories(initState, timeDiscretization, primalSolution_, *initializerPtr_, x, u);
+  if (settings_.horizonShiftingWarmStart) {
+    multiple_shooting::shiftStateInputTrajectories(initState, timeDiscretization, primalSolution_, *initializerPtr_, x, u);
+  } else {
+    multiple_shooting::initializeStateInputTrajectories(initState, timeDiscretization, primalSolution_, *initializerPtr_, x, u);
+  }
 
   // Initialize the slack and dual variables of the interior point method
   if (!slackIneqTrajectory_.timeTrajectory.empty()) {
@@ -254,6 +266,7 @@ void IpmSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
   int iter = 0;
   ipm::Convergence convergence = ipm::Convergence::FALSE;
   while (convergence == ipm::Convergence::FALSE) {
+    OCS2_TRACE_ZONE("IpmSolver::iteration");
     if (settings_.printSolverStatus || settings_.printLinesearch) {
       std::cerr << "\nIPM iteration: " << iter << " (barrier parameter: " << barrierParam << ")\n";
     }
@@ -286,6 +299,12 @@ void IpmSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
     // Check convergence
     convergence = checkConvergence(iter, barrierParam, baselinePerformance, stepInfo);
 
+    // Publish the intermediate iterate
+    if (convergence == ipm::Convergence::FALSE && this->hasIntermediateSolutionCallback()) {
+      const auto intermediateSolution = toPrimalSolution(timeDiscretization, vector_array_t(x), vector_array_t(u));
+      this->publishIntermediateSolution(intermediateSolution, stepInfo.performanceAfterStep);
+    }
+
     // Update the barrier parameter
     barrierParam = updateBarrierParameter(barrierParam, baselinePerformance, stepInfo);
 
@@ -311,8 +330,9 @@ void IpmSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
   }
 }
 
-void IpmSolver::runParallel(std::function<void(int)> taskFunction) {
-  threadPool_.runParallel(std::move(taskFunction), settings_.nThreads);
+template <typename Functor>
+void IpmSolver::parallelFor(int begin, int end, Functor&& taskFunction) {
+  threadPool_.parallelFor(begin, end, 1, std::forward<Functor>(taskFunction));
 }
 
 void IpmSolver::initializeCostateTrajectory(const std::vector<AnnotatedTime>& timeDiscretization, const vector_array_t& stateTrajectory,
@@ -440,7 +460,7 @@ void IpmSolver::initializeSlackDualTrajectory(const std::vector<AnnotatedTime>&
         std::tie(slackStateIneq[i], slackStateInputIneq[i]) =
             ipm::fromMultiplierCollection(getIntermediateDualSolutionAtTime(slackIneqTrajectory_, time));
         std::tie(dualStateIneq[i], dualStateInputIneq[i]) =
-            ipm::fromMultiplierCollection(getIntermediateDualSolutionAtTime(slackIneqTrajectory_, time));
+            ipm::fromMultiplierCollection(getIntermediateDualSolutionAtTime(dualIneqTrajectory_, time));
       } else {
         std::tie(slackStateIneq[i], slackStateInputIneq[i]) = ipm::initializeIntermediateSlackVariable(
             ocpDefinition, time, x[i], u[i], settings_.initialSlackLowerBound, settings_.initialSlackMarginRate);
@@ -471,6 +491,7 @@ IpmSolver::OcpSubproblemSolution IpmSolver::getOCPSolution(const vector_t& delta
                                                            const vector_array_t& slackStateIneq, const vector_array_t& dualStateIneq,
                                                            const vector_array_t& slackStateInputIneq,
                                                            const vector_array_t& dualStateInputIneq) {
+  OCS2_TRACE_ZONE("IpmSolver::solveQp");
   // Solve the QP
   OcpSubproblemSolution solution;
   auto& deltaXSol = solution.deltaXSol;
@@ -510,13 +531,26 @@ IpmSolver::OcpSubproblemSolution IpmSolver::getOCPSolution(const vector_t& delta
   scalar_array_t primalStepSizes(settings_.nThreads, 1.0);
   scalar_array_t dualStepSizes(settings_.nThreads, 1.0);
 
-  std::atomic_int timeIndex{0};
-  auto parallelTask = [&](int workerId) {
+  vector_array_t tmpArray(settings_.nThreads);  // 1 temporary per worker for re-use for projection.
+  auto parallelTask = [&](int workerId, int i) {
     // Get worker specific resources
-    vector_t tmp;  // 1 temporary for re-use for projection.
+    vector_t& tmp = tmpArray[workerId];
 
-    int i = timeIndex++;
-    while (i < N) {
+    if (i == N) {
+      // Terminal node
+      deltaSlackStateIneq[i] = ipm::retrieveSlackDirection(stateIneqConstraints_[i], deltaXSol[i], barrierParam, slackStateIneq[i]);
+      deltaDualStateIneq[i] = ipm::retrieveDualDirection(barrierParam, slackStateIneq[i], dualStateIneq[i], deltaSlackStateIneq[i]);
+      primalStepSizes[workerId] =
+          std::min(primalStepSizes[workerId],
+                   ipm::fractionToBoundaryStepSize(slackStateIneq[i], deltaSlackStateIneq[i], settings_.fractionToBoundaryMargin));
+      dualStepSizes[workerId] = std::min(dualStepSizes[workerId], ipm::fractionToBoundaryStepSize(dualStateIneq[i], deltaDualStateIneq[i],
+                                                                                                  settings_.fractionToBoundaryMargin));
+      // Extract Newton directions of the costate
+      if (settings_.computeLagrangeMultipliers) {
+        deltaLmdSol[0] = valueFunction_[0].dfdx;
+        deltaLmdSol[0].noalias() += valueFunction_[i].dfdxx * deltaXSol[0];
+      }
+    } else {
       deltaSlackStateIneq[i] = ipm::retrieveSlackDirection(stateIneqConstraints_[i], deltaXSol[i], barrierParam, slackStateIneq[i]);
       deltaDualStateIneq[i] = ipm::retrieveDualDirection(barrierParam, slackStateIneq[i], dualStateIneq[i], deltaSlackStateIneq[i]);
       deltaSlackStateInputIneq[i] =
@@ -550,26 +584,9 @@ IpmSolver::OcpSubproblemSolution IpmSolver::getOCPSolution(const vector_t& delta
         deltaUSol[i] = tmp + constraintsProjection_[i].f;
         deltaUSol[i].noalias() += constraintsProjection_[i].dfdx * deltaXSol[i];
       }
-
-      i = timeIndex++;
-    }
-
-    if (i == N) {  // Only one worker will execute this
-      deltaSlackStateIneq[i] = ipm::retrieveSlackDirection(stateIneqConstraints_[i], deltaXSol[i], barrierParam, slackStateIneq[i]);
-      deltaDualStateIneq[i] = ipm::retrieveDualDirection(barrierParam, slackStateIneq[i], dualStateIneq[i], deltaSlackStateIneq[i]);
-      primalStepSizes[workerId] =
-          std::min(primalStepSizes[workerId],
-                   ipm::fractionToBoundaryStepSize(slackStateIneq[i], deltaSlackStateIneq[i], settings_.fractionToBoundaryMargin));
-      dualStepSizes[workerId] = std::min(dualStepSizes[workerId], ipm::fractionToBoundaryStepSize(dualStateIneq[i], deltaDualStateIneq[i],
-                                                                                                  settings_.fractionToBoundaryMargin));
-      // Extract Newton directions of the costate
-      if (settings_.computeLagrangeMultipliers) {
-        deltaLmdSol[0] = valueFunction_[0].dfdx;
-        deltaLmdSol[0].noalias() += valueFunction_[i].dfdxx * deltaXSol[0];
-      }
     }
   };
-  runParallel(std::move(parallelTask));
+  parallelFor(0, N + 1, std::move(parallelTask));
 
   solution.maxPrimalStepSize = *std::min_element(primalStepSizes.begin(), primalStepSizes.end());
   solution.maxDualStepSize = *std::min_element(dualStepSizes.begin(), dualStepSizes.end());
@@ -591,6 +608,7 @@ void IpmSolver::extractValueFunction(const std::vector<AnnotatedTime>& time, con
 }
 
 PrimalSolution IpmSolver::toPrimalSolution(const std::vector<AnnotatedTime>& time, vector_array_t&& x, vector_array_t&& u) {
+  OCS2_TRACE_ZONE("IpmSolver::toPrimalSolution");
   if (settings_.useFeedbackPolicy) {
     ModeSchedule modeSchedule = this->getReferenceManager().getModeSchedule();
     matrix_array_t KMatrices = hpipmInterface_.getRiccatiFeedback(dynamics_[0], lagrangian_[0]);
@@ -608,6 +626,7 @@ PerformanceIndex IpmSolver::setupQuadraticSubproblem(const std::vector<Annotated
                                                      const vector_array_t& nu, scalar_t barrierParam, const vector_array_t& slackStateIneq,
                                                      const vector_array_t& slackStateInputIneq, const vector_array_t& dualStateIneq,
                                                      const vector_array_t& dualStateInputIneq, std::vector<Metrics>& metrics) {
+  OCS2_TRACE_ZONE("IpmSolver::setupQuadraticSubproblem");
   // Problem horizon
   const int N = static_cast<int>(time.size()) - 1;
 
@@ -622,76 +641,13 @@ PerformanceIndex IpmSolver::setupQuadraticSubproblem(const std::vector<Annotated
   constraintsSize_.resize(N + 1);
   metrics.resize(N + 1);
 
-  std::atomic_int timeIndex{0};
-  auto parallelTask = [&](int workerId) {
+  auto parallelTask = [&](int workerId, int i) {
+    OCS2_TRACE_ZONE("IpmSolver::setupNode");
     // Get worker specific resources
     OptimalControlProblem& ocpDefinition = ocpDefinitions_[workerId];
 
-    int i = timeIndex++;
-    while (i < N) {
-      if (time[i].event == AnnotatedTime::Event::PreEvent) {
-        // Event node
-        auto result = multiple_shooting::setupEventNode(ocpDefinition, time[i].time, x[i], x[i + 1]);
-        metrics[i] = multiple_shooting::computeMetrics(result);
-        performance[workerId] += ipm::computePerformanceIndex(result, barrierParam, slackStateIneq[i]);
-        dynamics_[i] = std::move(result.dynamics);
-        stateInputEqConstraints_[i].resize(0, x[i].size());
-        stateIneqConstraints_[i] = std::move(result.ineqConstraints);
-        stateInputIneqConstraints_[i].resize(0, x[i].size());
-        constraintsProjection_[i].resize(0, x[i].size());
-        projectionMultiplierCoefficients_[i] = multiple_shooting::ProjectionMultiplierCoefficients();
-        constraintsSize_[i] = std::move(result.constraintsSize);
-        if (settings_.computeLagrangeMultipliers) {
-          lagrangian_[i] = multiple_shooting::evaluateLagrangianEventNode(lmd[i], lmd[i + 1], std::move(result.cost), dynamics_[i]);
-        } else {
-          lagrangian_[i] = std::move(result.cost);
-        }
-
-        ipm::condenseIneqConstraints(barrierParam, slackStateIneq[i], dualStateIneq[i], stateIneqConstraints_[i], lagrangian_[i]);
-        performance[workerId].dualFeasibilitiesSSE += multiple_shooting::evaluateDualFeasibilities(lagrangian_[i]);
-        performance[workerId].dualFeasibilitiesSSE +=
-            ipm::evaluateComplementarySlackness(barrierParam, slackStateIneq[i], dualStateIneq[i]);
-      } else {
-        // Normal, intermediate node
-        const scalar_t ti = getIntervalStart(time[i]);
-        const scalar_t dt = getIntervalDuration(time[i], time[i + 1]);
-        auto result = multiple_shooting::setupIntermediateNode(ocpDefinition, sensitivityDiscretizer_, ti, dt, x[i], x[i + 1], u[i]);
-        // Disable the state-only inequality constraints at the initial node
-        if (i == 0) {
-          result.stateIneqConstraints.setZero(0, x[i].size());
-          std::fill(result.constraintsSize.stateIneq.begin(), result.constraintsSize.stateIneq.end(), 0);
-        }
-        metrics[i] = multiple_shooting::computeMetrics(result);
-        performance[workerId] += ipm::computePerformanceIndex(result, dt, barrierParam, slackStateIneq[i], slackStateInputIneq[i]);
-        multiple_shooting::projectTranscription(result, settings_.computeLagrangeMultipliers);
-        dynamics_[i] = std::move(result.dynamics);
-        stateInputEqConstraints_[i] = std::move(result.stateInputEqConstraints);
-        stateIneqConstraints_[i] = std::move(result.stateIneqConstraints);
-        stateInputIneqConstraints_[i] = std::move(result.stateInputIneqConstraints);
-        constraintsProjection_[i] = std::move(result.constraintsProjection);
-        projectionMultiplierCoefficients_[i] = std::move(result.projectionMultiplierCoefficients);
-        constraintsSize_[i] = std::move(result.constraintsSize);
-        if (settings_.computeLagrangeMultipliers) {
-          lagrangian_[i] = multiple_shooting::evaluateLagrangianIntermediateNode(lmd[i], lmd[i + 1], nu[i], std::move(result.cost),
-                                                                                 dynamics_[i], stateInputEqConstraints_[i]);
-        } else {
-          lagrangian_[i] = std::move(result.cost);
-        }
-
-        ipm::condenseIneqConstraints(barrierParam, slackStateIneq[i], dualStateIneq[i], stateIneqConstraints_[i], lagrangian_[i]);
-        ipm::condenseIneqConstraints(barrierParam, slackStateInputIneq[i], dualStateInputIneq[i], stateInputIneqConstraints_[i],
-                                     lagrangian_[i]);
-        performance[workerId].dualFeasibilitiesSSE += multiple_shooting::evaluateDualFeasibilities(lagrangian_[i]);
-        performance[workerId].dualFeasibilitiesSSE +=
-            ipm::evaluateComplementarySlackness(barrierParam, slackStateIneq[i], dualStateIneq[i]);
-        performance[workerId].dualFeasibilitiesSSE +=
-            ipm::evaluateComplementarySlackness(barrierParam, slackStateInputIneq[i], dualStateInputIneq[i]);
-      }
-
-      i = timeIndex++;
-    }
-
-    if (i == N) {  // Only one worker will execute this
+    if (i == N) {
+      // Terminal node
       const scalar_t tN = getIntervalStart(time[N]);
       auto result = multiple_shooting::setupTerminalNode(ocpDefinition, tN, x[N]);
       metrics[i] = multiple_shooting::computeMetrics(result);
@@ -707,9 +663,66 @@ PerformanceIndex IpmSolver::setupQuadraticSubproblem(const std::vector<Annotated
       ipm::condenseIneqConstraints(barrierParam, slackStateIneq[N], dualStateIneq[N], stateIneqConstraints_[N], lagrangian_[N]);
       performance[workerId].dualFeasibilitiesSSE += multiple_shooting::evaluateDualFeasibilities(lagrangian_[N]);
       performance[workerId].dualFeasibilitiesSSE += ipm::evaluateComplementarySlackness(barrierParam, slackStateIneq[N], dualStateIneq[N]);
+    } else if (time[i].event == AnnotatedTime::Event::PreEvent) {
+      // Event node
+      auto result = multiple_shooting::setupEventNode(ocpDefinition, time[i].time, x[i], x[i + 1]);
+      metrics[i] = multiple_shooting::computeMetrics(result);
+      performance[workerId] += ipm::computePerformanceIndex(result, barrierParam, slackStateIneq[i]);
+      dynamics_[i] = std::move(result.dynamics);
+      stateInputEqConstraints_[i].resize(0, x[i].size());
+      stateIneqConstraints_[i] = std::move(result.ineqConstraints);
+      stateInputIneqConstraints_[i].resize(0, x[i].size());
+      constraintsProjection_[i].resize(0, x[i].size());
+      projectionMultiplierCoefficients_[i] = multiple_shooting::ProjectionMultiplierCoefficients();
+      constraintsSize_[i] = std::move(result.constraintsSize);
+      if (settings_.computeLagrangeMultipliers) {
+        lagrangian_[i] = multiple_shooting::evaluateLagrangianEventNode(lmd[i], lmd[i + 1], std::move(result.cost), dynamics_[i]);
+      } else {
+        lagrangian_[i] = std::move(result.cost);
+      }
+
+      ipm::condenseIneqConstraints(barrierParam, slackStateIneq[i], dualStateIneq[i], stateIneqConstraints_[i], lagrangian_[i]);
+      performance[workerId].dualFeasibilitiesSSE += multiple_shooting::evaluateDualFeasibilities(lagrangian_[i]);
+      performance[workerId].dualFeasibilitiesSSE +=
+          ipm::evaluateComplementarySlackness(barrierParam, slackStateIneq[i], dualStateIneq[i]);
+    } else {
+      // Normal, intermediate node
+      const scalar_t ti = getIntervalStart(time[i]);
+      const scalar_t dt = getIntervalDuration(time[i], time[i + 1]);
+      auto result = multiple_shooting::setupIntermediateNode(ocpDefinition, sensitivityDiscretizer_, ti, dt, x[i], x[i + 1], u[i]);
+      // Disable the state-only inequality constraints at the initial node
+      if (i == 0) {
+        result.stateIneqConstraints.setZero(0, x[i].size());
+        std::fill(result.constraintsSize.stateIneq.begin(), result.constraintsSize.stateIneq.end(), 0);
+      }
+      metrics[i] = multiple_shooting::computeMetrics(result);
+      performance[workerId] += ipm::computePerformanceIndex(result, dt, barrierParam, slackStateIneq[i], slackStateInputIneq[i]);
+      multiple_shooting::projectTranscription(result, settings_.computeLagrangeMultipliers);
+      dynamics_[i] = std::move(result.dynamics);
+      stateInputEqConstraints_[i] = std::move(result.stateInputEqConstraints);
+      stateIneqConstraints_[i] = std::move(result.stateIneqConstraints);
+      stateInputIneqConstraints_[i] = std::move(result.stateInputIneqConstraints);
+      constraintsProjection_[i] = std::move(result.constraintsProjection);
+      projectionMultiplierCoefficients_[i] = std::move(result.projectionMultiplierCoefficients);
+      constraintsSize_[i] = std::move(result.constraintsSize);
+      if (settings_.computeLagrangeMultipliers) {
+        lagrangian_[i] = multiple_shooting::evaluateLagrangianIntermediateNode(lmd[i], lmd[i + 1], nu[i], std::move(result.cost),
+                                                                               dynamics_[i], stateInputEqConstraints_[i]);
+      } else {
+        lagrangian_[i] = std::move(result.cost);
+      }
+
+      ipm::condenseIneqConstraints(barrierParam, slackStateIneq[i], dualStateIneq[i], stateIneqConstraints_[i], lagrangian_[i]);
+      ipm::condenseIneqConstraints(barrierParam, slackStateInputIneq[i], dualStateInputIneq[i], stateInputIneqConstraints_[i],
+                                   lagrangian_[i]);
+      performance[workerId].dualFeasibilitiesSSE += multiple_shooting::evaluateDualFeasibilities(lagrangian_[i]);
+      performance[workerId].dualFeasibilitiesSSE +=
+          ipm::evaluateComplementarySlackness(barrierParam, slackStateIneq[i], dualStateIneq[i]);
+      performance[workerId].dualFeasibilitiesSSE +=
+          ipm::evaluateComplementarySlackness(barrierParam, slackStateInputIneq[i], dualStateInputIneq[i]);
     }
   };
-  runParallel(std::move(parallelTask));
+  parallelFor(0, N + 1, std::move(parallelTask));
 
   // Account for initial state in performance
   const vector_t initDynamicsViolation = initState - x.front();
@@ -726,45 +739,39 @@ PerformanceIndex IpmSolver::setupQuadraticSubproblem(const std::vector<Annotated
 PerformanceIndex IpmSolver::computePerformance(const std::vector<AnnotatedTime>& time, const vector_t& initState, const vector_array_t& x,
                                                const vector_array_t& u, scalar_t barrierParam, const vector_array_t& slackStateIneq,
                                                const vector_array_t& slackStateInputIneq, std::vector<Metrics>& metrics) {
+  OCS2_TRACE_ZONE("IpmSolver::computePerformance");
   // Problem horizon
   const int N = static_cast<int>(time.size()) - 1;
   metrics.resize(N + 1);
 
   std::vector<PerformanceIndex> performance(settings_.nThreads, PerformanceIndex());
-  std::atomic_int timeIndex{0};
-  auto parallelTask = [&](int workerId) {
+  auto parallelTask = [&](int workerId, int i) {
     // Get worker specific resources
     OptimalControlProblem& ocpDefinition = ocpDefinitions_[workerId];
 
-    int i = timeIndex++;
-    while (i < N) {
-      if (time[i].event == AnnotatedTime::Event::PreEvent) {
-        // Event node
-        metrics[i] = multiple_shooting::computeEventMetrics(ocpDefinition, time[i].time, x[i], x[i + 1]);
-        performance[workerId] += ipm::toPerformanceIndex(metrics[i], barrierParam, slackStateIneq[i]);
-      } else {
-        // Normal, intermediate node
-        const scalar_t ti = getIntervalStart(time[i]);
-        const scalar_t dt = getIntervalDuration(time[i], time[i + 1]);
-        const bool enableStateInequalityConstraints = (i > 0);
-        metrics[i] = multiple_shooting::computeIntermediateMetrics(ocpDefinition, discretizer_, ti, dt, x[i], x[i + 1], u[i]);
-        // Disable the state-only inequality constraints at the initial node
-        if (i == 0) {
-          metrics[i].stateIneqConstraint.clear();
-        }
-        performance[workerId] += ipm::toPerformanceIndex(metrics[i], dt, barrierParam, slackStateIneq[i], slackStateInputIneq[i]);
-      }
-
-      i = timeIndex++;
-    }
-
-    if (i == N) {  // Only one worker will execute this
+    if (i == N) {
+      // Terminal node
       const scalar_t tN = getIntervalStart(time[N]);
       metrics[N] = multiple_shooting::computeTerminalMetrics(ocpDefinition, tN, x[N]);
       performance[workerId] += ipm::toPerformanceIndex(metrics[N], barrierParam, slackStateIneq[N]);
+    } else if (time[i].event == AnnotatedTime::Event::PreEvent) {
+      // Event node
+      metrics[i] = multiple_shooting::computeEventMetrics(ocpDefinition, time[i].time, x[i], x[i + 1]);
+      performance[workerId] += ipm::toPerformanceIndex(metrics[i], barrierParam, slackStateIneq[i]);
+    } else {
+      // Normal, intermediate node
+      const scalar_t ti = getIntervalStart(time[i]);
+      const scalar_t dt = getIntervalDuration(time[i], time[i + 1]);
+      const bool enableStateInequalityConstraints = (i > 0);
+      metrics[i] = multiple_shooting::computeIntermediateMetrics(ocpDefinition, discretizer_, ti, dt, x[i], x[i + 1], u[i]);
+      // Disable the state-only inequality constraints at the initial node
+      if (i == 0) {
+        metrics[i].stateIneqConstraint.clear();
+      }
+      performance[workerId] += ipm::toPerformanceIndex(metrics[i], dt, barrierParam, slackStateIneq[i], slackStateInputIneq[i]);
     }
   };
-  runParallel(std::move(parallelTask));
+  parallelFor(0, N + 1, std::move(parallelTask));
 
   // Account for initial state in performance
   const vector_t initDynamicsViolation = initState - x.front();
@@ -781,6 +788,7 @@ ipm::StepInfo IpmSolver::takePrimalStep(const PerformanceIndex& baseline, const
                                         const vector_t& initState, const OcpSubproblemSolution& subproblemSolution, vector_array_t& x,
                                         vector_array_t& u, scalar_t barrierParam, vector_array_t& slackStateIneq,
                                         vector_array_t& slackStateInputIneq, std::vector<Metrics>& metrics) {
+  OCS2_TRACE_ZONE("IpmSolver::takePrimalStep");
   using StepType = FilterLinesearch::StepType;
 
   /*
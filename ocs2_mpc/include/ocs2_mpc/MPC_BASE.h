@@ -67,6 +67,12 @@ class MPC_BASE {
    */
   virtual bool run(scalar_t currentTime, const vector_t& currentState);
 
+  /**
+   * Prepares the next call of run() before its state is measured, e.g., the preparation phase of a real-time iteration. The MPC
+   * interfaces call it after the solution of run() has been passed on. The default implementation does nothing.
+   */
+  virtual void prepareNextRun() {}
+
   /** Gets a pointer to the underlying solver used in the MPC. */
   virtual SolverBase* getSolverPtr() = 0;
 
@@ -79,6 +85,14 @@ class MPC_BASE {
   /** Gets the MPC settings. */
   const mpc::Settings& settings() const { return mpcSettings_; }
 
+  /**
+   * Sets a callback which receives the intermediate iterates of the solver while run() is in progress. It is only installed if
+   * mpc::Settings::publishIntermediateSolutions_ is set, and it only receives the iterates which pass the quality gate of
+   * mpc::Settings::intermediateSolutionMaxConstraintViolation_. The final solution is still retrieved from the solver after
+   * run() has returned. The callback is called from the thread running run(). Pass an empty function to remove it.
+   */
+  void setIntermediateSolutionCallback(SolverBase::intermediate_solution_callback_t callback);
+
  protected:
   /**
    * Solves the optimal control problem for the given state and time period ([initTime,finalTime]).
@@ -51,11 +51,12 @@ class MPC_MRT_Interface final : public MRT_BASE {
  public:
   /**
    * Constructor
-   * @param [in] mpc: The underlying MPC class to be used.
+   * @param [in] mpc: The underlying MPC class to be used. If mpc::Settings::publishIntermediateSolutions_ is set, the
+   * intermediate iterates of the solver which pass the quality gate are moved to the buffer while advanceMpc() is running.
    */
   explicit MPC_MRT_Interface(MPC_BASE& mpc);
 
-  ~MPC_MRT_Interface() override = default;
+  ~MPC_MRT_Interface() override;
 
   void resetMpcNode(const TargetTrajectories& initTargetTrajectories) override;
 
@@ -123,12 +124,24 @@ class MPC_MRT_Interface final : public MRT_BASE {
    */
   void copyToBuffer(const SystemObservation& mpcInitObservation);
 
+  /**
+   * Moves an intermediate iterate of the solver to the buffer. This method is called by the solver through MPC_BASE while
+   * advanceMpc() is running.
+   *
+   * @param [in] primalSolution: The primal solution of the iterate.
+   * @param [in] performanceIndex: The performance index of the iterate.
+   */
+  void copyIntermediateSolutionToBuffer(const PrimalSolution& primalSolution, const PerformanceIndex& performanceIndex);
+
   MPC_BASE& mpc_;
   benchmark::RepeatedTimer mpcTimer_;
 
   // MPC inputs
   SystemObservation currentObservation_;
   std::mutex observationMutex_;
+
+  // The observation of the ongoing advanceMpc() call
+  SystemObservation mpcInitObservation_;
 };
 
 }  // namespace ocs2
@@ -56,6 +56,17 @@ struct Settings {
    * or the given operating trajectories (cold start). */
   bool coldStart_ = false;
 
+  /**
+   * This value determines to publish the intermediate iterates of the solver before it has converged, see
+   * MPC_BASE::setIntermediateSolutionCallback(). Only the solvers which support it (SQP, SLP, and IPM) provide such iterates.
+   */
+  bool publishIntermediateSolutions_ = false;
+  /**
+   * The quality gate for the intermediate iterates. An iterate is only published if its total constraint violation, i.e., the
+   * norm of the dynamics and equality constraint violations as used by the filter line-search, is not above this value.
+   */
+  scalar_t intermediateSolutionMaxConstraintViolation_ = 1e-3;
+
   /**
    * MPC loop frequency in Hz. This setting is only used in Dummy_Loop for testing. If set to a
    * positive number, THe MPC loop will be simulated to run by the given frequency (note that this
@@ -31,17 +31,21 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <Eigen/Dense>
 
+#include <array>
 #include <atomic>
 #include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <mutex>
 
 #include <ocs2_core/Types.h>
 #include <ocs2_core/control/ControllerBase.h>
+#include <ocs2_core/misc/AllocationTracking.h>
 #include <ocs2_core/misc/LinearInterpolation.h>
 #include <ocs2_core/reference/ModeSchedule.h>
 #include <ocs2_core/reference/TargetTrajectories.h>
 #include <ocs2_oc/oc_data/PerformanceIndex.h>
+#include <ocs2_oc/oc_data/PolicyEvaluator.h>
 #include <ocs2_oc/oc_data/PrimalSolution.h>
 #include <ocs2_oc/rollout/RolloutBase.h>
 
@@ -54,6 +58,10 @@ namespace ocs2 {
 /**
  * This class implements core MRT (Model Reference Tracking) functionality.
  * The responsibility of filling the buffer variables is left to the deriving classes.
+ *
+ * The policies are exchanged through a triple buffer: the active policy is owned by the thread calling updatePolicy(), the buffered
+ * policy by moveToBuffer(), and the third one is passed between them with a single atomic exchange. Hence updatePolicy() never
+ * blocks and never frees memory, independent of the time spent in moveToBuffer() and the MrtObserver callbacks.
  */
 class MRT_BASE {
  public:
@@ -63,6 +71,7 @@ class MRT_BASE {
 
   /**
    * Resets the class to its instantiated state.
+   * @warning must not be called concurrently with updatePolicy() or the policy evaluation.
    */
   void reset();
 
@@ -114,9 +123,21 @@ class MRT_BASE {
    */
   void initRollout(const RolloutBase* rolloutPtr);
 
+  /**
+   * Resamples the policies at a fixed period when they are moved to the buffer, such that evaluatePolicy() computes the interval of the
+   * query time directly, see PolicyEvaluator. Applies to the policies received after the call.
+   * @note A resampled policy does not reflect the changes of MrtObserver::modifyActiveSolution() to the state and controller
+   * trajectories, as the resampling is done before. Such changes should be done in MrtObserver::modifyBufferedSolution().
+   *
+   * @param [in] period: The resampling period. A non-positive value disables the resampling (default).
+   */
+  void setPolicyResamplingPeriod(scalar_t period);
+
   /**
    * @brief Evaluates the controller
    *
+   * The evaluation caches the interval of the last query, and does not allocate once the outputs are sized, see PolicyEvaluator.
+   *
    * @param [in] currentTime: the query time.
    * @param [in] currentState: the query state.
    * @param [out] mpcState: the current nominal state of MPC.
@@ -125,6 +146,12 @@ class MRT_BASE {
    */
   void evaluatePolicy(scalar_t currentTime, const vector_t& currentState, vector_t& mpcState, vector_t& mpcInput, size_t& mode);
 
+  /**
+   * Gets the heap allocations of evaluatePolicy() on the calling thread. Only counted if allocation tracking is enabled, see
+   * allocation::isTrackingEnabled().
+   */
+  const allocation::PhaseAllocationCounter& getPolicyEvaluationAllocations() const { return policyEvaluationAllocations_; }
+
   /**
    * @brief Rolls out the control policy from the current time and state to get the next state and input using the MPC policy.
    *
@@ -143,6 +170,8 @@ class MRT_BASE {
    * is available on the buffer this method will load it to the in-use policy.
    * This method also calls the modifyActiveSolution() method.
    *
+   * This method is wait-free: besides modifyActiveSolution(), it only performs one atomic load and at most one atomic exchange.
+   *
    * @return True if the policy is updated.
    */
   bool updatePolicy();
@@ -163,31 +192,42 @@ class MRT_BASE {
                     std::unique_ptr<PerformanceIndex> performanceIndicesPtr);
 
  private:
-  /** Calls modifyActiveSolution on all mrt observers. This function is called while holding a policyBufferMutex lock */
+  /** The MPC output of one slot of the triple buffer. */
+  struct PolicyBuffer {
+    std::unique_ptr<CommandData> commandPtr;
+    std::unique_ptr<PrimalSolution> primalSolutionPtr;
+    std::unique_ptr<PerformanceIndex> performanceIndicesPtr;
+    PolicyEvaluator evaluator;
+  };
+
+  /** Calls modifyActiveSolution on all mrt observers. This function is called on the thread of updatePolicy() */
   void modifyActiveSolution(const CommandData& command, PrimalSolution& primalSolution);
 
-  /** Calls modifyBufferedSolution on all mrt observers. This function is called while holding a policyBufferMutex lock */
+  /** Calls modifyBufferedSolution on all mrt observers. This function is called while holding the bufferMutex_ lock */
   void modifyBufferedSolution(const CommandData& commandBuffer, PrimalSolution& primalSolutionBuffer);
 
+  /** The policy in use, owned by the thread of updatePolicy() */
+  const PolicyBuffer& activePolicy() const { return policyBuffers_[activeIndex_]; }
+
   // flags on state of the class
   std::atomic_bool policyReceivedEver_;
-  bool newPolicyInBuffer_;  // whether a new policy is waiting to be swapped in
 
-  // variables related to the MPC output
-  std::unique_ptr<CommandData> activeCommandPtr_;
-  std::unique_ptr<CommandData> bufferCommandPtr_;
-  std::unique_ptr<PrimalSolution> activePrimalSolutionPtr_;
-  std::unique_ptr<PrimalSolution> bufferPrimalSolutionPtr_;
-  std::unique_ptr<PerformanceIndex> activePerformanceIndicesPtr_;
-  std::unique_ptr<PerformanceIndex> bufferPerformanceIndicesPtr_;
+  // triple buffer of the MPC output
+  static constexpr uint8_t indexMask_ = 0x3;
+  static constexpr uint8_t newPolicyFlag_ = 0x4;  // set on the exchanged index when it holds a policy not yet swapped in
+  std::array<PolicyBuffer, 3> policyBuffers_;
+  size_t activeIndex_;                 // only accessed by updatePolicy() and the policy evaluation
+  size_t bufferIndex_;                 // only accessed by moveToBuffer()
+  std::atomic<uint8_t> exchangeIndex_;  // the index passed between the two sides, with newPolicyFlag_
 
   // thread safety
-  mutable std::mutex bufferMutex_;  // for policy variables with the prefix (buffer*)
-  const size_t mrtTrylockWarningThreshold_ = 5;
-  size_t mrtTrylockWarningCount_;
+  std::mutex bufferMutex_;  // serializes moveToBuffer() calls, reset(), and the policy resampling period
+
+  scalar_t policyResamplingPeriod_ = 0.0;
 
   // variables needed for policy evaluation
   std::unique_ptr<RolloutBase> rolloutPtr_;
+  allocation::PhaseAllocationCounter policyEvaluationAllocations_{"Policy Evaluation", allocation::CountingScope::CallingThread};
 
   std::vector<std::shared_ptr<MrtObserver>> observerPtrArray_;
 };
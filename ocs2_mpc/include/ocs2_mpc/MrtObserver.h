@@ -46,7 +46,8 @@ namespace ocs2 {
  * When a user requests an update, the in-use policy is swapped for the buffered policy.
  *      - At this point the "modifyActiveSolution" of this class is called.
  *
- * Both filling of the buffer and the update swapping are protected by the same mutex.
+ * The update swapping is wait-free, see MRT_BASE. Hence the two methods can run concurrently on different threads, and an observer
+ * which shares data between them has to synchronize it without blocking modifyActiveSolution.
  */
 class MrtObserver {
  public:
@@ -66,7 +67,7 @@ class MrtObserver {
    * This function is executed sequentially with updatePolicy and thus blocks the main thread. Computationally expensive modifications
    * should therefore rather be done in "modifyBufferedSolution".
    *
-   * A call to this function is protected by the same mutex as modifyBufferedSolution.
+   * This function may run concurrently with modifyBufferedSolution.
    */
   virtual void modifyActiveSolution(const CommandData& command, PrimalSolution& primalSolution) {}
 
@@ -76,7 +77,7 @@ class MrtObserver {
    *
    * When using a multi-threaded MRT, this function does not block the main thread.
    *
-   * A call to this function is protected by the same mutex as modifyActiveSolution.
+   * Calls to this function are serialized with each other, but may run concurrently with modifyActiveSolution.
    */
   virtual void modifyBufferedSolution(const CommandData& commandBuffer, PrimalSolution& primalSolutionBuffer) {}
 };
@@ -0,0 +1,139 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include <ocs2_oc/oc_data/PerformanceIndex.h>
+#include <ocs2_oc/oc_data/PrimalSolution.h>
+
+#include "ocs2_mpc/CommandData.h"
+
+namespace ocs2 {
+
+/** Capacities of a shared-memory policy channel. The slots have a fixed layout, hence every policy has to fit into them. */
+struct SharedPolicyDimensions {
+  size_t stateDim = 0;
+  size_t inputDim = 0;
+  /** Maximum number of nodes of the primal solution */
+  size_t maxNumNodes = 0;
+  /** Maximum number of event times of the mode schedule and of post-event indices */
+  size_t maxNumEvents = 0;
+  /** Maximum number of nodes of the target trajectories */
+  size_t maxNumTargetNodes = 0;
+};
+
+namespace shared_policy {
+class Segment;
+}  // namespace shared_policy
+
+/**
+ * Publishes MPC policies to an MRT process on the same host through a named POSIX shared-memory segment. The segment holds a ring of
+ * slots with a fixed, contiguous layout in double precision (time, state, input, feedforward and gain arrays), such that a policy is
+ * exchanged by two memory copies without any serialization. Each slot is guarded by a sequence lock, writing never blocks and a reader
+ * never blocks the writer.
+ *
+ * Only FeedforwardController and LinearController policies are supported. The controller is sampled at the nodes of the primal
+ * solution, as done by the ROS policy message.
+ */
+class SharedPolicyWriter {
+ public:
+  /**
+   * Creates the segment, replacing a stale segment with the same name.
+   * @param [in] name : Name of the segment, e.g. "/legged_robot_mpc_policy".
+   * @param [in] dimensions : Capacities of the slots.
+   */
+  SharedPolicyWriter(const std::string& name, const SharedPolicyDimensions& dimensions);
+
+  /** Marks the segment as closed for the readers and removes its name. */
+  ~SharedPolicyWriter();
+
+  SharedPolicyWriter(const SharedPolicyWriter&) = delete;
+  SharedPolicyWriter& operator=(const SharedPolicyWriter&) = delete;
+
+  /** Publishes a policy. Throws if the policy does not fit into the slot layout. */
+  void write(const CommandData& commandData, const PrimalSolution& primalSolution, const PerformanceIndex& performanceIndices);
+
+  /** Number of published policies */
+  uint64_t getNumPublished() const;
+
+ private:
+  std::unique_ptr<shared_policy::Segment> segmentPtr_;
+};
+
+/**
+ * Reads the policies of a SharedPolicyWriter, see SharedPolicyWriter.
+ */
+class SharedPolicyReader {
+ public:
+  /**
+   * Opens an existing segment. Throws if the segment does not exist or has an incompatible layout.
+   * @param [in] name : Name of the segment.
+   */
+  explicit SharedPolicyReader(const std::string& name);
+
+  ~SharedPolicyReader();
+
+  SharedPolicyReader(const SharedPolicyReader&) = delete;
+  SharedPolicyReader& operator=(const SharedPolicyReader&) = delete;
+
+  /** Whether a policy was published since the last successful read. */
+  bool hasNewPolicy() const;
+
+  /** Whether the writer closed the segment, in which case the reader has to be reopened to follow a restarted writer. */
+  bool isWriterClosed() const;
+
+  /**
+   * Reads the latest policy if it is newer than the last one read.
+   *
+   * @param [out] commandData: The MPC command data
+   * @param [out] primalSolution: The MPC policy data
+   * @param [out] performanceIndices: The MPC performance indices data
+   * @return true if a new policy was read. False if there is no new policy or the writer kept overwriting the slot while reading.
+   */
+  bool read(CommandData& commandData, PrimalSolution& primalSolution, PerformanceIndex& performanceIndices);
+
+  /** Capacities of the segment */
+  const SharedPolicyDimensions& getDimensions() const;
+
+ private:
+  std::unique_ptr<shared_policy::Segment> segmentPtr_;
+  uint64_t lastReadSequence_ = 0;
+};
+
+/**
+ * Gets the name of the shared-memory segment that carries the policy of the given topic prefix, e.g. "/legged_robot_mpc_policy" for
+ * "legged_robot".
+ */
+std::string getSharedPolicySegmentName(const std::string& topicPrefix);
+
+}  // namespace ocs2
@@ -31,6 +31,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_mpc/MPC_BASE.h>
 
+#include <ocs2_oc/search_strategy/FilterLinesearch.h>
+
 namespace ocs2 {
 
 /******************************************************************************************************/
@@ -47,6 +49,24 @@ void MPC_BASE::reset() {
   getSolverPtr()->reset();
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MPC_BASE::setIntermediateSolutionCallback(SolverBase::intermediate_solution_callback_t callback) {
+  if (!mpcSettings_.publishIntermediateSolutions_ || !callback) {
+    getSolverPtr()->setIntermediateSolutionCallback(nullptr);
+    return;
+  }
+
+  const scalar_t maxConstraintViolation = mpcSettings_.intermediateSolutionMaxConstraintViolation_;
+  getSolverPtr()->setIntermediateSolutionCallback(
+      [maxConstraintViolation, callback = std::move(callback)](const PrimalSolution& primalSolution, const PerformanceIndex& performance) {
+        if (FilterLinesearch::totalConstraintViolation(performance) <= maxConstraintViolation) {
+          callback(primalSolution, performance);
+        }
+      });
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
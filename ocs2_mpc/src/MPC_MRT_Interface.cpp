@@ -39,6 +39,16 @@ namespace ocs2 {
 /******************************************************************************************************/
 MPC_MRT_Interface::MPC_MRT_Interface(MPC_BASE& mpc) : mpc_(mpc) {
   mpcTimer_.reset();
+  mpc_.setIntermediateSolutionCallback([this](const PrimalSolution& primalSolution, const PerformanceIndex& performanceIndex) {
+    copyIntermediateSolutionToBuffer(primalSolution, performanceIndex);
+  });
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+MPC_MRT_Interface::~MPC_MRT_Interface() {
+  mpc_.setIntermediateSolutionCallback(nullptr);
 }
 
 /******************************************************************************************************/
@@ -79,11 +89,11 @@ void MPC_MRT_Interface::advanceMpc() {
   // measure the delay in running MPC
   mpcTimer_.startTimer();
 
-  SystemObservation currentObservation;
   {
     std::lock_guard<std::mutex> lock(observationMutex_);
-    currentObservation = currentObservation_;
+    mpcInitObservation_ = currentObservation_;
   }
+  const SystemObservation& currentObservation = mpcInitObservation_;
 
   bool controllerIsUpdated = mpc_.run(currentObservation.time, currentObservation.state);
   if (!controllerIsUpdated) {
@@ -110,6 +120,9 @@ void MPC_MRT_Interface::advanceMpc() {
     std::cerr << "\n###   Average : " << mpcTimer_.getAverageInMilliseconds() << "[ms].";
     std::cerr << "\n###   Latest  : " << mpcTimer_.getLastIntervalInMilliseconds() << "[ms]." << std::endl;
   }
+
+  // prepare the next run while the policy is tracked
+  mpc_.prepareNextRun();
 }
 
 /******************************************************************************************************/
@@ -135,6 +148,18 @@ void MPC_MRT_Interface::copyToBuffer(const SystemObservation& mpcInitObservation
   this->moveToBuffer(std::move(commandPtr), std::move(primalSolutionPtr), std::move(performanceIndicesPtr));
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MPC_MRT_Interface::copyIntermediateSolutionToBuffer(const PrimalSolution& primalSolution, const PerformanceIndex& performanceIndex) {
+  auto commandPtr = std::make_unique<CommandData>();
+  commandPtr->mpcInitObservation_ = mpcInitObservation_;
+  commandPtr->mpcTargetTrajectories_ = mpc_.getSolverPtr()->getReferenceManager().getTargetTrajectories();
+
+  this->moveToBuffer(std::move(commandPtr), std::make_unique<PrimalSolution>(primalSolution),
+                     std::make_unique<PerformanceIndex>(performanceIndex));
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -47,23 +47,26 @@ void MRT_BASE::reset() {
   std::lock_guard<std::mutex> lock(bufferMutex_);
 
   policyReceivedEver_ = false;
-  newPolicyInBuffer_ = false;
-  mrtTrylockWarningCount_ = 0;
-
-  activeCommandPtr_.reset();
-  bufferCommandPtr_.reset();
-  activePrimalSolutionPtr_.reset();
-  bufferPrimalSolutionPtr_.reset();
-  activePerformanceIndicesPtr_.reset();
-  bufferPerformanceIndicesPtr_.reset();
+
+  for (auto& policyBuffer : policyBuffers_) {
+    policyBuffer.commandPtr.reset();
+    policyBuffer.primalSolutionPtr.reset();
+    policyBuffer.performanceIndicesPtr.reset();
+    policyBuffer.evaluator.clear();
+  }
+  activeIndex_ = 0;
+  bufferIndex_ = 1;
+  exchangeIndex_ = 2;
+
+  policyEvaluationAllocations_.reset();
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 const CommandData& MRT_BASE::getCommand() const {
-  if (activeCommandPtr_ != nullptr) {
-    return *activeCommandPtr_;
+  if (activePolicy().commandPtr != nullptr) {
+    return *activePolicy().commandPtr;
   } else {
     throw std::runtime_error("[MRT_BASE::getCommand] updatePolicy() should be called first!");
   }
@@ -73,8 +76,8 @@ const CommandData& MRT_BASE::getCommand() const {
 /******************************************************************************************************/
 /******************************************************************************************************/
 const PrimalSolution& MRT_BASE::getPolicy() const {
-  if (activePrimalSolutionPtr_ != nullptr) {
-    return *activePrimalSolutionPtr_;
+  if (activePolicy().primalSolutionPtr != nullptr) {
+    return *activePolicy().primalSolutionPtr;
   } else {
     throw std::runtime_error("[MRT_BASE::getPolicy] updatePolicy() should be called first!");
   }
@@ -84,8 +87,8 @@ const PrimalSolution& MRT_BASE::getPolicy() const {
 /******************************************************************************************************/
 /******************************************************************************************************/
 const PerformanceIndex& MRT_BASE::getPerformanceIndices() const {
-  if (activePerformanceIndicesPtr_ != nullptr) {
-    return *activePerformanceIndicesPtr_;
+  if (activePolicy().performanceIndicesPtr != nullptr) {
+    return *activePolicy().performanceIndicesPtr;
   } else {
     throw std::runtime_error("[MRT_BASE::getPerformanceIndices] updatePolicy() should be called first!");
   }
@@ -98,24 +101,35 @@ void MRT_BASE::initRollout(const RolloutBase* rolloutPtr) {
   rolloutPtr_.reset(rolloutPtr->clone());
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MRT_BASE::setPolicyResamplingPeriod(scalar_t period) {
+  std::lock_guard<std::mutex> lock(bufferMutex_);
+  policyResamplingPeriod_ = period;
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 void MRT_BASE::evaluatePolicy(scalar_t currentTime, const vector_t& currentState, vector_t& mpcState, vector_t& mpcInput, size_t& mode) {
-  if (activePrimalSolutionPtr_ == nullptr) {
+  const auto& activePrimalSolutionPtr = activePolicy().primalSolutionPtr;
+  if (activePrimalSolutionPtr == nullptr) {
     throw std::runtime_error("[MRT_BASE::evaluatePolicy] updatePolicy() should be called first!");
   }
 
-  if (currentTime > activePrimalSolutionPtr_->timeTrajectory_.back()) {
+  if (currentTime > activePrimalSolutionPtr->timeTrajectory_.back()) {
     std::cerr << "The requested currentTime is greater than the received plan: " << std::to_string(currentTime) << ">"
-              << std::to_string(activePrimalSolutionPtr_->timeTrajectory_.back()) << "\n";
+              << std::to_string(activePrimalSolutionPtr->timeTrajectory_.back()) << "\n";
   }
 
-  mpcInput = activePrimalSolutionPtr_->controllerPtr_->computeInput(currentTime, currentState);
-  mpcState =
-      LinearInterpolation::interpolate(currentTime, activePrimalSolutionPtr_->timeTrajectory_, activePrimalSolutionPtr_->stateTrajectory_);
+  // once the outputs are sized, the evaluation is expected not to allocate
+  const bool isSteadyState = mpcState.size() > 0 && mpcInput.size() > 0;
+  policyEvaluationAllocations_.start();
+
+  policyBuffers_[activeIndex_].evaluator.evaluate(currentTime, currentState, mpcState, mpcInput, mode);
 
-  mode = activePrimalSolutionPtr_->modeSchedule_.modeAtTime(currentTime);
+  policyEvaluationAllocations_.end(isSteadyState);
 }
 
 /******************************************************************************************************/
@@ -123,17 +137,18 @@ void MRT_BASE::evaluatePolicy(scalar_t currentTime, const vector_t& currentState
 /******************************************************************************************************/
 void MRT_BASE::rolloutPolicy(scalar_t currentTime, const vector_t& currentState, const scalar_t& timeStep, vector_t& mpcState,
                              vector_t& mpcInput, size_t& mode) {
+  const auto& activePrimalSolutionPtr = activePolicy().primalSolutionPtr;
   if (rolloutPtr_ == nullptr) {
     throw std::runtime_error("[MRT_BASE::rolloutPolicy] rollout class is not set! Use initRollout() to initialize it!");
   }
 
-  if (activePrimalSolutionPtr_ == nullptr) {
+  if (activePrimalSolutionPtr == nullptr) {
     throw std::runtime_error("[MRT_BASE::rolloutPolicy] updatePolicy() should be called first!");
   }
 
-  if (currentTime > activePrimalSolutionPtr_->timeTrajectory_.back()) {
+  if (currentTime > activePrimalSolutionPtr->timeTrajectory_.back()) {
     std::cerr << "The requested currentTime is greater than the received plan: " << std::to_string(currentTime) << ">"
-              << std::to_string(activePrimalSolutionPtr_->timeTrajectory_.back()) << "\n";
+              << std::to_string(activePrimalSolutionPtr->timeTrajectory_.back()) << "\n";
   }
 
   // perform a rollout
@@ -141,42 +156,34 @@ void MRT_BASE::rolloutPolicy(scalar_t currentTime, const vector_t& currentState,
   size_array_t postEventIndicesStock;
   vector_array_t stateTrajectory, inputTrajectory;
   const scalar_t finalTime = currentTime + timeStep;
-  rolloutPtr_->run(currentTime, currentState, finalTime, activePrimalSolutionPtr_->controllerPtr_.get(),
-                   activePrimalSolutionPtr_->modeSchedule_, timeTrajectory, postEventIndicesStock, stateTrajectory, inputTrajectory);
+  rolloutPtr_->run(currentTime, currentState, finalTime, activePrimalSolutionPtr->controllerPtr_.get(),
+                   activePrimalSolutionPtr->modeSchedule_, timeTrajectory, postEventIndicesStock, stateTrajectory, inputTrajectory);
 
   mpcState = stateTrajectory.back();
   mpcInput = inputTrajectory.back();
 
-  mode = activePrimalSolutionPtr_->modeSchedule_.modeAtTime(finalTime);
+  mode = activePrimalSolutionPtr->modeSchedule_.modeAtTime(finalTime);
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 bool MRT_BASE::updatePolicy() {
-  std::unique_lock<std::mutex> lock(bufferMutex_, std::try_to_lock);
-  if (lock.owns_lock()) {
-    mrtTrylockWarningCount_ = 0;
-    if (newPolicyInBuffer_) {
-      // update the active solution from buffer
-      activeCommandPtr_.swap(bufferCommandPtr_);
-      activePrimalSolutionPtr_.swap(bufferPrimalSolutionPtr_);
-      activePerformanceIndicesPtr_.swap(bufferPerformanceIndicesPtr_);
-      newPolicyInBuffer_ = false;  // make sure we don't swap in the old policy again
-
-      modifyActiveSolution(*activeCommandPtr_, *activePrimalSolutionPtr_);
-      return true;
-    } else {
-      return false;  // No policy update: the buffer contains nothing new.
-    }
-  } else {
-    ++mrtTrylockWarningCount_;
-    if (mrtTrylockWarningCount_ > mrtTrylockWarningThreshold_) {
-      std::cerr << "[MRT_BASE::updatePolicy] failed to lock the policyBufferMutex for " << mrtTrylockWarningCount_
-                << " consecutive times.\n";
-    }
-    return false;  // No policy update: the lock could not be acquired.
+  // only this side clears the flag, hence it remains set until the exchange below
+  if ((exchangeIndex_.load(std::memory_order_acquire) & newPolicyFlag_) == 0) {
+    return false;  // No policy update: the buffer contains nothing new.
+  }
+
+  // update the active solution from buffer. The previous active solution is released by moveToBuffer().
+  activeIndex_ = exchangeIndex_.exchange(static_cast<uint8_t>(activeIndex_), std::memory_order_acq_rel) & indexMask_;
+
+  auto& policyBuffer = policyBuffers_[activeIndex_];
+  modifyActiveSolution(*policyBuffer.commandPtr, *policyBuffer.primalSolutionPtr);
+  if (!observerPtrArray_.empty() && !policyBuffer.evaluator.isResampled()) {
+    // the observers might have replaced the controller. A resampled policy is not resampled again on this thread.
+    policyBuffer.evaluator.setPolicy(*policyBuffer.primalSolutionPtr);
   }
+  return true;
 }
 
 /******************************************************************************************************/
@@ -198,14 +205,17 @@ void MRT_BASE::moveToBuffer(std::unique_ptr<CommandData> commandDataPtr, std::un
 
   std::lock_guard<std::mutex> lk(bufferMutex_);
   // use swap such that the old objects are destroyed after releasing the lock.
-  bufferCommandPtr_.swap(commandDataPtr);
-  bufferPrimalSolutionPtr_.swap(primalSolutionPtr);
-  bufferPerformanceIndicesPtr_.swap(performanceIndicesPtr);
+  auto& policyBuffer = policyBuffers_[bufferIndex_];
+  policyBuffer.commandPtr.swap(commandDataPtr);
+  policyBuffer.primalSolutionPtr.swap(primalSolutionPtr);
+  policyBuffer.performanceIndicesPtr.swap(performanceIndicesPtr);
 
   // allow user to modify the buffer
-  modifyBufferedSolution(*bufferCommandPtr_, *bufferPrimalSolutionPtr_);
+  modifyBufferedSolution(*policyBuffer.commandPtr, *policyBuffer.primalSolutionPtr);
+  policyBuffer.evaluator.setPolicy(*policyBuffer.primalSolutionPtr, policyResamplingPeriod_);
 
-  newPolicyInBuffer_ = true;
+  // publish the buffer. The returned slot holds either an outdated policy or the previous active one of updatePolicy().
+  bufferIndex_ = exchangeIndex_.exchange(static_cast<uint8_t>(bufferIndex_) | newPolicyFlag_, std::memory_order_acq_rel) & indexMask_;
   policyReceivedEver_ = true;
 }
 
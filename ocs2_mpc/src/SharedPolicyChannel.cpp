@@ -0,0 +1,518 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_mpc/SharedPolicyChannel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <ocs2_core/control/FeedforwardController.h>
+#include <ocs2_core/control/LinearController.h>
+#include <ocs2_core/misc/LinearInterpolation.h>
+
+namespace ocs2 {
+namespace shared_policy {
+
+namespace {
+/** Identifies the segment layout, "ocs2pol1" */
+constexpr uint64_t magicNumber = 0x6f637332706f6c31;
+/** A reader can copy a slot while the writer fills the two other ones */
+constexpr uint64_t numSlots = 3;
+constexpr size_t cacheLineSize = 64;
+constexpr int maxReadAttempts = 4;
+
+constexpr uint64_t feedforwardControllerType = 0;
+constexpr uint64_t linearControllerType = 1;
+
+size_t alignToCacheLine(size_t numBytes) {
+  return (numBytes + cacheLineSize - 1) / cacheLineSize * cacheLineSize;
+}
+
+struct SegmentHeader {
+  uint64_t magic;
+  uint64_t stateDim;
+  uint64_t inputDim;
+  uint64_t maxNumNodes;
+  uint64_t maxNumEvents;
+  uint64_t maxNumTargetNodes;
+  /** Sequence number of the latest complete policy, 0 if none was written yet */
+  std::atomic<uint64_t> latestSequence;
+  std::atomic<uint64_t> isClosed;
+};
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "The shared-memory policy channel requires lock-free 64 bit atomics.");
+
+struct SlotHeader {
+  /** Sequence lock: twice the sequence number of the stored policy, odd while the slot is written */
+  std::atomic<uint64_t> lock;
+  uint64_t numNodes;
+  uint64_t numEventTimes;
+  uint64_t numPostEventIndices;
+  uint64_t numTargetNodes;
+  uint64_t numTargetInputs;
+  uint64_t controllerType;
+  uint64_t initMode;
+  scalar_t initTime;
+  PerformanceIndex performanceIndices;
+};
+static_assert(std::is_trivially_copyable<PerformanceIndex>::value, "PerformanceIndex is copied into shared memory.");
+
+/** Offsets of the arrays of a slot, in 8 byte words after the slot header */
+struct SlotLayout {
+  explicit SlotLayout(const SharedPolicyDimensions& dims) {
+    const size_t nx = dims.stateDim;
+    const size_t nu = dims.inputDim;
+    size_t offset = 0;
+    const auto addArray = [&](size_t& arrayOffset, size_t numWords) {
+      arrayOffset = offset;
+      offset += numWords;
+    };
+    addArray(time, dims.maxNumNodes);
+    addArray(state, dims.maxNumNodes * nx);
+    addArray(input, dims.maxNumNodes * nu);
+    addArray(bias, dims.maxNumNodes * nu);
+    addArray(gain, dims.maxNumNodes * nu * nx);
+    addArray(eventTimes, dims.maxNumEvents);
+    addArray(modeSequence, dims.maxNumEvents + 1);
+    addArray(postEventIndices, dims.maxNumEvents);
+    addArray(initState, nx);
+    addArray(initInput, nu);
+    addArray(targetTime, dims.maxNumTargetNodes);
+    addArray(targetState, dims.maxNumTargetNodes * nx);
+    addArray(targetInput, dims.maxNumTargetNodes * nu);
+    numWords = offset;
+    slotSize = alignToCacheLine(sizeof(SlotHeader)) + alignToCacheLine(numWords * sizeof(scalar_t));
+  }
+
+  size_t time, state, input, bias, gain;
+  size_t eventTimes, modeSequence, postEventIndices;
+  size_t initState, initInput;
+  size_t targetTime, targetState, targetInput;
+  size_t numWords;
+  size_t slotSize;
+};
+
+size_t getSegmentSize(const SlotLayout& layout) {
+  return alignToCacheLine(sizeof(SegmentHeader)) + numSlots * layout.slotSize;
+}
+
+/** Interpolates the controller data at a node, without temporaries */
+template <typename Data, typename Destination>
+void interpolateInto(LinearInterpolation::index_alpha_t indexAlpha, const std::vector<Data>& dataArray, Destination&& destination) {
+  if (dataArray.size() == 1) {
+    destination = dataArray.front();
+  } else {
+    const scalar_t alpha = indexAlpha.second;
+    destination = alpha * dataArray[indexAlpha.first] + (1.0 - alpha) * dataArray[indexAlpha.first + 1];
+  }
+}
+}  // unnamed namespace
+
+/** A mapped policy segment */
+class Segment {
+ public:
+  Segment(std::string name, void* address, const SharedPolicyDimensions& dims, bool isOwner)
+      : name_(std::move(name)), address_(static_cast<char*>(address)), dimensions_(dims), layout_(dims), isOwner_(isOwner) {}
+
+  ~Segment() {
+    if (isOwner_) {
+      header().isClosed.store(1, std::memory_order_release);
+      ::shm_unlink(name_.c_str());
+    }
+    ::munmap(address_, getSegmentSize(layout_));
+  }
+
+  Segment(const Segment&) = delete;
+  Segment& operator=(const Segment&) = delete;
+
+  SegmentHeader& header() { return *reinterpret_cast<SegmentHeader*>(address_); }
+
+  SlotHeader& slotHeader(uint64_t sequence) { return *reinterpret_cast<SlotHeader*>(slotAddress(sequence)); }
+
+  scalar_t* slotData(uint64_t sequence) {
+    return reinterpret_cast<scalar_t*>(slotAddress(sequence) + alignToCacheLine(sizeof(SlotHeader)));
+  }
+
+  const SharedPolicyDimensions& dimensions() const { return dimensions_; }
+  const SlotLayout& layout() const { return layout_; }
+
+ private:
+  char* slotAddress(uint64_t sequence) {
+    return address_ + alignToCacheLine(sizeof(SegmentHeader)) + (sequence % numSlots) * layout_.slotSize;
+  }
+
+  std::string name_;
+  char* address_;
+  SharedPolicyDimensions dimensions_;
+  SlotLayout layout_;
+  bool isOwner_;
+};
+
+}  // namespace shared_policy
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+SharedPolicyWriter::SharedPolicyWriter(const std::string& name, const SharedPolicyDimensions& dimensions) {
+  using namespace shared_policy;
+  if (dimensions.stateDim == 0 || dimensions.maxNumNodes == 0) {
+    throw std::runtime_error("[SharedPolicyWriter] The state dimension and the number of nodes must be positive.");
+  }
+
+  // a stale segment of a crashed writer may still be mapped by a reader, hence a new segment is created instead of resizing it
+  ::shm_unlink(name.c_str());
+  const int fileDescriptor = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+  if (fileDescriptor < 0) {
+    throw std::runtime_error("[SharedPolicyWriter] Could not create the shared memory segment " + name + ": " + std::strerror(errno));
+  }
+
+  const size_t segmentSize = getSegmentSize(SlotLayout(dimensions));
+  void* address = MAP_FAILED;
+  if (::ftruncate(fileDescriptor, static_cast<off_t>(segmentSize)) == 0) {
+    address = ::mmap(nullptr, segmentSize, PROT_READ | PROT_WRITE, MAP_SHARED, fileDescriptor, 0);
+  }
+  ::close(fileDescriptor);
+  if (address == MAP_FAILED) {
+    ::shm_unlink(name.c_str());
+    throw std::runtime_error("[SharedPolicyWriter] Could not map the shared memory segment " + name + ": " + std::strerror(errno));
+  }
+
+  // the memory of a new segment is zero-initialized
+  auto* header = new (address) SegmentHeader();
+  header->magic = magicNumber;
+  header->stateDim = dimensions.stateDim;
+  header->inputDim = dimensions.inputDim;
+  header->maxNumNodes = dimensions.maxNumNodes;
+  header->maxNumEvents = dimensions.maxNumEvents;
+  header->maxNumTargetNodes = dimensions.maxNumTargetNodes;
+  header->latestSequence.store(0, std::memory_order_release);
+  header->isClosed.store(0, std::memory_order_release);
+
+  segmentPtr_.reset(new Segment(name, address, dimensions, true));
+  for (uint64_t i = 0; i < numSlots; ++i) {
+    new (&segmentPtr_->slotHeader(i)) SlotHeader();
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+SharedPolicyWriter::~SharedPolicyWriter() = default;
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+uint64_t SharedPolicyWriter::getNumPublished() const {
+  return segmentPtr_->header().latestSequence.load(std::memory_order_relaxed);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void SharedPolicyWriter::write(const CommandData& commandData, const PrimalSolution& primalSolution,
+                               const PerformanceIndex& performanceIndices) {
+  using namespace shared_policy;
+  auto& segment = *segmentPtr_;
+  const auto& dims = segment.dimensions();
+  const auto& layout = segment.layout();
+  const Eigen::Index nx = dims.stateDim;
+  const Eigen::Index nu = dims.inputDim;
+
+  // check that the policy fits before touching the slot
+  const size_t N = primalSolution.timeTrajectory_.size();
+  const auto& modeSchedule = primalSolution.modeSchedule_;
+  const auto& targetTrajectories = commandData.mpcTargetTrajectories_;
+  const auto& observation = commandData.mpcInitObservation_;
+  if (N == 0 || N > dims.maxNumNodes) {
+    throw std::runtime_error("[SharedPolicyWriter::write] The number of nodes " + std::to_string(N) + " exceeds the capacity " +
+                             std::to_string(dims.maxNumNodes) + ".");
+  }
+  if (primalSolution.stateTrajectory_.size() != N || primalSolution.inputTrajectory_.size() != N) {
+    throw std::runtime_error("[SharedPolicyWriter::write] State and input trajectories must have the same length as the time trajectory.");
+  }
+  const auto hasWrongSize = [](const vector_array_t& trajectory, Eigen::Index size) {
+    return std::any_of(trajectory.begin(), trajectory.end(), [size](const vector_t& v) { return v.size() != size; });
+  };
+  if (hasWrongSize(primalSolution.stateTrajectory_, nx) || hasWrongSize(primalSolution.inputTrajectory_, nu)) {
+    throw std::runtime_error("[SharedPolicyWriter::write] The state and input dimensions do not match the segment.");
+  }
+  if (modeSchedule.eventTimes.size() > dims.maxNumEvents || primalSolution.postEventIndices_.size() > dims.maxNumEvents) {
+    throw std::runtime_error("[SharedPolicyWriter::write] The number of events exceeds the capacity " + std::to_string(dims.maxNumEvents) +
+                             ".");
+  }
+  const size_t numTargetNodes = targetTrajectories.timeTrajectory.size();
+  const size_t numTargetInputs = targetTrajectories.inputTrajectory.size();
+  if (numTargetNodes > dims.maxNumTargetNodes || (numTargetInputs != 0 && numTargetInputs != numTargetNodes) ||
+      hasWrongSize(targetTrajectories.stateTrajectory, nx) || hasWrongSize(targetTrajectories.inputTrajectory, nu)) {
+    throw std::runtime_error("[SharedPolicyWriter::write] The target trajectories do not fit into the segment.");
+  }
+  if (observation.state.size() != nx || observation.input.size() != nu) {
+    throw std::runtime_error("[SharedPolicyWriter::write] The dimensions of the initial observation do not match the segment.");
+  }
+  const auto* linearControllerPtr = dynamic_cast<const LinearController*>(primalSolution.controllerPtr_.get());
+  const auto* feedforwardControllerPtr = dynamic_cast<const FeedforwardController*>(primalSolution.controllerPtr_.get());
+  if (linearControllerPtr == nullptr && feedforwardControllerPtr == nullptr) {
+    throw std::runtime_error("[SharedPolicyWriter::write] Only linear and feedforward controllers are supported.");
+  }
+
+  auto& header = segment.header();
+  const uint64_t sequence = header.latestSequence.load(std::memory_order_relaxed) + 1;
+  auto& slot = segment.slotHeader(sequence);
+  scalar_t* data = segment.slotData(sequence);
+  auto* integerData = reinterpret_cast<uint64_t*>(data);
+
+  slot.lock.store(2 * sequence - 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  slot.numNodes = N;
+  slot.numEventTimes = modeSchedule.eventTimes.size();
+  slot.numPostEventIndices = primalSolution.postEventIndices_.size();
+  slot.numTargetNodes = numTargetNodes;
+  slot.numTargetInputs = numTargetInputs;
+  slot.controllerType = (linearControllerPtr != nullptr) ? linearControllerType : feedforwardControllerType;
+  slot.initMode = observation.mode;
+  slot.initTime = observation.time;
+  slot.performanceIndices = performanceIndices;
+
+  // primal solution
+  std::copy(primalSolution.timeTrajectory_.begin(), primalSolution.timeTrajectory_.end(), data + layout.time);
+  for (size_t k = 0; k < N; ++k) {
+    Eigen::Map<vector_t>(data + layout.state + k * nx, nx) = primalSolution.stateTrajectory_[k];
+    Eigen::Map<vector_t>(data + layout.input + k * nu, nu) = primalSolution.inputTrajectory_[k];
+  }
+
+  // controller, sampled at the nodes of the primal solution
+  for (size_t k = 0; k < N; ++k) {
+    const scalar_t t = primalSolution.timeTrajectory_[k];
+    Eigen::Map<vector_t> bias(data + layout.bias + k * nu, nu);
+    if (linearControllerPtr != nullptr) {
+      const auto indexAlpha = LinearInterpolation::timeSegment(t, linearControllerPtr->timeStamp_);
+      interpolateInto(indexAlpha, linearControllerPtr->biasArray_, bias);
+      interpolateInto(indexAlpha, linearControllerPtr->gainArray_, Eigen::Map<matrix_t>(data + layout.gain + k * nu * nx, nu, nx));
+    } else {
+      const auto indexAlpha = LinearInterpolation::timeSegment(t, feedforwardControllerPtr->timeStamp_);
+      interpolateInto(indexAlpha, feedforwardControllerPtr->uffArray_, bias);
+    }
+  }
+
+  // mode schedule
+  std::copy(modeSchedule.eventTimes.begin(), modeSchedule.eventTimes.end(), data + layout.eventTimes);
+  std::copy(modeSchedule.modeSequence.begin(), modeSchedule.modeSequence.end(), integerData + layout.modeSequence);
+  std::copy(primalSolution.postEventIndices_.begin(), primalSolution.postEventIndices_.end(), integerData + layout.postEventIndices);
+
+  // command
+  Eigen::Map<vector_t>(data + layout.initState, nx) = observation.state;
+  Eigen::Map<vector_t>(data + layout.initInput, nu) = observation.input;
+  std::copy(targetTrajectories.timeTrajectory.begin(), targetTrajectories.timeTrajectory.end(), data + layout.targetTime);
+  for (size_t k = 0; k < numTargetNodes; ++k) {
+    Eigen::Map<vector_t>(data + layout.targetState + k * nx, nx) = targetTrajectories.stateTrajectory[k];
+  }
+  for (size_t k = 0; k < numTargetInputs; ++k) {
+    Eigen::Map<vector_t>(data + layout.targetInput + k * nu, nu) = targetTrajectories.inputTrajectory[k];
+  }
+
+  slot.lock.store(2 * sequence, std::memory_order_release);
+  header.latestSequence.store(sequence, std::memory_order_release);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+SharedPolicyReader::SharedPolicyReader(const std::string& name) {
+  using namespace shared_policy;
+  const int fileDescriptor = ::shm_open(name.c_str(), O_RDONLY, 0);
+  if (fileDescriptor < 0) {
+    throw std::runtime_error("[SharedPolicyReader] Could not open the shared memory segment " + name + ": " + std::strerror(errno));
+  }
+
+  struct stat fileStatus;
+  const bool hasHeader = ::fstat(fileDescriptor, &fileStatus) == 0 && static_cast<size_t>(fileStatus.st_size) >= sizeof(SegmentHeader);
+  void* address = hasHeader ? ::mmap(nullptr, fileStatus.st_size, PROT_READ, MAP_SHARED, fileDescriptor, 0) : MAP_FAILED;
+  ::close(fileDescriptor);
+  if (address == MAP_FAILED) {
+    throw std::runtime_error("[SharedPolicyReader] Could not map the shared memory segment " + name + ".");
+  }
+
+  const auto* header = static_cast<const SegmentHeader*>(address);
+  SharedPolicyDimensions dimensions;
+  dimensions.stateDim = header->stateDim;
+  dimensions.inputDim = header->inputDim;
+  dimensions.maxNumNodes = header->maxNumNodes;
+  dimensions.maxNumEvents = header->maxNumEvents;
+  dimensions.maxNumTargetNodes = header->maxNumTargetNodes;
+  if (header->magic != magicNumber || getSegmentSize(SlotLayout(dimensions)) != static_cast<size_t>(fileStatus.st_size)) {
+    ::munmap(address, fileStatus.st_size);
+    throw std::runtime_error("[SharedPolicyReader] The shared memory segment " + name + " has an incompatible layout.");
+  }
+
+  segmentPtr_.reset(new Segment(name, address, dimensions, false));
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+SharedPolicyReader::~SharedPolicyReader() = default;
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool SharedPolicyReader::hasNewPolicy() const {
+  return segmentPtr_->header().latestSequence.load(std::memory_order_acquire) != lastReadSequence_;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool SharedPolicyReader::isWriterClosed() const {
+  return segmentPtr_->header().isClosed.load(std::memory_order_acquire) != 0;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+const SharedPolicyDimensions& SharedPolicyReader::getDimensions() const {
+  return segmentPtr_->dimensions();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool SharedPolicyReader::read(CommandData& commandData, PrimalSolution& primalSolution, PerformanceIndex& performanceIndices) {
+  using namespace shared_policy;
+  auto& segment = *segmentPtr_;
+  const auto& dims = segment.dimensions();
+  const auto& layout = segment.layout();
+  const Eigen::Index nx = dims.stateDim;
+  const Eigen::Index nu = dims.inputDim;
+
+  for (int attempt = 0; attempt < maxReadAttempts; ++attempt) {
+    const uint64_t sequence = segment.header().latestSequence.load(std::memory_order_acquire);
+    if (sequence == 0 || sequence == lastReadSequence_) {
+      return false;
+    }
+
+    const auto& slot = segment.slotHeader(sequence);
+    const uint64_t lock = slot.lock.load(std::memory_order_acquire);
+    if (lock != 2 * sequence) {
+      continue;  // the slot is already overwritten by a newer policy
+    }
+
+    // Copy the slot, the copy is only used if the lock did not change meanwhile. The sizes are clamped such that a torn read stays
+    // within the slot.
+    const size_t N = std::min<size_t>(slot.numNodes, dims.maxNumNodes);
+    const size_t numEventTimes = std::min<size_t>(slot.numEventTimes, dims.maxNumEvents);
+    const size_t numPostEventIndices = std::min<size_t>(slot.numPostEventIndices, dims.maxNumEvents);
+    const size_t numTargetNodes = std::min<size_t>(slot.numTargetNodes, dims.maxNumTargetNodes);
+    const size_t numTargetInputs = std::min<size_t>(slot.numTargetInputs, numTargetNodes);
+    const uint64_t controllerType = slot.controllerType;
+    const size_t initMode = slot.initMode;
+    const scalar_t initTime = slot.initTime;
+    const PerformanceIndex performance = slot.performanceIndices;
+
+    const scalar_t* data = segment.slotData(sequence);
+    const auto* integerData = reinterpret_cast<const uint64_t*>(data);
+    const auto copyVectors = [](const scalar_t* source, size_t numVectors, Eigen::Index size) {
+      vector_array_t vectors(numVectors);
+      for (size_t k = 0; k < numVectors; ++k) {
+        vectors[k] = Eigen::Map<const vector_t>(source + k * size, size);
+      }
+      return vectors;
+    };
+
+    scalar_array_t timeTrajectory(data + layout.time, data + layout.time + N);
+    vector_array_t stateTrajectory = copyVectors(data + layout.state, N, nx);
+    vector_array_t inputTrajectory = copyVectors(data + layout.input, N, nu);
+    vector_array_t biasArray = copyVectors(data + layout.bias, N, nu);
+    matrix_array_t gainArray;
+    if (controllerType == linearControllerType) {
+      gainArray.resize(N);
+      for (size_t k = 0; k < N; ++k) {
+        gainArray[k] = Eigen::Map<const matrix_t>(data + layout.gain + k * nu * nx, nu, nx);
+      }
+    }
+    scalar_array_t eventTimes(data + layout.eventTimes, data + layout.eventTimes + numEventTimes);
+    std::vector<size_t> modeSequence(integerData + layout.modeSequence, integerData + layout.modeSequence + numEventTimes + 1);
+    size_array_t postEventIndices(integerData + layout.postEventIndices, integerData + layout.postEventIndices + numPostEventIndices);
+    vector_t initState = Eigen::Map<const vector_t>(data + layout.initState, nx);
+    vector_t initInput = Eigen::Map<const vector_t>(data + layout.initInput, nu);
+    scalar_array_t targetTime(data + layout.targetTime, data + layout.targetTime + numTargetNodes);
+    vector_array_t targetState = copyVectors(data + layout.targetState, numTargetNodes, nx);
+    vector_array_t targetInput = copyVectors(data + layout.targetInput, numTargetInputs, nu);
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.lock.load(std::memory_order_relaxed) != lock) {
+      continue;  // the writer overwrote the slot while copying
+    }
+
+    primalSolution.clear();
+    primalSolution.modeSchedule_ = ModeSchedule(std::move(eventTimes), std::move(modeSequence));
+    primalSolution.postEventIndices_ = std::move(postEventIndices);
+    if (controllerType == linearControllerType) {
+      primalSolution.controllerPtr_.reset(new LinearController(timeTrajectory, std::move(biasArray), std::move(gainArray)));
+    } else {
+      primalSolution.controllerPtr_.reset(new FeedforwardController(timeTrajectory, std::move(biasArray)));
+    }
+    primalSolution.timeTrajectory_ = std::move(timeTrajectory);
+    primalSolution.stateTrajectory_ = std::move(stateTrajectory);
+    primalSolution.inputTrajectory_ = std::move(inputTrajectory);
+
+    commandData.mpcInitObservation_.time = initTime;
+    commandData.mpcInitObservation_.mode = initMode;
+    commandData.mpcInitObservation_.state = std::move(initState);
+    commandData.mpcInitObservation_.input = std::move(initInput);
+    commandData.mpcTargetTrajectories_ = TargetTrajectories(std::move(targetTime), std::move(targetState), std::move(targetInput));
+
+    performanceIndices = performance;
+    lastReadSequence_ = sequence;
+    return true;
+  }
+
+  return false;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::string getSharedPolicySegmentName(const std::string& topicPrefix) {
+  // POSIX shared memory names are a single path component
+  std::string name = "/" + topicPrefix + "_mpc_policy";
+  std::replace(name.begin() + 1, name.end(), '/', '_');
+  return name;
+}
+
+}  // namespace ocs2
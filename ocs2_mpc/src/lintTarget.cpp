@@ -2,6 +2,7 @@
 #include <ocs2_mpc/MPC_MRT_Interface.h>
 #include <ocs2_mpc/MPC_Settings.h>
 #include <ocs2_mpc/MRT_BASE.h>
+#include <ocs2_mpc/SharedPolicyChannel.h>
 
 #include <ocs2_mpc/CommandData.h>
 #include <ocs2_mpc/SystemObservation.h>
@@ -0,0 +1,305 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <ocs2_core/control/FeedforwardController.h>
+#include <ocs2_core/control/LinearController.h>
+
+#include "ocs2_mpc/SharedPolicyChannel.h"
+
+using namespace ocs2;
+
+namespace {
+constexpr size_t stateDim = 3;
+constexpr size_t inputDim = 2;
+
+SharedPolicyDimensions getDimensions() {
+  SharedPolicyDimensions dimensions;
+  dimensions.stateDim = stateDim;
+  dimensions.inputDim = inputDim;
+  dimensions.maxNumNodes = 20;
+  dimensions.maxNumEvents = 4;
+  dimensions.maxNumTargetNodes = 3;
+  return dimensions;
+}
+
+/** A unique segment name per process, such that concurrent test runs do not share a segment */
+std::string getSegmentName(const std::string& testName) {
+  return "/ocs2_test_" + testName + "_" + std::to_string(::getpid());
+}
+
+/** A random policy with N nodes and an event */
+void getRandomPolicy(size_t N, bool isLinear, CommandData& commandData, PrimalSolution& primalSolution,
+                     PerformanceIndex& performanceIndices) {
+  primalSolution.clear();
+  for (size_t k = 0; k < N; ++k) {
+    primalSolution.timeTrajectory_.push_back(0.1 * k);
+    primalSolution.stateTrajectory_.push_back(vector_t::Random(stateDim));
+    primalSolution.inputTrajectory_.push_back(vector_t::Random(inputDim));
+  }
+  primalSolution.modeSchedule_ = ModeSchedule({0.25}, {1, 2});
+  primalSolution.postEventIndices_ = {3};
+
+  vector_array_t biasArray(N);
+  for (auto& bias : biasArray) {
+    bias.setRandom(inputDim);
+  }
+  if (isLinear) {
+    matrix_array_t gainArray(N);
+    for (auto& gain : gainArray) {
+      gain.setRandom(inputDim, stateDim);
+    }
+    primalSolution.controllerPtr_.reset(new LinearController(primalSolution.timeTrajectory_, biasArray, gainArray));
+  } else {
+    primalSolution.controllerPtr_.reset(new FeedforwardController(primalSolution.timeTrajectory_, biasArray));
+  }
+
+  commandData.mpcInitObservation_.time = 0.0;
+  commandData.mpcInitObservation_.mode = 1;
+  commandData.mpcInitObservation_.state.setRandom(stateDim);
+  commandData.mpcInitObservation_.input.setRandom(inputDim);
+  commandData.mpcTargetTrajectories_ = TargetTrajectories({0.0, 1.0}, {vector_t::Random(stateDim), vector_t::Random(stateDim)},
+                                                          {vector_t::Random(inputDim), vector_t::Random(inputDim)});
+
+  performanceIndices.merit = 1.0;
+  performanceIndices.cost = 2.0;
+  performanceIndices.dynamicsViolationSSE = 3.0;
+}
+
+/** A policy whose entries all equal the given value, such that a torn read mixes values */
+void getUniformPolicy(scalar_t value, CommandData& commandData, PrimalSolution& primalSolution, PerformanceIndex& performanceIndices) {
+  constexpr size_t N = 20;
+  primalSolution.clear();
+  for (size_t k = 0; k < N; ++k) {
+    primalSolution.timeTrajectory_.push_back(value + k);
+  }
+  primalSolution.stateTrajectory_.assign(N, vector_t::Constant(stateDim, value));
+  primalSolution.inputTrajectory_.assign(N, vector_t::Constant(inputDim, value));
+  vector_array_t biasArray(N, vector_t::Constant(inputDim, value));
+  matrix_array_t gainArray(N, matrix_t::Constant(inputDim, stateDim, value));
+  primalSolution.controllerPtr_.reset(new LinearController(primalSolution.timeTrajectory_, std::move(biasArray), std::move(gainArray)));
+
+  commandData.mpcInitObservation_.time = value;
+  commandData.mpcInitObservation_.state = vector_t::Constant(stateDim, value);
+  commandData.mpcInitObservation_.input = vector_t::Constant(inputDim, value);
+  commandData.mpcTargetTrajectories_ = TargetTrajectories({value}, {vector_t::Constant(stateDim, value)});
+
+  performanceIndices.merit = value;
+}
+
+bool isUniform(scalar_t value, const CommandData& commandData, const PrimalSolution& primalSolution,
+               const PerformanceIndex& performanceIndices) {
+  const auto* controllerPtr = dynamic_cast<const LinearController*>(primalSolution.controllerPtr_.get());
+  bool uniform = controllerPtr != nullptr && primalSolution.timeTrajectory_.size() == 20;
+  for (size_t k = 0; uniform && k < primalSolution.timeTrajectory_.size(); ++k) {
+    uniform = primalSolution.timeTrajectory_[k] == value + k && (primalSolution.stateTrajectory_[k].array() == value).all() &&
+              (primalSolution.inputTrajectory_[k].array() == value).all() && (controllerPtr->biasArray_[k].array() == value).all() &&
+              (controllerPtr->gainArray_[k].array() == value).all();
+  }
+  return uniform && commandData.mpcInitObservation_.time == value && (commandData.mpcInitObservation_.state.array() == value).all() &&
+         commandData.mpcTargetTrajectories_.timeTrajectory.front() == value && performanceIndices.merit == value;
+}
+}  // unnamed namespace
+
+TEST(testSharedPolicyChannel, segmentName) {
+  EXPECT_EQ(getSharedPolicySegmentName("legged_robot"), "/legged_robot_mpc_policy");
+  EXPECT_EQ(getSharedPolicySegmentName("robot/arm"), "/robot_arm_mpc_policy");
+}
+
+TEST(testSharedPolicyChannel, roundTrip) {
+  const auto name = getSegmentName("roundTrip");
+  SharedPolicyWriter writer(name, getDimensions());
+  SharedPolicyReader reader(name);
+  EXPECT_FALSE(reader.hasNewPolicy());
+
+  for (const bool isLinear : {true, false}) {
+    CommandData commandData;
+    PrimalSolution primalSolution;
+    PerformanceIndex performanceIndices;
+    getRandomPolicy(10, isLinear, commandData, primalSolution, performanceIndices);
+    writer.write(commandData, primalSolution, performanceIndices);
+    ASSERT_TRUE(reader.hasNewPolicy());
+
+    CommandData readCommandData;
+    PrimalSolution readPrimalSolution;
+    PerformanceIndex readPerformanceIndices;
+    ASSERT_TRUE(reader.read(readCommandData, readPrimalSolution, readPerformanceIndices));
+    EXPECT_FALSE(reader.hasNewPolicy());
+    EXPECT_FALSE(reader.read(readCommandData, readPrimalSolution, readPerformanceIndices));
+
+    // primal solution
+    EXPECT_EQ(readPrimalSolution.timeTrajectory_, primalSolution.timeTrajectory_);
+    EXPECT_EQ(readPrimalSolution.stateTrajectory_, primalSolution.stateTrajectory_);
+    EXPECT_EQ(readPrimalSolution.inputTrajectory_, primalSolution.inputTrajectory_);
+    EXPECT_EQ(readPrimalSolution.modeSchedule_.eventTimes, primalSolution.modeSchedule_.eventTimes);
+    EXPECT_EQ(readPrimalSolution.modeSchedule_.modeSequence, primalSolution.modeSchedule_.modeSequence);
+    EXPECT_EQ(readPrimalSolution.postEventIndices_, primalSolution.postEventIndices_);
+
+    // controller
+    if (isLinear) {
+      const auto& controller = dynamic_cast<const LinearController&>(*primalSolution.controllerPtr_);
+      const auto* readControllerPtr = dynamic_cast<const LinearController*>(readPrimalSolution.controllerPtr_.get());
+      ASSERT_NE(readControllerPtr, nullptr);
+      EXPECT_EQ(readControllerPtr->timeStamp_, controller.timeStamp_);
+      EXPECT_EQ(readControllerPtr->biasArray_, controller.biasArray_);
+      EXPECT_EQ(readControllerPtr->gainArray_, controller.gainArray_);
+    } else {
+      const auto& controller = dynamic_cast<const FeedforwardController&>(*primalSolution.controllerPtr_);
+      const auto* readControllerPtr = dynamic_cast<const FeedforwardController*>(readPrimalSolution.controllerPtr_.get());
+      ASSERT_NE(readControllerPtr, nullptr);
+      EXPECT_EQ(readControllerPtr->timeStamp_, controller.timeStamp_);
+      EXPECT_EQ(readControllerPtr->uffArray_, controller.uffArray_);
+    }
+
+    // command data
+    EXPECT_EQ(readCommandData.mpcInitObservation_.time, commandData.mpcInitObservation_.time);
+    EXPECT_EQ(readCommandData.mpcInitObservation_.mode, commandData.mpcInitObservation_.mode);
+    EXPECT_EQ(readCommandData.mpcInitObservation_.state, commandData.mpcInitObservation_.state);
+    EXPECT_EQ(readCommandData.mpcInitObservation_.input, commandData.mpcInitObservation_.input);
+    EXPECT_TRUE(readCommandData.mpcTargetTrajectories_ == commandData.mpcTargetTrajectories_);
+
+    // performance indices
+    EXPECT_EQ(readPerformanceIndices.merit, performanceIndices.merit);
+    EXPECT_EQ(readPerformanceIndices.cost, performanceIndices.cost);
+    EXPECT_EQ(readPerformanceIndices.dynamicsViolationSSE, performanceIndices.dynamicsViolationSSE);
+  }
+
+  EXPECT_EQ(writer.getNumPublished(), 2);
+}
+
+TEST(testSharedPolicyChannel, capacityOverflow) {
+  const auto name = getSegmentName("capacityOverflow");
+  SharedPolicyWriter writer(name, getDimensions());
+  SharedPolicyReader reader(name);
+
+  CommandData commandData;
+  PrimalSolution primalSolution;
+  PerformanceIndex performanceIndices;
+  getRandomPolicy(getDimensions().maxNumNodes + 1, true, commandData, primalSolution, performanceIndices);
+  EXPECT_THROW(writer.write(commandData, primalSolution, performanceIndices), std::runtime_error);
+
+  // the rejected policy is not published
+  EXPECT_EQ(writer.getNumPublished(), 0);
+  EXPECT_FALSE(reader.hasNewPolicy());
+}
+
+TEST(testSharedPolicyChannel, overwrittenSlot) {
+  const auto name = getSegmentName("overwrittenSlot");
+  SharedPolicyWriter writer(name, getDimensions());
+  SharedPolicyReader reader(name);
+
+  CommandData commandData;
+  PrimalSolution primalSolution;
+  PerformanceIndex performanceIndices;
+  getUniformPolicy(1.0, commandData, primalSolution, performanceIndices);
+  writer.write(commandData, primalSolution, performanceIndices);
+
+  // Map the segment: a cache line of segment header followed by three slots, each starting with its sequence lock. The slot of the first
+  // policy is marked as being overwritten by the fourth policy, as if the writer lapped the ring during a read.
+  const int fileDescriptor = ::shm_open(name.c_str(), O_RDWR, 0600);
+  ASSERT_GE(fileDescriptor, 0);
+  struct stat segmentStat;
+  ASSERT_EQ(::fstat(fileDescriptor, &segmentStat), 0);
+  const auto segmentSize = static_cast<size_t>(segmentStat.st_size);
+  void* address = ::mmap(nullptr, segmentSize, PROT_READ | PROT_WRITE, MAP_SHARED, fileDescriptor, 0);
+  ::close(fileDescriptor);
+  ASSERT_NE(address, MAP_FAILED);
+  const size_t segmentHeaderSize = 64;
+  const size_t slotSize = (segmentSize - segmentHeaderSize) / 3;
+  const size_t slotIndex = 1;  // sequence number modulo the number of slots
+  auto* lockPtr = reinterpret_cast<std::atomic<uint64_t>*>(static_cast<char*>(address) + segmentHeaderSize + slotIndex * slotSize);
+  ASSERT_EQ(lockPtr->load(), 2);
+  lockPtr->store(2 * 4 - 1);
+
+  // the reader rejects the slot
+  CommandData readCommandData;
+  PrimalSolution readPrimalSolution;
+  PerformanceIndex readPerformanceIndices;
+  EXPECT_FALSE(reader.read(readCommandData, readPrimalSolution, readPerformanceIndices));
+  EXPECT_TRUE(reader.hasNewPolicy());
+
+  // and reads the next policy
+  getUniformPolicy(2.0, commandData, primalSolution, performanceIndices);
+  writer.write(commandData, primalSolution, performanceIndices);
+  ASSERT_TRUE(reader.read(readCommandData, readPrimalSolution, readPerformanceIndices));
+  EXPECT_TRUE(isUniform(2.0, readCommandData, readPrimalSolution, readPerformanceIndices));
+
+  ::munmap(address, segmentSize);
+}
+
+TEST(testSharedPolicyChannel, concurrentReader) {
+  const auto name = getSegmentName("concurrentReader");
+  SharedPolicyWriter writer(name, getDimensions());
+  SharedPolicyReader reader(name);
+
+  // the writer laps the ring of slots while the reader copies, which the reader has to detect and retry
+  std::atomic_bool stopWriting{false};
+  std::thread writerThread([&]() {
+    CommandData commandData;
+    PrimalSolution primalSolution;
+    PerformanceIndex performanceIndices;
+    for (size_t k = 1; !stopWriting; ++k) {
+      getUniformPolicy(static_cast<scalar_t>(k), commandData, primalSolution, performanceIndices);
+      writer.write(commandData, primalSolution, performanceIndices);
+    }
+  });
+
+  CommandData commandData;
+  PrimalSolution primalSolution;
+  PerformanceIndex performanceIndices;
+  size_t numReads = 0;
+  size_t numTornReads = 0;
+  scalar_t lastValue = 0.0;
+  while (numReads < 200) {
+    if (reader.read(commandData, primalSolution, performanceIndices)) {
+      ++numReads;
+      const scalar_t value = performanceIndices.merit;
+      if (!isUniform(value, commandData, primalSolution, performanceIndices)) {
+        ++numTornReads;
+      }
+      EXPECT_GT(value, lastValue) << "The reader went back in time.";
+      lastValue = value;
+    }
+  }
+  stopWriting = true;
+  writerThread.join();
+
+  EXPECT_EQ(numTornReads, 0);
+}
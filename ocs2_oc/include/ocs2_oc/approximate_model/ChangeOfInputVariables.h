@@ -30,6 +30,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #pragma once
 
 #include <ocs2_core/Types.h>
+#include <ocs2_core/misc/MonotonicArena.h>
 
 namespace ocs2 {
 
@@ -54,4 +55,15 @@ void changeOfInputVariables(ScalarFunctionQuadraticApproximation& quadraticAppro
 void changeOfInputVariables(VectorFunctionLinearApproximation& linearApproximation, const matrix_t& Pu, const matrix_t& Px = matrix_t(),
                             const vector_t& u0 = vector_t());
 
+/**
+ * Applies the change of input variables to the quadraticApproximation, where the temporaries are allocated from the given arena.
+ * See the overload without arena for the definition of the arguments.
+ */
+void changeOfInputVariables(ScalarFunctionQuadraticApproximation& quadraticApproximation, const matrix_t& Pu, const matrix_t& Px,
+                            const vector_t& u0, MonotonicArena& arena);
+
+/** Applies the change of input variables to a linear system, where the temporaries are allocated from the given arena. */
+void changeOfInputVariables(VectorFunctionLinearApproximation& linearApproximation, const matrix_t& Pu, const matrix_t& Px,
+                            const vector_t& u0, MonotonicArena& arena);
+
 }  // namespace ocs2
\ No newline at end of file
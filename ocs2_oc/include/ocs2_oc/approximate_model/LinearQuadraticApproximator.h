@@ -129,12 +129,26 @@ inline ModelData approximateFinalLQ(OptimalControlProblem& problem, const scalar
  */
 scalar_t computeCost(const OptimalControlProblem& problem, const scalar_t& time, const vector_t& state, const vector_t& input);
 
+/**
+ * Compute the quadratic approximation of the total intermediate cost (i.e. cost + softConstraints). It is assumed that the precomputation
+ * request is already made.
+ *
+ * @note The approximation is written in place. Cost terms that override StateInputCost::addQuadraticApproximation (resp.
+ * StateCost::addQuadraticApproximation) do not allocate once the approximation has its dimensions.
+ */
+void approximateCost(const OptimalControlProblem& problem, const scalar_t& time, const vector_t& state, const vector_t& input,
+                     ScalarFunctionQuadraticApproximation& cost);
+
 /**
  * Compute the quadratic approximation of the total intermediate cost (i.e. cost + softConstraints). It is assumed that the precomputation
  * request is already made.
  */
-ScalarFunctionQuadraticApproximation approximateCost(const OptimalControlProblem& problem, const scalar_t& time, const vector_t& state,
-                                                     const vector_t& input);
+inline ScalarFunctionQuadraticApproximation approximateCost(const OptimalControlProblem& problem, const scalar_t& time,
+                                                            const vector_t& state, const vector_t& input) {
+  ScalarFunctionQuadraticApproximation cost;
+  approximateCost(problem, time, state, input, cost);
+  return cost;
+}
 
 /**
  * Compute the total preJump cost (i.e. cost + softConstraints). It is assumed that the precomputation request is already made.
@@ -156,9 +170,22 @@ scalar_t computeFinalCost(const OptimalControlProblem& problem, const scalar_t&
 /**
  * Compute the quadratic approximation of the total final cost (i.e. cost + softConstraints). It is assumed that the precomputation
  * request is already made.
+ *
+ * @note The approximation is written in place, see approximateCost.
  */
-ScalarFunctionQuadraticApproximation approximateFinalCost(const OptimalControlProblem& problem, const scalar_t& time,
-                                                          const vector_t& state);
+void approximateFinalCost(const OptimalControlProblem& problem, const scalar_t& time, const vector_t& state,
+                          ScalarFunctionQuadraticApproximation& cost);
+
+/**
+ * Compute the quadratic approximation of the total final cost (i.e. cost + softConstraints). It is assumed that the precomputation
+ * request is already made.
+ */
+inline ScalarFunctionQuadraticApproximation approximateFinalCost(const OptimalControlProblem& problem, const scalar_t& time,
+                                                                 const vector_t& state) {
+  ScalarFunctionQuadraticApproximation cost;
+  approximateFinalCost(problem, time, state, cost);
+  return cost;
+}
 
 /**
  * Compute the intermediate-time Metrics (i.e. cost, softConstraints, and constraints).
@@ -94,5 +94,23 @@ void initializeStateInputTrajectories(const vector_t& initState, const std::vect
                                       const PrimalSolution& primalSolution, Initializer& initializer, vector_array_t& stateTrajectory,
                                       vector_array_t& inputTrajectory);
 
+/**
+ * Initializes the state-input trajectories by shifting the previous solution to the new horizon. The nodes of timeDiscretization that
+ * coincide with the nodes of the previous solution (same time and event type), such as the shared nodes of two shifted horizons
+ * discretized by alignedTimeDiscretizationWithEvents(), copy the previous state and input without interpolation. This includes the
+ * post-event states which are otherwise initialized by the identity map. The remaining nodes are initialized as in
+ * initializeStateInputTrajectories().
+ *
+ * @param [in] initState :  Initial state
+ * @param [in] timeDiscretization : The annotated time trajectory
+ * @param [in] primalSolution : previous solution
+ * @param [in] initializer : System initializer
+ * @param [out] stateTrajectory : The initialized state trajectory
+ * @param [out] inputTrajectory : The initialized input trajectory
+ */
+void shiftStateInputTrajectories(const vector_t& initState, const std::vector<AnnotatedTime>& timeDiscretization,
+                                 const PrimalSolution& primalSolution, Initializer& initializer, vector_array_t& stateTrajectory,
+                                 vector_array_t& inputTrajectory);
+
 }  // namespace multiple_shooting
 }  // namespace ocs2
@@ -46,6 +46,14 @@ namespace multiple_shooting {
  */
 Metrics computeMetrics(const Transcription& transcription);
 
+/**
+ * Compute the Metrics for a single intermediate node. Same as computeMetrics(transcription), but the Metrics are written in place, such
+ * that their storage is reused.
+ * @param transcription: multiple shooting transcription for an intermediate node.
+ * @param metrics: Metrics for a single intermediate node.
+ */
+void computeMetrics(const Transcription& transcription, Metrics& metrics);
+
 /**
  * Compute the Metrics for the event node.
  * @param transcription: multiple shooting transcription for event node.
@@ -0,0 +1,104 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+
+#pragma once
+
+#include <ocs2_core/Types.h>
+#include <ocs2_core/misc/MonotonicArena.h>
+
+namespace ocs2 {
+namespace multiple_shooting {
+
+/**
+ * Determines the blocks of the move blocking, where the QP input is held constant on blocks of consecutive intervals. The first
+ * numFreeIntervals intervals have an individual input, the remaining ones are grouped into blocks of blockSize intervals. An interval
+ * without input (event) forms a block on its own and restarts the grouping.
+ *
+ * @param [in] inputTrajectory : The input trajectory, where an empty input denotes an event interval.
+ * @param [in] numFreeIntervals : Number of leading intervals with an individual input.
+ * @param [in] blockSize : Number of intervals per block.
+ * @return The index of the first interval of each block, followed by the number of intervals.
+ */
+std::vector<int> getMoveBlockingIndices(const vector_array_t& inputTrajectory, int numFreeIntervals, int blockSize);
+
+/**
+ * Sets the input of each interval to the input at the start of its block.
+ *
+ * @param [in] blockIndices : The block indices from getMoveBlockingIndices().
+ * @param [in, out] inputTrajectory : The input trajectory.
+ */
+void holdInputOnBlocks(const std::vector<int>& blockIndices, vector_array_t& inputTrajectory);
+
+/**
+ * Reduces the LQ approximation to the move-blocked QP. Stage b of the blocked QP maps the state at interval blockIndices[b] with the
+ * single input of the block to the state at interval blockIndices[b + 1]. The intermediate states are eliminated by forward substitution,
+ * x_j = Phi_j * x + Gamma_j * v + phi_j, and their costs are expressed in the stage variables {x, v}. The terminal cost is copied.
+ *
+ * @param [in] blockIndices : The block indices from getMoveBlockingIndices().
+ * @param [in] dynamics : The linearized dynamics of the intervals.
+ * @param [in] cost : The quadratic cost of the nodes.
+ * @param [out] blockedDynamics : The dynamics of the blocked QP.
+ * @param [out] blockedCost : The cost of the blocked QP.
+ * @param [in] arena : Memory for the temporaries.
+ */
+void reduceMoveBlocking(const std::vector<int>& blockIndices, const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                        const std::vector<ScalarFunctionQuadraticApproximation>& cost,
+                        std::vector<VectorFunctionLinearApproximation>& blockedDynamics,
+                        std::vector<ScalarFunctionQuadraticApproximation>& blockedCost, MonotonicArena& arena);
+
+/**
+ * Expands the solution of the move-blocked QP to all intervals. The intermediate states are recovered by the linearized dynamics.
+ *
+ * @param [in] blockIndices : The block indices from getMoveBlockingIndices().
+ * @param [in] dynamics : The linearized dynamics of the intervals.
+ * @param [in] blockedDeltaX : The state trajectory of the blocked QP solution.
+ * @param [in] blockedDeltaU : The input trajectory of the blocked QP solution.
+ * @param [out] deltaX : The state trajectory of the QP subproblem solution.
+ * @param [out] deltaU : The input trajectory of the QP subproblem solution.
+ */
+void expandMoveBlocking(const std::vector<int>& blockIndices, const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                        const vector_array_t& blockedDeltaX, const vector_array_t& blockedDeltaU, vector_array_t& deltaX,
+                        vector_array_t& deltaU);
+
+/**
+ * Expands the LQR gains of the move-blocked QP to all intervals. The gain of a block maps the state at the start of the block to the
+ * block input. The gains of the following intervals of the block hold this input: along a rollout of the linearized dynamics that
+ * starts with a deviated state, they give the same input as the block gain at the start of the block.
+ *
+ * @param [in] blockIndices : The block indices from getMoveBlockingIndices().
+ * @param [in] dynamics : The linearized dynamics of the intervals.
+ * @param [in] blockedKMatrices : The LQR gains of the blocked QP.
+ * @param [out] KMatrices : The LQR gains of all intervals.
+ */
+void expandMoveBlockingGain(const std::vector<int>& blockIndices, const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                            const matrix_array_t& blockedKMatrices, matrix_array_t& KMatrices);
+
+}  // namespace multiple_shooting
+}  // namespace ocs2
@@ -30,6 +30,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #pragma once
 
 #include <ocs2_core/Types.h>
+#include <ocs2_core/misc/MonotonicArena.h>
 
 namespace ocs2 {
 namespace multiple_shooting {
@@ -54,6 +55,10 @@ struct ProjectionMultiplierCoefficients {
    */
   void compute(const ScalarFunctionQuadraticApproximation& cost, const VectorFunctionLinearApproximation& dynamics,
                const VectorFunctionLinearApproximation& constraintProjection, const matrix_t& pseudoInverse);
+
+  /** Computes the coefficients, where the temporaries are allocated from the given arena. */
+  void compute(const ScalarFunctionQuadraticApproximation& cost, const VectorFunctionLinearApproximation& dynamics,
+               const VectorFunctionLinearApproximation& constraintProjection, const matrix_t& pseudoInverse, MonotonicArena& arena);
 };
 
 }  // namespace multiple_shooting
@@ -31,6 +31,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/Types.h>
 #include <ocs2_core/integration/SensitivityIntegrator.h>
+#include <ocs2_core/misc/MonotonicArena.h>
 
 #include "ocs2_oc/multiple_shooting/ProjectionMultiplierCoefficients.h"
 #include "ocs2_oc/oc_problem/OptimalControlProblem.h"
@@ -73,10 +74,44 @@ struct Transcription {
  * @param x : State at start of the interval
  * @param x_next : State at the end of the interval
  * @param u : Input, taken to be constant across the interval.
- * @return multiple shooting transcription for this node.
+ * @param transcription : multiple shooting transcription for this node.
  */
-Transcription setupIntermediateNode(OptimalControlProblem& optimalControlProblem, DynamicsSensitivityDiscretizer& sensitivityDiscretizer,
-                                    scalar_t t, scalar_t dt, const vector_t& x, const vector_t& x_next, const vector_t& u);
+void setupIntermediateNode(OptimalControlProblem& optimalControlProblem, DynamicsSensitivityDiscretizer& sensitivityDiscretizer,
+                           scalar_t t, scalar_t dt, const vector_t& x, const vector_t& x_next, const vector_t& u,
+                           Transcription& transcription);
+
+/**
+ * Compute the multiple shooting transcription for a single intermediate node.
+ * The overload above writes the cost into the existing transcription, the discrete dynamics and the constraints are returned by value.
+ * Use setupIntermediateNodes to also write the dynamics in place.
+ */
+inline Transcription setupIntermediateNode(OptimalControlProblem& optimalControlProblem,
+                                           DynamicsSensitivityDiscretizer& sensitivityDiscretizer, scalar_t t, scalar_t dt,
+                                           const vector_t& x, const vector_t& x_next, const vector_t& u) {
+  Transcription transcription;
+  setupIntermediateNode(optimalControlProblem, sensitivityDiscretizer, t, dt, x, x_next, u, transcription);
+  return transcription;
+}
+
+/**
+ * Compute the multiple shooting transcriptions for a block of intermediate nodes. The discrete dynamics of all nodes are computed by a
+ * single call of the block integrator, such that the system can evaluate the nodes at once, see
+ * SystemDynamicsBase::linearApproximationBatch. The other terms are computed node by node as in setupIntermediateNode.
+ *
+ * The dynamics and the cost are written into the storage of the block and of the transcriptions. Hence, once the storage has its
+ * dimensions, a node without constraints does not allocate if the system overrides linearApproximationBatch to write in place (e.g.
+ * SystemDynamicsBaseAD, LinearSystemDynamics) and the cost terms override addQuadraticApproximation (e.g. QuadraticStateInputCost).
+ * The constraints are still returned by value.
+ *
+ * @param optimalControlProblem : Definition of the optimal control problem
+ * @param sensitivityDiscretizer : Block integrator to use for creating the discrete dynamics.
+ * @param block : Start, duration, state and input of the intervals. Its dynamics are used as workspace.
+ * @param x_next : States at the end of the intervals
+ * @param transcriptions : multiple shooting transcriptions of the nodes, the first block.size entries are written.
+ */
+void setupIntermediateNodes(OptimalControlProblem& optimalControlProblem, DynamicsSensitivityBlockDiscretizer& sensitivityDiscretizer,
+                            SensitivityDiscretizationBlock& block, const vector_array_t& x_next,
+                            std::vector<Transcription>& transcriptions);
 
 /**
  * Apply the state-input equality constraint projection for a single intermediate node transcription.
@@ -86,6 +121,16 @@ Transcription setupIntermediateNode(OptimalControlProblem& optimalControlProblem
  */
 void projectTranscription(Transcription& transcription, bool extractProjectionMultiplier = false);
 
+/**
+ * Apply the state-input equality constraint projection for a single intermediate node transcription. The temporaries of the projection
+ * are allocated from the given arena.
+ *
+ * @param transcription : Transcription for a single intermediate node
+ * @param extractProjectionMultiplier : Whether to extract the projection multiplier.
+ * @param arena : Scratch memory, e.g. of the worker thread that sets up the node.
+ */
+void projectTranscription(Transcription& transcription, bool extractProjectionMultiplier, MonotonicArena& arena);
+
 /**
  * Results of the transcription at a terminal node
  */
@@ -102,9 +147,16 @@ struct TerminalTranscription {
  * @param optimalControlProblem : Definition of the optimal control problem
  * @param t : Time at the terminal node
  * @param x : Terminal state
- * @return multiple shooting transcription for the terminal node.
+ * @param transcription : multiple shooting transcription for the terminal node.
  */
-TerminalTranscription setupTerminalNode(OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x);
+void setupTerminalNode(OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x, TerminalTranscription& transcription);
+
+/** Compute the multiple shooting transcription the terminal node. */
+inline TerminalTranscription setupTerminalNode(OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x) {
+  TerminalTranscription transcription;
+  setupTerminalNode(optimalControlProblem, t, x, transcription);
+  return transcription;
+}
 
 /**
  * Results of the transcription at an event
@@ -124,9 +176,18 @@ struct EventTranscription {
  * @param t : Time at the event node
  * @param x : Pre-event state
  * @param x_next : Post-event state
- * @return multiple shooting transcription for the event node.
+ * @param transcription : multiple shooting transcription for the event node.
  */
-EventTranscription setupEventNode(OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x, const vector_t& x_next);
+void setupEventNode(OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x, const vector_t& x_next,
+                    EventTranscription& transcription);
+
+/** Compute the jump transcription at an event node. */
+inline EventTranscription setupEventNode(OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x,
+                                         const vector_t& x_next) {
+  EventTranscription transcription;
+  setupEventNode(optimalControlProblem, t, x, x_next, transcription);
+  return transcription;
+}
 
 }  // namespace multiple_shooting
 }  // namespace ocs2
@@ -0,0 +1,111 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <ocs2_core/Types.h>
+#include <ocs2_core/control/FeedforwardController.h>
+#include <ocs2_core/control/LinearController.h>
+#include <ocs2_core/misc/LinearInterpolation.h>
+
+#include "ocs2_oc/oc_data/PrimalSolution.h"
+
+namespace ocs2 {
+
+/**
+ * Evaluates the nominal state, the input, and the mode of a primal solution in a control loop. In contrast to
+ * ControllerBase::computeInput(), the evaluator caches the interval of the last query, such that the lookup is amortized O(1) for
+ * increasing query times, and writes into preallocated buffers, such that the evaluation does not allocate once the outputs are sized.
+ *
+ * The policy can optionally be resampled at a fixed period when it is set. The interval of a query is then computed directly from the
+ * query time. The resampled policy is linearly interpolated between the samples, so the period should resolve the time grid and the
+ * switching times of the policy.
+ *
+ * LinearController and FeedforwardController are evaluated natively. Other controllers fall back to ControllerBase::computeInput().
+ */
+class PolicyEvaluator {
+ public:
+  /**
+   * Sets the policy to evaluate and resets the cached interval.
+   * @note The evaluator refers to the primal solution, which must outlive it or be replaced by another call. The buffers are reused if
+   * the dimensions do not change.
+   *
+   * @param [in] primalSolution: The policy.
+   * @param [in] resamplingPeriod: If positive, the period of the fixed-rate resampling of the policy.
+   */
+  void setPolicy(const PrimalSolution& primalSolution, scalar_t resamplingPeriod = 0.0);
+
+  /** Whether a policy is set. */
+  bool hasPolicy() const { return primalSolutionPtr_ != nullptr; }
+
+  /** Whether the policy is resampled. */
+  bool isResampled() const { return isResampled_; }
+
+  /** Forgets the policy. */
+  void clear() { primalSolutionPtr_ = nullptr; }
+
+  /**
+   * Evaluates the policy. Equivalent to interpolating the state trajectory, ControllerBase::computeInput(), and
+   * ModeSchedule::modeAtTime().
+   *
+   * @param [in] time: The query time.
+   * @param [in] state: The query state.
+   * @param [out] nominalState: The nominal state of the policy.
+   * @param [out] input: The input of the policy.
+   * @param [out] mode: The active mode.
+   */
+  void evaluate(scalar_t time, const vector_t& state, vector_t& nominalState, vector_t& input, size_t& mode);
+
+ private:
+  /** Computes the interval and the interpolation coefficient of the query time. */
+  LinearInterpolation::index_alpha_t resampledTimeSegment(scalar_t time) const;
+
+  /** Samples the trajectory at the resampling times. */
+  template <typename Data>
+  void resample(const scalar_array_t& timeArray, const std::vector<Data>& dataArray, std::vector<Data>& resampledArray);
+
+  const PrimalSolution* primalSolutionPtr_ = nullptr;
+  const LinearController* linearControllerPtr_ = nullptr;
+  const FeedforwardController* feedforwardControllerPtr_ = nullptr;
+
+  // cached intervals of the last query
+  int stateInterval_ = 0;
+  int controllerInterval_ = 0;
+  int modeInterval_ = 0;
+
+  // fixed-rate resampling
+  bool isResampled_ = false;
+  scalar_t resamplingPeriod_ = 0.0;
+  scalar_array_t resampledTime_;
+  vector_array_t resampledState_;
+  vector_array_t resampledBias_;
+  matrix_array_t resampledGain_;
+};
+
+}  // namespace ocs2
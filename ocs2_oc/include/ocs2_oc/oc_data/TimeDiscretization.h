@@ -76,6 +76,60 @@ std::vector<AnnotatedTime> timeDiscretizationWithEvents(scalar_t initTime, scala
                                                         const scalar_array_t& eventTimes,
                                                         scalar_t dt_min = 10.0 * numeric_traits::limitEpsilon<scalar_t>());
 
+/**
+ * Decides on a time discretization along the horizon which is aligned to the grid {k * dt}, such that the discretizations of two
+ * shifted horizons share their nodes, see multiple_shooting::shiftStateInputTrajectories(). Except for the initial and final times,
+ * all nodes are either grid points or event times. Grid points closer than dt / 2 to the initial or the final time are skipped, such
+ * that the number of nodes is constant for a fixed horizon length of a multiple of dt and without events.
+ *
+ * @param initTime : start time.
+ * @param finalTime : final time.
+ * @param dt : grid step.
+ * @param eventTimes : Event times where a time discretization must be made.
+ * @param dt_min : minimum discretization step. Smaller intervals will be merged. Needs to be bigger than limitEpsilon to avoid
+ * interpolation problems
+ * @return vector of discrete time points
+ */
+std::vector<AnnotatedTime> alignedTimeDiscretizationWithEvents(scalar_t initTime, scalar_t finalTime, scalar_t dt,
+                                                               const scalar_array_t& eventTimes,
+                                                               scalar_t dt_min = 10.0 * numeric_traits::limitEpsilon<scalar_t>());
+
+/**
+ * Decides on a non-uniform time discretization along the horizon. The step is dt at the initial time and at the event times, and grows
+ * geometrically with the given rate away from them, up to dtMax. Event times are part of the discretization.
+ *
+ * @param initTime : start time.
+ * @param finalTime : final time.
+ * @param dt : smallest discretization step, used at the initial time and around the events.
+ * @param growthRate : ratio between two consecutive steps (>= 1.0). For 1.0, the discretization is uniform.
+ * @param dtMax : largest discretization step.
+ * @param eventTimes : Event times where a time discretization must be made.
+ * @param dt_min : minimum discretization step. Smaller intervals will be merged. Needs to be bigger than limitEpsilon to avoid
+ * interpolation problems
+ * @return vector of discrete time points
+ */
+std::vector<AnnotatedTime> adaptiveTimeDiscretizationWithEvents(scalar_t initTime, scalar_t finalTime, scalar_t dt, scalar_t growthRate,
+                                                                scalar_t dtMax, const scalar_array_t& eventTimes,
+                                                                scalar_t dt_min = 10.0 * numeric_traits::limitEpsilon<scalar_t>());
+
+/**
+ * Decides on the time discretization of the horizon from the discretization settings of the multiple-shooting solvers. The
+ * discretization is non-uniform for growthRate > 1.0, aligned to the grid {k * dt} if isAligned is set, and uniform otherwise.
+ * The non-uniform and the aligned discretizations can not be combined, since the non-uniform grid moves with the initial time.
+ *
+ * @param initTime : start time.
+ * @param finalTime : final time.
+ * @param dt : discretization step, the smallest one for the non-uniform discretization.
+ * @param growthRate : ratio between two consecutive steps of the non-uniform discretization (>= 1.0).
+ * @param dtMax : largest discretization step of the non-uniform discretization.
+ * @param isAligned : Whether the discretization is aligned to the grid {k * dt}.
+ * @param eventTimes : Event times where a time discretization must be made.
+ * @return vector of discrete time points
+ * @throws std::runtime_error if growthRate > 1.0 and isAligned is set.
+ */
+std::vector<AnnotatedTime> getTimeDiscretization(scalar_t initTime, scalar_t finalTime, scalar_t dt, scalar_t growthRate, scalar_t dtMax,
+                                                 bool isAligned, const scalar_array_t& eventTimes);
+
 /**
  * Extracts the time trajectory from the annotated time trajectory.
  *
@@ -29,6 +29,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <functional>
 #include <iostream>
 #include <memory>
 #include <mutex>
@@ -53,6 +54,9 @@ namespace ocs2 {
  */
 class SolverBase {
  public:
+  /** Callback type for the intermediate iterates of the solver, see setIntermediateSolutionCallback(). */
+  using intermediate_solution_callback_t = std::function<void(const PrimalSolution&, const PerformanceIndex&)>;
+
   /**
    * Constructor.
    */
@@ -139,6 +143,14 @@ class SolverBase {
    */
   void addSolverObserver(std::unique_ptr<SolverObserver> observerModule) { solverObservers_.push_back(std::move(observerModule)); }
 
+  /**
+   * Sets a callback which receives the primal solution and its performance index after each iteration of the solver
+   * except the last one, whose solution is available through getPrimalSolution(). The callback is called from the
+   * thread running the solver and blocks it, so it should return quickly. Solvers which do not support intermediate
+   * solutions ignore the callback. Pass an empty function to remove it.
+   */
+  void setIntermediateSolutionCallback(intermediate_solution_callback_t callback) { intermediateSolutionCallback_ = std::move(callback); }
+
   /**
    * @brief Returns a const reference to the definition of optimal control problem.
    *
@@ -252,6 +264,18 @@ class SolverBase {
    */
   void printString(const std::string& text) const;
 
+ protected:
+  /** Whether an intermediate solution callback is set. Solvers should only construct the intermediate solutions if so. */
+  bool hasIntermediateSolutionCallback() const { return static_cast<bool>(intermediateSolutionCallback_); }
+
+  /**
+   * Passes an intermediate iterate to the callback set by setIntermediateSolutionCallback().
+   *
+   * @param [in] primalSolution: The primal solution of the current iterate.
+   * @param [in] performanceIndex: The performance index of the current iterate.
+   */
+  void publishIntermediateSolution(const PrimalSolution& primalSolution, const PerformanceIndex& performanceIndex) const;
+
  private:
   virtual void runImpl(scalar_t initTime, const vector_t& initState, scalar_t finalTime) = 0;
 
@@ -270,6 +294,7 @@ class SolverBase {
   std::shared_ptr<ReferenceManagerInterface> referenceManagerPtr_;  // this pointer cannot be nullptr
   std::vector<std::shared_ptr<SolverSynchronizedModule>> synchronizedModules_;
   std::vector<std::unique_ptr<SolverObserver>> solverObservers_;
+  intermediate_solution_callback_t intermediateSolutionCallback_;
 };
 
 }  // namespace ocs2
@@ -33,6 +33,18 @@ namespace ocs2 {
 
 void changeOfInputVariables(ScalarFunctionQuadraticApproximation& quadraticApproximation, const matrix_t& Pu, const matrix_t& Px,
                             const vector_t& u0) {
+  MonotonicArena arena;
+  changeOfInputVariables(quadraticApproximation, Pu, Px, u0, arena);
+}
+
+void changeOfInputVariables(VectorFunctionLinearApproximation& linearApproximation, const matrix_t& Pu, const matrix_t& Px,
+                            const vector_t& u0) {
+  MonotonicArena arena;
+  changeOfInputVariables(linearApproximation, Pu, Px, u0, arena);
+}
+
+void changeOfInputVariables(ScalarFunctionQuadraticApproximation& quadraticApproximation, const matrix_t& Pu, const matrix_t& Px,
+                            const vector_t& u0, MonotonicArena& arena) {
   /*
    * 3 temporaries are needed in any branch because Pu is non-zero and:
    *  - new P contains a product Pu'*P
@@ -47,13 +59,15 @@ void changeOfInputVariables(ScalarFunctionQuadraticApproximation& quadraticAppro
   const bool hasu0(u0.size() > 0);
 
   // Shared term number 1
-  matrix_t P_plus_R_Px = quadraticApproximation.dfdux;
+  auto P_plus_R_Px = arena.allocateMatrix(quadraticApproximation.dfdux.rows(), quadraticApproximation.dfdux.cols());
+  P_plus_R_Px = quadraticApproximation.dfdux;
   if (hasPx) {
     P_plus_R_Px.noalias() += quadraticApproximation.dfduu * Px;
   }  // else added term is zero
 
   // Shared term number 2
-  vector_t r_plus_R_u0 = quadraticApproximation.dfdu;
+  auto r_plus_R_u0 = arena.allocateVector(quadraticApproximation.dfdu.size());
+  r_plus_R_u0 = quadraticApproximation.dfdu;
   if (hasu0) {
     r_plus_R_u0.noalias() += quadraticApproximation.dfduu * u0;
   }  // else added term is zero
@@ -81,7 +95,9 @@ void changeOfInputVariables(ScalarFunctionQuadraticApproximation& quadraticAppro
   quadraticApproximation.dfdux.noalias() = Pu.transpose() * P_plus_R_Px;
 
   // R = Pu' * R * Pu
-  matrix_t R_Pu = quadraticApproximation.dfduu * Pu;  // make the required temporary explicit, to save it in the second multiplication
+  // make the required temporary explicit, to save it in the second multiplication
+  auto R_Pu = arena.allocateMatrix(quadraticApproximation.dfduu.rows(), Pu.cols());
+  R_Pu.noalias() = quadraticApproximation.dfduu * Pu;
   quadraticApproximation.dfduu.noalias() = Pu.transpose() * R_Pu;
 
   // r = Pu' * (R*u0 + r)
@@ -89,7 +105,7 @@ void changeOfInputVariables(ScalarFunctionQuadraticApproximation& quadraticAppro
 }
 
 void changeOfInputVariables(VectorFunctionLinearApproximation& linearApproximation, const matrix_t& Pu, const matrix_t& Px,
-                            const vector_t& u0) {
+                            const vector_t& u0, MonotonicArena& arena) {
   const bool hasPx(Px.size() > 0);
   const bool hasu0(u0.size() > 0);
 
@@ -104,7 +120,9 @@ void changeOfInputVariables(VectorFunctionLinearApproximation& linearApproximati
   }
 
   // B = B*Pu
-  linearApproximation.dfdu = linearApproximation.dfdu * Pu;  // temporary matrix unavoidable
+  auto B_Pu = arena.allocateMatrix(linearApproximation.dfdu.rows(), Pu.cols());  // temporary matrix unavoidable
+  B_Pu.noalias() = linearApproximation.dfdu * Pu;
+  linearApproximation.dfdu = B_Pu;
 }
 
 }  // namespace ocs2
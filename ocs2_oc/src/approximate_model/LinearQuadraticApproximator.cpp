@@ -178,34 +178,27 @@ scalar_t computeCost(const OptimalControlProblem& problem, const scalar_t& time,
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-ScalarFunctionQuadraticApproximation approximateCost(const OptimalControlProblem& problem, const scalar_t& time, const vector_t& state,
-                                                     const vector_t& input) {
+void approximateCost(const OptimalControlProblem& problem, const scalar_t& time, const vector_t& state, const vector_t& input,
+                     ScalarFunctionQuadraticApproximation& cost) {
   const auto& targetTrajectories = *problem.targetTrajectoriesPtr;
   const auto& preComputation = *problem.preComputationPtr;
 
   // get the state-input cost approximations
-  auto cost = problem.costPtr->getQuadraticApproximation(time, state, input, targetTrajectories, preComputation);
+  cost.setZero(state.rows(), input.rows());
+  problem.costPtr->addQuadraticApproximation(time, state, input, targetTrajectories, preComputation, cost);
 
   if (!problem.softConstraintPtr->empty()) {
-    cost += problem.softConstraintPtr->getQuadraticApproximation(time, state, input, targetTrajectories, preComputation);
+    problem.softConstraintPtr->addQuadraticApproximation(time, state, input, targetTrajectories, preComputation, cost);
   }
 
   // get the state only cost approximations
   if (!problem.stateCostPtr->empty()) {
-    auto stateCost = problem.stateCostPtr->getQuadraticApproximation(time, state, targetTrajectories, preComputation);
-    cost.f += stateCost.f;
-    cost.dfdx += stateCost.dfdx;
-    cost.dfdxx += stateCost.dfdxx;
+    problem.stateCostPtr->addQuadraticApproximation(time, state, targetTrajectories, preComputation, cost);
   }
 
   if (!problem.stateSoftConstraintPtr->empty()) {
-    auto stateCost = problem.stateSoftConstraintPtr->getQuadraticApproximation(time, state, targetTrajectories, preComputation);
-    cost.f += stateCost.f;
-    cost.dfdx += stateCost.dfdx;
-    cost.dfdxx += stateCost.dfdxx;
+    problem.stateSoftConstraintPtr->addQuadraticApproximation(time, state, targetTrajectories, preComputation, cost);
   }
-
-  return cost;
 }
 
 /******************************************************************************************************/
@@ -253,17 +246,16 @@ scalar_t computeFinalCost(const OptimalControlProblem& problem, const scalar_t&
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-ScalarFunctionQuadraticApproximation approximateFinalCost(const OptimalControlProblem& problem, const scalar_t& time,
-                                                          const vector_t& state) {
+void approximateFinalCost(const OptimalControlProblem& problem, const scalar_t& time, const vector_t& state,
+                          ScalarFunctionQuadraticApproximation& cost) {
   const auto& targetTrajectories = *problem.targetTrajectoriesPtr;
   const auto& preComputation = *problem.preComputationPtr;
 
-  auto cost = problem.finalCostPtr->getQuadraticApproximation(time, state, targetTrajectories, preComputation);
+  cost.setZero(state.rows());
+  problem.finalCostPtr->addQuadraticApproximation(time, state, targetTrajectories, preComputation, cost);
   if (!problem.finalSoftConstraintPtr->empty()) {
-    cost += problem.finalSoftConstraintPtr->getQuadraticApproximation(time, state, targetTrajectories, preComputation);
+    problem.finalSoftConstraintPtr->addQuadraticApproximation(time, state, targetTrajectories, preComputation, cost);
   }
-
-  return cost;
 }
 
 /******************************************************************************************************/
@@ -78,5 +78,89 @@ void initializeStateInputTrajectories(const vector_t& initState, const std::vect
   }
 }
 
+void shiftStateInputTrajectories(const vector_t& initState, const std::vector<AnnotatedTime>& timeDiscretization,
+                                 const PrimalSolution& primalSolution, Initializer& initializer, vector_array_t& stateTrajectory,
+                                 vector_array_t& inputTrajectory) {
+  const auto& previousTime = primalSolution.timeTrajectory_;
+  if (previousTime.size() < 2) {
+    initializeStateInputTrajectories(initState, timeDiscretization, primalSolution, initializer, stateTrajectory, inputTrajectory);
+    return;
+  }
+
+  // Recover the annotation of the previous time discretization
+  std::vector<AnnotatedTime::Event> previousEvents(previousTime.size(), AnnotatedTime::Event::None);
+  for (const auto postEventIndex : primalSolution.postEventIndices_) {
+    previousEvents[postEventIndex - 1] = AnnotatedTime::Event::PreEvent;
+    previousEvents[postEventIndex] = AnnotatedTime::Event::PostEvent;
+  }
+
+  // Match the nodes with the previous nodes. Both discretizations are sorted, hence a single forward pass suffices.
+  const int N = static_cast<int>(timeDiscretization.size()) - 1;  // size of the input trajectory
+  const int previousSize = static_cast<int>(previousTime.size());
+  std::vector<int> previousIndices(N + 1, -1);
+  int j = 0;
+  for (int i = 0; i <= N; i++) {
+    const auto& node = timeDiscretization[i];
+    while (j < previousSize && previousTime[j] < node.time - numeric_traits::limitEpsilon<scalar_t>()) {
+      ++j;
+    }
+    for (int k = j; k < previousSize && previousTime[k] <= node.time + numeric_traits::limitEpsilon<scalar_t>(); ++k) {
+      if (previousEvents[k] == node.event) {
+        previousIndices[i] = k;
+        j = k + 1;
+        break;
+      }
+    }
+  }
+
+  stateTrajectory.clear();
+  stateTrajectory.reserve(N + 1);
+  inputTrajectory.clear();
+  inputTrajectory.reserve(N);
+
+  // Determine till when to use the previous solution
+  const scalar_t interpolateStateTill = previousTime.back();
+  const scalar_t interpolateInputTill = previousTime[previousTime.size() - 2];
+
+  // Initial state
+  const scalar_t initTime = getIntervalStart(timeDiscretization[0]);
+  if (previousIndices[0] >= 0) {
+    stateTrajectory.push_back(primalSolution.stateTrajectory_[previousIndices[0]]);
+  } else if (initTime < interpolateStateTill) {
+    stateTrajectory.push_back(LinearInterpolation::interpolate(initTime, previousTime, primalSolution.stateTrajectory_));
+  } else {
+    stateTrajectory.push_back(initState);
+  }
+
+  for (int i = 0; i < N; i++) {
+    const bool isShifted = previousIndices[i] >= 0 && previousIndices[i + 1] == previousIndices[i] + 1;
+    if (timeDiscretization[i].event == AnnotatedTime::Event::PreEvent) {
+      // Event Node
+      inputTrajectory.push_back(vector_t());  // no input at event node
+      if (isShifted) {
+        stateTrajectory.push_back(primalSolution.stateTrajectory_[previousIndices[i + 1]]);
+      } else {
+        stateTrajectory.push_back(initializeEventNode(timeDiscretization[i].time, stateTrajectory.back()));
+      }
+    } else if (isShifted) {
+      // Shifted interval
+      inputTrajectory.push_back(primalSolution.inputTrajectory_[previousIndices[i]]);
+      stateTrajectory.push_back(primalSolution.stateTrajectory_[previousIndices[i + 1]]);
+    } else {
+      // Intermediate node
+      const scalar_t time = getIntervalStart(timeDiscretization[i]);
+      const scalar_t nextTime = getIntervalEnd(timeDiscretization[i + 1]);
+      vector_t input, nextState;
+      if (time > interpolateInputTill || nextTime > interpolateStateTill) {  // Using initializer
+        std::tie(input, nextState) = initializeIntermediateNode(initializer, time, nextTime, stateTrajectory.back());
+      } else {  // interpolate previous solution
+        std::tie(input, nextState) = initializeIntermediateNode(primalSolution, time, nextTime);
+      }
+      inputTrajectory.push_back(std::move(input));
+      stateTrajectory.push_back(std::move(nextState));
+    }
+  }
+}
+
 }  // namespace multiple_shooting
 }  // namespace ocs2
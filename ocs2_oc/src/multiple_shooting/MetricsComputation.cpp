@@ -34,10 +34,26 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 namespace ocs2 {
 namespace multiple_shooting {
 
-Metrics computeMetrics(const Transcription& transcription) {
-  const auto& constraintsSize = transcription.constraintsSize;
+namespace {
+/** Same as toConstraintArray(termsSize, vec), but writes to the entries of constraintArray in place */
+void assignConstraintArray(const size_array_t& termsSize, const vector_t& vec, vector_array_t& constraintArray) {
+  constraintArray.resize(termsSize.size());
+  size_t head = 0;
+  for (size_t i = 0; i < termsSize.size(); i++) {
+    constraintArray[i] = vec.segment(head, termsSize[i]);
+    head += termsSize[i];
+  }
+}
+}  // namespace
 
+Metrics computeMetrics(const Transcription& transcription) {
   Metrics metrics;
+  computeMetrics(transcription, metrics);
+  return metrics;
+}
+
+void computeMetrics(const Transcription& transcription, Metrics& metrics) {
+  const auto& constraintsSize = transcription.constraintsSize;
 
   // Cost
   metrics.cost = transcription.cost.f;
@@ -46,14 +62,18 @@ Metrics computeMetrics(const Transcription& transcription) {
   metrics.dynamicsViolation = transcription.dynamics.f;
 
   // Equality constraints
-  metrics.stateEqConstraint = toConstraintArray(constraintsSize.stateEq, transcription.stateEqConstraints.f);
-  metrics.stateInputEqConstraint = toConstraintArray(constraintsSize.stateInputEq, transcription.stateInputEqConstraints.f);
+  assignConstraintArray(constraintsSize.stateEq, transcription.stateEqConstraints.f, metrics.stateEqConstraint);
+  assignConstraintArray(constraintsSize.stateInputEq, transcription.stateInputEqConstraints.f, metrics.stateInputEqConstraint);
 
   // Inequality constraints.
-  metrics.stateIneqConstraint = toConstraintArray(constraintsSize.stateIneq, transcription.stateIneqConstraints.f);
-  metrics.stateInputIneqConstraint = toConstraintArray(constraintsSize.stateInputIneq, transcription.stateInputIneqConstraints.f);
-
-  return metrics;
+  assignConstraintArray(constraintsSize.stateIneq, transcription.stateIneqConstraints.f, metrics.stateIneqConstraint);
+  assignConstraintArray(constraintsSize.stateInputIneq, transcription.stateInputIneqConstraints.f, metrics.stateInputIneqConstraint);
+
+  // Lagrangians are not part of the transcription
+  metrics.stateEqLagrangian.clear();
+  metrics.stateIneqLagrangian.clear();
+  metrics.stateInputEqLagrangian.clear();
+  metrics.stateInputIneqLagrangian.clear();
 }
 
 Metrics computeMetrics(const EventTranscription& transcription) {
@@ -0,0 +1,206 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+
+#include "ocs2_oc/multiple_shooting/MoveBlocking.h"
+
+namespace ocs2 {
+namespace multiple_shooting {
+
+std::vector<int> getMoveBlockingIndices(const vector_array_t& inputTrajectory, int numFreeIntervals, int blockSize) {
+  const int N = static_cast<int>(inputTrajectory.size());
+  std::vector<int> blockIndices;
+  blockIndices.reserve(N + 1);
+
+  int i = 0;
+  while (i < N) {
+    blockIndices.push_back(i);
+    const int inputDim = inputTrajectory[i].size();
+    if (i < numFreeIntervals || inputDim == 0) {
+      ++i;
+    } else {
+      const int blockEnd = std::min(i + std::max(blockSize, 1), N);
+      ++i;
+      while (i < blockEnd && inputTrajectory[i].size() == inputDim) {  // blocks end at events
+        ++i;
+      }
+    }
+  }
+  blockIndices.push_back(N);
+
+  return blockIndices;
+}
+
+void holdInputOnBlocks(const std::vector<int>& blockIndices, vector_array_t& inputTrajectory) {
+  const int numBlocks = static_cast<int>(blockIndices.size()) - 1;
+  for (int b = 0; b < numBlocks; b++) {
+    for (int i = blockIndices[b] + 1; i < blockIndices[b + 1]; i++) {
+      inputTrajectory[i] = inputTrajectory[blockIndices[b]];
+    }
+  }
+}
+
+void reduceMoveBlocking(const std::vector<int>& blockIndices, const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                        const std::vector<ScalarFunctionQuadraticApproximation>& cost,
+                        std::vector<VectorFunctionLinearApproximation>& blockedDynamics,
+                        std::vector<ScalarFunctionQuadraticApproximation>& blockedCost, MonotonicArena& arena) {
+  /*
+   * The terms of the quadratic functions have the following notation:
+   * dfdxx = Q, dfdux = P, dfduu = R, dfdx = q, dfdu = r, f = c.
+   *
+   * The state of interval j within the block is x_j = Phi * x + Gamma * v + phi, with Phi = I, Gamma = 0, phi = 0 at the start of the
+   * block, and the input is u_j = v.
+   */
+  const int numBlocks = static_cast<int>(blockIndices.size()) - 1;
+  blockedDynamics.resize(numBlocks);
+  blockedCost.resize(numBlocks + 1);
+
+  for (int b = 0; b < numBlocks; b++) {
+    const int start = blockIndices[b];
+    const int end = blockIndices[b + 1];
+
+    // The first interval is in the stage variables
+    auto& blockDynamics = blockedDynamics[b];
+    auto& blockCost = blockedCost[b];
+    blockDynamics = dynamics[start];
+    blockCost = cost[start];
+
+    const auto nx = blockDynamics.dfdx.cols();
+    const auto nu = blockDynamics.dfdu.cols();
+    for (int j = start + 1; j < end; j++) {
+      const auto& A = dynamics[j].dfdx;
+      const auto& B = dynamics[j].dfdu;
+      const auto& Q = cost[j].dfdxx;
+      const auto& P = cost[j].dfdux;
+      if (B.cols() != nu || A.cols() != A.rows()) {
+        throw std::runtime_error("[reduceMoveBlocking] The state and input dimensions must be constant within a block!");
+      }
+
+      // Phi, Gamma, phi of interval j
+      auto& Phi = blockDynamics.dfdx;
+      auto& Gamma = blockDynamics.dfdu;
+      auto& phi = blockDynamics.f;
+
+      auto Q_Phi = arena.allocateMatrix(Q.rows(), nx);
+      auto Q_Gamma = arena.allocateMatrix(Q.rows(), nu);
+      auto Q_phi_plus_q = arena.allocateVector(Q.rows());
+      auto P_Gamma = arena.allocateMatrix(nu, nu);
+      Q_Phi.noalias() = Q * Phi;
+      Q_Gamma.noalias() = Q * Gamma;
+      Q_phi_plus_q = cost[j].dfdx;
+      Q_phi_plus_q.noalias() += Q * phi;
+      P_Gamma.noalias() = P * Gamma;
+
+      // c = c + c_j + phi' * q_j + 1/2 * phi' * Q_j * phi = c + c_j + 1/2 * phi' * ((Q_j * phi + q_j) + q_j)
+      blockCost.f += cost[j].f + 0.5 * phi.dot(Q_phi_plus_q + cost[j].dfdx);
+      // q = q + Phi' * (Q_j * phi + q_j)
+      blockCost.dfdx.noalias() += Phi.transpose() * Q_phi_plus_q;
+      // r = r + r_j + P_j * phi + Gamma' * (Q_j * phi + q_j)
+      blockCost.dfdu += cost[j].dfdu;
+      blockCost.dfdu.noalias() += P * phi;
+      blockCost.dfdu.noalias() += Gamma.transpose() * Q_phi_plus_q;
+      // Q = Q + Phi' * Q_j * Phi
+      blockCost.dfdxx.noalias() += Phi.transpose() * Q_Phi;
+      // P = P + P_j * Phi + Gamma' * Q_j * Phi
+      blockCost.dfdux.noalias() += P * Phi;
+      blockCost.dfdux.noalias() += Gamma.transpose() * Q_Phi;
+      // R = R + R_j + P_j * Gamma + Gamma' * P_j' + Gamma' * Q_j * Gamma
+      blockCost.dfduu += cost[j].dfduu;
+      blockCost.dfduu += P_Gamma;
+      blockCost.dfduu += P_Gamma.transpose();
+      blockCost.dfduu.noalias() += Gamma.transpose() * Q_Gamma;
+
+      // Phi = A_j * Phi, Gamma = A_j * Gamma + B_j, phi = A_j * phi + b_j
+      auto A_Phi = arena.allocateMatrix(A.rows(), nx);
+      A_Phi.noalias() = A * Phi;
+      Phi = A_Phi;
+      auto A_Gamma = arena.allocateMatrix(A.rows(), nu);
+      A_Gamma = B;
+      A_Gamma.noalias() += A * Gamma;
+      Gamma = A_Gamma;
+      auto A_phi = arena.allocateVector(A.rows());
+      A_phi = dynamics[j].f;
+      A_phi.noalias() += A * phi;
+      phi = A_phi;
+    }
+  }
+
+  // Terminal cost
+  blockedCost[numBlocks] = cost.back();
+}
+
+void expandMoveBlocking(const std::vector<int>& blockIndices, const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                        const vector_array_t& blockedDeltaX, const vector_array_t& blockedDeltaU, vector_array_t& deltaX,
+                        vector_array_t& deltaU) {
+  const int numBlocks = static_cast<int>(blockIndices.size()) - 1;
+  const int N = blockIndices.back();
+  deltaX.resize(N + 1);
+  deltaU.resize(N);
+
+  for (int b = 0; b < numBlocks; b++) {
+    deltaX[blockIndices[b]] = blockedDeltaX[b];
+    for (int i = blockIndices[b]; i < blockIndices[b + 1]; i++) {
+      deltaU[i] = blockedDeltaU[b];
+      if (i + 1 < blockIndices[b + 1]) {
+        deltaX[i + 1] = dynamics[i].f;
+        deltaX[i + 1].noalias() += dynamics[i].dfdx * deltaX[i];
+        deltaX[i + 1].noalias() += dynamics[i].dfdu * deltaU[i];
+      }
+    }
+  }
+  deltaX[N] = blockedDeltaX[numBlocks];
+}
+
+void expandMoveBlockingGain(const std::vector<int>& blockIndices, const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                            const matrix_array_t& blockedKMatrices, matrix_array_t& KMatrices) {
+  /*
+   * A state deviation dx at the start of a block changes the block input by dv = K * dx. With the input held on the block, the deviation
+   * of interval j is dx_j = M_j * dx, with M = I at the start of the block and M_j+1 = A_j * M_j + B_j * K. The gain of interval j
+   * reproduces the block input, K_j * M_j = K, which is solved in the least-squares sense if M_j is singular.
+   */
+  const int numBlocks = static_cast<int>(blockIndices.size()) - 1;
+  KMatrices.resize(blockIndices.back());
+  matrix_t M, MNext;
+  for (int b = 0; b < numBlocks; b++) {
+    const int start = blockIndices[b];
+    const int end = blockIndices[b + 1];
+    const auto& K = blockedKMatrices[b];
+    KMatrices[start] = K;
+    M.setIdentity(K.cols(), K.cols());
+    for (int j = start + 1; j < end; j++) {
+      MNext.noalias() = dynamics[j - 1].dfdx * M;
+      MNext.noalias() += dynamics[j - 1].dfdu * K;
+      M.swap(MNext);
+      KMatrices[j] = M.transpose().completeOrthogonalDecomposition().solve(K.transpose()).transpose();
+    }
+  }
+}
+
+}  // namespace multiple_shooting
+}  // namespace ocs2
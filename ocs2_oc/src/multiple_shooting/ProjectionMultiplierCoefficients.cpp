@@ -36,13 +36,24 @@ void ProjectionMultiplierCoefficients::compute(const ScalarFunctionQuadraticAppr
                                                const VectorFunctionLinearApproximation& dynamics,
                                                const VectorFunctionLinearApproximation& constraintProjection,
                                                const matrix_t& pseudoInverse) {
-  vector_t semiprojectedCost_dfdu = cost.dfdu;
+  MonotonicArena arena;
+  compute(cost, dynamics, constraintProjection, pseudoInverse, arena);
+}
+
+void ProjectionMultiplierCoefficients::compute(const ScalarFunctionQuadraticApproximation& cost,
+                                               const VectorFunctionLinearApproximation& dynamics,
+                                               const VectorFunctionLinearApproximation& constraintProjection, const matrix_t& pseudoInverse,
+                                               MonotonicArena& arena) {
+  auto semiprojectedCost_dfdu = arena.allocateVector(cost.dfdu.size());
+  semiprojectedCost_dfdu = cost.dfdu;
   semiprojectedCost_dfdu.noalias() += cost.dfduu * constraintProjection.f;
 
-  matrix_t semiprojectedCost_dfdux = cost.dfdux;
+  auto semiprojectedCost_dfdux = arena.allocateMatrix(cost.dfdux.rows(), cost.dfdux.cols());
+  semiprojectedCost_dfdux = cost.dfdux;
   semiprojectedCost_dfdux.noalias() += cost.dfduu * constraintProjection.dfdx;
 
-  const matrix_t semiprojectedCost_dfduu = cost.dfduu * constraintProjection.dfdu;
+  auto semiprojectedCost_dfduu = arena.allocateMatrix(cost.dfduu.rows(), constraintProjection.dfdu.cols());
+  semiprojectedCost_dfduu.noalias() = cost.dfduu * constraintProjection.dfdu;
 
   this->dfdx.noalias() = -pseudoInverse * semiprojectedCost_dfdux;
   this->dfdu.noalias() = -pseudoInverse * semiprojectedCost_dfduu;
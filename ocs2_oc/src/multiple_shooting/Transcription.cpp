@@ -37,29 +37,25 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 namespace ocs2 {
 namespace multiple_shooting {
 
-Transcription setupIntermediateNode(OptimalControlProblem& optimalControlProblem, DynamicsSensitivityDiscretizer& sensitivityDiscretizer,
-                                    scalar_t t, scalar_t dt, const vector_t& x, const vector_t& x_next, const vector_t& u) {
-  // Results and short-hand notation
-  Transcription transcription;
+namespace {
+/** Costs and constraints of an intermediate node, everything except the dynamics */
+void setupIntermediateNodeTerms(OptimalControlProblem& optimalControlProblem, scalar_t t, scalar_t dt, const vector_t& x, const vector_t& u,
+                                Transcription& transcription) {
+  // Short-hand notation
   auto& cost = transcription.cost;
-  auto& dynamics = transcription.dynamics;
   auto& constraintsSize = transcription.constraintsSize;
   auto& stateEqConstraints = transcription.stateEqConstraints;
   auto& stateInputEqConstraints = transcription.stateInputEqConstraints;
   auto& stateIneqConstraints = transcription.stateIneqConstraints;
   auto& stateInputIneqConstraints = transcription.stateInputIneqConstraints;
-
-  // Dynamics
-  // Discretization returns x_{k+1} = A_{k} * dx_{k} + B_{k} * du_{k} + b_{k}
-  dynamics = sensitivityDiscretizer(*optimalControlProblem.dynamicsPtr, t, x, u, dt);
-  dynamics.f -= x_next;  // make it dx_{k+1} = ...
+  constraintsSize = ConstraintsSize();
 
   // Precomputation for other terms
   constexpr auto request = Request::Cost + Request::SoftConstraint + Request::Constraint + Request::Approximation;
   optimalControlProblem.preComputationPtr->request(request, t, x, u);
 
   // Costs: Approximate the integral with forward euler
-  cost = approximateCost(optimalControlProblem, t, x, u);
+  approximateCost(optimalControlProblem, t, x, u, cost);
   cost *= dt;
 
   // State equality constraints
@@ -67,6 +63,8 @@ Transcription setupIntermediateNode(OptimalControlProblem& optimalControlProblem
     constraintsSize.stateEq = optimalControlProblem.stateEqualityConstraintPtr->getTermsSize(t);
     stateEqConstraints =
         optimalControlProblem.stateEqualityConstraintPtr->getLinearApproximation(t, x, *optimalControlProblem.preComputationPtr);
+  } else {
+    stateEqConstraints = VectorFunctionLinearApproximation();
   }
 
   // State-input equality constraints
@@ -74,6 +72,8 @@ Transcription setupIntermediateNode(OptimalControlProblem& optimalControlProblem
     constraintsSize.stateInputEq = optimalControlProblem.equalityConstraintPtr->getTermsSize(t);
     stateInputEqConstraints =
         optimalControlProblem.equalityConstraintPtr->getLinearApproximation(t, x, u, *optimalControlProblem.preComputationPtr);
+  } else {
+    stateInputEqConstraints = VectorFunctionLinearApproximation();
   }
 
   // State inequality constraints.
@@ -81,6 +81,8 @@ Transcription setupIntermediateNode(OptimalControlProblem& optimalControlProblem
     constraintsSize.stateIneq = optimalControlProblem.stateInequalityConstraintPtr->getTermsSize(t);
     stateIneqConstraints =
         optimalControlProblem.stateInequalityConstraintPtr->getLinearApproximation(t, x, *optimalControlProblem.preComputationPtr);
+  } else {
+    stateIneqConstraints = VectorFunctionLinearApproximation();
   }
 
   // State-input inequality constraints.
@@ -88,12 +90,48 @@ Transcription setupIntermediateNode(OptimalControlProblem& optimalControlProblem
     constraintsSize.stateInputIneq = optimalControlProblem.inequalityConstraintPtr->getTermsSize(t);
     stateInputIneqConstraints =
         optimalControlProblem.inequalityConstraintPtr->getLinearApproximation(t, x, u, *optimalControlProblem.preComputationPtr);
+  } else {
+    stateInputIneqConstraints = VectorFunctionLinearApproximation();
   }
 
-  return transcription;
+  // Projection is applied separately
+  transcription.constraintsProjection = VectorFunctionLinearApproximation();
+  transcription.projectionMultiplierCoefficients = ProjectionMultiplierCoefficients();
+}
+}  // namespace
+
+void setupIntermediateNode(OptimalControlProblem& optimalControlProblem, DynamicsSensitivityDiscretizer& sensitivityDiscretizer,
+                           scalar_t t, scalar_t dt, const vector_t& x, const vector_t& x_next, const vector_t& u,
+                           Transcription& transcription) {
+  // Dynamics
+  // Discretization returns x_{k+1} = A_{k} * dx_{k} + B_{k} * du_{k} + b_{k}
+  transcription.dynamics = sensitivityDiscretizer(*optimalControlProblem.dynamicsPtr, t, x, u, dt);
+  transcription.dynamics.f -= x_next;  // make it dx_{k+1} = ...
+
+  setupIntermediateNodeTerms(optimalControlProblem, t, dt, x, u, transcription);
+}
+
+void setupIntermediateNodes(OptimalControlProblem& optimalControlProblem, DynamicsSensitivityBlockDiscretizer& sensitivityDiscretizer,
+                            SensitivityDiscretizationBlock& block, const vector_array_t& x_next,
+                            std::vector<Transcription>& transcriptions) {
+  // Dynamics of all nodes at once
+  sensitivityDiscretizer(*optimalControlProblem.dynamicsPtr, block);
+
+  for (size_t i = 0; i < block.size; i++) {
+    // Swapping hands the buffers of the previous transcription to the block for reuse
+    std::swap(transcriptions[i].dynamics, block.dynamics[i]);
+    transcriptions[i].dynamics.f -= x_next[i];  // make it dx_{k+1} = ...
+
+    setupIntermediateNodeTerms(optimalControlProblem, block.t[i], block.dt[i], block.x[i], block.u[i], transcriptions[i]);
+  }
 }
 
 void projectTranscription(Transcription& transcription, bool extractProjectionMultiplier) {
+  MonotonicArena arena;
+  projectTranscription(transcription, extractProjectionMultiplier, arena);
+}
+
+void projectTranscription(Transcription& transcription, bool extractProjectionMultiplier, MonotonicArena& arena) {
   auto& cost = transcription.cost;
   auto& dynamics = transcription.dynamics;
   auto& stateInputEqConstraints = transcription.stateInputEqConstraints;
@@ -106,7 +144,7 @@ void projectTranscription(Transcription& transcription, bool extractProjectionMu
     if (extractProjectionMultiplier) {
       matrix_t constraintPseudoInverse;
       std::tie(projection, constraintPseudoInverse) = LinearAlgebra::qrConstraintProjection(stateInputEqConstraints);
-      projectionMultiplierCoefficients.compute(cost, dynamics, projection, constraintPseudoInverse);
+      projectionMultiplierCoefficients.compute(cost, dynamics, projection, constraintPseudoInverse, arena);
     } else {
       projection = LinearAlgebra::luConstraintProjection(stateInputEqConstraints).first;
       projectionMultiplierCoefficients = ProjectionMultiplierCoefficients();
@@ -114,33 +152,35 @@ void projectTranscription(Transcription& transcription, bool extractProjectionMu
     stateInputEqConstraints = VectorFunctionLinearApproximation();
 
     // Adapt dynamics, cost, and state-input inequality constraints
-    changeOfInputVariables(dynamics, projection.dfdu, projection.dfdx, projection.f);
-    changeOfInputVariables(cost, projection.dfdu, projection.dfdx, projection.f);
+    changeOfInputVariables(dynamics, projection.dfdu, projection.dfdx, projection.f, arena);
+    changeOfInputVariables(cost, projection.dfdu, projection.dfdx, projection.f, arena);
     if (stateInputIneqConstraints.f.size() > 0) {
-      changeOfInputVariables(stateInputIneqConstraints, projection.dfdu, projection.dfdx, projection.f);
+      changeOfInputVariables(stateInputIneqConstraints, projection.dfdu, projection.dfdx, projection.f, arena);
     }
   }
 }
 
-TerminalTranscription setupTerminalNode(OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x) {
-  // Results and short-hand notation
-  TerminalTranscription transcription;
+void setupTerminalNode(OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x, TerminalTranscription& transcription) {
+  // Short-hand notation
   auto& cost = transcription.cost;
   auto& constraintsSize = transcription.constraintsSize;
   auto& eqConstraints = transcription.eqConstraints;
   auto& ineqConstraints = transcription.ineqConstraints;
+  constraintsSize = ConstraintsSize();
 
   constexpr auto request = Request::Cost + Request::SoftConstraint + Request::Approximation;
   optimalControlProblem.preComputationPtr->requestFinal(request, t, x);
 
   // Costs
-  cost = approximateFinalCost(optimalControlProblem, t, x);
+  approximateFinalCost(optimalControlProblem, t, x, cost);
 
   // State equality constraints.
   if (!optimalControlProblem.finalEqualityConstraintPtr->empty()) {
     constraintsSize.stateEq = optimalControlProblem.finalEqualityConstraintPtr->getTermsSize(t);
     eqConstraints =
         optimalControlProblem.finalEqualityConstraintPtr->getLinearApproximation(t, x, *optimalControlProblem.preComputationPtr);
+  } else {
+    eqConstraints = VectorFunctionLinearApproximation();
   }
 
   // State inequality constraints.
@@ -148,19 +188,20 @@ TerminalTranscription setupTerminalNode(OptimalControlProblem& optimalControlPro
     constraintsSize.stateIneq = optimalControlProblem.finalInequalityConstraintPtr->getTermsSize(t);
     ineqConstraints =
         optimalControlProblem.finalInequalityConstraintPtr->getLinearApproximation(t, x, *optimalControlProblem.preComputationPtr);
+  } else {
+    ineqConstraints = VectorFunctionLinearApproximation();
   }
-
-  return transcription;
 }
 
-EventTranscription setupEventNode(OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x, const vector_t& x_next) {
-  // Results and short-hand notation
-  EventTranscription transcription;
+void setupEventNode(OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x, const vector_t& x_next,
+                    EventTranscription& transcription) {
+  // Short-hand notation
   auto& cost = transcription.cost;
   auto& dynamics = transcription.dynamics;
   auto& constraintsSize = transcription.constraintsSize;
   auto& eqConstraints = transcription.eqConstraints;
   auto& ineqConstraints = transcription.ineqConstraints;
+  constraintsSize = ConstraintsSize();
 
   constexpr auto request = Request::Cost + Request::SoftConstraint + Request::Dynamics + Request::Approximation;
   optimalControlProblem.preComputationPtr->requestPreJump(request, t, x);
@@ -179,6 +220,8 @@ EventTranscription setupEventNode(OptimalControlProblem& optimalControlProblem,
     constraintsSize.stateEq = optimalControlProblem.preJumpEqualityConstraintPtr->getTermsSize(t);
     eqConstraints =
         optimalControlProblem.preJumpEqualityConstraintPtr->getLinearApproximation(t, x, *optimalControlProblem.preComputationPtr);
+  } else {
+    eqConstraints = VectorFunctionLinearApproximation();
   }
 
   // State inequality constraints.
@@ -186,9 +229,9 @@ EventTranscription setupEventNode(OptimalControlProblem& optimalControlProblem,
     constraintsSize.stateIneq = optimalControlProblem.preJumpInequalityConstraintPtr->getTermsSize(t);
     ineqConstraints =
         optimalControlProblem.preJumpInequalityConstraintPtr->getLinearApproximation(t, x, *optimalControlProblem.preComputationPtr);
+  } else {
+    ineqConstraints = VectorFunctionLinearApproximation();
   }
-
-  return transcription;
 }
 
 }  // namespace multiple_shooting
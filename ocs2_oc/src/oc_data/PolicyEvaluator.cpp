@@ -0,0 +1,187 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_oc/oc_data/PolicyEvaluator.h"
+
+#include <cmath>
+
+#include <ocs2_core/misc/LinearInterpolation.h>
+#include <ocs2_core/misc/Lookup.h>
+
+namespace ocs2 {
+
+namespace {
+
+/** Same as LinearInterpolation::interpolate(), but writes into the result, which does not allocate if it is already sized. */
+template <typename Data>
+void interpolateInto(const LinearInterpolation::index_alpha_t& indexAlpha, const std::vector<Data>& dataArray, Data& result) {
+  if (dataArray.size() > 1) {
+    const auto& lhs = dataArray[indexAlpha.first];
+    const auto& rhs = dataArray[indexAlpha.first + 1];
+    if (lhs.size() == rhs.size()) {
+      result = indexAlpha.second * lhs + (scalar_t(1.0) - indexAlpha.second) * rhs;
+    } else {
+      result = (indexAlpha.second > 0.5) ? lhs : rhs;
+    }
+  } else {
+    result = dataArray.front();
+  }
+}
+
+/** Adds the interpolated gain times the state to the input without forming the interpolated gain. */
+void addInterpolatedFeedback(const LinearInterpolation::index_alpha_t& indexAlpha, const matrix_array_t& gainArray, const vector_t& state,
+                             vector_t& input) {
+  if (gainArray.size() > 1) {
+    const auto& lhs = gainArray[indexAlpha.first];
+    const auto& rhs = gainArray[indexAlpha.first + 1];
+    if (lhs.rows() == rhs.rows() && lhs.cols() == rhs.cols()) {
+      input.noalias() += indexAlpha.second * (lhs * state);
+      input.noalias() += (scalar_t(1.0) - indexAlpha.second) * (rhs * state);
+    } else {
+      input.noalias() += ((indexAlpha.second > 0.5) ? lhs : rhs) * state;
+    }
+  } else {
+    input.noalias() += gainArray.front() * state;
+  }
+}
+
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PolicyEvaluator::setPolicy(const PrimalSolution& primalSolution, scalar_t resamplingPeriod) {
+  primalSolutionPtr_ = &primalSolution;
+  linearControllerPtr_ = dynamic_cast<const LinearController*>(primalSolution.controllerPtr_.get());
+  feedforwardControllerPtr_ = dynamic_cast<const FeedforwardController*>(primalSolution.controllerPtr_.get());
+
+  stateInterval_ = 0;
+  controllerInterval_ = 0;
+  modeInterval_ = 0;
+
+  const auto& timeTrajectory = primalSolution.timeTrajectory_;
+  const bool isControllerSupported = linearControllerPtr_ != nullptr || feedforwardControllerPtr_ != nullptr;
+  isResampled_ = resamplingPeriod > 0.0 && !timeTrajectory.empty() && isControllerSupported;
+  if (!isResampled_) {
+    return;
+  }
+
+  // the last sample is at or after the final time
+  resamplingPeriod_ = resamplingPeriod;
+  const auto numSamples = static_cast<size_t>(std::ceil((timeTrajectory.back() - timeTrajectory.front()) / resamplingPeriod_)) + 1;
+  resampledTime_.resize(numSamples);
+  for (size_t k = 0; k < numSamples; k++) {
+    resampledTime_[k] = timeTrajectory.front() + static_cast<scalar_t>(k) * resamplingPeriod_;
+  }
+
+  resample(timeTrajectory, primalSolution.stateTrajectory_, resampledState_);
+  if (linearControllerPtr_ != nullptr) {
+    resample(linearControllerPtr_->timeStamp_, linearControllerPtr_->biasArray_, resampledBias_);
+    resample(linearControllerPtr_->timeStamp_, linearControllerPtr_->gainArray_, resampledGain_);
+  } else {
+    resample(feedforwardControllerPtr_->timeStamp_, feedforwardControllerPtr_->uffArray_, resampledBias_);
+    resampledGain_.clear();
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PolicyEvaluator::evaluate(scalar_t time, const vector_t& state, vector_t& nominalState, vector_t& input, size_t& mode) {
+  if (primalSolutionPtr_ == nullptr) {
+    throw std::runtime_error("[PolicyEvaluator::evaluate] setPolicy() should be called first!");
+  }
+  const auto& primalSolution = *primalSolutionPtr_;
+
+  if (isResampled_) {
+    const auto indexAlpha = resampledTimeSegment(time);
+    interpolateInto(indexAlpha, resampledState_, nominalState);
+    interpolateInto(indexAlpha, resampledBias_, input);
+    if (!resampledGain_.empty()) {
+      addInterpolatedFeedback(indexAlpha, resampledGain_, state, input);
+    }
+
+  } else {
+    const auto stateIndexAlpha = LinearInterpolation::timeSegment(time, primalSolution.timeTrajectory_, stateInterval_);
+    interpolateInto(stateIndexAlpha, primalSolution.stateTrajectory_, nominalState);
+
+    if (linearControllerPtr_ != nullptr) {
+      const auto indexAlpha = LinearInterpolation::timeSegment(time, linearControllerPtr_->timeStamp_, controllerInterval_);
+      interpolateInto(indexAlpha, linearControllerPtr_->biasArray_, input);
+      addInterpolatedFeedback(indexAlpha, linearControllerPtr_->gainArray_, state, input);
+    } else if (feedforwardControllerPtr_ != nullptr) {
+      const auto indexAlpha = LinearInterpolation::timeSegment(time, feedforwardControllerPtr_->timeStamp_, controllerInterval_);
+      interpolateInto(indexAlpha, feedforwardControllerPtr_->uffArray_, input);
+    } else if (primalSolution.controllerPtr_ != nullptr) {
+      input = primalSolution.controllerPtr_->computeInput(time, state);
+    } else {
+      throw std::runtime_error("[PolicyEvaluator::evaluate] The policy has no controller!");
+    }
+  }
+
+  // same as ModeSchedule::modeAtTime
+  const auto& eventTimes = primalSolution.modeSchedule_.eventTimes;
+  if (eventTimes.empty()) {
+    mode = primalSolution.modeSchedule_.modeSequence.front();
+  } else {
+    modeInterval_ = lookup::findIntervalInTimeArray(eventTimes, time, modeInterval_);
+    mode = primalSolution.modeSchedule_.modeSequence[modeInterval_ + 1];
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+LinearInterpolation::index_alpha_t PolicyEvaluator::resampledTimeSegment(scalar_t time) const {
+  const auto lastSample = static_cast<int>(resampledTime_.size()) - 1;
+  const scalar_t sample = (time - resampledTime_.front()) / resamplingPeriod_;
+  if (lastSample == 0 || sample <= 0.0) {
+    return {0, scalar_t(1.0)};
+  } else if (sample >= static_cast<scalar_t>(lastSample)) {
+    return {lastSample - 1, scalar_t(0.0)};
+  } else {
+    const auto index = static_cast<int>(sample);
+    return {index, scalar_t(1.0) - (sample - static_cast<scalar_t>(index))};
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+template <typename Data>
+void PolicyEvaluator::resample(const scalar_array_t& timeArray, const std::vector<Data>& dataArray, std::vector<Data>& resampledArray) {
+  resampledArray.resize(resampledTime_.size());
+  int interval = 0;
+  for (size_t k = 0; k < resampledTime_.size(); k++) {
+    const auto indexAlpha = LinearInterpolation::timeSegment(resampledTime_[k], timeArray, interval);
+    interpolateInto(indexAlpha, dataArray, resampledArray[k]);
+  }
+}
+
+}  // namespace ocs2
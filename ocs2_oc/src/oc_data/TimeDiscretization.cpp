@@ -29,6 +29,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_oc/oc_data/TimeDiscretization.h"
 
+#include <cmath>
+#include <stdexcept>
+
 #include <ocs2_core/misc/Lookup.h>
 
 namespace ocs2 {
@@ -57,9 +60,17 @@ scalar_t getIntervalDuration(const AnnotatedTime& start, const AnnotatedTime& en
   return getIntervalEnd(end) - getIntervalStart(start);
 }
 
-std::vector<AnnotatedTime> timeDiscretizationWithEvents(scalar_t initTime, scalar_t finalTime, scalar_t dt,
-                                                        const scalar_array_t& eventTimes, scalar_t dt_min) {
-  assert(dt > 0);
+namespace {
+
+/**
+ * Discretizes the horizon with the grid given by nextGridTime, ensuring that event times are part of the discretization.
+ *
+ * @param nextGridTime : Callable (scalar_t time, bool isInitial) -> scalar_t returning the next grid point after the given time.
+ * @param finalMargin : Grid points closer than this value to the final time are skipped.
+ */
+template <typename NextGridTime>
+std::vector<AnnotatedTime> discretizeWithEvents(scalar_t initTime, scalar_t finalTime, const scalar_array_t& eventTimes, scalar_t dt_min,
+                                                NextGridTime&& nextGridTime, scalar_t finalMargin) {
   assert(finalTime > initTime);
   std::vector<AnnotatedTime> timeDiscretization;
 
@@ -70,7 +81,7 @@ std::vector<AnnotatedTime> timeDiscretizationWithEvents(scalar_t initTime, scala
   // Fill iteratively with pre event, post events are added later
   AnnotatedTime nextNode = timeDiscretization.back();
   while (timeDiscretization.back().time < finalTime) {
-    nextNode.time = nextNode.time + dt;
+    nextNode.time = nextGridTime(nextNode.time, timeDiscretization.size() == 1);
     nextNode.event = AnnotatedTime::Event::None;
 
     // Check if an event has passed
@@ -80,8 +91,9 @@ std::vector<AnnotatedTime> timeDiscretizationWithEvents(scalar_t initTime, scala
       nextEventIdx++;
     }
 
-    // Check if final time has passed
-    if (nextNode.time >= finalTime) {
+    // Check if final time has passed, grid points within the margin are skipped
+    const bool isWithinFinalMargin = nextNode.event == AnnotatedTime::Event::None && nextNode.time >= finalTime - finalMargin;
+    if (nextNode.time >= finalTime || isWithinFinalMargin) {
       nextNode.time = finalTime;
       nextNode.event = AnnotatedTime::Event::None;
     }
@@ -113,6 +125,77 @@ std::vector<AnnotatedTime> timeDiscretizationWithEvents(scalar_t initTime, scala
   return timeDiscretizationWithDoubleEvents;
 }
 
+}  // namespace
+
+std::vector<AnnotatedTime> timeDiscretizationWithEvents(scalar_t initTime, scalar_t finalTime, scalar_t dt,
+                                                        const scalar_array_t& eventTimes, scalar_t dt_min) {
+  assert(dt > 0);
+  const auto nextGridTime = [dt](scalar_t time, bool isInitial) { return time + dt; };
+  return discretizeWithEvents(initTime, finalTime, eventTimes, dt_min, nextGridTime, 0.0);
+}
+
+std::vector<AnnotatedTime> alignedTimeDiscretizationWithEvents(scalar_t initTime, scalar_t finalTime, scalar_t dt,
+                                                               const scalar_array_t& eventTimes, scalar_t dt_min) {
+  assert(dt > 0);
+  // The grid points are computed as k * dt, such that they are bitwise identical between calls. The first grid point is at least
+  // dt / 2 after the initial time, the other ones at least dt_min after the previous node.
+  const auto nextGridTime = [dt, dt_min](scalar_t time, bool isInitial) {
+    const scalar_t minStep = isInitial ? 0.5 * dt : dt_min;
+    return (std::floor((time + minStep) / dt) + 1.0) * dt;
+  };
+  return discretizeWithEvents(initTime, finalTime, eventTimes, dt_min, nextGridTime, 0.5 * dt);
+}
+
+std::vector<AnnotatedTime> adaptiveTimeDiscretizationWithEvents(scalar_t initTime, scalar_t finalTime, scalar_t dt, scalar_t growthRate,
+                                                                scalar_t dtMax, const scalar_array_t& eventTimes, scalar_t dt_min) {
+  assert(dt > 0);
+  assert(growthRate >= 1.0);
+  assert(dtMax >= dt);
+  // A geometric sequence of steps dt * growthRate^k reaches the distance d from its origin with the step dt + (growthRate - 1) * d. The
+  // origins are the initial time and the event times. Towards an upcoming event, the step is reduced such that the following step is
+  // consistent with the geometric sequence as well.
+  const auto nextGridTime = [&](scalar_t time, bool isInitial) {
+    scalar_t step = std::min(dtMax, dt + (growthRate - 1.0) * (time - initTime));
+    const int numEvents = static_cast<int>(eventTimes.size());
+    int nextEventIdx = lookup::findIndexInTimeArray(eventTimes, time);
+    if (nextEventIdx < numEvents && eventTimes[nextEventIdx] <= time) {  // an event at the current time is a preceding event
+      ++nextEventIdx;
+    }
+    if (nextEventIdx > 0) {
+      step = std::min(step, dt + (growthRate - 1.0) * (time - eventTimes[nextEventIdx - 1]));
+    }
+    step = std::max(step, dt);
+    if (nextEventIdx < numEvents) {
+      const scalar_t timeToEvent = eventTimes[nextEventIdx] - time;
+      step = std::max(std::min(step, (dt + (growthRate - 1.0) * timeToEvent) / growthRate), dt);
+      if (timeToEvent - step < 0.5 * dt) {  // avoid a short interval before the event
+        return eventTimes[nextEventIdx];
+      }
+    }
+    // The final node absorbs grid points within dt / 2, split the remainder instead if this would exceed dtMax
+    const scalar_t timeToFinal = finalTime - time;
+    if (timeToFinal > dtMax && timeToFinal - step < 0.5 * dt) {
+      return time + 0.5 * timeToFinal;
+    }
+    return time + step;
+  };
+  return discretizeWithEvents(initTime, finalTime, eventTimes, dt_min, nextGridTime, 0.5 * dt);
+}
+
+std::vector<AnnotatedTime> getTimeDiscretization(scalar_t initTime, scalar_t finalTime, scalar_t dt, scalar_t growthRate, scalar_t dtMax,
+                                                 bool isAligned, const scalar_array_t& eventTimes) {
+  if (growthRate > 1.0) {
+    if (isAligned) {
+      throw std::runtime_error("[getTimeDiscretization] The non-uniform discretization can not be aligned, set the growth rate to 1.0!");
+    }
+    return adaptiveTimeDiscretizationWithEvents(initTime, finalTime, dt, growthRate, dtMax, eventTimes);
+  } else if (isAligned) {
+    return alignedTimeDiscretizationWithEvents(initTime, finalTime, dt, eventTimes);
+  } else {
+    return timeDiscretizationWithEvents(initTime, finalTime, dt, eventTimes);
+  }
+}
+
 scalar_array_t toTime(const std::vector<AnnotatedTime>& annotatedTime) {
   scalar_array_t timeTrajectory;
   timeTrajectory.reserve(annotatedTime.size());
@@ -128,7 +211,7 @@ scalar_array_t toInterpolationTime(const std::vector<AnnotatedTime>& annotatedTi
   }
   scalar_array_t timeTrajectory;
   timeTrajectory.reserve(annotatedTime.size());
-  timeTrajectory.push_back(annotatedTime.back().time - numeric_traits::limitEpsilon<scalar_t>());
+  timeTrajectory.push_back(annotatedTime.front().time);
   for (int i = 1; i < annotatedTime.size() - 1; i++) {
     if (annotatedTime[i].event == AnnotatedTime::Event::PostEvent) {
       timeTrajectory.push_back(getInterpolationTime(annotatedTime[i]));
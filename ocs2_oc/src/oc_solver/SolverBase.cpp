@@ -87,6 +87,15 @@ void SolverBase::printString(const std::string& text) const {
   std::cerr << text << '\n';
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void SolverBase::publishIntermediateSolution(const PrimalSolution& primalSolution, const PerformanceIndex& performanceIndex) const {
+  if (intermediateSolutionCallback_) {
+    intermediateSolutionCallback_(primalSolution, performanceIndex);
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
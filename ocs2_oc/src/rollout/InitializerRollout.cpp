@@ -30,6 +30,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ocs2_oc/rollout/InitializerRollout.h"
 
 #include <ocs2_core/NumericTraits.h>
+#include <ocs2_core/misc/Trace.h>
 
 namespace ocs2 {
 
@@ -52,6 +53,7 @@ InitializerRollout* InitializerRollout::clone() const {
 vector_t InitializerRollout::run(scalar_t initTime, const vector_t& initState, scalar_t finalTime, ControllerBase* controller,
                                  ModeSchedule& modeSchedule, scalar_array_t& timeTrajectory, size_array_t& postEventIndices,
                                  vector_array_t& stateTrajectory, vector_array_t& inputTrajectory) {
+  OCS2_TRACE_ZONE("InitializerRollout::run");
   if (initTime > finalTime) {
     throw std::runtime_error("[InitializerRollout::run] The initial time should be less-equal to the final time!");
   }
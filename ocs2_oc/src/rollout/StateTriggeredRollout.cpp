@@ -30,6 +30,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ocs2_oc/rollout/StateTriggeredRollout.h"
 
 #include <ocs2_core/control/StateBasedLinearController.h>
+#include <ocs2_core/misc/Trace.h>
 #include <ocs2_oc/rollout/RootFinder.h>
 
 namespace ocs2 {
@@ -51,6 +52,7 @@ StateTriggeredRollout::StateTriggeredRollout(const ControlledSystemBase& systemD
 vector_t StateTriggeredRollout::run(scalar_t initTime, const vector_t& initState, scalar_t finalTime, ControllerBase* controller,
                                     ModeSchedule& modeSchedule, scalar_array_t& timeTrajectory, size_array_t& postEventIndices,
                                     vector_array_t& stateTrajectory, vector_array_t& inputTrajectory) {
+  OCS2_TRACE_ZONE("StateTriggeredRollout::run");
   if (initTime > finalTime) {
     throw std::runtime_error("[StateTriggeredRollout::run] The initial time should be less-equal to the final time!");
   }
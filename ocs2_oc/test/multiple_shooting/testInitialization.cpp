@@ -0,0 +1,96 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <ocs2_core/initialization/DefaultInitializer.h>
+
+#include <ocs2_oc/multiple_shooting/Helpers.h>
+#include <ocs2_oc/multiple_shooting/Initialization.h>
+
+using namespace ocs2;
+
+TEST(test_multiple_shooting_initialization, shiftStateInputTrajectories) {
+  constexpr int nx = 3;
+  constexpr int nu = 2;
+  const scalar_t dt = 0.1;
+  const scalar_t horizon = 1.0;
+  const scalar_array_t eventTimes{0.55};
+  DefaultInitializer initializer(nu);
+
+  // previous solution
+  const auto previousTime = alignedTimeDiscretizationWithEvents(0.123, 0.123 + horizon, dt, eventTimes);
+  vector_array_t x, u;
+  x.push_back(vector_t::Random(nx));
+  for (const auto& node : previousTime) {
+    if (node.event == AnnotatedTime::Event::PreEvent) {
+      u.push_back(vector_t());
+    } else {
+      u.push_back(vector_t::Random(nu));
+    }
+    x.push_back(vector_t::Random(nx));
+  }
+  x.pop_back();
+  u.pop_back();
+  ModeSchedule modeSchedule(eventTimes, size_array_t{0, 1});
+  const auto primalSolution =
+      multiple_shooting::toPrimalSolution(previousTime, std::move(modeSchedule), vector_array_t(x), vector_array_t(u));
+
+  // shifted horizon
+  const vector_t initState = vector_t::Random(nx);
+  const auto time = alignedTimeDiscretizationWithEvents(0.187, 0.187 + horizon, dt, eventTimes);
+  vector_array_t xShifted, uShifted;
+  multiple_shooting::shiftStateInputTrajectories(initState, time, primalSolution, initializer, xShifted, uShifted);
+  ASSERT_EQ(xShifted.size(), time.size());
+  ASSERT_EQ(uShifted.size(), time.size() - 1);
+
+  // The shared nodes copy the previous solution, i.e. time[i] == previousTime[i + 1] for 0 < i < N - 1
+  const int N = static_cast<int>(time.size()) - 1;
+  for (int i = 1; i < N - 1; i++) {
+    ASSERT_EQ(time[i].time, previousTime[i + 1].time);
+    ASSERT_TRUE(xShifted[i].isApprox(x[i + 1]));
+    if (time[i].event != AnnotatedTime::Event::PreEvent) {
+      ASSERT_TRUE(uShifted[i].isApprox(u[i + 1]));
+    }
+  }
+
+  // Same initialization as interpolating the previous solution, except for the post-event state. The interpolation at the pre-event
+  // node is evaluated at (t - eps), hence the tolerance.
+  const scalar_t tol = 1e-6;
+  vector_array_t xInterpolated, uInterpolated;
+  multiple_shooting::initializeStateInputTrajectories(initState, time, primalSolution, initializer, xInterpolated, uInterpolated);
+  ASSERT_TRUE(xShifted.front().isApprox(xInterpolated.front(), tol));
+  for (int i = 0; i < N; i++) {
+    if (time[i].event != AnnotatedTime::Event::PreEvent) {
+      ASSERT_TRUE(xShifted[i + 1].isApprox(xInterpolated[i + 1], tol));
+    }
+    ASSERT_EQ(uShifted[i].size(), uInterpolated[i].size());
+    ASSERT_TRUE(uShifted[i].isApprox(uInterpolated[i], tol));
+  }
+}
@@ -0,0 +1,176 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+
+#include <gtest/gtest.h>
+
+#include <ocs2_oc/multiple_shooting/MoveBlocking.h>
+
+#include "ocs2_oc/test/testProblemsGeneration.h"
+
+using namespace ocs2;
+
+namespace {
+scalar_t evaluateCost(const ScalarFunctionQuadraticApproximation& cost, const vector_t& x, const vector_t& u) {
+  scalar_t value = cost.f + cost.dfdx.dot(x) + 0.5 * x.dot(cost.dfdxx * x);
+  if (u.size() > 0) {
+    value += cost.dfdu.dot(u) + 0.5 * u.dot(cost.dfduu * u) + u.dot(cost.dfdux * x);
+  }
+  return value;
+}
+}  // namespace
+
+TEST(test_move_blocking, blockIndices) {
+  constexpr int N = 10;
+  constexpr int eventIndex = 5;
+  vector_array_t u(N, vector_t::Ones(2));
+  u[eventIndex] = vector_t();
+
+  const auto blockIndices = multiple_shooting::getMoveBlockingIndices(u, 2, 3);
+  const std::vector<int> expectedBlockIndices{0, 1, 2, 5, 6, 9, 10};
+  ASSERT_EQ(blockIndices, expectedBlockIndices);
+
+  // Block size of 1 does not block
+  const auto unblockedIndices = multiple_shooting::getMoveBlockingIndices(u, 0, 1);
+  ASSERT_EQ(unblockedIndices.size(), N + 1);
+
+  // Inputs are held on the blocks
+  for (int i = 0; i < N; i++) {
+    u[i] *= i;
+  }
+  multiple_shooting::holdInputOnBlocks(blockIndices, u);
+  ASSERT_TRUE(u[3].isApprox(u[2]));
+  ASSERT_TRUE(u[4].isApprox(u[2]));
+  ASSERT_EQ(u[eventIndex].size(), 0);
+  ASSERT_TRUE(u[8].isApprox(u[6]));
+  ASSERT_FALSE(u[9].isApprox(u[6]));
+}
+
+TEST(test_move_blocking, reduceAndExpand) {
+  constexpr int nx = 3;
+  constexpr int nu = 2;
+  constexpr int N = 10;
+  constexpr int eventIndex = 5;
+
+  // LQ approximation with an event
+  std::vector<VectorFunctionLinearApproximation> dynamics;
+  std::vector<ScalarFunctionQuadraticApproximation> cost;
+  vector_array_t u(N);
+  for (int i = 0; i < N; i++) {
+    const int m = (i == eventIndex) ? 0 : nu;
+    dynamics.push_back(getRandomDynamics(nx, m));
+    cost.push_back(getRandomCost(nx, m));
+    u[i].setZero(m);
+  }
+  cost.push_back(getRandomCost(nx, 0));
+
+  const auto blockIndices = multiple_shooting::getMoveBlockingIndices(u, 2, 3);
+  const int numBlocks = static_cast<int>(blockIndices.size()) - 1;
+
+  std::vector<VectorFunctionLinearApproximation> blockedDynamics;
+  std::vector<ScalarFunctionQuadraticApproximation> blockedCost;
+  MonotonicArena arena;
+  multiple_shooting::reduceMoveBlocking(blockIndices, dynamics, cost, blockedDynamics, blockedCost, arena);
+  ASSERT_EQ(blockedDynamics.size(), numBlocks);
+  ASSERT_EQ(blockedCost.size(), numBlocks + 1);
+
+  // Random trajectory of the blocked QP
+  vector_array_t blockedX{vector_t::Random(nx)};
+  vector_array_t blockedU;
+  scalar_t blockedCostValue = 0.0;
+  for (int b = 0; b < numBlocks; b++) {
+    blockedU.push_back(vector_t::Random(blockedDynamics[b].dfdu.cols()));
+    blockedCostValue += evaluateCost(blockedCost[b], blockedX[b], blockedU[b]);
+    blockedX.push_back(blockedDynamics[b].dfdx * blockedX[b] + blockedDynamics[b].dfdu * blockedU[b] + blockedDynamics[b].f);
+  }
+  blockedCostValue += evaluateCost(blockedCost[numBlocks], blockedX[numBlocks], vector_t());
+
+  // Expanded trajectory satisfies the dynamics and has the same cost
+  vector_array_t x;
+  multiple_shooting::expandMoveBlocking(blockIndices, dynamics, blockedX, blockedU, x, u);
+  ASSERT_EQ(x.size(), N + 1);
+  ASSERT_EQ(u.size(), N);
+  scalar_t costValue = 0.0;
+  for (int i = 0; i < N; i++) {
+    ASSERT_TRUE(x[i + 1].isApprox(dynamics[i].dfdx * x[i] + dynamics[i].dfdu * u[i] + dynamics[i].f));
+    costValue += evaluateCost(cost[i], x[i], u[i]);
+  }
+  costValue += evaluateCost(cost[N], x[N], vector_t());
+  ASSERT_NEAR(costValue, blockedCostValue, 1e-9 * std::abs(costValue));
+  for (int b = 0; b <= numBlocks; b++) {
+    ASSERT_TRUE(x[blockIndices[b]].isApprox(blockedX[b]));
+  }
+  ASSERT_EQ(u[eventIndex].size(), 0);
+  ASSERT_TRUE(u[3].isApprox(u[2]));
+}
+
+TEST(test_move_blocking, expandGain) {
+  constexpr int nx = 3;
+  constexpr int nu = 2;
+  constexpr int N = 10;
+  constexpr int eventIndex = 5;
+
+  std::vector<VectorFunctionLinearApproximation> dynamics;
+  std::vector<ScalarFunctionQuadraticApproximation> cost;
+  vector_array_t u(N);
+  for (int i = 0; i < N; i++) {
+    const int m = (i == eventIndex) ? 0 : nu;
+    dynamics.push_back(getRandomDynamics(nx, m));
+    cost.push_back(getRandomCost(nx, m));
+    u[i].setZero(m);
+  }
+  cost.push_back(getRandomCost(nx, 0));
+
+  const auto blockIndices = multiple_shooting::getMoveBlockingIndices(u, 2, 3);
+  const int numBlocks = static_cast<int>(blockIndices.size()) - 1;
+  std::vector<VectorFunctionLinearApproximation> blockedDynamics;
+  std::vector<ScalarFunctionQuadraticApproximation> blockedCost;
+  MonotonicArena arena;
+  multiple_shooting::reduceMoveBlocking(blockIndices, dynamics, cost, blockedDynamics, blockedCost, arena);
+
+  matrix_array_t blockedK, K;
+  for (int b = 0; b < numBlocks; b++) {
+    blockedK.push_back(matrix_t::Random(blockedDynamics[b].dfdu.cols(), nx));
+  }
+  multiple_shooting::expandMoveBlockingGain(blockIndices, dynamics, blockedK, K);
+  ASSERT_EQ(K.size(), N);
+
+  // A rollout of the expanded policy from a perturbed state gives the inputs and block end states of the blocked policy
+  vector_t dx = vector_t::Random(nx);
+  for (int b = 0; b < numBlocks; b++) {
+    const vector_t blockedDu = blockedK[b] * dx;
+    const vector_t blockedDxNext = blockedDynamics[b].dfdx * dx + blockedDynamics[b].dfdu * blockedDu;
+    for (int i = blockIndices[b]; i < blockIndices[b + 1]; i++) {
+      const vector_t du = K[i] * dx;
+      ASSERT_TRUE(du.isApprox(blockedDu, 1e-9)) << "interval " << i;
+      dx = dynamics[i].dfdx * dx + dynamics[i].dfdu * du;
+    }
+    ASSERT_TRUE(dx.isApprox(blockedDxNext, 1e-9)) << "block " << b;
+  }
+}
@@ -0,0 +1,125 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <ocs2_core/misc/AllocationTracking.h>
+#include <ocs2_oc/multiple_shooting/MetricsComputation.h>
+#include <ocs2_oc/multiple_shooting/Transcription.h>
+
+#include "ocs2_oc/test/testProblemsGeneration.h"
+
+using namespace ocs2;
+
+namespace {
+constexpr int nx = 3;
+constexpr int nu = 2;
+constexpr int N = 5;
+
+class TranscriptionTest : public testing::Test {
+ protected:
+  TranscriptionTest() {
+    targetTrajectories = TargetTrajectories({0.0, 1.0}, {vector_t::Random(nx), vector_t::Random(nx)},
+                                            {vector_t::Random(nu), vector_t::Random(nu)});
+    problem.dynamicsPtr = getOcs2Dynamics(getRandomDynamics(nx, nu));
+    problem.costPtr->add("cost", getOcs2Cost(getRandomCost(nx, nu)));
+    problem.stateCostPtr->add("stateCost", getOcs2StateCost(getRandomCost(nx, 0)));
+    problem.finalCostPtr->add("finalCost", getOcs2StateCost(getRandomCost(nx, 0)));
+    problem.targetTrajectoriesPtr = &targetTrajectories;
+
+    block.resize(N);
+    xNext.resize(N);
+    for (int i = 0; i < N; i++) {
+      block.t[i] = 0.1 * i;
+      block.dt[i] = 0.1;
+      block.x[i] = vector_t::Random(nx);
+      block.u[i] = vector_t::Random(nu);
+      xNext[i] = vector_t::Random(nx);
+    }
+  }
+
+  TargetTrajectories targetTrajectories;
+  OptimalControlProblem problem;
+  SensitivityDiscretizationBlock block;
+  vector_array_t xNext;
+};
+}  // namespace
+
+TEST_F(TranscriptionTest, blockMatchesNodeByNode) {
+  for (const auto integratorType : {SensitivityIntegratorType::EULER, SensitivityIntegratorType::RK2, SensitivityIntegratorType::RK4}) {
+    auto sensitivityDiscretizer = selectDynamicsSensitivityDiscretization(integratorType);
+    auto blockSensitivityDiscretizer = selectDynamicsSensitivityBlockDiscretization(integratorType);
+
+    std::vector<multiple_shooting::Transcription> transcriptions(N);
+    multiple_shooting::setupIntermediateNodes(problem, blockSensitivityDiscretizer, block, xNext, transcriptions);
+
+    for (int i = 0; i < N; i++) {
+      const auto expected = multiple_shooting::setupIntermediateNode(problem, sensitivityDiscretizer, block.t[i], block.dt[i], block.x[i],
+                                                                     xNext[i], block.u[i]);
+      const auto& dynamics = transcriptions[i].dynamics;
+      const auto& cost = transcriptions[i].cost;
+      EXPECT_TRUE(dynamics.f.isApprox(expected.dynamics.f));
+      EXPECT_TRUE(dynamics.dfdx.isApprox(expected.dynamics.dfdx));
+      EXPECT_TRUE(dynamics.dfdu.isApprox(expected.dynamics.dfdu));
+      EXPECT_DOUBLE_EQ(cost.f, expected.cost.f);
+      EXPECT_TRUE(cost.dfdx.isApprox(expected.cost.dfdx));
+      EXPECT_TRUE(cost.dfdu.isApprox(expected.cost.dfdu));
+      EXPECT_TRUE(cost.dfdxx.isApprox(expected.cost.dfdxx));
+      EXPECT_TRUE(cost.dfdux.isApprox(expected.cost.dfdux));
+      EXPECT_TRUE(cost.dfduu.isApprox(expected.cost.dfduu));
+    }
+  }
+}
+
+TEST_F(TranscriptionTest, steadyStateAllocations) {
+  // Once the storage has its dimensions, the transcription of an unconstrained problem is written in place. Without
+  // OCS2_ALLOCATION_TRACKING nothing is counted and the test only checks that the transcription can be repeated.
+  auto blockSensitivityDiscretizer = selectDynamicsSensitivityBlockDiscretization(SensitivityIntegratorType::RK4);
+  std::vector<multiple_shooting::Transcription> transcriptions(N);
+  std::vector<Metrics> metrics(N);
+  multiple_shooting::TerminalTranscription terminalTranscription;
+  const vector_t xFinal = vector_t::Random(nx);
+
+  allocation::PhaseAllocationCounter counter("transcription", allocation::CountingScope::CallingThread);
+  for (int iter = 0; iter < 4; iter++) {
+    counter.start();
+    multiple_shooting::setupIntermediateNodes(problem, blockSensitivityDiscretizer, block, xNext, transcriptions);
+    for (int i = 0; i < N; i++) {
+      multiple_shooting::computeMetrics(transcriptions[i], metrics[i]);
+    }
+    multiple_shooting::setupTerminalNode(problem, 0.1 * N, xFinal, terminalTranscription);
+    counter.end();
+
+    // The dynamics of the block and of the transcriptions are swapped, both have their dimensions after two iterations
+    if (iter >= 2) {
+      EXPECT_EQ(counter.getLast().count, 0) << "MESSAGE: iteration " << iter << " allocated!";
+    }
+  }
+  EXPECT_TRUE(metrics.back().dynamicsViolation.isApprox(transcriptions.back().dynamics.f));
+}
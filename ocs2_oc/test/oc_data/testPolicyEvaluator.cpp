@@ -0,0 +1,144 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include <ocs2_core/misc/LinearInterpolation.h>
+
+#include "ocs2_oc/oc_data/PolicyEvaluator.h"
+
+using namespace ocs2;
+
+namespace {
+
+constexpr size_t stateDim = 4;
+constexpr size_t inputDim = 3;
+
+/** A policy on [0, 1] with two events, which duplicate the nodes at the event times. */
+PrimalSolution getPolicy(bool isLinear) {
+  PrimalSolution primalSolution;
+  primalSolution.modeSchedule_ = ModeSchedule({0.3, 0.7}, {0, 1, 2});
+
+  const scalar_array_t nodeTimes{0.0, 0.1, 0.2, 0.3, 0.3, 0.45, 0.6, 0.7, 0.7, 0.8, 0.9, 1.0};
+  vector_array_t biasArray;
+  matrix_array_t gainArray;
+  for (const auto t : nodeTimes) {
+    primalSolution.timeTrajectory_.push_back(t);
+    primalSolution.stateTrajectory_.push_back(vector_t::Random(stateDim));
+    primalSolution.inputTrajectory_.push_back(vector_t::Random(inputDim));
+    biasArray.push_back(vector_t::Random(inputDim));
+    gainArray.push_back(matrix_t::Random(inputDim, stateDim));
+  }
+
+  if (isLinear) {
+    primalSolution.controllerPtr_.reset(new LinearController(nodeTimes, biasArray, gainArray));
+  } else {
+    primalSolution.controllerPtr_.reset(new FeedforwardController(nodeTimes, biasArray));
+  }
+  return primalSolution;
+}
+
+/** Checks the evaluator against the interpolation of the primal solution. */
+void checkEvaluation(PolicyEvaluator& evaluator, PrimalSolution& primalSolution, scalar_t time, scalar_t tolerance) {
+  const vector_t state = vector_t::Random(stateDim);
+  vector_t nominalState, input;
+  size_t mode;
+  evaluator.evaluate(time, state, nominalState, input, mode);
+
+  const vector_t expectedState = LinearInterpolation::interpolate(time, primalSolution.timeTrajectory_, primalSolution.stateTrajectory_);
+  const vector_t expectedInput = primalSolution.controllerPtr_->computeInput(time, state);
+  EXPECT_TRUE(nominalState.isApprox(expectedState, tolerance)) << "time: " << time;
+  EXPECT_TRUE(input.isApprox(expectedInput, tolerance)) << "time: " << time;
+  EXPECT_EQ(mode, primalSolution.modeSchedule_.modeAtTime(time)) << "time: " << time;
+}
+
+}  // unnamed namespace
+
+TEST(testPolicyEvaluator, increasingTime) {
+  for (const bool isLinear : {true, false}) {
+    auto primalSolution = getPolicy(isLinear);
+    PolicyEvaluator evaluator;
+    evaluator.setPolicy(primalSolution);
+    for (scalar_t t = -0.1; t < 1.1; t += 0.001) {
+      checkEvaluation(evaluator, primalSolution, t, 1e-12);
+    }
+    // the event and node times
+    for (const auto t : primalSolution.timeTrajectory_) {
+      checkEvaluation(evaluator, primalSolution, t, 1e-12);
+    }
+  }
+}
+
+TEST(testPolicyEvaluator, randomTime) {
+  std::mt19937 generator(0);
+  std::uniform_real_distribution<scalar_t> timeDistribution(-0.1, 1.1);
+
+  auto primalSolution = getPolicy(true);
+  PolicyEvaluator evaluator;
+  evaluator.setPolicy(primalSolution);
+  for (size_t i = 0; i < 1000; i++) {
+    checkEvaluation(evaluator, primalSolution, timeDistribution(generator), 1e-12);
+  }
+}
+
+TEST(testPolicyEvaluator, resampling) {
+  // without events the policy is linear between the nodes, hence any period which divides the node intervals is exact
+  auto primalSolution = getPolicy(true);
+  primalSolution.modeSchedule_ = ModeSchedule();
+  primalSolution.timeTrajectory_ = {0.0, 0.1, 0.2, 0.3, 0.4, 0.5, 0.6, 0.7, 0.8, 0.9, 1.0, 1.1};
+  auto& linearController = dynamic_cast<LinearController&>(*primalSolution.controllerPtr_);
+  linearController.timeStamp_ = primalSolution.timeTrajectory_;
+
+  PolicyEvaluator evaluator;
+  evaluator.setPolicy(primalSolution, 0.025);
+  for (scalar_t t = -0.1; t < 1.2; t += 0.001) {
+    checkEvaluation(evaluator, primalSolution, t, 1e-9);
+  }
+
+  // a new policy is resampled into the same buffers
+  auto otherPrimalSolution = getPolicy(false);
+  evaluator.setPolicy(otherPrimalSolution, 0.001);
+  for (scalar_t t = 0.0; t < 1.0; t += 0.0123) {
+    vector_t nominalState, input;
+    size_t mode;
+    evaluator.evaluate(t, vector_t::Zero(stateDim), nominalState, input, mode);
+    EXPECT_EQ(mode, otherPrimalSolution.modeSchedule_.modeAtTime(t));
+    EXPECT_EQ(input.size(), inputDim);
+  }
+}
+
+TEST(testPolicyEvaluator, noPolicy) {
+  PolicyEvaluator evaluator;
+  vector_t nominalState, input;
+  size_t mode;
+  EXPECT_FALSE(evaluator.hasPolicy());
+  EXPECT_THROW(evaluator.evaluate(0.0, vector_t::Zero(stateDim), nominalState, input, mode), std::runtime_error);
+}
@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+
 #include "ocs2_oc/oc_data/TimeDiscretization.h"
 
 using namespace ocs2;
@@ -127,4 +129,162 @@ TEST(test_time_discretization, withEvents) {
   ASSERT_EQ(time[12].event, AnnotatedTime::Event::PreEvent);
   ASSERT_EQ(time[13].event, AnnotatedTime::Event::PostEvent);
   ASSERT_EQ(time[14].event, AnnotatedTime::Event::None);
-}
\ No newline at end of file
+}
+
+TEST(test_time_discretization, alignedNoEvents) {
+  const scalar_t dt = 0.1;
+  const scalar_t horizon = 1.0;
+  const scalar_array_t eventTimes{};
+
+  const auto time = alignedTimeDiscretizationWithEvents(0.123, 0.123 + horizon, dt, eventTimes);
+  //  timeDiscretization = {0.123, 0.2, 0.3, ..., 1.0, 1.123}
+  ASSERT_EQ(time.size(), 11);
+  ASSERT_EQ(time.front().time, 0.123);
+  ASSERT_EQ(time.back().time, 0.123 + horizon);
+  for (size_t i = 1; i < time.size() - 1; i++) {
+    ASSERT_DOUBLE_EQ(time[i].time, (i + 1) * dt);
+    ASSERT_EQ(time[i].event, AnnotatedTime::Event::None);
+  }
+
+  // The shifted horizon has the same number of nodes and shares the grid points
+  const auto shiftedTime = alignedTimeDiscretizationWithEvents(0.187, 0.187 + horizon, dt, eventTimes);
+  //  timeDiscretization = {0.187, 0.3, 0.4, ..., 1.1, 1.187}
+  ASSERT_EQ(shiftedTime.size(), time.size());
+  for (size_t i = 1; i < shiftedTime.size() - 2; i++) {
+    ASSERT_EQ(shiftedTime[i].time, time[i + 1].time);
+  }
+}
+
+TEST(test_time_discretization, alignedWithEvents) {
+  const scalar_t initTime = 0.12;
+  const scalar_t finalTime = 0.9;
+  const scalar_t dt = 0.1;
+  const scalar_array_t eventTimes{0.55, 0.88};
+
+  const auto time = alignedTimeDiscretizationWithEvents(initTime, finalTime, dt, eventTimes);
+  //  timeDiscretization = {0.12, 0.2, 0.3, 0.4, 0.5, 0.55, 0.55, 0.6, 0.7, 0.8, 0.88, 0.88, 0.9}
+  ASSERT_EQ(time.size(), 13);
+  ASSERT_EQ(time[0].time, initTime);
+  ASSERT_DOUBLE_EQ(time[1].time, 0.2);
+  ASSERT_DOUBLE_EQ(time[4].time, 0.5);
+  ASSERT_EQ(time[5].time, eventTimes[0]);
+  ASSERT_EQ(time[6].time, eventTimes[0]);
+  ASSERT_DOUBLE_EQ(time[7].time, 0.6);
+  ASSERT_DOUBLE_EQ(time[9].time, 0.8);
+  ASSERT_EQ(time[10].time, eventTimes[1]);  // Kept although within dt / 2 of the final time
+  ASSERT_EQ(time[11].time, eventTimes[1]);
+  ASSERT_EQ(time[12].time, finalTime);
+
+  // Events
+  ASSERT_EQ(time[5].event, AnnotatedTime::Event::PreEvent);
+  ASSERT_EQ(time[6].event, AnnotatedTime::Event::PostEvent);
+  ASSERT_EQ(time[7].event, AnnotatedTime::Event::None);
+  ASSERT_EQ(time[10].event, AnnotatedTime::Event::PreEvent);
+  ASSERT_EQ(time[11].event, AnnotatedTime::Event::PostEvent);
+  ASSERT_EQ(time[12].event, AnnotatedTime::Event::None);
+}
+
+TEST(test_time_discretization, interpolationTime) {
+  const scalar_t initTime = 3.0;
+  const scalar_t finalTime = 4.0;
+  const scalar_array_t eventTimes{3.25};
+
+  const auto time = timeDiscretizationWithEvents(initTime, finalTime, 0.1, eventTimes);
+  const auto interpolationTime = toInterpolationTime(time);
+  ASSERT_EQ(interpolationTime.size(), time.size());
+  ASSERT_EQ(interpolationTime.front(), initTime);
+  ASSERT_LT(interpolationTime.back(), finalTime);
+  for (size_t i = 1; i < interpolationTime.size(); i++) {
+    ASSERT_GT(interpolationTime[i], interpolationTime[i - 1]);
+  }
+}
+
+TEST(test_time_discretization, adaptiveNoEvents) {
+  const scalar_t initTime = 0.0;
+  const scalar_t finalTime = 1.0;
+  const scalar_t dt = 0.01;
+  const scalar_t dtMax = 0.1;
+  const scalar_array_t eventTimes{};
+
+  // Uniform for a unit growth rate
+  const auto uniformTime = adaptiveTimeDiscretizationWithEvents(initTime, finalTime, dt, 1.0, dtMax, eventTimes);
+  ASSERT_EQ(uniformTime.size(), 101);
+
+  const auto time = adaptiveTimeDiscretizationWithEvents(initTime, finalTime, dt, 1.1, dtMax, eventTimes);
+  ASSERT_LT(time.size(), uniformTime.size() / 2);
+  ASSERT_EQ(time.front().time, initTime);
+  ASSERT_EQ(time.back().time, finalTime);
+  ASSERT_DOUBLE_EQ(time[1].time - time[0].time, dt);
+  for (size_t i = 1; i < time.size() - 1; i++) {
+    const scalar_t step = time[i].time - time[i - 1].time;
+    const scalar_t nextStep = time[i + 1].time - time[i].time;
+    ASSERT_LE(step, dtMax);
+    if (i + 1 < time.size() - 1) {  // except for the final step
+      ASSERT_GE(nextStep, step);
+    }
+    ASSERT_EQ(time[i].event, AnnotatedTime::Event::None);
+  }
+}
+
+TEST(test_time_discretization, adaptiveWithEvents) {
+  const scalar_t initTime = 0.0;
+  const scalar_t finalTime = 1.0;
+  const scalar_t dt = 0.01;
+  const scalar_t dtMax = 0.1;
+  const scalar_array_t eventTimes{0.6};
+
+  const auto time = adaptiveTimeDiscretizationWithEvents(initTime, finalTime, dt, 1.1, dtMax, eventTimes);
+  const auto eventIt =
+      std::find_if(time.begin(), time.end(), [](const AnnotatedTime& t) { return t.event == AnnotatedTime::Event::PreEvent; });
+  ASSERT_NE(eventIt, time.end());
+  ASSERT_EQ(eventIt->time, eventTimes[0]);
+  ASSERT_EQ(std::next(eventIt)->time, eventTimes[0]);
+  ASSERT_EQ(std::next(eventIt)->event, AnnotatedTime::Event::PostEvent);
+
+  // Refined around the event
+  ASSERT_LT(eventIt->time - std::prev(eventIt)->time, 1.5 * dt);
+  ASSERT_NEAR(std::next(eventIt, 2)->time - std::next(eventIt)->time, dt, 1e-12);
+  for (size_t i = 1; i < time.size(); i++) {
+    ASSERT_LE(time[i].time - time[i - 1].time, dtMax);
+  }
+}
+
+TEST(test_time_discretization, adaptiveFinalInterval) {
+  const scalar_t initTime = 0.0;
+  const scalar_t dt = 0.01;
+  const scalar_t growthRate = 1.5;
+  const scalar_t dtMax = 0.1;
+  const scalar_array_t eventTimes{};
+
+  // The final node may not merge the remainder into a step of dtMax
+  for (scalar_t finalTime = 0.5; finalTime < 1.5; finalTime += 0.0037) {
+    const auto time = adaptiveTimeDiscretizationWithEvents(initTime, finalTime, dt, growthRate, dtMax, eventTimes);
+    ASSERT_EQ(time.back().time, finalTime);
+    for (size_t i = 1; i < time.size(); i++) {
+      ASSERT_LE(time[i].time - time[i - 1].time, dtMax + 1e-12);
+    }
+  }
+}
+
+TEST(test_time_discretization, getTimeDiscretization) {
+  const scalar_t initTime = 0.187;
+  const scalar_t finalTime = 1.187;
+  const scalar_t dt = 0.01;
+  const scalar_t dtMax = 0.1;
+  const scalar_array_t eventTimes{0.6};
+
+  const auto uniformTime = getTimeDiscretization(initTime, finalTime, dt, 1.0, dtMax, false, eventTimes);
+  const auto expectedUniformTime = timeDiscretizationWithEvents(initTime, finalTime, dt, eventTimes);
+  ASSERT_EQ(toTime(uniformTime), toTime(expectedUniformTime));
+
+  const auto alignedTime = getTimeDiscretization(initTime, finalTime, dt, 1.0, dtMax, true, eventTimes);
+  const auto expectedAlignedTime = alignedTimeDiscretizationWithEvents(initTime, finalTime, dt, eventTimes);
+  ASSERT_EQ(toTime(alignedTime), toTime(expectedAlignedTime));
+
+  const auto adaptiveTime = getTimeDiscretization(initTime, finalTime, dt, 1.1, dtMax, false, eventTimes);
+  const auto expectedAdaptiveTime = adaptiveTimeDiscretizationWithEvents(initTime, finalTime, dt, 1.1, dtMax, eventTimes);
+  ASSERT_EQ(toTime(adaptiveTime), toTime(expectedAdaptiveTime));
+
+  // The non-uniform discretization can not be aligned
+  ASSERT_THROW(getTimeDiscretization(initTime, finalTime, dt, 1.1, dtMax, true, eventTimes), std::runtime_error);
+}
@@ -255,4 +255,47 @@ TEST(linear_change_of_input_variables, bothPx_U0) {
   const vector_t unprojected = evaluate(linear, dx, Pu * du_tilde + Px * dx + u0);
   const vector_t projected = evaluate(linearProjected, dx, du_tilde);
   ASSERT_TRUE(unprojected.isApprox(projected));
-}
\ No newline at end of file
+}
+TEST(change_of_input_variables, reusedArena) {
+  const int n = 4;
+  const int m = 3;
+  const int p = 2;
+
+  MonotonicArena arena;
+  size_t capacity = 0;
+  for (int iteration = 0; iteration < 3; iteration++) {
+    arena.reset();
+    if (iteration > 1) {
+      // the block holds all temporaries after the first iteration
+      ASSERT_EQ(arena.capacity(), capacity);
+    }
+    capacity = arena.capacity();
+
+    // Create change of variables
+    const matrix_t Pu = matrix_t::Random(m, p);
+    const matrix_t Px = matrix_t::Random(m, n);
+    const vector_t u0 = vector_t::Random(m);
+    const auto quadratic = getRandomCost(n, m);
+    const auto linear = getRandomDynamics(n, m);
+
+    // Apply change of variables with and without arena
+    auto quadraticProjected = quadratic;
+    auto quadraticProjectedArena = quadratic;
+    changeOfInputVariables(quadraticProjected, Pu, Px, u0);
+    changeOfInputVariables(quadraticProjectedArena, Pu, Px, u0, arena);
+    auto linearProjected = linear;
+    auto linearProjectedArena = linear;
+    changeOfInputVariables(linearProjected, Pu, Px, u0);
+    changeOfInputVariables(linearProjectedArena, Pu, Px, u0, arena);
+
+    ASSERT_TRUE(quadraticProjected.dfdxx.isApprox(quadraticProjectedArena.dfdxx));
+    ASSERT_TRUE(quadraticProjected.dfdux.isApprox(quadraticProjectedArena.dfdux));
+    ASSERT_TRUE(quadraticProjected.dfduu.isApprox(quadraticProjectedArena.dfduu));
+    ASSERT_TRUE(quadraticProjected.dfdx.isApprox(quadraticProjectedArena.dfdx));
+    ASSERT_TRUE(quadraticProjected.dfdu.isApprox(quadraticProjectedArena.dfdu));
+    ASSERT_DOUBLE_EQ(quadraticProjected.f, quadraticProjectedArena.f);
+    ASSERT_TRUE(linearProjected.dfdx.isApprox(linearProjectedArena.dfdx));
+    ASSERT_TRUE(linearProjected.dfdu.isApprox(linearProjectedArena.dfdu));
+    ASSERT_TRUE(linearProjected.f.isApprox(linearProjectedArena.f));
+  }
+}
@@ -59,7 +59,7 @@ EndEffectorDistanceConstraintCppAd::EndEffectorDistanceConstraintCppAd(size_t st
   if (config_.generateModel) {
     kinematicsModelPtr_->createModels(order, config_.verbose);
   } else {
-    kinematicsModelPtr_->loadModelsIfAvailable(order, config_.verbose);
+    kinematicsModelPtr_->loadModelsIfUpToDate(order, config_.verbose);
   }
 }
 
@@ -60,7 +60,7 @@ class PinocchioCentroidalDynamicsAD final {
    * @param [in] modelName : Name of the generate model library
    * @param [in] modelFolder : Folder to save the model library files to
    * @param [in] recompileLibraries : If true, the model library will be newly compiled. If false, an existing library will be loaded if
-   *                                  available.
+   *                                  it is up to date.
    * @param [in] verbose : print information.
    */
   PinocchioCentroidalDynamicsAD(const PinocchioInterface& pinocchioInterface, const CentroidalModelInfo& info, const std::string& modelName,
@@ -59,7 +59,7 @@ PinocchioCentroidalDynamicsAD::PinocchioCentroidalDynamicsAD(const PinocchioInte
   if (recompileLibraries) {
     systemFlowMapCppAdInterfacePtr_->createModels(CppAdInterface::ApproximationOrder::First, verbose);
   } else {
-    systemFlowMapCppAdInterfacePtr_->loadModelsIfAvailable(CppAdInterface::ApproximationOrder::First, verbose);
+    systemFlowMapCppAdInterfacePtr_->loadModelsIfUpToDate(CppAdInterface::ApproximationOrder::First, verbose);
   }
 }
 
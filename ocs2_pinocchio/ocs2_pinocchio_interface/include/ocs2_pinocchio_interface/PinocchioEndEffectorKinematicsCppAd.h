@@ -66,7 +66,7 @@ class PinocchioEndEffectorKinematicsCppAd final : public EndEffectorKinematics<s
    * @param [in] modelName : name of the generate model library
    * @param [in] modelFolder : folder to save the model library files to
    * @param [in] recompileLibraries : If true, the model library will be newly compiled. If false, an existing library will be loaded if
-   *                                  available.
+   *                                  it is up to date.
    * @param [in] verbose : print information.
    */
   PinocchioEndEffectorKinematicsCppAd(const PinocchioInterface& pinocchioInterface, const PinocchioStateInputMapping<ad_scalar_t>& mapping,
@@ -85,7 +85,7 @@ class PinocchioEndEffectorKinematicsCppAd final : public EndEffectorKinematics<s
    * @param [in] modelName : name of the generate model library
    * @param [in] modelFolder : folder to save the model library files to
    * @param [in] recompileLibraries : If true, the model library will be newly compiled. If false, an existing library will be loaded if
-   *                                  available.
+   *                                  it is up to date.
    * @param [in] verbose : print information.
    */
   PinocchioEndEffectorKinematicsCppAd(const PinocchioInterface& pinocchioInterface, const PinocchioStateInputMapping<ad_scalar_t>& mapping,
@@ -48,13 +48,9 @@ SelfCollisionCppAd::SelfCollisionCppAd(const PinocchioInterface& pinocchioInterf
     : pinocchioGeometryInterface_(std::move(pinocchioGeometryInterface)), minimumDistance_(minimumDistance) {
   PinocchioInterfaceCppAd pinocchioInterfaceAd = pinocchioInterface.toCppAd();
   setADInterfaces(pinocchioInterfaceAd, modelName, modelFolder);
-  if (recompileLibraries) {
-    cppAdInterfaceDistanceCalculation_->createModels(CppAdInterface::ApproximationOrder::First, verbose);
-    cppAdInterfaceLinkPoints_->createModels(CppAdInterface::ApproximationOrder::First, verbose);
-  } else {
-    cppAdInterfaceDistanceCalculation_->loadModelsIfAvailable(CppAdInterface::ApproximationOrder::First, verbose);
-    cppAdInterfaceLinkPoints_->loadModelsIfAvailable(CppAdInterface::ApproximationOrder::First, verbose);
-  }
+  CppAdInterface::createModelsInParallel({{cppAdInterfaceDistanceCalculation_.get(), CppAdInterface::ApproximationOrder::First},
+                                          {cppAdInterfaceLinkPoints_.get(), CppAdInterface::ApproximationOrder::First}},
+                                         0, !recompileLibraries, verbose);
 }
 
 /******************************************************************************************************/
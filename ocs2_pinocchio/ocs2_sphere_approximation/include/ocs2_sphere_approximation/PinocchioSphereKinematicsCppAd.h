@@ -71,7 +71,7 @@ class PinocchioSphereKinematicsCppAd final : public EndEffectorKinematics<scalar
    * @param [in] modelName : name of the generate model library
    * @param [in] modelFolder : folder to save the model library files to
    * @param [in] recompileLibraries : If true, the model library will be newly compiled. If false, an existing library will be loaded if
-   *                                  available.
+   *                                  it is up to date.
    * @param [in] verbose : print information.
    */
   PinocchioSphereKinematicsCppAd(const PinocchioInterface& pinocchioInterface, PinocchioSphereInterface pinocchioSphereInterface,
@@ -71,7 +71,7 @@ PinocchioSphereKinematicsCppAd::PinocchioSphereKinematicsCppAd(const PinocchioIn
   if (recompileLibraries) {
     positionCppAdInterfacePtr_->createModels(CppAdInterface::ApproximationOrder::First, verbose);
   } else {
-    positionCppAdInterfacePtr_->loadModelsIfAvailable(CppAdInterface::ApproximationOrder::First, verbose);
+    positionCppAdInterfacePtr_->loadModelsIfUpToDate(CppAdInterface::ApproximationOrder::First, verbose);
   }
 }
 
@@ -48,12 +48,18 @@ namespace ballbot {
  */
 class BallbotSystemDynamics : public SystemDynamicsBaseAD {
  public:
-  /** Constructor */
-  BallbotSystemDynamics(const std::string& libraryFolder, bool recompileLibraries) : SystemDynamicsBaseAD() {
+  /**
+   * Constructor
+   *
+   * @param [in] libraryFolder: Folder of the generated library.
+   * @param [in] recompileLibraries: If true, the library is always regenerated.
+   * @param [in] numLanes: Number of points evaluated at once by the batch linearization, see CppAdInterface::setNumLanes().
+   */
+  BallbotSystemDynamics(const std::string& libraryFolder, bool recompileLibraries, size_t numLanes = 0) : SystemDynamicsBaseAD() {
     wheelRadius_ = param_.wheelRadius_;
     ballRadius_ = param_.ballRadius_;
 
-    initialize(STATE_DIM, INPUT_DIM, "ballbot_dynamics", libraryFolder, recompileLibraries, true);
+    initialize(STATE_DIM, INPUT_DIM, "ballbot_dynamics", libraryFolder, recompileLibraries, true, numLanes);
   }
 
   /** Destructor */
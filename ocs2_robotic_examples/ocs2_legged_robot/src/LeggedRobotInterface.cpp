@@ -41,6 +41,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_centroidal_model/AccessHelperFunctions.h>
 #include <ocs2_centroidal_model/CentroidalModelPinocchioMapping.h>
 #include <ocs2_centroidal_model/ModelHelperFunctions.h>
+#include <ocs2_core/automatic_differentiation/CppAdModelBatch.h>
 #include <ocs2_core/misc/Display.h>
 #include <ocs2_core/soft_constraint/StateInputSoftConstraint.h>
 #include <ocs2_oc/synchronized_module/SolverSynchronizedModule.h>
@@ -151,6 +152,10 @@ void LeggedRobotInterface::setupOptimalConrolProblem(
   // Optimal control problem
   problemPtr_.reset(new OptimalControlProblem);
 
+  // The libraries of all CppAD models compile concurrently, they are loaded by
+  // modelBatch.finish()
+  CppAdModelBatch modelBatch;
+
   // Dynamics
   bool useAnalyticalGradientsDynamics = false;
   loadData::loadCppDataType(
@@ -247,6 +252,8 @@ void LeggedRobotInterface::setupOptimalConrolProblem(
   constexpr bool extendNormalizedMomentum = true;
   initializerPtr_.reset(new LeggedRobotInitializer(
       centroidalModelInfo_, *referenceManagerPtr_, extendNormalizedMomentum));
+
+  modelBatch.finish();
 }
 
 /******************************************************************************************************/
@@ -44,10 +44,11 @@ class QuadraticInputCost final : public QuadraticStateInputCost {
   QuadraticInputCost(const QuadraticInputCost& rhs) = default;
   QuadraticInputCost* clone() const override { return new QuadraticInputCost(*this); }
 
-  std::pair<vector_t, vector_t> getStateInputDeviation(scalar_t time, const vector_t& state, const vector_t& input,
-                                                       const TargetTrajectories& targetTrajectories) const override {
-    const vector_t inputDeviation = input - targetTrajectories.getDesiredInput(time);
-    return {vector_t::Zero(stateDim_), inputDeviation};
+  void getStateInputDeviation(scalar_t time, const vector_t& state, const vector_t& input, const TargetTrajectories& targetTrajectories,
+                              vector_t& stateDeviation, vector_t& inputDeviation) const override {
+    stateDeviation.setZero(stateDim_);
+    targetTrajectories.getDesiredInput(time, inputDeviation);
+    inputDeviation = input - inputDeviation;
   }
 
  private:
@@ -36,6 +36,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_mobile_manipulator/MobileManipulatorInterface.h"
 
+#include <ocs2_core/automatic_differentiation/CppAdModelBatch.h>
 #include <ocs2_core/initialization/DefaultInitializer.h>
 #include <ocs2_core/misc/LoadData.h>
 #include <ocs2_core/misc/LoadStdVectorOfPair.h>
@@ -159,6 +160,9 @@ MobileManipulatorInterface::MobileManipulatorInterface(const std::string& taskFi
   /*
    * Optimal control problem
    */
+  // The libraries of all CppAD models compile concurrently, they are loaded by modelBatch.finish()
+  CppAdModelBatch modelBatch;
+
   // Cost
   problem_.costPtr->add("inputCost", getQuadraticInputCost(taskFile));
 
@@ -218,6 +222,8 @@ MobileManipulatorInterface::MobileManipulatorInterface(const std::string& taskFi
 
   // Initialization
   initializerPtr_.reset(new DefaultInitializer(manipulatorModelInfo_.inputDim));
+
+  modelBatch.finish();
 }
 
 /******************************************************************************************************/
@@ -46,13 +46,9 @@ SwitchedModelPreComputation::SwitchedModelPreComputation(const SwingTrajectoryPl
   // Generate the models
   const bool verbose = true;
   const auto order = ocs2::CppAdInterface::ApproximationOrder::First;
-  if (settings.recompileLibraries_) {
-    intermediateLinearOutputAdInterface_->createModels(order, verbose);
-    prejumpLinearOutputAdInterface_->createModels(order, verbose);
-  } else {
-    intermediateLinearOutputAdInterface_->loadModelsIfAvailable(order, verbose);
-    prejumpLinearOutputAdInterface_->loadModelsIfAvailable(order, verbose);
-  }
+  ocs2::CppAdInterface::createModelsInParallel(
+      {{intermediateLinearOutputAdInterface_.get(), order}, {prejumpLinearOutputAdInterface_.get(), order}}, 0,
+      !settings.recompileLibraries_, verbose);
 }
 
 SwitchedModelPreComputation::SwitchedModelPreComputation(const SwitchedModelPreComputation& other)
@@ -0,0 +1,136 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <utility>
+
+#include <ocs2_msgs/msg/mpc_flat_policy.hpp>
+#include <ocs2_msgs/msg/mpc_flat_policy_delta.hpp>
+
+namespace ocs2 {
+
+/**
+ * Encodes a sequence of flat policies as incremental updates. Consecutive MPC
+ * policies mostly overlap in time, so every node of the new policy that lies
+ * in the time range of the last acknowledged policy is sent as an int16
+ * quantized delta against that policy, linearly interpolated at the node time.
+ * Only the new tail of the horizon is sent in full precision.
+ *
+ * The encoder keeps the policies as reconstructed by the decoder, such that
+ * the quantization error does not accumulate over the updates. A keyframe is
+ * sent when no acknowledged reference is available and every keyframeInterval
+ * messages.
+ */
+class PolicyDeltaEncoder {
+ public:
+  /**
+   * Constructor.
+   *
+   * @param [in] keyframeInterval: The maximum number of messages between two
+   * keyframes.
+   * @param [in] historySize: The number of sent policies which can serve as
+   * the reference. Should cover the messages in flight.
+   */
+  explicit PolicyDeltaEncoder(size_t keyframeInterval = 50,
+                              size_t historySize = 8);
+
+  /**
+   * Encodes the policy against the last acknowledged policy.
+   *
+   * @param [in] policyMsg: The flat policy message.
+   * @return The incremental update.
+   */
+  ocs2_msgs::msg::MpcFlatPolicyDelta encode(
+      const ocs2_msgs::msg::MpcFlatPolicy& policyMsg);
+
+  /**
+   * Marks a policy as received by the decoder. Thread-safe with respect to
+   * encode().
+   *
+   * @param [in] sequence: The sequence number of the decoded policy.
+   */
+  void acknowledge(uint64_t sequence);
+
+  /**
+   * Forgets all the references such that the next message is a keyframe, e.g.
+   * after an MPC reset. Thread-safe with respect to encode(), the references
+   * are dropped at the beginning of the next encode().
+   */
+  void reset();
+
+ private:
+  size_t keyframeInterval_;
+  size_t historySize_;
+  uint64_t sequence_ = 0;
+  size_t numSinceKeyframe_ = 0;
+  std::atomic<uint64_t> acknowledgedSequence_{0};
+  std::atomic<bool> resetRequested_{false};
+  std::deque<std::pair<uint64_t, ocs2_msgs::msg::MpcFlatPolicy>> history_;
+};
+
+/**
+ * Reconstructs the flat policies from the incremental updates of
+ * PolicyDeltaEncoder. The sequence number of every decoded policy should be
+ * sent back to the encoder with PolicyDeltaEncoder::acknowledge().
+ */
+class PolicyDeltaDecoder {
+ public:
+  /**
+   * Constructor.
+   *
+   * @param [in] historySize: The number of decoded policies which can serve as
+   * the reference. Should match the history size of the encoder.
+   */
+  explicit PolicyDeltaDecoder(size_t historySize = 8);
+
+  /**
+   * Reconstructs the policy of an incremental update.
+   *
+   * @param [in] deltaMsg: The incremental update.
+   * @param [out] policyMsg: The reconstructed flat policy message.
+   * @return false if the reference of the update is not available, in which
+   * case the update is dropped until the next keyframe or acknowledged
+   * reference arrives.
+   */
+  bool decode(const ocs2_msgs::msg::MpcFlatPolicyDelta& deltaMsg,
+              ocs2_msgs::msg::MpcFlatPolicy& policyMsg);
+
+  /** Forgets all the references. */
+  void reset() { history_.clear(); }
+
+ private:
+  size_t historySize_;
+  std::deque<std::pair<uint64_t, ocs2_msgs::msg::MpcFlatPolicy>> history_;
+};
+
+}  // namespace ocs2
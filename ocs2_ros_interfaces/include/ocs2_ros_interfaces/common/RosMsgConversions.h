@@ -34,13 +34,16 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/model_data/Multiplier.h>
 #include <ocs2_core/reference/ModeSchedule.h>
 #include <ocs2_core/reference/TargetTrajectories.h>
+#include <ocs2_mpc/CommandData.h>
 #include <ocs2_mpc/SystemObservation.h>
 #include <ocs2_oc/oc_data/PerformanceIndex.h>
+#include <ocs2_oc/oc_data/PrimalSolution.h>
 
 // MPC messages
 #include <ocs2_msgs/msg/constraint.hpp>
 #include <ocs2_msgs/msg/lagrangian_metrics.hpp>
 #include <ocs2_msgs/msg/mode_schedule.hpp>
+#include <ocs2_msgs/msg/mpc_flat_policy.hpp>
 #include <ocs2_msgs/msg/mpc_observation.hpp>
 #include <ocs2_msgs/msg/mpc_performance_indices.hpp>
 #include <ocs2_msgs/msg/mpc_target_trajectories.hpp>
@@ -87,6 +90,33 @@ ocs2_msgs::msg::MpcPerformanceIndices createPerformanceIndicesMsg(
 PerformanceIndex readPerformanceIndicesMsg(
     const ocs2_msgs::msg::MpcPerformanceIndices& performanceIndicesMsg);
 
+/**
+ * Creates the flat policy message, which stores each trajectory and the
+ * controller in one contiguous double precision array. The controller is
+ * sampled at the nodes of the primal solution. All nodes must have the same
+ * state and input dimensions.
+ *
+ * @param [in] primalSolution: The policy data of the MPC.
+ * @param [in] commandData: The command data of the MPC.
+ * @param [in] performanceIndices: The performance indices data of the solver.
+ * @return The flat policy message.
+ */
+ocs2_msgs::msg::MpcFlatPolicy createFlatPolicyMsg(
+    const PrimalSolution& primalSolution, const CommandData& commandData,
+    const PerformanceIndex& performanceIndices);
+
+/**
+ * Reads the flat policy message.
+ *
+ * @param [in] policyMsg: The flat policy message.
+ * @param [out] commandData: The MPC command data.
+ * @param [out] primalSolution: The MPC policy data.
+ * @param [out] performanceIndices: The MPC performance indices data.
+ */
+void readFlatPolicyMsg(const ocs2_msgs::msg::MpcFlatPolicy& policyMsg,
+                       CommandData& commandData, PrimalSolution& primalSolution,
+                       PerformanceIndex& performanceIndices);
+
 /** Creates constraint message. */
 ocs2_msgs::msg::Constraint createConstraintMsg(scalar_t time,
                                                const vector_t& constraint);
@@ -34,19 +34,25 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/misc/Benchmark.h>
 #include <ocs2_mpc/CommandData.h>
 #include <ocs2_mpc/MPC_BASE.h>
+#include <ocs2_mpc/SharedPolicyChannel.h>
 #include <ocs2_mpc/SystemObservation.h>
 #include <ocs2_oc/oc_data/PrimalSolution.h>
 
+#include "ocs2_ros_interfaces/common/PolicyDeltaCodec.h"
+
 #include <atomic>
 #include <condition_variable>
 #include <iostream>
 #include <memory>
 #include <mutex>
 #include <ocs2_msgs/msg/mode_schedule.hpp>
+#include <ocs2_msgs/msg/mpc_flat_policy.hpp>
+#include <ocs2_msgs/msg/mpc_flat_policy_delta.hpp>
 #include <ocs2_msgs/msg/mpc_flattened_controller.hpp>
 #include <ocs2_msgs/msg/mpc_observation.hpp>
 #include <ocs2_msgs/msg/mpc_target_trajectories.hpp>
 #include <ocs2_msgs/srv/reset.hpp>
+#include <std_msgs/msg/u_int64.hpp>
 #include <string>
 #include <thread>
 #include <vector>
@@ -65,7 +71,10 @@ class MPC_ROS_Interface {
   /**
    * Constructor.
    *
-   * @param [in] mpc: The underlying MPC class to be used.
+   * @param [in] mpc: The underlying MPC class to be used. If
+   * mpc::Settings::publishIntermediateSolutions_ is set, the intermediate
+   * iterates of the solver which pass the quality gate are published while the
+   * MPC is running.
    * @param [in] topicPrefix: The robot's name.
    */
   explicit MPC_ROS_Interface(MPC_BASE& mpc,
@@ -101,6 +110,34 @@ class MPC_ROS_Interface {
    */
   void launchNodes(const rclcpp::Node::SharedPtr& node);
 
+  /**
+   * Additionally publishes the policy through a shared-memory segment for MRT
+   * processes on the same host, see SharedPolicyWriter. The segment is named
+   * after the policy topic. Must be called before launchNodes().
+   *
+   * @param [in] dimensions: The capacities of the policy slots.
+   */
+  void enableSharedMemoryTransport(const SharedPolicyDimensions& dimensions);
+
+  /**
+   * Publishes the policy as ocs2_msgs::msg::MpcFlatPolicy on the
+   * "<topicPrefix>_mpc_flat_policy" topic instead of the flattened controller
+   * message. The MRT must be configured accordingly. Must be called before
+   * launchNodes().
+   */
+  void enableFlatPolicyMsg();
+
+  /**
+   * Publishes the policy as incremental updates on the
+   * "<topicPrefix>_mpc_policy_delta" topic, see PolicyDeltaEncoder. The MRT
+   * acknowledges the decoded policies on "<topicPrefix>_mpc_policy_ack". The
+   * MRT must be configured accordingly. Must be called before launchNodes().
+   *
+   * @param [in] keyframeInterval: The maximum number of messages between two
+   * keyframes.
+   */
+  void enableIncrementalPolicyMsg(size_t keyframeInterval = 50);
+
  protected:
   /**
    * Callback to reset MPC.
@@ -124,6 +161,17 @@ class MPC_ROS_Interface {
       const PrimalSolution& primalSolution, const CommandData& commandData,
       const PerformanceIndex& performanceIndices);
 
+  /**
+   * Publishes the policy on all the enabled transports.
+   *
+   * @param [in] commandData: The command data of the MPC.
+   * @param [in] primalSolution: The policy data of the MPC.
+   * @param [in] performanceIndices: The performance indices data of the solver.
+   */
+  void publishPolicy(const CommandData& commandData,
+                     const PrimalSolution& primalSolution,
+                     const PerformanceIndex& performanceIndices);
+
   /**
    * Handles ROS publishing thread.
    */
@@ -137,6 +185,23 @@ class MPC_ROS_Interface {
    */
   void copyToBuffer(const SystemObservation& mpcInitObservation);
 
+  /**
+   * Copies an intermediate iterate of the solver to the buffer and publishes
+   * it. This method is called by the solver through MPC_BASE while the MPC is
+   * running.
+   *
+   * @param [in] primalSolution: The primal solution of the iterate.
+   * @param [in] performanceIndex: The performance index of the iterate.
+   */
+  void publishIntermediateSolution(const PrimalSolution& primalSolution,
+                                   const PerformanceIndex& performanceIndex);
+
+  /**
+   * Publishes the buffer, either by notifying the publisher thread or
+   * directly.
+   */
+  void publishBuffer();
+
   /**
    * The callback method which receives the current observation, invokes the MPC
    * algorithm, and finally publishes the optimized policy.
@@ -163,7 +228,16 @@ class MPC_ROS_Interface {
       mpcTargetTrajectoriesSubscriber_;
   rclcpp::Publisher<ocs2_msgs::msg::MpcFlattenedController>::SharedPtr
       mpcPolicyPublisher_;
+  rclcpp::Publisher<ocs2_msgs::msg::MpcFlatPolicy>::SharedPtr
+      mpcFlatPolicyPublisher_;
+  bool useFlatPolicyMsg_ = false;
+  rclcpp::Publisher<ocs2_msgs::msg::MpcFlatPolicyDelta>::SharedPtr
+      mpcPolicyDeltaPublisher_;
+  rclcpp::Subscription<std_msgs::msg::UInt64>::SharedPtr
+      mpcPolicyAckSubscriber_;
+  std::unique_ptr<PolicyDeltaEncoder> policyDeltaEncoderPtr_;
   rclcpp::Service<ocs2_msgs::srv::Reset>::SharedPtr mpcResetServiceServer_;
+  std::unique_ptr<SharedPolicyWriter> sharedPolicyWriterPtr_;
 
   std::unique_ptr<CommandData> bufferCommandPtr_;
   std::unique_ptr<CommandData> publisherCommandPtr_;
@@ -175,6 +249,9 @@ class MPC_ROS_Interface {
   mutable std::mutex
       bufferMutex_;  // for policy variables with prefix (buffer*)
 
+  // The observation of the ongoing MPC run
+  SystemObservation mpcInitObservation_;
+
   // multi-threading for publishers
   std::atomic_bool terminateThread_{false};
   std::atomic_bool readyToPublish_{false};
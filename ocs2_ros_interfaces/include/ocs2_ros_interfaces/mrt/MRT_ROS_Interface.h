@@ -41,10 +41,15 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 // MPC messages
 #include <ocs2_mpc/MRT_BASE.h>
+#include <ocs2_mpc/SharedPolicyChannel.h>
 
+#include <ocs2_msgs/msg/mpc_flat_policy.hpp>
+#include <ocs2_msgs/msg/mpc_flat_policy_delta.hpp>
 #include <ocs2_msgs/msg/mpc_flattened_controller.hpp>
 #include <ocs2_msgs/srv/reset.hpp>
+#include <std_msgs/msg/u_int64.hpp>
 
+#include "ocs2_ros_interfaces/common/PolicyDeltaCodec.h"
 #include "ocs2_ros_interfaces/common/RosMsgConversions.h"
 
 #define PUBLISH_THREAD
@@ -99,6 +104,28 @@ class MRT_ROS_Interface : public MRT_BASE {
   void setCurrentObservation(
       const SystemObservation& currentObservation) override;
 
+  /**
+   * Receives the policy through the shared-memory segment of an MPC node on
+   * the same host instead of the policy topic, see
+   * MPC_ROS_Interface::enableSharedMemoryTransport(). The segment is polled in
+   * spinMRT(). Must be called before launchNodes().
+   */
+  void enableSharedMemoryTransport() { useSharedMemoryTransport_ = true; }
+
+  /**
+   * Receives the policy as ocs2_msgs::msg::MpcFlatPolicy instead of the
+   * flattened controller message, see MPC_ROS_Interface::enableFlatPolicyMsg().
+   * Must be called before launchNodes().
+   */
+  void enableFlatPolicyMsg() { useFlatPolicyMsg_ = true; }
+
+  /**
+   * Receives the policy as incremental updates and acknowledges the decoded
+   * policies, see MPC_ROS_Interface::enableIncrementalPolicyMsg(). Must be
+   * called before launchNodes().
+   */
+  void enableIncrementalPolicyMsg() { useIncrementalPolicyMsg_ = true; }
+
  private:
   /**
    * Callback method to receive the MPC policy as well as the mode sequence.
@@ -109,6 +136,23 @@ class MRT_ROS_Interface : public MRT_BASE {
   void mpcPolicyCallback(
       const ocs2_msgs::msg::MpcFlattenedController::ConstSharedPtr& msg);
 
+  /**
+   * Callback method to receive the MPC policy as a flat policy message.
+   *
+   * @param [in] msg: A constant pointer to the message
+   */
+  void mpcFlatPolicyCallback(
+      const ocs2_msgs::msg::MpcFlatPolicy::ConstSharedPtr& msg);
+
+  /**
+   * Callback method to receive the MPC policy as an incremental update. The
+   * policy is reconstructed against the previously decoded policies.
+   *
+   * @param [in] msg: A constant pointer to the message
+   */
+  void mpcPolicyDeltaCallback(
+      const ocs2_msgs::msg::MpcFlatPolicyDelta::ConstSharedPtr& msg);
+
   /**
    * Helper function to read a MPC policy message.
    *
@@ -128,6 +172,12 @@ class MRT_ROS_Interface : public MRT_BASE {
    */
   void publisherWorkerThread();
 
+  /**
+   * Moves a new policy from the shared-memory segment to the buffer. Opens the
+   * segment once the MPC node has created it.
+   */
+  void readSharedPolicy();
+
  private:
   std::string topicPrefix_;
 
@@ -137,8 +187,20 @@ class MRT_ROS_Interface : public MRT_BASE {
       mpcObservationPublisher_;
   rclcpp::Subscription<ocs2_msgs::msg::MpcFlattenedController>::SharedPtr
       mpcPolicySubscriber_;
+  rclcpp::Subscription<ocs2_msgs::msg::MpcFlatPolicy>::SharedPtr
+      mpcFlatPolicySubscriber_;
+  bool useFlatPolicyMsg_ = false;
+  rclcpp::Subscription<ocs2_msgs::msg::MpcFlatPolicyDelta>::SharedPtr
+      mpcPolicyDeltaSubscriber_;
+  rclcpp::Publisher<std_msgs::msg::UInt64>::SharedPtr mpcPolicyAckPublisher_;
+  bool useIncrementalPolicyMsg_ = false;
+  PolicyDeltaDecoder policyDeltaDecoder_;
   rclcpp::Client<ocs2_msgs::srv::Reset>::SharedPtr mpcResetServiceClient_;
 
+  // Same-host policy transport
+  bool useSharedMemoryTransport_ = false;
+  std::unique_ptr<SharedPolicyReader> sharedPolicyReaderPtr_;
+
   // ROS messages
   ocs2_msgs::msg::MpcObservation mpcObservationMsg_;
   ocs2_msgs::msg::MpcObservation mpcObservationMsgBuffer_;
@@ -0,0 +1,389 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_ros_interfaces/common/PolicyDeltaCodec.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include <ocs2_core/misc/LinearInterpolation.h>
+
+namespace ocs2 {
+
+namespace {
+
+using ocs2_msgs::msg::MpcFlatPolicy;
+using ocs2_msgs::msg::MpcFlatPolicyDelta;
+
+constexpr double maxQuantizedValue = 32767.0;
+
+/**
+ * Returns the number of leading nodes of the policy which lie in the time
+ * range of the reference, and can therefore be encoded as deltas.
+ */
+size_t getNumDeltaNodes(const MpcFlatPolicy& policyMsg,
+                        const MpcFlatPolicy& referenceMsg) {
+  const auto& referenceTime = referenceMsg.time_trajectory;
+  if (policyMsg.controller_type != referenceMsg.controller_type ||
+      policyMsg.state_dim != referenceMsg.state_dim ||
+      policyMsg.input_dim != referenceMsg.input_dim || referenceTime.empty()) {
+    return 0;
+  }
+
+  const auto& time = policyMsg.time_trajectory;
+  size_t numDeltaNodes = 0;
+  while (numDeltaNodes < time.size() &&
+         time[numDeltaNodes] >= referenceTime.front() &&
+         time[numDeltaNodes] <= referenceTime.back()) {
+    numDeltaNodes++;
+  }
+  return numDeltaNodes;
+}
+
+/**
+ * Linearly interpolates a block of dim values per node of a flat array. This
+ * is the prediction of the delta nodes, so the encoder and the decoder must
+ * evaluate it in exactly the same way.
+ */
+void interpolateBlock(const LinearInterpolation::index_alpha_t& indexAlpha,
+                      size_t dim, const std::vector<double>& data,
+                      double* prediction) {
+  const size_t i = indexAlpha.first;
+  const double alpha = indexAlpha.second;
+  if (alpha == 1.0) {
+    std::copy_n(data.data() + i * dim, dim, prediction);
+  } else {
+    for (size_t j = 0; j < dim; j++) {
+      prediction[j] =
+          alpha * data[i * dim + j] + (1.0 - alpha) * data[(i + 1) * dim + j];
+    }
+  }
+}
+
+/**
+ * Quantizes the difference between a block and its prediction. On return the
+ * prediction holds the reconstructed block.
+ */
+void quantizeBlock(const double* block, size_t dim, double* prediction,
+                   std::vector<double>& scale, std::vector<int16_t>& delta) {
+  double maxAbsDelta = 0.0;
+  for (size_t j = 0; j < dim; j++) {
+    maxAbsDelta = std::max(maxAbsDelta, std::abs(block[j] - prediction[j]));
+  }
+  const double step = maxAbsDelta / maxQuantizedValue;
+  scale.push_back(step);
+
+  for (size_t j = 0; j < dim; j++) {
+    const auto q =
+        (step > 0.0) ? static_cast<int16_t>(std::lround(
+                           std::max(-maxQuantizedValue,
+                                    std::min(maxQuantizedValue,
+                                             (block[j] - prediction[j]) / step))))
+                     : int16_t(0);
+    delta.push_back(q);
+    prediction[j] += q * step;
+  }
+}
+
+/** Adds the quantized delta to the prediction. */
+void dequantizeBlock(double step, const int16_t* delta, size_t dim,
+                     double* prediction) {
+  for (size_t j = 0; j < dim; j++) {
+    prediction[j] += delta[j] * step;
+  }
+}
+
+/** Returns the size of the feedback gain of a node. */
+size_t getGainDim(const MpcFlatPolicy& policyMsg) {
+  return (policyMsg.controller_type == MpcFlatPolicy::CONTROLLER_LINEAR)
+             ? policyMsg.input_dim * policyMsg.state_dim
+             : 0;
+}
+
+/** Copies everything but the state, input, and controller arrays. */
+void copyHeader(const MpcFlatPolicy& policyMsg, MpcFlatPolicy& headerMsg) {
+  headerMsg.controller_type = policyMsg.controller_type;
+  headerMsg.init_observation = policyMsg.init_observation;
+  headerMsg.plan_target_trajectories = policyMsg.plan_target_trajectories;
+  headerMsg.mode_schedule = policyMsg.mode_schedule;
+  headerMsg.performance_indices = policyMsg.performance_indices;
+  headerMsg.state_dim = policyMsg.state_dim;
+  headerMsg.input_dim = policyMsg.input_dim;
+  headerMsg.time_trajectory = policyMsg.time_trajectory;
+  headerMsg.post_event_indices = policyMsg.post_event_indices;
+}
+
+}  // namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+PolicyDeltaEncoder::PolicyDeltaEncoder(size_t keyframeInterval,
+                                       size_t historySize)
+    : keyframeInterval_(keyframeInterval),
+      historySize_(std::max(historySize, size_t(1))) {}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PolicyDeltaEncoder::acknowledge(uint64_t sequence) {
+  uint64_t acknowledged = acknowledgedSequence_.load();
+  while (sequence > acknowledged &&
+         !acknowledgedSequence_.compare_exchange_weak(acknowledged, sequence)) {
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PolicyDeltaEncoder::reset() {
+  resetRequested_ = true;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+MpcFlatPolicyDelta PolicyDeltaEncoder::encode(const MpcFlatPolicy& policyMsg) {
+  const size_t N = policyMsg.time_trajectory.size();
+  const size_t stateDim = policyMsg.state_dim;
+  const size_t inputDim = policyMsg.input_dim;
+  const size_t gainDim = getGainDim(policyMsg);
+  if (policyMsg.state_trajectory.size() != N * stateDim ||
+      policyMsg.input_trajectory.size() != N * inputDim ||
+      policyMsg.feedforward.size() != N * inputDim ||
+      policyMsg.gain.size() != N * gainDim) {
+    throw std::runtime_error(
+        "[PolicyDeltaEncoder::encode] The trajectories do not match the "
+        "dimensions!");
+  }
+
+  if (resetRequested_.exchange(false)) {
+    history_.clear();
+    numSinceKeyframe_ = 0;
+  }
+
+  // the reference is the last acknowledged policy
+  const MpcFlatPolicy* referencePtr = nullptr;
+  const uint64_t acknowledged = acknowledgedSequence_.load();
+  if (numSinceKeyframe_ < keyframeInterval_) {
+    const auto it = std::find_if(
+        history_.cbegin(), history_.cend(),
+        [acknowledged](const auto& entry) { return entry.first == acknowledged; });
+    if (it != history_.cend()) {
+      referencePtr = &it->second;
+    }
+  }
+
+  MpcFlatPolicyDelta deltaMsg;
+  deltaMsg.sequence = ++sequence_;
+  const size_t numDeltaNodes =
+      (referencePtr != nullptr) ? getNumDeltaNodes(policyMsg, *referencePtr)
+                                : 0;
+  deltaMsg.num_delta_nodes = static_cast<uint32_t>(numDeltaNodes);
+  deltaMsg.base_sequence = (numDeltaNodes > 0) ? acknowledged : deltaMsg.sequence;
+
+  // the tail nodes in full precision
+  copyHeader(policyMsg, deltaMsg.policy);
+  auto assignTail = [numDeltaNodes](const std::vector<double>& data,
+                                    size_t dim, std::vector<double>& tail) {
+    tail.assign(data.begin() + numDeltaNodes * dim, data.end());
+  };
+  assignTail(policyMsg.state_trajectory, stateDim,
+             deltaMsg.policy.state_trajectory);
+  assignTail(policyMsg.input_trajectory, inputDim,
+             deltaMsg.policy.input_trajectory);
+  assignTail(policyMsg.feedforward, inputDim, deltaMsg.policy.feedforward);
+  assignTail(policyMsg.gain, gainDim, deltaMsg.policy.gain);
+
+  // the policy as it will be reconstructed by the decoder
+  MpcFlatPolicy reconstructedMsg = policyMsg;
+  if (numDeltaNodes > 0) {
+    const auto& referenceTime = referencePtr->time_trajectory;
+    deltaMsg.state_scale.reserve(numDeltaNodes);
+    deltaMsg.state_delta.reserve(numDeltaNodes * stateDim);
+    deltaMsg.input_scale.reserve(numDeltaNodes);
+    deltaMsg.input_delta.reserve(numDeltaNodes * inputDim);
+    deltaMsg.feedforward_scale.reserve(numDeltaNodes);
+    deltaMsg.feedforward_delta.reserve(numDeltaNodes * inputDim);
+    if (gainDim > 0) {
+      deltaMsg.gain_scale.reserve(numDeltaNodes);
+      deltaMsg.gain_delta.reserve(numDeltaNodes * gainDim);
+    }
+
+    for (size_t k = 0; k < numDeltaNodes; k++) {
+      const auto indexAlpha = LinearInterpolation::timeSegment(
+          policyMsg.time_trajectory[k], referenceTime);
+
+      auto encodeBlock = [&](const std::vector<double>& data,
+                             const std::vector<double>& referenceData,
+                             size_t dim, std::vector<double>& reconstructed,
+                             std::vector<double>& scale,
+                             std::vector<int16_t>& delta) {
+        double* prediction = reconstructed.data() + k * dim;
+        interpolateBlock(indexAlpha, dim, referenceData, prediction);
+        quantizeBlock(data.data() + k * dim, dim, prediction, scale, delta);
+      };
+      encodeBlock(policyMsg.state_trajectory, referencePtr->state_trajectory,
+                  stateDim, reconstructedMsg.state_trajectory,
+                  deltaMsg.state_scale, deltaMsg.state_delta);
+      encodeBlock(policyMsg.input_trajectory, referencePtr->input_trajectory,
+                  inputDim, reconstructedMsg.input_trajectory,
+                  deltaMsg.input_scale, deltaMsg.input_delta);
+      encodeBlock(policyMsg.feedforward, referencePtr->feedforward, inputDim,
+                  reconstructedMsg.feedforward, deltaMsg.feedforward_scale,
+                  deltaMsg.feedforward_delta);
+      if (gainDim > 0) {
+        encodeBlock(policyMsg.gain, referencePtr->gain, gainDim,
+                    reconstructedMsg.gain, deltaMsg.gain_scale,
+                    deltaMsg.gain_delta);
+      }
+    }  // end of k loop
+    numSinceKeyframe_++;
+
+  } else {
+    numSinceKeyframe_ = 0;
+  }
+
+  history_.emplace_back(deltaMsg.sequence, std::move(reconstructedMsg));
+  if (history_.size() > historySize_) {
+    history_.pop_front();
+  }
+
+  return deltaMsg;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+PolicyDeltaDecoder::PolicyDeltaDecoder(size_t historySize)
+    : historySize_(std::max(historySize, size_t(1))) {}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool PolicyDeltaDecoder::decode(const MpcFlatPolicyDelta& deltaMsg,
+                                MpcFlatPolicy& policyMsg) {
+  const auto& tailMsg = deltaMsg.policy;
+  const size_t N = tailMsg.time_trajectory.size();
+  const size_t numDeltaNodes = deltaMsg.num_delta_nodes;
+  const size_t stateDim = tailMsg.state_dim;
+  const size_t inputDim = tailMsg.input_dim;
+  const size_t gainDim = getGainDim(tailMsg);
+  const size_t numTailNodes = N - std::min(numDeltaNodes, N);
+  if (numDeltaNodes > N ||
+      tailMsg.state_trajectory.size() != numTailNodes * stateDim ||
+      tailMsg.input_trajectory.size() != numTailNodes * inputDim ||
+      tailMsg.feedforward.size() != numTailNodes * inputDim ||
+      tailMsg.gain.size() != numTailNodes * gainDim ||
+      deltaMsg.state_scale.size() != numDeltaNodes ||
+      deltaMsg.state_delta.size() != numDeltaNodes * stateDim ||
+      deltaMsg.input_scale.size() != numDeltaNodes ||
+      deltaMsg.input_delta.size() != numDeltaNodes * inputDim ||
+      deltaMsg.feedforward_scale.size() != numDeltaNodes ||
+      deltaMsg.feedforward_delta.size() != numDeltaNodes * inputDim ||
+      deltaMsg.gain_scale.size() != (gainDim > 0 ? numDeltaNodes : 0) ||
+      deltaMsg.gain_delta.size() != numDeltaNodes * gainDim) {
+    throw std::runtime_error(
+        "[PolicyDeltaDecoder::decode] The message does not match the "
+        "dimensions!");
+  }
+
+  const MpcFlatPolicy* referencePtr = nullptr;
+  if (numDeltaNodes > 0) {
+    const auto it = std::find_if(history_.cbegin(), history_.cend(),
+                                 [&deltaMsg](const auto& entry) {
+                                   return entry.first == deltaMsg.base_sequence;
+                                 });
+    if (it == history_.cend() ||
+        getNumDeltaNodes(tailMsg, it->second) < numDeltaNodes) {
+      return false;
+    }
+    referencePtr = &it->second;
+  }
+
+  MpcFlatPolicy reconstructedMsg;
+  copyHeader(tailMsg, reconstructedMsg);
+
+  // the delta nodes are predicted in front of the tail nodes
+  auto spliceTail = [numDeltaNodes](const std::vector<double>& tail,
+                                    size_t dim, std::vector<double>& data) {
+    data.resize(numDeltaNodes * dim);
+    data.insert(data.end(), tail.begin(), tail.end());
+  };
+  spliceTail(tailMsg.state_trajectory, stateDim,
+             reconstructedMsg.state_trajectory);
+  spliceTail(tailMsg.input_trajectory, inputDim,
+             reconstructedMsg.input_trajectory);
+  spliceTail(tailMsg.feedforward, inputDim, reconstructedMsg.feedforward);
+  spliceTail(tailMsg.gain, gainDim, reconstructedMsg.gain);
+
+  for (size_t k = 0; k < numDeltaNodes; k++) {
+    const auto indexAlpha = LinearInterpolation::timeSegment(
+        tailMsg.time_trajectory[k], referencePtr->time_trajectory);
+
+    auto decodeBlock = [&](const std::vector<double>& referenceData, size_t dim,
+                           const std::vector<double>& scale,
+                           const std::vector<int16_t>& delta,
+                           std::vector<double>& reconstructed) {
+      double* prediction = reconstructed.data() + k * dim;
+      interpolateBlock(indexAlpha, dim, referenceData, prediction);
+      dequantizeBlock(scale[k], delta.data() + k * dim, dim, prediction);
+    };
+    decodeBlock(referencePtr->state_trajectory, stateDim, deltaMsg.state_scale,
+                deltaMsg.state_delta, reconstructedMsg.state_trajectory);
+    decodeBlock(referencePtr->input_trajectory, inputDim, deltaMsg.input_scale,
+                deltaMsg.input_delta, reconstructedMsg.input_trajectory);
+    decodeBlock(referencePtr->feedforward, inputDim, deltaMsg.feedforward_scale,
+                deltaMsg.feedforward_delta, reconstructedMsg.feedforward);
+    if (gainDim > 0) {
+      decodeBlock(referencePtr->gain, gainDim, deltaMsg.gain_scale,
+                  deltaMsg.gain_delta, reconstructedMsg.gain);
+    }
+  }  // end of k loop
+
+  // a restarted encoder reuses the sequence numbers
+  if (numDeltaNodes == 0) {
+    history_.erase(std::remove_if(history_.begin(), history_.end(),
+                                  [&deltaMsg](const auto& entry) {
+                                    return entry.first >= deltaMsg.sequence;
+                                  }),
+                   history_.end());
+  }
+
+  policyMsg = reconstructedMsg;
+  history_.emplace_back(deltaMsg.sequence, std::move(reconstructedMsg));
+  if (history_.size() > historySize_) {
+    history_.pop_front();
+  }
+
+  return true;
+}
+
+}  // namespace ocs2
@@ -29,6 +29,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_ros_interfaces/common/RosMsgConversions.h"
 
+#include <ocs2_core/control/FeedforwardController.h>
+#include <ocs2_core/control/LinearController.h>
+
 namespace ocs2 {
 namespace ros_msg_conversions {
 
@@ -295,5 +298,159 @@ ocs2_msgs::msg::Multiplier createMultiplierMsg(scalar_t time,
   return multiplierMsg;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ocs2_msgs::msg::MpcFlatPolicy createFlatPolicyMsg(
+    const PrimalSolution& primalSolution, const CommandData& commandData,
+    const PerformanceIndex& performanceIndices) {
+  const size_t N = primalSolution.timeTrajectory_.size();
+  if (N == 0 || primalSolution.stateTrajectory_.size() != N ||
+      primalSolution.inputTrajectory_.size() != N) {
+    throw std::runtime_error(
+        "[createFlatPolicyMsg] The primal solution is empty or its "
+        "trajectories have different lengths!");
+  }
+  const size_t stateDim = primalSolution.stateTrajectory_.front().size();
+  const size_t inputDim = primalSolution.inputTrajectory_.front().size();
+
+  ocs2_msgs::msg::MpcFlatPolicy policyMsg;
+  policyMsg.init_observation =
+      createObservationMsg(commandData.mpcInitObservation_);
+  policyMsg.plan_target_trajectories =
+      createTargetTrajectoriesMsg(commandData.mpcTargetTrajectories_);
+  policyMsg.mode_schedule = createModeScheduleMsg(primalSolution.modeSchedule_);
+  policyMsg.performance_indices = createPerformanceIndicesMsg(
+      commandData.mpcInitObservation_.time, performanceIndices);
+
+  policyMsg.state_dim = static_cast<uint32_t>(stateDim);
+  policyMsg.input_dim = static_cast<uint32_t>(inputDim);
+  policyMsg.time_trajectory = primalSolution.timeTrajectory_;
+  policyMsg.post_event_indices.assign(primalSolution.postEventIndices_.begin(),
+                                      primalSolution.postEventIndices_.end());
+
+  // trajectories
+  policyMsg.state_trajectory.resize(N * stateDim);
+  policyMsg.input_trajectory.resize(N * inputDim);
+  for (size_t k = 0; k < N; k++) {
+    if (primalSolution.stateTrajectory_[k].size() != stateDim ||
+        primalSolution.inputTrajectory_[k].size() != inputDim) {
+      throw std::runtime_error(
+          "[createFlatPolicyMsg] The state and input dimensions must be the "
+          "same for all nodes!");
+    }
+    vector_t::Map(&policyMsg.state_trajectory[k * stateDim], stateDim) =
+        primalSolution.stateTrajectory_[k];
+    vector_t::Map(&policyMsg.input_trajectory[k * inputDim], inputDim) =
+        primalSolution.inputTrajectory_[k];
+  }  // end of k loop
+
+  // controller
+  policyMsg.feedforward.resize(N * inputDim);
+  if (const auto* controllerPtr = dynamic_cast<const LinearController*>(
+          primalSolution.controllerPtr_.get())) {
+    policyMsg.controller_type =
+        ocs2_msgs::msg::MpcFlatPolicy::CONTROLLER_LINEAR;
+    policyMsg.gain.resize(N * inputDim * stateDim);
+    vector_t bias;
+    matrix_t gain;
+    for (size_t k = 0; k < N; k++) {
+      controllerPtr->getBias(primalSolution.timeTrajectory_[k], bias);
+      controllerPtr->getFeedbackGain(primalSolution.timeTrajectory_[k], gain);
+      vector_t::Map(&policyMsg.feedforward[k * inputDim], inputDim) = bias;
+      matrix_t::Map(&policyMsg.gain[k * inputDim * stateDim], inputDim,
+                    stateDim) = gain;
+    }  // end of k loop
+  } else if (const auto* controllerPtr =
+                 dynamic_cast<const FeedforwardController*>(
+                     primalSolution.controllerPtr_.get())) {
+    policyMsg.controller_type =
+        ocs2_msgs::msg::MpcFlatPolicy::CONTROLLER_FEEDFORWARD;
+    for (size_t k = 0; k < N; k++) {
+      vector_t::Map(&policyMsg.feedforward[k * inputDim], inputDim) =
+          LinearInterpolation::interpolate(primalSolution.timeTrajectory_[k],
+                                           controllerPtr->timeStamp_,
+                                           controllerPtr->uffArray_);
+    }  // end of k loop
+  } else {
+    throw std::runtime_error(
+        "[createFlatPolicyMsg] Unknown ControllerType!");
+  }
+
+  return policyMsg;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void readFlatPolicyMsg(const ocs2_msgs::msg::MpcFlatPolicy& policyMsg,
+                       CommandData& commandData, PrimalSolution& primalSolution,
+                       PerformanceIndex& performanceIndices) {
+  const size_t N = policyMsg.time_trajectory.size();
+  const size_t stateDim = policyMsg.state_dim;
+  const size_t inputDim = policyMsg.input_dim;
+  if (N == 0) {
+    throw std::runtime_error(
+        "[readFlatPolicyMsg] controller message is empty!");
+  }
+  if (policyMsg.state_trajectory.size() != N * stateDim ||
+      policyMsg.input_trajectory.size() != N * inputDim ||
+      policyMsg.feedforward.size() != N * inputDim) {
+    throw std::runtime_error(
+        "[readFlatPolicyMsg] The trajectories do not match the dimensions!");
+  }
+
+  commandData.mpcInitObservation_ =
+      readObservationMsg(policyMsg.init_observation);
+  commandData.mpcTargetTrajectories_ =
+      readTargetTrajectoriesMsg(policyMsg.plan_target_trajectories);
+  performanceIndices = readPerformanceIndicesMsg(policyMsg.performance_indices);
+
+  primalSolution.clear();
+  primalSolution.modeSchedule_ = readModeScheduleMsg(policyMsg.mode_schedule);
+  primalSolution.timeTrajectory_ = policyMsg.time_trajectory;
+  primalSolution.postEventIndices_.assign(policyMsg.post_event_indices.begin(),
+                                          policyMsg.post_event_indices.end());
+
+  primalSolution.stateTrajectory_.reserve(N);
+  primalSolution.inputTrajectory_.reserve(N);
+  vector_array_t bias;
+  bias.reserve(N);
+  for (size_t k = 0; k < N; k++) {
+    primalSolution.stateTrajectory_.emplace_back(
+        vector_t::Map(&policyMsg.state_trajectory[k * stateDim], stateDim));
+    primalSolution.inputTrajectory_.emplace_back(
+        vector_t::Map(&policyMsg.input_trajectory[k * inputDim], inputDim));
+    bias.emplace_back(
+        vector_t::Map(&policyMsg.feedforward[k * inputDim], inputDim));
+  }  // end of k loop
+
+  // instantiate the correct controller
+  switch (policyMsg.controller_type) {
+    case ocs2_msgs::msg::MpcFlatPolicy::CONTROLLER_FEEDFORWARD: {
+      primalSolution.controllerPtr_.reset(new FeedforwardController(
+          primalSolution.timeTrajectory_, std::move(bias)));
+      break;
+    }
+    case ocs2_msgs::msg::MpcFlatPolicy::CONTROLLER_LINEAR: {
+      if (policyMsg.gain.size() != N * inputDim * stateDim) {
+        throw std::runtime_error(
+            "[readFlatPolicyMsg] The gains do not match the dimensions!");
+      }
+      matrix_array_t gain;
+      gain.reserve(N);
+      for (size_t k = 0; k < N; k++) {
+        gain.emplace_back(matrix_t::Map(
+            &policyMsg.gain[k * inputDim * stateDim], inputDim, stateDim));
+      }  // end of k loop
+      primalSolution.controllerPtr_.reset(new LinearController(
+          primalSolution.timeTrajectory_, std::move(bias), std::move(gain)));
+      break;
+    }
+    default:
+      throw std::runtime_error("[readFlatPolicyMsg] Unknown controllerType!");
+  }
+}
+
 }  // namespace ros_msg_conversions
 }  // namespace ocs2
@@ -47,6 +47,12 @@ MPC_ROS_Interface::MPC_ROS_Interface(MPC_BASE& mpc, std::string topicPrefix)
       publisherCommandPtr_(new CommandData()),
       bufferPerformanceIndicesPtr_(new PerformanceIndex),
       publisherPerformanceIndicesPtr_(new PerformanceIndex) {
+  mpc_.setIntermediateSolutionCallback(
+      [this](const PrimalSolution& primalSolution,
+             const PerformanceIndex& performanceIndex) {
+        publishIntermediateSolution(primalSolution, performanceIndex);
+      });
+
   // start thread for publishing
 #ifdef PUBLISH_THREAD
   publisherWorker_ = std::thread(&MPC_ROS_Interface::publisherWorker, this);
@@ -56,7 +62,10 @@ MPC_ROS_Interface::MPC_ROS_Interface(MPC_BASE& mpc, std::string topicPrefix)
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-MPC_ROS_Interface::~MPC_ROS_Interface() { shutdownNode(); }
+MPC_ROS_Interface::~MPC_ROS_Interface() {
+  mpc_.setIntermediateSolutionCallback(nullptr);
+  shutdownNode();
+}
 
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -68,6 +77,10 @@ void MPC_ROS_Interface::resetMpcNode(
   mpc_.getSolverPtr()->getReferenceManager().setTargetTrajectories(
       std::move(initTargetTrajectories));
   mpcTimer_.reset();
+  // the policies before the reset are no valid references
+  if (policyDeltaEncoderPtr_ != nullptr) {
+    policyDeltaEncoderPtr_->reset();
+  }
   resetRequestedEver_ = true;
   terminateThread_ = false;
   readyToPublish_ = false;
@@ -209,12 +222,9 @@ void MPC_ROS_Interface::publisherWorker() {
       publisherPerformanceIndicesPtr_.swap(bufferPerformanceIndicesPtr_);
     }
 
-    ocs2_msgs::msg::MpcFlattenedController mpcPolicyMsg =
-        createMpcPolicyMsg(*publisherPrimalSolutionPtr_, *publisherCommandPtr_,
-                           *publisherPerformanceIndicesPtr_);
-
     // publish the message
-    mpcPolicyPublisher_->publish(mpcPolicyMsg);
+    publishPolicy(*publisherCommandPtr_, *publisherPrimalSolutionPtr_,
+                  *publisherPerformanceIndicesPtr_);
 
     readyToPublish_ = false;
     lk.unlock();
@@ -222,6 +232,39 @@ void MPC_ROS_Interface::publisherWorker() {
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MPC_ROS_Interface::publishPolicy(
+    const CommandData& commandData, const PrimalSolution& primalSolution,
+    const PerformanceIndex& performanceIndices) {
+  // same-host MRTs read the policy without serialization
+  if (sharedPolicyWriterPtr_ != nullptr) {
+    try {
+      sharedPolicyWriterPtr_->write(commandData, primalSolution,
+                                    performanceIndices);
+    } catch (const std::runtime_error& error) {
+      // the policy does not fit into the segment, the ROS message still
+      // carries it
+      RCLCPP_WARN_STREAM(LOGGER,
+                         "[MPC_ROS_Interface] Skipped the shared-memory policy: "
+                             << error.what());
+    }
+  }
+
+  if (policyDeltaEncoderPtr_ != nullptr) {
+    mpcPolicyDeltaPublisher_->publish(
+        policyDeltaEncoderPtr_->encode(ros_msg_conversions::createFlatPolicyMsg(
+            primalSolution, commandData, performanceIndices)));
+  } else if (useFlatPolicyMsg_) {
+    mpcFlatPolicyPublisher_->publish(ros_msg_conversions::createFlatPolicyMsg(
+        primalSolution, commandData, performanceIndices));
+  } else {
+    mpcPolicyPublisher_->publish(
+        createMpcPolicyMsg(primalSolution, commandData, performanceIndices));
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -248,6 +291,40 @@ void MPC_ROS_Interface::copyToBuffer(
   *bufferPerformanceIndicesPtr_ = mpc_.getSolverPtr()->getPerformanceIndeces();
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MPC_ROS_Interface::publishIntermediateSolution(
+    const PrimalSolution& primalSolution,
+    const PerformanceIndex& performanceIndex) {
+  {
+    std::lock_guard<std::mutex> policyBufferLock(bufferMutex_);
+    *bufferPrimalSolutionPtr_ = primalSolution;
+    bufferCommandPtr_->mpcInitObservation_ = mpcInitObservation_;
+    bufferCommandPtr_->mpcTargetTrajectories_ =
+        mpc_.getSolverPtr()->getReferenceManager().getTargetTrajectories();
+    *bufferPerformanceIndicesPtr_ = performanceIndex;
+  }
+
+  publishBuffer();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MPC_ROS_Interface::publishBuffer() {
+#ifdef PUBLISH_THREAD
+  std::unique_lock<std::mutex> lk(publisherMutex_);
+  readyToPublish_ = true;
+  lk.unlock();
+  msgReady_.notify_one();
+
+#else
+  publishPolicy(*bufferCommandPtr_, *bufferPrimalSolutionPtr_,
+                *bufferPerformanceIndicesPtr_);
+#endif
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -263,7 +340,8 @@ void MPC_ROS_Interface::mpcObservationCallback(
   }
 
   // current time, state, input, and subsystem
-  const auto currentObservation = ros_msg_conversions::readObservationMsg(*msg);
+  mpcInitObservation_ = ros_msg_conversions::readObservationMsg(*msg);
+  const SystemObservation& currentObservation = mpcInitObservation_;
 
   // measure the delay in running MPC
   mpcTimer_.startTimer();
@@ -302,18 +380,10 @@ void MPC_ROS_Interface::mpcObservationCallback(
               << std::endl;
   }
 
-#ifdef PUBLISH_THREAD
-  std::unique_lock<std::mutex> lk(publisherMutex_);
-  readyToPublish_ = true;
-  lk.unlock();
-  msgReady_.notify_one();
+  publishBuffer();
 
-#else
-  ocs2_msgs::msg::MpcFlattenedController mpcPolicyMsg =
-      createMpcPolicyMsg(*bufferPrimalSolutionPtr_, *bufferCommandPtr_,
-                         *bufferPerformanceIndicesPtr_);
-  mpcPolicyPublisher_.publish(mpcPolicyMsg);
-#endif
+  // prepare the next run while the policy is tracked
+  mpc_.prepareNextRun();
 }
 
 /******************************************************************************************************/
@@ -348,6 +418,32 @@ void MPC_ROS_Interface::spin() {
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MPC_ROS_Interface::enableSharedMemoryTransport(
+    const SharedPolicyDimensions& dimensions) {
+  const auto segmentName = getSharedPolicySegmentName(topicPrefix_);
+  sharedPolicyWriterPtr_.reset(
+      new SharedPolicyWriter(segmentName, dimensions));
+  RCLCPP_INFO_STREAM(LOGGER, "Publishing the MPC policy in shared memory "
+                                 << segmentName << ".");
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MPC_ROS_Interface::enableFlatPolicyMsg() {
+  useFlatPolicyMsg_ = true;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MPC_ROS_Interface::enableIncrementalPolicyMsg(size_t keyframeInterval) {
+  policyDeltaEncoderPtr_.reset(new PolicyDeltaEncoder(keyframeInterval));
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -363,9 +459,25 @@ void MPC_ROS_Interface::launchNodes(const rclcpp::Node::SharedPtr& node) {
                     std::placeholders::_1));
 
   // MPC publisher
-  mpcPolicyPublisher_ =
-      node_->create_publisher<ocs2_msgs::msg::MpcFlattenedController>(
-          topicPrefix_ + "_mpc_policy", 1);
+  if (policyDeltaEncoderPtr_ != nullptr) {
+    mpcPolicyDeltaPublisher_ =
+        node_->create_publisher<ocs2_msgs::msg::MpcFlatPolicyDelta>(
+            topicPrefix_ + "_mpc_policy_delta", 1);
+    mpcPolicyAckSubscriber_ =
+        node_->create_subscription<std_msgs::msg::UInt64>(
+            topicPrefix_ + "_mpc_policy_ack", 1,
+            [this](const std_msgs::msg::UInt64::ConstSharedPtr& msg) {
+              policyDeltaEncoderPtr_->acknowledge(msg->data);
+            });
+  } else if (useFlatPolicyMsg_) {
+    mpcFlatPolicyPublisher_ =
+        node_->create_publisher<ocs2_msgs::msg::MpcFlatPolicy>(
+            topicPrefix_ + "_mpc_flat_policy", 1);
+  } else {
+    mpcPolicyPublisher_ =
+        node_->create_publisher<ocs2_msgs::msg::MpcFlattenedController>(
+            topicPrefix_ + "_mpc_policy", 1);
+  }
 
   // MPC reset service server
   mpcResetServiceServer_ = node_->create_service<ocs2_msgs::srv::Reset>(
@@ -228,6 +228,49 @@ void MRT_ROS_Interface::mpcPolicyCallback(
                      std::move(performanceIndicesPtr));
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MRT_ROS_Interface::mpcFlatPolicyCallback(
+    const ocs2_msgs::msg::MpcFlatPolicy::ConstSharedPtr& msg) {
+  // read new policy and command from msg
+  auto commandPtr = std::make_unique<CommandData>();
+  auto primalSolutionPtr = std::make_unique<PrimalSolution>();
+  auto performanceIndicesPtr = std::make_unique<PerformanceIndex>();
+  ros_msg_conversions::readFlatPolicyMsg(*msg, *commandPtr, *primalSolutionPtr,
+                                         *performanceIndicesPtr);
+
+  this->moveToBuffer(std::move(commandPtr), std::move(primalSolutionPtr),
+                     std::move(performanceIndicesPtr));
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MRT_ROS_Interface::mpcPolicyDeltaCallback(
+    const ocs2_msgs::msg::MpcFlatPolicyDelta::ConstSharedPtr& msg) {
+  // the reference of the update is not available, wait for the next one
+  ocs2_msgs::msg::MpcFlatPolicy policyMsg;
+  if (!policyDeltaDecoder_.decode(*msg, policyMsg)) {
+    return;
+  }
+
+  std_msgs::msg::UInt64 ackMsg;
+  ackMsg.data = msg->sequence;
+  mpcPolicyAckPublisher_->publish(ackMsg);
+
+  // read new policy and command from msg
+  auto commandPtr = std::make_unique<CommandData>();
+  auto primalSolutionPtr = std::make_unique<PrimalSolution>();
+  auto performanceIndicesPtr = std::make_unique<PerformanceIndex>();
+  ros_msg_conversions::readFlatPolicyMsg(policyMsg, *commandPtr,
+                                         *primalSolutionPtr,
+                                         *performanceIndicesPtr);
+
+  this->moveToBuffer(std::move(commandPtr), std::move(primalSolutionPtr),
+                     std::move(performanceIndicesPtr));
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -265,8 +308,42 @@ void MRT_ROS_Interface::shutdownPublisher() {
 void MRT_ROS_Interface::spinMRT() {
   // callback_executor_.spin_once();
   rclcpp::spin_some(node_);
+  if (useSharedMemoryTransport_) {
+    readSharedPolicy();
+  }
 };
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MRT_ROS_Interface::readSharedPolicy() {
+  // follow a restarted MPC node
+  if (sharedPolicyReaderPtr_ != nullptr &&
+      sharedPolicyReaderPtr_->isWriterClosed()) {
+    sharedPolicyReaderPtr_.reset();
+  }
+
+  if (sharedPolicyReaderPtr_ == nullptr) {
+    try {
+      sharedPolicyReaderPtr_.reset(
+          new SharedPolicyReader(getSharedPolicySegmentName(topicPrefix_)));
+    } catch (const std::runtime_error&) {
+      return;  // the MPC node has not created the segment yet
+    }
+  }
+
+  if (sharedPolicyReaderPtr_->hasNewPolicy()) {
+    auto commandPtr = std::make_unique<CommandData>();
+    auto primalSolutionPtr = std::make_unique<PrimalSolution>();
+    auto performanceIndicesPtr = std::make_unique<PerformanceIndex>();
+    if (sharedPolicyReaderPtr_->read(*commandPtr, *primalSolutionPtr,
+                                     *performanceIndicesPtr)) {
+      this->moveToBuffer(std::move(commandPtr), std::move(primalSolutionPtr),
+                         std::move(performanceIndicesPtr));
+    }
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -281,13 +358,33 @@ void MRT_ROS_Interface::launchNodes(const rclcpp::Node::SharedPtr& node) {
       node_->create_publisher<ocs2_msgs::msg::MpcObservation>(
           topicPrefix_ + "_mpc_observation", 1);
 
-  // policy subscriber
-  mpcPolicySubscriber_ =
-      node_->create_subscription<ocs2_msgs::msg::MpcFlattenedController>(
-          topicPrefix_ + "_mpc_policy",  // topic name
-          1,                             // queue length
-          std::bind(&MRT_ROS_Interface::mpcPolicyCallback, this,
-                    std::placeholders::_1));
+  // policy subscriber, unless the policy is read from shared memory
+  if (useSharedMemoryTransport_) {
+    // the policy is polled in spinMRT()
+  } else if (useIncrementalPolicyMsg_) {
+    mpcPolicyDeltaSubscriber_ =
+        node_->create_subscription<ocs2_msgs::msg::MpcFlatPolicyDelta>(
+            topicPrefix_ + "_mpc_policy_delta",  // topic name
+            1,                                   // queue length
+            std::bind(&MRT_ROS_Interface::mpcPolicyDeltaCallback, this,
+                      std::placeholders::_1));
+    mpcPolicyAckPublisher_ = node_->create_publisher<std_msgs::msg::UInt64>(
+        topicPrefix_ + "_mpc_policy_ack", 1);
+  } else if (useFlatPolicyMsg_) {
+    mpcFlatPolicySubscriber_ =
+        node_->create_subscription<ocs2_msgs::msg::MpcFlatPolicy>(
+            topicPrefix_ + "_mpc_flat_policy",  // topic name
+            1,                                  // queue length
+            std::bind(&MRT_ROS_Interface::mpcFlatPolicyCallback, this,
+                      std::placeholders::_1));
+  } else {
+    mpcPolicySubscriber_ =
+        node_->create_subscription<ocs2_msgs::msg::MpcFlattenedController>(
+            topicPrefix_ + "_mpc_policy",  // topic name
+            1,                             // queue length
+            std::bind(&MRT_ROS_Interface::mpcPolicyCallback, this,
+                      std::placeholders::_1));
+  }
 
   // MPC reset service client
   mpcResetServiceClient_ =
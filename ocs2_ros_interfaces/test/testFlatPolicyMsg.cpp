@@ -0,0 +1,235 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <ocs2_core/control/FeedforwardController.h>
+#include <ocs2_core/control/LinearController.h>
+
+#include "ocs2_ros_interfaces/common/RosMsgConversions.h"
+
+using namespace ocs2;
+
+namespace {
+constexpr size_t stateDim = 3;
+constexpr size_t inputDim = 2;
+constexpr size_t numNodes = 10;
+// the observation, the target trajectories and the performance indices are
+// sent in single precision
+constexpr scalar_t floatPrecision = 1e-6;
+
+CommandData getCommandData() {
+  CommandData commandData;
+  commandData.mpcInitObservation_.time = 0.1;
+  commandData.mpcInitObservation_.mode = 1;
+  commandData.mpcInitObservation_.state = vector_t::Random(stateDim);
+  commandData.mpcInitObservation_.input = vector_t::Random(inputDim);
+  commandData.mpcTargetTrajectories_ = TargetTrajectories(
+      {0.0, 1.0}, {vector_t::Random(stateDim), vector_t::Random(stateDim)},
+      {vector_t::Random(inputDim), vector_t::Random(inputDim)});
+  return commandData;
+}
+
+PerformanceIndex getPerformanceIndices() {
+  PerformanceIndex performanceIndices;
+  performanceIndices.merit = 1.5;
+  performanceIndices.cost = 2.5;
+  performanceIndices.dynamicsViolationSSE = 0.25;
+  return performanceIndices;
+}
+
+/** A primal solution with two events, without the controller. */
+PrimalSolution getPrimalSolution() {
+  PrimalSolution primalSolution;
+  for (size_t k = 0; k < numNodes; ++k) {
+    primalSolution.timeTrajectory_.push_back(0.1 * k);
+    primalSolution.stateTrajectory_.push_back(vector_t::Random(stateDim));
+    primalSolution.inputTrajectory_.push_back(vector_t::Random(inputDim));
+  }
+  primalSolution.modeSchedule_ = ModeSchedule({0.25, 0.55}, {0, 1, 2});
+  primalSolution.postEventIndices_ = {3, 6};
+  return primalSolution;
+}
+
+void compareCommonData(const CommandData& commandData,
+                       const PrimalSolution& primalSolution,
+                       const PerformanceIndex& performanceIndices,
+                       const CommandData& readCommandData,
+                       const PrimalSolution& readPrimalSolution,
+                       const PerformanceIndex& readPerformanceIndices) {
+  // the trajectories are sent in double precision
+  EXPECT_EQ(readPrimalSolution.timeTrajectory_, primalSolution.timeTrajectory_);
+  EXPECT_EQ(readPrimalSolution.stateTrajectory_,
+            primalSolution.stateTrajectory_);
+  EXPECT_EQ(readPrimalSolution.inputTrajectory_,
+            primalSolution.inputTrajectory_);
+  EXPECT_EQ(readPrimalSolution.postEventIndices_,
+            primalSolution.postEventIndices_);
+
+  // mode schedule
+  EXPECT_EQ(readPrimalSolution.modeSchedule_.eventTimes,
+            primalSolution.modeSchedule_.eventTimes);
+  EXPECT_EQ(readPrimalSolution.modeSchedule_.modeSequence,
+            primalSolution.modeSchedule_.modeSequence);
+
+  // command data
+  const auto& observation = commandData.mpcInitObservation_;
+  const auto& readObservation = readCommandData.mpcInitObservation_;
+  EXPECT_DOUBLE_EQ(readObservation.time, observation.time);
+  EXPECT_EQ(readObservation.mode, observation.mode);
+  EXPECT_TRUE(
+      readObservation.state.isApprox(observation.state, floatPrecision));
+  EXPECT_TRUE(
+      readObservation.input.isApprox(observation.input, floatPrecision));
+  const auto& targetTrajectories = commandData.mpcTargetTrajectories_;
+  const auto& readTargetTrajectories = readCommandData.mpcTargetTrajectories_;
+  ASSERT_EQ(readTargetTrajectories.size(), targetTrajectories.size());
+  for (size_t i = 0; i < targetTrajectories.size(); ++i) {
+    EXPECT_NEAR(readTargetTrajectories.timeTrajectory[i],
+                targetTrajectories.timeTrajectory[i], floatPrecision);
+    EXPECT_TRUE(readTargetTrajectories.stateTrajectory[i].isApprox(
+        targetTrajectories.stateTrajectory[i], floatPrecision));
+    EXPECT_TRUE(readTargetTrajectories.inputTrajectory[i].isApprox(
+        targetTrajectories.inputTrajectory[i], floatPrecision));
+  }
+
+  // performance indices
+  EXPECT_NEAR(readPerformanceIndices.merit, performanceIndices.merit,
+              floatPrecision);
+  EXPECT_NEAR(readPerformanceIndices.cost, performanceIndices.cost,
+              floatPrecision);
+  EXPECT_NEAR(readPerformanceIndices.dynamicsViolationSSE,
+              performanceIndices.dynamicsViolationSSE, floatPrecision);
+}
+}  // unnamed namespace
+
+TEST(testFlatPolicyMsg, linearController) {
+  const auto commandData = getCommandData();
+  const auto performanceIndices = getPerformanceIndices();
+  auto primalSolution = getPrimalSolution();
+  vector_array_t biasArray(numNodes);
+  matrix_array_t gainArray(numNodes);
+  for (size_t k = 0; k < numNodes; ++k) {
+    biasArray[k].setRandom(inputDim);
+    gainArray[k].setRandom(inputDim, stateDim);
+  }
+  primalSolution.controllerPtr_.reset(new LinearController(
+      primalSolution.timeTrajectory_, biasArray, gainArray));
+
+  const auto policyMsg = ros_msg_conversions::createFlatPolicyMsg(
+      primalSolution, commandData, performanceIndices);
+  EXPECT_EQ(policyMsg.controller_type,
+            ocs2_msgs::msg::MpcFlatPolicy::CONTROLLER_LINEAR);
+  EXPECT_EQ(policyMsg.state_trajectory.size(), numNodes * stateDim);
+  EXPECT_EQ(policyMsg.gain.size(), numNodes * inputDim * stateDim);
+
+  CommandData readCommandData;
+  PrimalSolution readPrimalSolution;
+  PerformanceIndex readPerformanceIndices;
+  ros_msg_conversions::readFlatPolicyMsg(policyMsg, readCommandData,
+                                         readPrimalSolution,
+                                         readPerformanceIndices);
+  compareCommonData(commandData, primalSolution, performanceIndices,
+                    readCommandData, readPrimalSolution,
+                    readPerformanceIndices);
+
+  const auto* readControllerPtr = dynamic_cast<const LinearController*>(
+      readPrimalSolution.controllerPtr_.get());
+  ASSERT_NE(readControllerPtr, nullptr);
+  EXPECT_EQ(readControllerPtr->timeStamp_, primalSolution.timeTrajectory_);
+  EXPECT_EQ(readControllerPtr->biasArray_, biasArray);
+  EXPECT_EQ(readControllerPtr->gainArray_, gainArray);
+}
+
+TEST(testFlatPolicyMsg, feedforwardController) {
+  const auto commandData = getCommandData();
+  const auto performanceIndices = getPerformanceIndices();
+  auto primalSolution = getPrimalSolution();
+
+  // the controller has its own time stamps and is sampled at the nodes
+  scalar_array_t timeStamp{0.0, 1.0};
+  vector_array_t uffArray{vector_t::Zero(inputDim),
+                          vector_t::Constant(inputDim, 1.0)};
+  primalSolution.controllerPtr_.reset(
+      new FeedforwardController(timeStamp, uffArray));
+
+  const auto policyMsg = ros_msg_conversions::createFlatPolicyMsg(
+      primalSolution, commandData, performanceIndices);
+  EXPECT_EQ(policyMsg.controller_type,
+            ocs2_msgs::msg::MpcFlatPolicy::CONTROLLER_FEEDFORWARD);
+  EXPECT_TRUE(policyMsg.gain.empty());
+
+  CommandData readCommandData;
+  PrimalSolution readPrimalSolution;
+  PerformanceIndex readPerformanceIndices;
+  ros_msg_conversions::readFlatPolicyMsg(policyMsg, readCommandData,
+                                         readPrimalSolution,
+                                         readPerformanceIndices);
+  compareCommonData(commandData, primalSolution, performanceIndices,
+                    readCommandData, readPrimalSolution,
+                    readPerformanceIndices);
+
+  const auto* readControllerPtr = dynamic_cast<const FeedforwardController*>(
+      readPrimalSolution.controllerPtr_.get());
+  ASSERT_NE(readControllerPtr, nullptr);
+  EXPECT_EQ(readControllerPtr->timeStamp_, primalSolution.timeTrajectory_);
+  for (size_t k = 0; k < numNodes; ++k) {
+    const scalar_t t = primalSolution.timeTrajectory_[k];
+    EXPECT_TRUE(readControllerPtr->uffArray_[k].isApprox(
+        vector_t::Constant(inputDim, t)))
+        << "node " << k;
+  }
+}
+
+TEST(testFlatPolicyMsg, inconsistentDimensions) {
+  const auto commandData = getCommandData();
+  const auto performanceIndices = getPerformanceIndices();
+  auto primalSolution = getPrimalSolution();
+  primalSolution.controllerPtr_.reset(new FeedforwardController(
+      primalSolution.timeTrajectory_, primalSolution.inputTrajectory_));
+
+  // all nodes must have the same dimensions
+  primalSolution.stateTrajectory_.back() = vector_t::Random(stateDim + 1);
+  EXPECT_THROW(ros_msg_conversions::createFlatPolicyMsg(
+                   primalSolution, commandData, performanceIndices),
+               std::runtime_error);
+
+  // a message whose arrays do not match the dimensions is rejected
+  primalSolution.stateTrajectory_.back() = vector_t::Random(stateDim);
+  auto policyMsg = ros_msg_conversions::createFlatPolicyMsg(
+      primalSolution, commandData, performanceIndices);
+  policyMsg.state_trajectory.pop_back();
+  CommandData readCommandData;
+  PrimalSolution readPrimalSolution;
+  PerformanceIndex readPerformanceIndices;
+  EXPECT_THROW(ros_msg_conversions::readFlatPolicyMsg(
+                   policyMsg, readCommandData, readPrimalSolution,
+                   readPerformanceIndices),
+               std::runtime_error);
+}
@@ -0,0 +1,179 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "ocs2_ros_interfaces/common/PolicyDeltaCodec.h"
+
+using namespace ocs2;
+
+namespace {
+constexpr size_t stateDim = 3;
+constexpr size_t inputDim = 2;
+constexpr size_t numNodes = 20;
+constexpr double timeStep = 0.05;
+// the quantization error of a delta node is at most half a step of the
+// int16 range over the largest deviation from the prediction
+constexpr double quantizationPrecision = 1e-4;
+
+/** A linear policy of smooth trajectories over [initTime, initTime + 1). */
+ocs2_msgs::msg::MpcFlatPolicy getPolicyMsg(double initTime) {
+  ocs2_msgs::msg::MpcFlatPolicy policyMsg;
+  policyMsg.controller_type = ocs2_msgs::msg::MpcFlatPolicy::CONTROLLER_LINEAR;
+  policyMsg.state_dim = stateDim;
+  policyMsg.input_dim = inputDim;
+  for (size_t k = 0; k < numNodes; k++) {
+    const double t = initTime + k * timeStep;
+    policyMsg.time_trajectory.push_back(t);
+    for (size_t j = 0; j < stateDim; j++) {
+      policyMsg.state_trajectory.push_back(std::sin(t + j));
+    }
+    for (size_t j = 0; j < inputDim; j++) {
+      policyMsg.input_trajectory.push_back(std::cos(t + j));
+      policyMsg.feedforward.push_back(2.0 * std::cos(t + j));
+    }
+    for (size_t j = 0; j < inputDim * stateDim; j++) {
+      policyMsg.gain.push_back(std::sin(2.0 * t + j));
+    }
+  }
+  return policyMsg;
+}
+
+void expectNear(const std::vector<double>& lhs, const std::vector<double>& rhs,
+                double precision) {
+  ASSERT_EQ(lhs.size(), rhs.size());
+  for (size_t i = 0; i < lhs.size(); i++) {
+    EXPECT_NEAR(lhs[i], rhs[i], precision) << "entry " << i;
+  }
+}
+
+void expectNear(const ocs2_msgs::msg::MpcFlatPolicy& lhs,
+                const ocs2_msgs::msg::MpcFlatPolicy& rhs, double precision) {
+  EXPECT_EQ(lhs.controller_type, rhs.controller_type);
+  EXPECT_EQ(lhs.time_trajectory, rhs.time_trajectory);
+  expectNear(lhs.state_trajectory, rhs.state_trajectory, precision);
+  expectNear(lhs.input_trajectory, rhs.input_trajectory, precision);
+  expectNear(lhs.feedforward, rhs.feedforward, precision);
+  expectNear(lhs.gain, rhs.gain, precision);
+}
+}  // unnamed namespace
+
+TEST(testPolicyDeltaCodec, keyframe) {
+  PolicyDeltaEncoder encoder;
+  PolicyDeltaDecoder decoder;
+
+  // without an acknowledged reference, the policy is sent in full precision
+  const auto policyMsg = getPolicyMsg(0.0);
+  const auto deltaMsg = encoder.encode(policyMsg);
+  EXPECT_EQ(deltaMsg.num_delta_nodes, 0);
+  EXPECT_EQ(deltaMsg.base_sequence, deltaMsg.sequence);
+  EXPECT_TRUE(deltaMsg.state_delta.empty());
+
+  ocs2_msgs::msg::MpcFlatPolicy decodedMsg;
+  ASSERT_TRUE(decoder.decode(deltaMsg, decodedMsg));
+  expectNear(decodedMsg, policyMsg, 0.0);
+}
+
+TEST(testPolicyDeltaCodec, delta) {
+  PolicyDeltaEncoder encoder;
+  PolicyDeltaDecoder decoder;
+
+  ocs2_msgs::msg::MpcFlatPolicy decodedMsg;
+  const auto keyframeMsg = encoder.encode(getPolicyMsg(0.0));
+  ASSERT_TRUE(decoder.decode(keyframeMsg, decodedMsg));
+  encoder.acknowledge(keyframeMsg.sequence);
+
+  // the shifted horizon overlaps with the reference except for the new tail
+  const size_t shift = 5;
+  const auto policyMsg = getPolicyMsg(shift * timeStep);
+  const auto deltaMsg = encoder.encode(policyMsg);
+  EXPECT_EQ(deltaMsg.base_sequence, keyframeMsg.sequence);
+  EXPECT_EQ(deltaMsg.num_delta_nodes, numNodes - shift);
+  EXPECT_EQ(deltaMsg.policy.state_trajectory.size(), shift * stateDim);
+  EXPECT_EQ(deltaMsg.state_delta.size(), (numNodes - shift) * stateDim);
+  EXPECT_EQ(deltaMsg.gain_delta.size(),
+            (numNodes - shift) * inputDim * stateDim);
+
+  ASSERT_TRUE(decoder.decode(deltaMsg, decodedMsg));
+  expectNear(decodedMsg, policyMsg, quantizationPrecision);
+
+  // an update whose reference the decoder does not have is dropped
+  PolicyDeltaDecoder freshDecoder;
+  EXPECT_FALSE(freshDecoder.decode(deltaMsg, decodedMsg));
+}
+
+TEST(testPolicyDeltaCodec, keyframeInterval) {
+  constexpr size_t keyframeInterval = 3;
+  PolicyDeltaEncoder encoder(keyframeInterval);
+  PolicyDeltaDecoder decoder;
+
+  ocs2_msgs::msg::MpcFlatPolicy decodedMsg;
+  for (size_t i = 0; i < 2 * (keyframeInterval + 1); i++) {
+    const auto policyMsg = getPolicyMsg(i * timeStep);
+    const auto deltaMsg = encoder.encode(policyMsg);
+    const bool isKeyframe = (i % (keyframeInterval + 1) == 0);
+    EXPECT_EQ(deltaMsg.num_delta_nodes == 0, isKeyframe) << "message " << i;
+    ASSERT_TRUE(decoder.decode(deltaMsg, decodedMsg));
+    expectNear(decodedMsg, policyMsg, quantizationPrecision);
+    encoder.acknowledge(deltaMsg.sequence);
+  }
+}
+
+TEST(testPolicyDeltaCodec, reset) {
+  PolicyDeltaEncoder encoder;
+  PolicyDeltaDecoder decoder;
+
+  ocs2_msgs::msg::MpcFlatPolicy decodedMsg;
+  const auto keyframeMsg = encoder.encode(getPolicyMsg(0.0));
+  ASSERT_TRUE(decoder.decode(keyframeMsg, decodedMsg));
+  encoder.acknowledge(keyframeMsg.sequence);
+
+  // after a reset, e.g. of the MPC, the acknowledged policy is no reference
+  encoder.reset();
+  const auto policyMsg = getPolicyMsg(timeStep);
+  const auto deltaMsg = encoder.encode(policyMsg);
+  EXPECT_EQ(deltaMsg.num_delta_nodes, 0);
+  EXPECT_GT(deltaMsg.sequence, keyframeMsg.sequence);
+
+  // a decoder that missed the policies before the reset follows as well
+  PolicyDeltaDecoder freshDecoder;
+  ASSERT_TRUE(freshDecoder.decode(deltaMsg, decodedMsg));
+  expectNear(decodedMsg, policyMsg, 0.0);
+
+  // the updates after the reset are encoded against the new keyframe
+  encoder.acknowledge(deltaMsg.sequence);
+  const auto nextPolicyMsg = getPolicyMsg(2.0 * timeStep);
+  const auto nextDeltaMsg = encoder.encode(nextPolicyMsg);
+  EXPECT_EQ(nextDeltaMsg.base_sequence, deltaMsg.sequence);
+  EXPECT_GT(nextDeltaMsg.num_delta_nodes, 0);
+  ASSERT_TRUE(freshDecoder.decode(nextDeltaMsg, decodedMsg));
+  expectNear(decodedMsg, nextPolicyMsg, quantizationPrecision);
+}
@@ -56,6 +56,10 @@ struct Settings {
 
   // Discretization method
   scalar_t dt = 0.01;  // user-defined time discretization
+  // Non-uniform discretization: the step is dt at the initial time and around the events, and grows geometrically with dtGrowthRate
+  // away from them, up to dtMax. A growth rate of 1.0 gives the uniform discretization.
+  scalar_t dtGrowthRate = 1.0;
+  scalar_t dtMax = 0.1;
   SensitivityIntegratorType integratorType = SensitivityIntegratorType::RK2;
 
   // Inequality penalty relaxed barrier parameters
@@ -73,6 +77,8 @@ struct Settings {
   // Threading
   size_t nThreads = 4;
   int threadPriority = 50;
+  std::string threadAffinity;                     // CPUs of the worker threads in cpulist format, e.g. "0-3,8". Empty to not pin them
+  std::vector<std::string> workerThreadAffinity;  // CPUs per worker index in cpulist format, a non-empty entry overrides threadAffinity
 
   // LP subproblem solver settings
   pipg::Settings pipgSettings = pipg::Settings();
@@ -112,8 +112,9 @@ class SlpSolver : public SolverBase {
     runImpl(initTime, initState, finalTime);
   }
 
-  /** Run a task in parallel with settings.nThreads */
-  void runParallel(std::function<void(int)> taskFunction);
+  /** Run taskFunction(workerId, i) for every node i in [begin, end) in parallel with settings.nThreads */
+  template <typename Functor>
+  void parallelFor(int begin, int end, Functor&& taskFunction);
 
   /** Get profiling information as a string */
   std::string getBenchmarkingInformation() const;
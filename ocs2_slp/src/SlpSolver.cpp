@@ -33,6 +33,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <iostream>
 #include <numeric>
 
+#include <ocs2_core/misc/Trace.h>
+#include <ocs2_core/thread_support/SetThreadAffinity.h>
+
 #include <ocs2_oc/multiple_shooting/Helpers.h>
 #include <ocs2_oc/multiple_shooting/Initialization.h>
 #include <ocs2_oc/multiple_shooting/MetricsComputation.h>
@@ -48,7 +51,8 @@ namespace ocs2 {
 SlpSolver::SlpSolver(slp::Settings settings, const OptimalControlProblem& optimalControlProblem, const Initializer& initializer)
     : settings_(std::move(settings)),
       pipgSolver_(settings_.pipgSettings),
-      threadPool_(std::max(settings_.nThreads - 1, size_t(1)) - 1, settings_.threadPriority) {
+      threadPool_(std::max(settings_.nThreads - 1, size_t(1)) - 1, settings_.threadPriority,
+                  getWorkerCpuSets(settings_.threadAffinity, settings_.workerThreadAffinity, settings_.nThreads)) {
   Eigen::setNbThreads(1);  // No multithreading within Eigen.
   Eigen::initParallel();
 
@@ -56,9 +60,13 @@ SlpSolver::SlpSolver(slp::Settings settings, const OptimalControlProblem& optima
   discretizer_ = selectDynamicsDiscretization(settings_.integratorType);
   sensitivityDiscretizer_ = selectDynamicsSensitivityDiscretization(settings_.integratorType);
 
-  // Clone objects to have one for each worker
-  for (int w = 0; w < settings_.nThreads; w++) {
-    ocpDefinitions_.push_back(optimalControlProblem);
+  // Clone objects to have one for each worker. The copies are created on the CPUs of the worker such that they are allocated on its
+  // NUMA node (first-touch).
+  // The pool runs one thread less than nThreads, the copies of the unused worker indices are not placed.
+  ocpDefinitions_.reserve(settings_.nThreads);
+  for (size_t w = 0; w < settings_.nThreads; w++) {
+    const auto& cpus = (w <= threadPool_.numThreads()) ? threadPool_.getCpuAffinity(w) : std::vector<int>();
+    runOnCpus(cpus, [&] { ocpDefinitions_.push_back(optimalControlProblem); });
   }
 
   // Operating points
@@ -157,6 +165,7 @@ const std::vector<PerformanceIndex>& SlpSolver::getIterationsLog() const {
 }
 
 void SlpSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t finalTime) {
+  OCS2_TRACE_ZONE("SlpSolver::run");
   if (settings_.printSolverStatus || settings_.printLinesearch) {
     std::cerr << "\n++++++++++++++++++++++++++++++++++++++++++++++++++++++";
     std::cerr << "\n+++++++++++++ SLP solver is initialized ++++++++++++++";
@@ -165,7 +174,8 @@ void SlpSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
 
   // Determine time discretization, taking into account event times.
   const auto& eventTimes = this->getReferenceManager().getModeSchedule().eventTimes;
-  const auto timeDiscretization = timeDiscretizationWithEvents(initTime, finalTime, settings_.dt, eventTimes);
+  const auto timeDiscretization =
+      getTimeDiscretization(initTime, finalTime, settings_.dt, settings_.dtGrowthRate, settings_.dtMax, /*isAligned=*/false, eventTimes);
 
   // Initialize references
   for (auto& ocpDefinition : ocpDefinitions_) {
@@ -189,6 +199,7 @@ void SlpSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
   int iter = 0;
   slp::Convergence convergence = slp::Convergence::FALSE;
   while (convergence == slp::Convergence::FALSE) {
+    OCS2_TRACE_ZONE("SlpSolver::iteration");
     if (settings_.printSolverStatus || settings_.printLinesearch) {
       std::cerr << "\nPIPG iteration: " << iter << "\n";
     }
@@ -212,6 +223,12 @@ void SlpSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
     // Check convergence
     convergence = checkConvergence(iter, baselinePerformance, stepInfo);
 
+    // Publish the intermediate iterate
+    if (convergence == slp::Convergence::FALSE && this->hasIntermediateSolutionCallback()) {
+      const auto intermediateSolution = toPrimalSolution(timeDiscretization, vector_array_t(x), vector_array_t(u));
+      this->publishIntermediateSolution(intermediateSolution, stepInfo.performanceAfterStep);
+    }
+
     // Next iteration
     ++iter;
     ++totalNumIterations_;
@@ -232,11 +249,13 @@ void SlpSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
   }
 }
 
-void SlpSolver::runParallel(std::function<void(int)> taskFunction) {
-  threadPool_.runParallel(std::move(taskFunction), settings_.nThreads);
+template <typename Functor>
+void SlpSolver::parallelFor(int begin, int end, Functor&& taskFunction) {
+  threadPool_.parallelFor(begin, end, 1, std::forward<Functor>(taskFunction));
 }
 
 SlpSolver::OcpSubproblemSolution SlpSolver::getOCPSolution(const vector_t& delta_x0) {
+  OCS2_TRACE_ZONE("SlpSolver::solveQp");
   // Solve the QP
   OcpSubproblemSolution solution;
   auto& deltaXSol = solution.deltaXSol;
@@ -294,12 +313,14 @@ SlpSolver::OcpSubproblemSolution SlpSolver::getOCPSolution(const vector_t& delta
 }
 
 PrimalSolution SlpSolver::toPrimalSolution(const std::vector<AnnotatedTime>& time, vector_array_t&& x, vector_array_t&& u) {
+  OCS2_TRACE_ZONE("SlpSolver::toPrimalSolution");
   ModeSchedule modeSchedule = this->getReferenceManager().getModeSchedule();
   return multiple_shooting::toPrimalSolution(time, std::move(modeSchedule), std::move(x), std::move(u));
 }
 
 PerformanceIndex SlpSolver::setupQuadraticSubproblem(const std::vector<AnnotatedTime>& time, const vector_t& initState,
                                                      const vector_array_t& x, const vector_array_t& u, std::vector<Metrics>& metrics) {
+  OCS2_TRACE_ZONE("SlpSolver::setupQuadraticSubproblem");
   // Problem horizon
   const int N = static_cast<int>(time.size()) - 1;
 
@@ -313,59 +334,50 @@ PerformanceIndex SlpSolver::setupQuadraticSubproblem(const std::vector<Annotated
   projectionMultiplierCoefficients_.resize(N);
   metrics.resize(N + 1);
 
-  std::atomic_int timeIndex{0};
-  auto parallelTask = [&](int workerId) {
+  auto parallelTask = [&](int workerId, int i) {
+    OCS2_TRACE_ZONE("SlpSolver::setupNode");
     // Get worker specific resources
     OptimalControlProblem& ocpDefinition = ocpDefinitions_[workerId];
-    PerformanceIndex workerPerformance;  // Accumulate performance in local variable
-
-    int i = timeIndex++;
-    while (i < N) {
-      if (time[i].event == AnnotatedTime::Event::PreEvent) {
-        // Event node
-        auto result = multiple_shooting::setupEventNode(ocpDefinition, time[i].time, x[i], x[i + 1]);
-        metrics[i] = multiple_shooting::computeMetrics(result);
-        workerPerformance += multiple_shooting::computePerformanceIndex(result);
-        cost_[i] = std::move(result.cost);
-        dynamics_[i] = std::move(result.dynamics);
-        stateInputEqConstraints_[i].resize(0, x[i].size());
-        stateIneqConstraints_[i] = std::move(result.ineqConstraints);
-        stateInputIneqConstraints_[i].resize(0, x[i].size());
-        constraintsProjection_[i].resize(0, x[i].size());
-        projectionMultiplierCoefficients_[i] = multiple_shooting::ProjectionMultiplierCoefficients();
-      } else {
-        // Normal, intermediate node
-        const scalar_t ti = getIntervalStart(time[i]);
-        const scalar_t dt = getIntervalDuration(time[i], time[i + 1]);
-        auto result = multiple_shooting::setupIntermediateNode(ocpDefinition, sensitivityDiscretizer_, ti, dt, x[i], x[i + 1], u[i]);
-        metrics[i] = multiple_shooting::computeMetrics(result);
-        workerPerformance += multiple_shooting::computePerformanceIndex(result, dt);
-        multiple_shooting::projectTranscription(result, settings_.extractProjectionMultiplier);
-        cost_[i] = std::move(result.cost);
-        dynamics_[i] = std::move(result.dynamics);
-        stateInputEqConstraints_[i] = std::move(result.stateInputEqConstraints);
-        stateIneqConstraints_[i] = std::move(result.stateIneqConstraints);
-        stateInputIneqConstraints_[i] = std::move(result.stateInputIneqConstraints);
-        constraintsProjection_[i] = std::move(result.constraintsProjection);
-        projectionMultiplierCoefficients_[i] = std::move(result.projectionMultiplierCoefficients);
-      }
+    PerformanceIndex& workerPerformance = performance[workerId];  // Accumulate performance per worker
 
-      i = timeIndex++;
-    }
-
-    if (i == N) {  // Only one worker will execute this
+    if (i == N) {
+      // Terminal node
       const scalar_t tN = getIntervalStart(time[N]);
       auto result = multiple_shooting::setupTerminalNode(ocpDefinition, tN, x[N]);
       metrics[i] = multiple_shooting::computeMetrics(result);
       workerPerformance += multiple_shooting::computePerformanceIndex(result);
       cost_[i] = std::move(result.cost);
       stateIneqConstraints_[i] = std::move(result.ineqConstraints);
+    } else if (time[i].event == AnnotatedTime::Event::PreEvent) {
+      // Event node
+      auto result = multiple_shooting::setupEventNode(ocpDefinition, time[i].time, x[i], x[i + 1]);
+      metrics[i] = multiple_shooting::computeMetrics(result);
+      workerPerformance += multiple_shooting::computePerformanceIndex(result);
+      cost_[i] = std::move(result.cost);
+      dynamics_[i] = std::move(result.dynamics);
+      stateInputEqConstraints_[i].resize(0, x[i].size());
+      stateIneqConstraints_[i] = std::move(result.ineqConstraints);
+      stateInputIneqConstraints_[i].resize(0, x[i].size());
+      constraintsProjection_[i].resize(0, x[i].size());
+      projectionMultiplierCoefficients_[i] = multiple_shooting::ProjectionMultiplierCoefficients();
+    } else {
+      // Normal, intermediate node
+      const scalar_t ti = getIntervalStart(time[i]);
+      const scalar_t dt = getIntervalDuration(time[i], time[i + 1]);
+      auto result = multiple_shooting::setupIntermediateNode(ocpDefinition, sensitivityDiscretizer_, ti, dt, x[i], x[i + 1], u[i]);
+      metrics[i] = multiple_shooting::computeMetrics(result);
+      workerPerformance += multiple_shooting::computePerformanceIndex(result, dt);
+      multiple_shooting::projectTranscription(result, settings_.extractProjectionMultiplier);
+      cost_[i] = std::move(result.cost);
+      dynamics_[i] = std::move(result.dynamics);
+      stateInputEqConstraints_[i] = std::move(result.stateInputEqConstraints);
+      stateIneqConstraints_[i] = std::move(result.stateIneqConstraints);
+      stateInputIneqConstraints_[i] = std::move(result.stateInputIneqConstraints);
+      constraintsProjection_[i] = std::move(result.constraintsProjection);
+      projectionMultiplierCoefficients_[i] = std::move(result.projectionMultiplierCoefficients);
     }
-
-    // Accumulate! Same worker might run multiple tasks
-    performance[workerId] += workerPerformance;
   };
-  runParallel(std::move(parallelTask));
+  parallelFor(0, N + 1, std::move(parallelTask));
 
   // Account for init state in performance
   performance.front().dynamicsViolationSSE += (initState - x.front()).squaredNorm();
@@ -379,40 +391,34 @@ PerformanceIndex SlpSolver::setupQuadraticSubproblem(const std::vector<Annotated
 
 PerformanceIndex SlpSolver::computePerformance(const std::vector<AnnotatedTime>& time, const vector_t& initState, const vector_array_t& x,
                                                const vector_array_t& u, std::vector<Metrics>& metrics) {
+  OCS2_TRACE_ZONE("SlpSolver::computePerformance");
   // Problem size
   const int N = static_cast<int>(time.size()) - 1;
   metrics.resize(N + 1);
 
   std::vector<PerformanceIndex> performance(settings_.nThreads, PerformanceIndex());
-  std::atomic_int timeIndex{0};
-  auto parallelTask = [&](int workerId) {
+  auto parallelTask = [&](int workerId, int i) {
     // Get worker specific resources
     OptimalControlProblem& ocpDefinition = ocpDefinitions_[workerId];
 
-    int i = timeIndex++;
-    while (i < N) {
-      if (time[i].event == AnnotatedTime::Event::PreEvent) {
-        // Event node
-        metrics[i] = multiple_shooting::computeEventMetrics(ocpDefinition, time[i].time, x[i], x[i + 1]);
-        performance[workerId] += toPerformanceIndex(metrics[i]);
-      } else {
-        // Normal, intermediate node
-        const scalar_t ti = getIntervalStart(time[i]);
-        const scalar_t dt = getIntervalDuration(time[i], time[i + 1]);
-        metrics[i] = multiple_shooting::computeIntermediateMetrics(ocpDefinition, discretizer_, ti, dt, x[i], x[i + 1], u[i]);
-        performance[workerId] += toPerformanceIndex(metrics[i], dt);
-      }
-
-      i = timeIndex++;
-    }
-
-    if (i == N) {  // Only one worker will execute this
+    if (i == N) {
+      // Terminal node
       const scalar_t tN = getIntervalStart(time[N]);
       metrics[N] = multiple_shooting::computeTerminalMetrics(ocpDefinition, tN, x[N]);
       performance[workerId] += toPerformanceIndex(metrics[N]);
+    } else if (time[i].event == AnnotatedTime::Event::PreEvent) {
+      // Event node
+      metrics[i] = multiple_shooting::computeEventMetrics(ocpDefinition, time[i].time, x[i], x[i + 1]);
+      performance[workerId] += toPerformanceIndex(metrics[i]);
+    } else {
+      // Normal, intermediate node
+      const scalar_t ti = getIntervalStart(time[i]);
+      const scalar_t dt = getIntervalDuration(time[i], time[i + 1]);
+      metrics[i] = multiple_shooting::computeIntermediateMetrics(ocpDefinition, discretizer_, ti, dt, x[i], x[i + 1], u[i]);
+      performance[workerId] += toPerformanceIndex(metrics[i], dt);
     }
   };
-  runParallel(std::move(parallelTask));
+  parallelFor(0, N + 1, std::move(parallelTask));
 
   // Account for initial state in performance
   const vector_t initDynamicsViolation = initState - x.front();
@@ -428,6 +434,7 @@ PerformanceIndex SlpSolver::computePerformance(const std::vector<AnnotatedTime>&
 slp::StepInfo SlpSolver::takeStep(const PerformanceIndex& baseline, const std::vector<AnnotatedTime>& timeDiscretization,
                                   const vector_t& initState, const OcpSubproblemSolution& subproblemSolution, vector_array_t& x,
                                   vector_array_t& u, std::vector<Metrics>& metrics) {
+  OCS2_TRACE_ZONE("SlpSolver::takeStep");
   using StepType = FilterLinesearch::StepType;
 
   /*
@@ -45,6 +45,10 @@ namespace ocs2 {
 /**
  * This class implements the interface between Linear Quadratic optimal control problems defined in OCS2 and the HPIPM solver.
  * If the problem dimensions change, resize needs to be called to re-initialize HPIPM.
+ *
+ * The HPIPM workspaces and the buffers that point HPIPM to the problem data are kept between solves of the same size. The problem
+ * data itself is still copied into the HPIPM storage on every solve: solving in place on the OCS2 data, e.g. by mapping Eigen
+ * matrices onto the HPIPM memory, is not supported.
  */
 class HpipmInterface {
  public:
@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "hpipm_catkin/HpipmInterface.h"
 
+#include <algorithm>
+
 #include <ocs2_core/misc/LinearAlgebra.h>
 
 extern "C" {
@@ -126,6 +128,16 @@ class HpipmInterface::Impl {
     const int ipm_size = d_ocp_qp_ipm_ws_memsize(&dim_, &arg_);
     ipmMem_.reserve(ipm_size);
     d_ocp_qp_ipm_ws_create(&dim_, &arg_, &workspace_, ipmMem_.get());
+
+    // Pointer arrays into the problem data. Entries that are not set in solve() stay nullptr.
+    const int N = ocpSize_.numStages;
+    for (auto* pointers : {&AA_, &BB_, &bb_}) {
+      pointers->assign(N, nullptr);
+    }
+    for (auto* pointers : {&QQ_, &RR_, &SS_, &qq_, &rr_, &CC_, &DD_, &llg_, &uug_}) {
+      pointers->assign(N + 1, nullptr);
+    }
+    boundData_.resize(N + 1);
   }
 
   void applySettings(Settings& settings) {
@@ -170,10 +182,6 @@ class HpipmInterface::Impl {
     verifySizes(x0, dynamics, cost, constraints);
 
     // === Dynamics ===
-    std::vector<scalar_t*> AA(N, nullptr);
-    std::vector<scalar_t*> BB(N, nullptr);
-    std::vector<scalar_t*> bb(N, nullptr);
-
     // k = 0. Absorb initial state into dynamics
     // The initial state is removed from the decision variables
     // The first dynamics becomes:
@@ -181,85 +189,77 @@ class HpipmInterface::Impl {
     //         = B[0]*u[0] + (b[0] + A[0]*x[0])
     //         = B[0]*u[0] + \tilde{b}[0]
     // numState[0] = 0 --> No need to specify A[0] here
-    vector_t b0 = dynamics[0].f;
-    b0.noalias() += dynamics[0].dfdx * x0;
-    BB[0] = dynamics[0].dfdu.data();
-    bb[0] = b0.data();
+    b0_ = dynamics[0].f;
+    b0_.noalias() += dynamics[0].dfdx * x0;
+    BB_[0] = dynamics[0].dfdu.data();
+    bb_[0] = b0_.data();
 
     // k = 1 -> N-1
     for (int k = 1; k < N; k++) {
-      AA[k] = dynamics[k].dfdx.data();
-      BB[k] = dynamics[k].dfdu.data();
-      bb[k] = dynamics[k].f.data();
+      AA_[k] = dynamics[k].dfdx.data();
+      BB_[k] = dynamics[k].dfdu.data();
+      bb_[k] = dynamics[k].f.data();
     }
 
     // === Costs ===
-    std::vector<scalar_t*> QQ(N + 1, nullptr);
-    std::vector<scalar_t*> RR(N + 1, nullptr);
-    std::vector<scalar_t*> SS(N + 1, nullptr);
-    std::vector<scalar_t*> qq(N + 1, nullptr);
-    std::vector<scalar_t*> rr(N + 1, nullptr);
-
     // k = 0. Elimination of initial state requires cost adaptation
     // numState[0] = 0 --> No need to specify Q[0], S[0], q[0] here
-    vector_t r0 = cost[0].dfdu;
-    r0 += cost[0].dfdux * x0;
-    RR[0] = cost[0].dfduu.data();
-    rr[0] = r0.data();
+    r0_ = cost[0].dfdu;
+    r0_.noalias() += cost[0].dfdux * x0;
+    RR_[0] = cost[0].dfduu.data();
+    rr_[0] = r0_.data();
 
     // k = 1 -> (N-1)
     for (int k = 1; k < N; k++) {
-      QQ[k] = cost[k].dfdxx.data();
-      RR[k] = cost[k].dfduu.data();
-      SS[k] = cost[k].dfdux.data();
-      qq[k] = cost[k].dfdx.data();
-      rr[k] = cost[k].dfdu.data();
+      QQ_[k] = cost[k].dfdxx.data();
+      RR_[k] = cost[k].dfduu.data();
+      SS_[k] = cost[k].dfdux.data();
+      qq_[k] = cost[k].dfdx.data();
+      rr_[k] = cost[k].dfdu.data();
     }
 
     // k = N, no inputs
-    QQ[N] = cost[N].dfdxx.data();
-    qq[N] = cost[N].dfdx.data();
+    QQ_[N] = cost[N].dfdxx.data();
+    qq_[N] = cost[N].dfdx.data();
 
     // === Constraints ===
     // for ocs2 --> C*dx + D*du + e = 0
     // for hpipm --> ug >= C*dx + D*du >= lg
-    std::vector<scalar_t*> CC(N + 1, nullptr);
-    std::vector<scalar_t*> DD(N + 1, nullptr);
-    std::vector<scalar_t*> llg(N + 1, nullptr);
-    std::vector<scalar_t*> uug(N + 1, nullptr);
-    std::vector<ocs2::vector_t> boundData;  // Declare at this scope to keep the data alive while HPIPM has the pointers
+    // Reset the pointers of the previous solve, nodes without constraints are marked by nullptr
+    for (auto* pointers : {&CC_, &DD_, &llg_, &uug_}) {
+      std::fill(pointers->begin(), pointers->end(), nullptr);
+    }
 
     if (constraints != nullptr) {
       auto& constr = *constraints;
-      boundData.resize(N + 1);
 
       // k = 0, eliminate initial state
       // numState[0] = 0 --> No need to specify C[0] here
       if (constr[0].f.size() > 0) {
-        boundData[0] = -constr[0].f;
-        boundData[0].noalias() -= constr[0].dfdx * x0;
-        llg[0] = boundData[0].data();
-        uug[0] = boundData[0].data();
-        DD[0] = constr[0].dfdu.data();
+        boundData_[0] = -constr[0].f;
+        boundData_[0].noalias() -= constr[0].dfdx * x0;
+        llg_[0] = boundData_[0].data();
+        uug_[0] = boundData_[0].data();
+        DD_[0] = constr[0].dfdu.data();
       }
 
       // k = 1 -> (N-1)
       for (int k = 1; k < N; k++) {
         if (constr[k].f.size() > 0) {
-          CC[k] = constr[k].dfdx.data();
-          DD[k] = constr[k].dfdu.data();
-          boundData[k] = -constr[k].f;
-          llg[k] = boundData[k].data();
-          uug[k] = boundData[k].data();
+          CC_[k] = constr[k].dfdx.data();
+          DD_[k] = constr[k].dfdu.data();
+          boundData_[k] = -constr[k].f;
+          llg_[k] = boundData_[k].data();
+          uug_[k] = boundData_[k].data();
         }
       }
 
       // k = N, no inputs
       if (constr[N].f.size() > 0) {
-        CC[N] = constr[N].dfdx.data();
-        boundData[N] = -constr[N].f;
-        llg[N] = boundData[N].data();
-        uug[N] = boundData[N].data();
+        CC_[N] = constr[N].dfdx.data();
+        boundData_[N] = -constr[N].f;
+        llg_[N] = boundData_[N].data();
+        uug_[N] = boundData_[N].data();
       }
     }
 
@@ -279,8 +279,8 @@ class HpipmInterface::Impl {
     scalar_t** hlus = nullptr;
 
     // === Set and solve ===
-    d_ocp_qp_set_all(AA.data(), BB.data(), bb.data(), QQ.data(), SS.data(), RR.data(), qq.data(), rr.data(), hidxbx, hlbx, hubx, hidxbu,
-                     hlbu, hubu, CC.data(), DD.data(), llg.data(), uug.data(), hZl, hZu, hzl, hzu, hidxs, hlls, hlus, &qp_);
+    d_ocp_qp_set_all(AA_.data(), BB_.data(), bb_.data(), QQ_.data(), SS_.data(), RR_.data(), qq_.data(), rr_.data(), hidxbx, hlbx, hubx,
+                     hidxbu, hlbu, hubu, CC_.data(), DD_.data(), llg_.data(), uug_.data(), hZl, hZu, hzl, hzu, hidxs, hlls, hlus, &qp_);
     d_ocp_qp_ipm_solve(&qp_, &qpSol_, &arg_, &workspace_);
 
     if (verbose) {
@@ -520,6 +520,14 @@ class HpipmInterface::Impl {
 
   MemoryBlock ipmMem_;
   d_ocp_qp_ipm_ws workspace_;
+
+  // Problem data handed to HPIPM. The pointer arrays are sized with the problem and refer to the data of the current solve.
+  std::vector<scalar_t*> AA_, BB_, bb_;
+  std::vector<scalar_t*> QQ_, RR_, SS_, qq_, rr_;
+  std::vector<scalar_t*> CC_, DD_, llg_, uug_;
+  vector_t b0_;
+  vector_t r0_;
+  vector_array_t boundData_;
 };
 
 HpipmInterface::HpipmInterface(OcpSize ocpSize, const Settings& settings)
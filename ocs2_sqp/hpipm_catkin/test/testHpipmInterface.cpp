@@ -205,6 +205,54 @@ TEST(test_hpiphm_interface, with_constraints) {
   }
 }
 
+TEST(test_hpiphm_interface, reuse_with_same_size) {
+  int nx = 3;
+  int nu = 2;
+  int nc = 1;
+  int N = 5;
+
+  // Problem setup
+  auto getRandomProblem = [&]() {
+    std::vector<ocs2::VectorFunctionLinearApproximation> system;
+    std::vector<ocs2::VectorFunctionLinearApproximation> constraints;
+    std::vector<ocs2::ScalarFunctionQuadraticApproximation> cost;
+    for (int k = 0; k < N; k++) {
+      system.emplace_back(ocs2::getRandomDynamics(nx, nu));
+      cost.emplace_back(ocs2::getRandomCost(nx, nu));
+      constraints.emplace_back(ocs2::getRandomConstraints(nx, nu, nc));
+    }
+    cost.emplace_back(ocs2::getRandomCost(nx, 0));
+    constraints.emplace_back(ocs2::getRandomConstraints(nx, 0, nc));
+    return std::make_tuple(system, cost, constraints);
+  };
+
+  ocs2::OcpSize ocpSize(N, nx, nu);
+  std::fill(ocpSize.numIneqConstraints.begin(), ocpSize.numIneqConstraints.end(), nc);
+
+  // Solve a first problem, the second one has the same size and reuses the memory
+  ocs2::HpipmInterface hpipmInterface(ocpSize);
+  std::vector<ocs2::vector_t> xSol;
+  std::vector<ocs2::vector_t> uSol;
+  {
+    auto problem = getRandomProblem();
+    hpipmInterface.solve(ocs2::vector_t::Random(nx), std::get<0>(problem), std::get<1>(problem), &std::get<2>(problem), xSol, uSol);
+  }
+
+  const ocs2::vector_t x0 = ocs2::vector_t::Random(nx);
+  auto problem = getRandomProblem();
+  hpipmInterface.resize(ocpSize);
+  const auto status = hpipmInterface.solve(x0, std::get<0>(problem), std::get<1>(problem), &std::get<2>(problem), xSol, uSol);
+  ASSERT_EQ(status, hpipm_status::SUCCESS);
+
+  // Compare against a fresh interface
+  ocs2::HpipmInterface freshHpipmInterface(ocpSize);
+  std::vector<ocs2::vector_t> xSolFresh;
+  std::vector<ocs2::vector_t> uSolFresh;
+  freshHpipmInterface.solve(x0, std::get<0>(problem), std::get<1>(problem), &std::get<2>(problem), xSolFresh, uSolFresh);
+  ASSERT_TRUE(ocs2::isEqual(xSolFresh, xSol, 1e-9));
+  ASSERT_TRUE(ocs2::isEqual(uSolFresh, uSol, 1e-9));
+}
+
 TEST(test_hpiphm_interface, noInputs) {
   // Initialize without size
   ocs2::HpipmInterface hpipmInterface;
@@ -42,14 +42,18 @@ class SqpMpc final : public MPC_BASE {
    *
    * @param mpcSettings : settings for the mpc wrapping of the solver. Do not use this for maxIterations and stepsize, use
    * multiple shooting SQP settings directly.
-   * @param settings : settings for the multiple shooting SQP solver.
+   * @param settings : settings for the multiple shooting SQP solver. With sqp::Settings::realTimeIteration, the linearization for the
+   * next run is done in prepareNextRun(), such that run() only solves the QP.
    * @param [in] optimalControlProblem: The optimal control problem formulation.
    * @param [in] initializer: This class initializes the state-input for the time steps that no controller is available.
    */
   SqpMpc(mpc::Settings mpcSettings, sqp::Settings settings, const OptimalControlProblem& optimalControlProblem,
          const Initializer& initializer)
-      : MPC_BASE(std::move(mpcSettings)) {
+      : MPC_BASE(std::move(mpcSettings)), realTimeIteration_(settings.realTimeIteration) {
     solverPtr_.reset(new SqpSolver(std::move(settings), optimalControlProblem, initializer));
+    if (this->settings().mpcDesiredFrequency_ > 0.0) {
+      samplingPeriod_ = 1.0 / this->settings().mpcDesiredFrequency_;
+    }
   };
 
   ~SqpMpc() override = default;
@@ -57,16 +61,37 @@ class SqpMpc final : public MPC_BASE {
   SqpSolver* getSolverPtr() override { return solverPtr_.get(); }
   const SqpSolver* getSolverPtr() const override { return solverPtr_.get(); }
 
+  /**
+   * Runs the preparation phase of the real-time iteration for the expected time of the next run. The time is predicted from the
+   * desired MPC frequency, or, if it is not set, from the time between the last two runs. If the next run starts at another time, the
+   * solution of the prepared QP is shifted to it, see SqpSolver::prepareRealTimeIteration().
+   */
+  void prepareNextRun() override {
+    if (realTimeIteration_ && !isFirstMpcRun()) {
+      const scalar_t nextInitTime = lastInitTime_ + samplingPeriod_;
+      solverPtr_->prepareRealTimeIteration(nextInitTime, nextInitTime + getTimeHorizon());
+    }
+  }
+
  protected:
   void calculateController(scalar_t initTime, const vector_t& initState, scalar_t finalTime) override {
     if (settings().coldStart_) {
       solverPtr_->reset();
     }
+    if (!isFirstMpcRun() && settings().mpcDesiredFrequency_ <= 0.0) {
+      samplingPeriod_ = initTime - lastInitTime_;
+    }
+    lastInitTime_ = initTime;
     solverPtr_->run(initTime, initState, finalTime);
   }
 
  private:
   std::unique_ptr<SqpSolver> solverPtr_;
+
+  // Real-time iteration
+  const bool realTimeIteration_;
+  scalar_t lastInitTime_ = 0.0;
+  scalar_t samplingPeriod_ = 0.0;
 };
 
 }  // namespace ocs2
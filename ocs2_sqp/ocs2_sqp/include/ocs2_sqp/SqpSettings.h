@@ -53,6 +53,10 @@ struct Settings {
   scalar_t armijoFactor = 1e-4;  // Armijo condition: c{i+1} < c{i} + armijoFactor * dc/dw'{i} * delta_w
   scalar_t gamma_c = 1e-6;       // (3): ELSE REQUIRE c{i+1} < (c{i} - gamma_c * g{i}) OR g{i+1} < (1-gamma_c) * g{i}
 
+  // Real-time iteration: each run takes a single full SQP step. The linearization (preparation phase) is done by
+  // SqpSolver::prepareRealTimeIteration() before the measurement arrives, run() only solves the QP (feedback phase).
+  bool realTimeIteration = false;
+
   // controller type
   bool useFeedbackPolicy = true;     // true to use feedback, false to use feedforward
   bool createValueFunction = false;  // true to store the value function, false to ignore it
@@ -62,7 +66,15 @@ struct Settings {
 
   // Discretization method
   scalar_t dt = 0.01;  // user-defined time discretization
+  // Non-uniform discretization: the step is dt at the initial time and around the events, and grows geometrically with dtGrowthRate
+  // away from them, up to dtMax. A growth rate of 1.0 gives the uniform discretization.
+  scalar_t dtGrowthRate = 1.0;
+  scalar_t dtMax = 0.1;
   SensitivityIntegratorType integratorType = SensitivityIntegratorType::RK2;
+  // Aligns the time discretization to the grid {k * dt}, such that consecutive MPC horizons share their nodes and the previous solution
+  // is shifted to the new horizon instead of interpolated. The number of nodes stays constant, which preserves the QP sparsity structure.
+  // It can not be combined with the non-uniform discretization (dtGrowthRate > 1.0), the solver throws in that case.
+  bool horizonShiftingWarmStart = false;
 
   // Inequality penalty relaxed barrier parameters
   scalar_t inequalityConstraintMu = 0.0;
@@ -71,6 +83,12 @@ struct Settings {
   bool projectStateInputEqualityConstraints = true;  // Use a projection method to resolve the state-input constraint Cx+Du+e
   bool extractProjectionMultiplier = false;          // Extract the Lagrange multiplier of the projected state-input constraint Cx+Du+e
 
+  // Move blocking: the QP input is held constant on blocks of moveBlockingSize intervals, except for the first moveBlockingFreeIntervals
+  // intervals. Each block is condensed into a single QP stage. A block size of 1 disables move blocking. With state-input equality
+  // constraints, it requires the projection and the projected input is held constant.
+  int moveBlockingSize = 1;
+  int moveBlockingFreeIntervals = 0;
+
   // Printing
   bool printSolverStatus = false;      // Print HPIPM status after solving the QP subproblem
   bool printSolverStatistics = false;  // Print benchmarking of the multiple shooting method
@@ -84,6 +102,8 @@ struct Settings {
   // Threading
   size_t nThreads = 4;
   int threadPriority = 50;
+  std::string threadAffinity;                     // CPUs of the worker threads in cpulist format, e.g. "0-3,8". Empty to not pin them
+  std::vector<std::string> workerThreadAffinity;  // CPUs per worker index in cpulist format, a non-empty entry overrides threadAffinity
 };
 
 /**
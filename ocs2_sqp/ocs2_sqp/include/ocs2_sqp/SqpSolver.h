@@ -31,10 +31,13 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/initialization/Initializer.h>
 #include <ocs2_core/integration/SensitivityIntegrator.h>
+#include <ocs2_core/misc/AllocationTracking.h>
 #include <ocs2_core/misc/Benchmark.h>
+#include <ocs2_core/misc/MonotonicArena.h>
 #include <ocs2_core/thread_support/ThreadPool.h>
 
 #include <ocs2_oc/multiple_shooting/ProjectionMultiplierCoefficients.h>
+#include <ocs2_oc/multiple_shooting/Transcription.h>
 #include <ocs2_oc/oc_data/TimeDiscretization.h>
 #include <ocs2_oc/oc_problem/OptimalControlProblem.h>
 #include <ocs2_oc/oc_solver/SolverBase.h>
@@ -91,6 +94,23 @@ class SqpSolver : public SolverBase {
     throw std::runtime_error("[SqpSolver] getIntermediateDualSolution() not available yet.");
   }
 
+  /**
+   * Preparation phase of the real-time iteration, see sqp::Settings::realTimeIteration. Linearizes the problem around the previous
+   * solution shifted to the given horizon, such that the next run() only embeds the initial state and solves the QP (feedback phase).
+   * It should be called after the previous solution has been retrieved and before the next initial state is available. Does nothing
+   * if there is no previous solution.
+   *
+   * The target trajectories of the reference manager and the updates of the synchronized modules are taken at this point. The feedback
+   * phase does not see changes made to them in between, they only enter the QP at the next preparation.
+   *
+   * If the next run starts at another time, the QP is not linearized again: its solution is shifted by the time offset, as in the
+   * standard real-time iteration. This holds for offsets up to sqp::Settings::dt, see runRealTimeIteration().
+   *
+   * @param [in] initTime: The predicted initial time of the next run.
+   * @param [in] finalTime: The predicted final time of the next run.
+   */
+  void prepareRealTimeIteration(scalar_t initTime, scalar_t finalTime);
+
  private:
   void runImpl(scalar_t initTime, const vector_t& initState, scalar_t finalTime) override;
 
@@ -112,8 +132,9 @@ class SqpSolver : public SolverBase {
     runImpl(initTime, initState, finalTime);
   }
 
-  /** Run a task in parallel with settings.nThreads */
-  void runParallel(std::function<void(int)> taskFunction);
+  /** Run taskFunction(workerId, i) for every node i in [begin, end) in parallel with settings.nThreads */
+  template <typename Functor>
+  void parallelFor(int begin, int end, Functor&& taskFunction);
 
   /** Get profiling information as a string */
   std::string getBenchmarkingInformation() const;
@@ -148,10 +169,19 @@ class SqpSolver : public SolverBase {
   /** Determine convergence after a step */
   sqp::Convergence checkConvergence(int iteration, const PerformanceIndex& baseline, const sqp::StepInfo& stepInfo) const;
 
+  /**
+   * Feedback phase of the real-time iteration. Embeds the initial state in the prepared QP, solves it, and takes a full step. The
+   * solution is shifted by the offset between the given and the prepared initial time. The preparation phase is run first if the offset
+   * is larger than sqp::Settings::dt, if the horizon length or the mode schedule differ, or if the prepared grid has event nodes and
+   * the offset is not zero. The targets and the synchronized-module updates are the ones from the preparation, see
+   * prepareRealTimeIteration().
+   */
+  void runRealTimeIteration(scalar_t initTime, const vector_t& initState, scalar_t finalTime);
+
   // Problem definition
   const sqp::Settings settings_;
   DynamicsDiscretizer discretizer_;
-  DynamicsSensitivityDiscretizer sensitivityDiscretizer_;
+  DynamicsSensitivityBlockDiscretizer blockSensitivityDiscretizer_;
   std::vector<OptimalControlProblem> ocpDefinitions_;
   std::unique_ptr<Initializer> initializerPtr_;
   FilterLinesearch filterLinesearch_;
@@ -162,6 +192,22 @@ class SqpSolver : public SolverBase {
   // Threading
   ThreadPool threadPool_;
 
+  // Per-worker scratch data, reused over the iterations. The arenas are reset for each node of the LQ approximation.
+  std::vector<MonotonicArena> workerArenas_;
+  std::vector<PerformanceIndex> workerPerformance_;
+  multiple_shooting::TerminalTranscription terminalTranscription_;
+
+  // Blocks of intermediate nodes whose dynamics are linearized at once, up to SystemDynamicsBase::getNumLanes() nodes per block. The
+  // terminal and the event nodes are blocks of their own. Each block is the range [first, second) of nodes. The transcriptions of the
+  // intermediate nodes are written into the storage of the workers, which is swapped with the LQ approximation below.
+  struct NodeBlockWorkspace {
+    SensitivityDiscretizationBlock block;
+    vector_array_t xNext;
+    std::vector<multiple_shooting::Transcription> transcriptions;
+  };
+  std::vector<std::pair<int, int>> nodeBlocks_;
+  std::vector<NodeBlockWorkspace> workerBlocks_;
+
   // Solution
   PrimalSolution primalSolution_;
 
@@ -179,6 +225,26 @@ class SqpSolver : public SolverBase {
   // Lagrange multipliers
   std::vector<multiple_shooting::ProjectionMultiplierCoefficients> projectionMultiplierCoefficients_;
 
+  // Move blocking: the first interval of each block followed by the number of intervals, and the blocked QP
+  std::vector<int> moveBlockingIndices_;
+  std::vector<VectorFunctionLinearApproximation> blockedDynamics_;
+  std::vector<ScalarFunctionQuadraticApproximation> blockedCost_;
+  vector_array_t blockedDeltaXSol_;
+  vector_array_t blockedDeltaUSol_;
+  MonotonicArena moveBlockingArena_;
+
+  // The QP of the real-time iteration, set up by prepareRealTimeIteration()
+  struct RealTimeIterationData {
+    bool isPrepared = false;
+    std::vector<AnnotatedTime> timeDiscretization;
+    ModeSchedule modeSchedule;
+    vector_array_t x;
+    vector_array_t u;
+    std::vector<Metrics> metrics;
+    PerformanceIndex performance;  // at the linearization point, without the initial state violation
+  };
+  RealTimeIterationData realTimeIteration_;
+
   // Iteration performance log
   std::vector<PerformanceIndex> performanceIndeces_;
 
@@ -194,6 +260,11 @@ class SqpSolver : public SolverBase {
   benchmark::RepeatedTimer solveQpTimer_;
   benchmark::RepeatedTimer linesearchTimer_;
   benchmark::RepeatedTimer computeControllerTimer_;
+
+  // Allocation tracking, the LQ approximation of an unconstrained problem without events is reported from the third iteration of a run on
+  allocation::PhaseAllocationCounter linearQuadraticApproximationAllocations_{"LQ Approximation"};
+  allocation::PhaseAllocationCounter solveQpAllocations_{"Solve QP"};
+  allocation::PhaseAllocationCounter linesearchAllocations_{"Linesearch"};
 };
 
 }  // namespace ocs2
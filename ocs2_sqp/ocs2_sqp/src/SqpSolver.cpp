@@ -29,15 +29,22 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_sqp/SqpSolver.h"
 
+#include <algorithm>
 #include <iomanip>
 #include <iostream>
 #include <numeric>
+#include <utility>
 
 #include <boost/filesystem.hpp>
 
+#include <ocs2_core/NumericTraits.h>
+#include <ocs2_core/misc/Trace.h>
+#include <ocs2_core/thread_support/SetThreadAffinity.h>
+
 #include <ocs2_oc/multiple_shooting/Helpers.h>
 #include <ocs2_oc/multiple_shooting/Initialization.h>
 #include <ocs2_oc/multiple_shooting/MetricsComputation.h>
+#include <ocs2_oc/multiple_shooting/MoveBlocking.h>
 #include <ocs2_oc/multiple_shooting/PerformanceIndexComputation.h>
 #include <ocs2_oc/multiple_shooting/Transcription.h>
 #include <ocs2_oc/oc_problem/OcpSize.h>
@@ -53,24 +60,51 @@ sqp::Settings rectifySettings(const OptimalControlProblem& ocp, sqp::Settings&&
   }
   return settings;
 }
+
+bool hasEventNodes(const std::vector<AnnotatedTime>& timeDiscretization) {
+  return std::any_of(timeDiscretization.begin(), timeDiscretization.end(),
+                     [](const AnnotatedTime& t) { return t.event == AnnotatedTime::Event::PreEvent; });
+}
+
+/** Whether the LQ approximation is written into the reused storage, constraints and event nodes are still approximated by value */
+bool isApproximatedInPlace(const OptimalControlProblem& ocp, const std::vector<AnnotatedTime>& timeDiscretization) {
+  const bool hasConstraints = !ocp.equalityConstraintPtr->empty() || !ocp.stateEqualityConstraintPtr->empty() ||
+                              !ocp.inequalityConstraintPtr->empty() || !ocp.stateInequalityConstraintPtr->empty() ||
+                              !ocp.finalEqualityConstraintPtr->empty() || !ocp.finalInequalityConstraintPtr->empty();
+  return !hasConstraints && !hasEventNodes(timeDiscretization);
+}
 }  // anonymous namespace
 
 SqpSolver::SqpSolver(sqp::Settings settings, const OptimalControlProblem& optimalControlProblem, const Initializer& initializer)
     : settings_(rectifySettings(optimalControlProblem, std::move(settings))),
       hpipmInterface_(OcpSize(), settings_.hpipmSettings),
-      threadPool_(std::max(settings_.nThreads, size_t(1)) - 1, settings_.threadPriority),
+      threadPool_(std::max(settings_.nThreads, size_t(1)) - 1, settings_.threadPriority,
+                  getWorkerCpuSets(settings_.threadAffinity, settings_.workerThreadAffinity, settings_.nThreads)),
       logger_(settings_.logSize) {
+  if (settings_.moveBlockingSize > 1) {
+    if (settings_.createValueFunction) {
+      throw std::runtime_error("[SqpSolver] The value function is not available with move blocking!");
+    }
+    if (!optimalControlProblem.equalityConstraintPtr->empty() && !settings_.projectStateInputEqualityConstraints) {
+      throw std::runtime_error("[SqpSolver] Move blocking requires projectStateInputEqualityConstraints with state-input constraints!");
+    }
+  }
+
   Eigen::setNbThreads(1);  // No multithreading within Eigen.
   Eigen::initParallel();
 
   // Dynamics discretization
   discretizer_ = selectDynamicsDiscretization(settings_.integratorType);
-  sensitivityDiscretizer_ = selectDynamicsSensitivityDiscretization(settings_.integratorType);
+  blockSensitivityDiscretizer_ = selectDynamicsSensitivityBlockDiscretization(settings_.integratorType);
 
-  // Clone objects to have one for each worker
+  // Clone objects to have one for each worker. The copies are created on the CPUs of the worker such that they are allocated on its
+  // NUMA node (first-touch).
+  ocpDefinitions_.reserve(settings_.nThreads);
   for (int w = 0; w < settings_.nThreads; w++) {
-    ocpDefinitions_.push_back(optimalControlProblem);
+    runOnCpus(threadPool_.getCpuAffinity(w), [&] { ocpDefinitions_.push_back(optimalControlProblem); });
   }
+  workerArenas_.resize(settings_.nThreads);
+  workerBlocks_.resize(settings_.nThreads);
 
   // Operating points
   initializerPtr_.reset(initializer.clone());
@@ -114,6 +148,7 @@ void SqpSolver::reset() {
   primalSolution_ = PrimalSolution();
   valueFunction_.clear();
   performanceIndeces_.clear();
+  realTimeIteration_.isPrepared = false;
 
   // reset timers
   numProblems_ = 0;
@@ -123,6 +158,9 @@ void SqpSolver::reset() {
   solveQpTimer_.reset();
   linesearchTimer_.reset();
   computeControllerTimer_.reset();
+  linearQuadraticApproximationAllocations_.reset();
+  solveQpAllocations_.reset();
+  linesearchAllocations_.reset();
 }
 
 std::string SqpSolver::getBenchmarkingInformation() const {
@@ -147,6 +185,12 @@ std::string SqpSolver::getBenchmarkingInformation() const {
                << linesearchTotal / benchmarkTotal * inPercent << "%)\n";
     infoStream << "\tCompute Controller :\t" << computeControllerTimer_.getAverageInMilliseconds() << " [ms] \t\t("
                << computeControllerTotal / benchmarkTotal * inPercent << "%)\n";
+    if (allocation::isTrackingEnabled()) {
+      infoStream << "SQP Allocations per iteration:\n";
+      infoStream << "\t" << linearQuadraticApproximationAllocations_ << "\n";
+      infoStream << "\t" << solveQpAllocations_ << "\n";
+      infoStream << "\t" << linesearchAllocations_ << "\n";
+    }
   }
   return infoStream.str();
 }
@@ -181,6 +225,13 @@ ScalarFunctionQuadraticApproximation SqpSolver::getValueFunction(scalar_t time,
 }
 
 void SqpSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t finalTime) {
+  OCS2_TRACE_ZONE("SqpSolver::run");
+  // The first run of the real-time iteration is solved to convergence
+  if (settings_.realTimeIteration && !primalSolution_.timeTrajectory_.empty()) {
+    runRealTimeIteration(initTime, initState, finalTime);
+    return;
+  }
+
   if (settings_.printSolverStatus || settings_.printLinesearch) {
     std::cerr << "\n++++++++++++++++++++++++++++++++++++++++++++++++++++++";
     std::cerr << "\n+++++++++++++ SQP solver is initialized ++++++++++++++";
@@ -189,7 +240,8 @@ void SqpSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
 
   // Determine time discretization, taking into account event times.
   const auto& eventTimes = this->getReferenceManager().getModeSchedule().eventTimes;
-  const auto timeDiscretization = timeDiscretizationWithEvents(initTime, finalTime, settings_.dt, eventTimes);
+  const auto timeDiscretization = getTimeDiscretization(initTime, finalTime, settings_.dt, settings_.dtGrowthRate, settings_.dtMax,
+                                                        settings_.horizonShiftingWarmStart, eventTimes);
 
   // Initialize references
   for (auto& ocpDefinition : ocpDefinitions_) {
@@ -204,39 +256,67 @@ void SqpSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
 
   // Initialize the state and input
   vector_array_t x, u;
-  multiple_shooting::initializeStateInputTrajectories(initState, timeDiscretization, primalSolution_, *initializerPtr_, x, u);
+  if (settings_.horizonShiftingWarmStart) {
+    multiple_shooting::shiftStateInputTrajectories(initState, timeDiscretization, primalSolution_, *initializerPtr_, x, u);
+  } else {
+    multiple_shooting::initializeStateInputTrajectories(initState, timeDiscretization, primalSolution_, *initializerPtr_, x, u);
+  }
+  if (settings_.moveBlockingSize > 1) {
+    moveBlockingIndices_ = multiple_shooting::getMoveBlockingIndices(u, settings_.moveBlockingFreeIntervals, settings_.moveBlockingSize);
+    multiple_shooting::holdInputOnBlocks(moveBlockingIndices_, u);
+  }
 
   // Bookkeeping
   performanceIndeces_.clear();
   std::vector<Metrics> metrics;
+  const bool isLqApproximationInPlace = isApproximatedInPlace(ocpDefinitions_.front(), timeDiscretization);
 
   int iter = 0;
   sqp::Convergence convergence = sqp::Convergence::FALSE;
   while (convergence == sqp::Convergence::FALSE) {
+    OCS2_TRACE_ZONE("SqpSolver::iteration");
     if (settings_.printSolverStatus || settings_.printLinesearch) {
       std::cerr << "\nSQP iteration: " << iter << "\n";
     }
+    // Only the LQ approximation is reported as a steady-state phase. The buffers of the nodes are passed between the workers and the LQ
+    // approximation by swapping, all of them have their dimensions from the third iteration on. The allocations of the other phases are
+    // counted but not reported as violations: the QP solution returns by value, and the linesearch records the performance of every
+    // iteration.
+    const bool isSteadyState = isLqApproximationInPlace && iter >= 2;
+
     // Make QP approximation
     linearQuadraticApproximationTimer_.startTimer();
+    linearQuadraticApproximationAllocations_.start();
     const auto baselinePerformance = setupQuadraticSubproblem(timeDiscretization, initState, x, u, metrics);
+    linearQuadraticApproximationAllocations_.end(isSteadyState);
     linearQuadraticApproximationTimer_.endTimer();
 
     // Solve QP
     solveQpTimer_.startTimer();
+    solveQpAllocations_.start();
     const vector_t delta_x0 = initState - x[0];
     const auto deltaSolution = getOCPSolution(delta_x0);
     extractValueFunction(timeDiscretization, x);
+    solveQpAllocations_.end();
     solveQpTimer_.endTimer();
 
     // Apply step
     linesearchTimer_.startTimer();
+    linesearchAllocations_.start();
     const auto stepInfo = takeStep(baselinePerformance, timeDiscretization, initState, deltaSolution, x, u, metrics);
     performanceIndeces_.push_back(stepInfo.performanceAfterStep);
+    linesearchAllocations_.end();
     linesearchTimer_.endTimer();
 
     // Check convergence
     convergence = checkConvergence(iter, baselinePerformance, stepInfo);
 
+    // Publish the intermediate iterate
+    if (convergence == sqp::Convergence::FALSE && this->hasIntermediateSolutionCallback()) {
+      const auto intermediateSolution = toPrimalSolution(timeDiscretization, vector_array_t(x), vector_array_t(u));
+      this->publishIntermediateSolution(intermediateSolution, stepInfo.performanceAfterStep);
+    }
+
     // Logging
     if (settings_.enableLogging) {
       auto& logEntry = logger_.currentEntry();
@@ -273,11 +353,127 @@ void SqpSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
   }
 }
 
-void SqpSolver::runParallel(std::function<void(int)> taskFunction) {
-  threadPool_.runParallel(std::move(taskFunction), settings_.nThreads);
+void SqpSolver::prepareRealTimeIteration(scalar_t initTime, scalar_t finalTime) {
+  OCS2_TRACE_ZONE("SqpSolver::prepareRealTimeIteration");
+  auto& rti = realTimeIteration_;
+  rti.isPrepared = false;
+  if (primalSolution_.timeTrajectory_.empty()) {
+    return;
+  }
+
+  // Determine time discretization, taking into account event times.
+  const auto& modeSchedule = this->getReferenceManager().getModeSchedule();
+  rti.timeDiscretization = getTimeDiscretization(initTime, finalTime, settings_.dt, settings_.dtGrowthRate, settings_.dtMax,
+                                                 settings_.horizonShiftingWarmStart, modeSchedule.eventTimes);
+  rti.modeSchedule = modeSchedule;
+
+  // Initialize references
+  for (auto& ocpDefinition : ocpDefinitions_) {
+    const auto& targetTrajectories = this->getReferenceManager().getTargetTrajectories();
+    ocpDefinition.targetTrajectoriesPtr = &targetTrajectories;
+  }
+
+  // Shift the previous solution to the new horizon, the initial state is predicted by the previous solution.
+  std::ignore = trajectorySpread(primalSolution_.modeSchedule_, modeSchedule, primalSolution_);
+  const vector_t predictedInitState =
+      LinearInterpolation::interpolate(initTime, primalSolution_.timeTrajectory_, primalSolution_.stateTrajectory_);
+  if (settings_.horizonShiftingWarmStart) {
+    multiple_shooting::shiftStateInputTrajectories(predictedInitState, rti.timeDiscretization, primalSolution_, *initializerPtr_, rti.x,
+                                                   rti.u);
+  } else {
+    multiple_shooting::initializeStateInputTrajectories(predictedInitState, rti.timeDiscretization, primalSolution_, *initializerPtr_,
+                                                        rti.x, rti.u);
+  }
+  if (settings_.moveBlockingSize > 1) {
+    moveBlockingIndices_ =
+        multiple_shooting::getMoveBlockingIndices(rti.u, settings_.moveBlockingFreeIntervals, settings_.moveBlockingSize);
+    multiple_shooting::holdInputOnBlocks(moveBlockingIndices_, rti.u);
+  }
+
+  // Make QP approximation
+  linearQuadraticApproximationTimer_.startTimer();
+  rti.performance = setupQuadraticSubproblem(rti.timeDiscretization, rti.x.front(), rti.x, rti.u, rti.metrics);
+  linearQuadraticApproximationTimer_.endTimer();
+
+  rti.isPrepared = true;
+}
+
+void SqpSolver::runRealTimeIteration(scalar_t initTime, const vector_t& initState, scalar_t finalTime) {
+  OCS2_TRACE_ZONE("SqpSolver::runRealTimeIteration");
+  auto& rti = realTimeIteration_;
+
+  // The prepared QP is used for a run that starts up to one interval away from the predicted time: the QP of the predicted grid is
+  // solved and its solution is shifted by the time offset. The grid of an event is not shifted, its nodes would move away from the event.
+  const auto& modeSchedule = this->getReferenceManager().getModeSchedule();
+  constexpr scalar_t timeTolerance = numeric_traits::weakEpsilon<scalar_t>();
+  const scalar_t timeOffset = rti.isPrepared ? initTime - rti.timeDiscretization.front().time : 0.0;
+  const bool isPrepared = rti.isPrepared && std::abs(timeOffset) <= settings_.dt &&
+                          std::abs(rti.timeDiscretization.back().time + timeOffset - finalTime) <= timeTolerance &&
+                          (std::abs(timeOffset) <= timeTolerance || !hasEventNodes(rti.timeDiscretization)) &&
+                          rti.modeSchedule.eventTimes == modeSchedule.eventTimes &&
+                          rti.modeSchedule.modeSequence == modeSchedule.modeSequence;
+  if (isPrepared) {
+    for (auto& t : rti.timeDiscretization) {
+      t.time += timeOffset;
+    }
+  } else {
+    prepareRealTimeIteration(initTime, finalTime);
+  }
+  rti.isPrepared = false;
+
+  // Solve QP
+  solveQpTimer_.startTimer();
+  const vector_t delta_x0 = initState - rti.x[0];
+  const auto deltaSolution = getOCPSolution(delta_x0);
+  extractValueFunction(rti.timeDiscretization, rti.x);
+  solveQpTimer_.endTimer();
+
+  // Take the full step
+  multiple_shooting::incrementTrajectory(rti.x, deltaSolution.deltaXSol, 1.0, rti.x);
+  multiple_shooting::incrementTrajectory(rti.u, deltaSolution.deltaUSol, 1.0, rti.u);
+
+  // Account for initial state in performance
+  PerformanceIndex performance = rti.performance;
+  performance.dynamicsViolationSSE += delta_x0.squaredNorm();
+  rti.metrics.front().dynamicsViolation += delta_x0;
+  performanceIndeces_.clear();
+  performanceIndeces_.push_back(performance);
+
+  // Logging
+  if (settings_.enableLogging) {
+    auto& logEntry = logger_.currentEntry();
+    logEntry.problemNumber = numProblems_;
+    logEntry.time = initTime;
+    logEntry.iteration = 0;
+    logEntry.linearQuadraticApproximationTime = linearQuadraticApproximationTimer_.getLastIntervalInMilliseconds();
+    logEntry.solveQpTime = solveQpTimer_.getLastIntervalInMilliseconds();
+    logEntry.linesearchTime = 0.0;
+    logEntry.baselinePerformanceIndex = performance;
+    logEntry.totalConstraintViolationBaseline = FilterLinesearch::totalConstraintViolation(performance);
+    logEntry.stepInfo = sqp::StepInfo();
+    logEntry.stepInfo.stepSize = 1.0;
+    logEntry.stepInfo.dx_norm = multiple_shooting::trajectoryNorm(deltaSolution.deltaXSol);
+    logEntry.stepInfo.du_norm = multiple_shooting::trajectoryNorm(deltaSolution.deltaUSol);
+    logEntry.convergence = sqp::Convergence::ITERATIONS;
+    logger_.advance();
+  }
+
+  ++numProblems_;
+  ++totalNumIterations_;
+
+  computeControllerTimer_.startTimer();
+  primalSolution_ = toPrimalSolution(rti.timeDiscretization, std::move(rti.x), std::move(rti.u));
+  problemMetrics_ = multiple_shooting::toProblemMetrics(rti.timeDiscretization, std::move(rti.metrics));
+  computeControllerTimer_.endTimer();
+}
+
+template <typename Functor>
+void SqpSolver::parallelFor(int begin, int end, Functor&& taskFunction) {
+  threadPool_.parallelFor(begin, end, 1, std::forward<Functor>(taskFunction));
 }
 
 SqpSolver::OcpSubproblemSolution SqpSolver::getOCPSolution(const vector_t& delta_x0) {
+  OCS2_TRACE_ZONE("SqpSolver::solveQp");
   // Solve the QP
   OcpSubproblemSolution solution;
   auto& deltaXSol = solution.deltaXSol;
@@ -288,6 +484,12 @@ SqpSolver::OcpSubproblemSolution SqpSolver::getOCPSolution(const vector_t& delta
     hpipmInterface_.resize(extractSizesFromProblem(dynamics_, cost_, &stateInputEqConstraints_));
     status =
         hpipmInterface_.solve(delta_x0, dynamics_, cost_, &stateInputEqConstraints_, deltaXSol, deltaUSol, settings_.printSolverStatus);
+  } else if (settings_.moveBlockingSize > 1) {  // unconstrained QP with a single input per block
+    moveBlockingArena_.reset();
+    multiple_shooting::reduceMoveBlocking(moveBlockingIndices_, dynamics_, cost_, blockedDynamics_, blockedCost_, moveBlockingArena_);
+    hpipmInterface_.resize(extractSizesFromProblem(blockedDynamics_, blockedCost_, nullptr));
+    status = hpipmInterface_.solve(delta_x0, blockedDynamics_, blockedCost_, nullptr, blockedDeltaXSol_, blockedDeltaUSol_,
+                                   settings_.printSolverStatus);
   } else {  // without constraints, or when using projection, we have an unconstrained QP.
     hpipmInterface_.resize(extractSizesFromProblem(dynamics_, cost_, nullptr));
     status = hpipmInterface_.solve(delta_x0, dynamics_, cost_, nullptr, deltaXSol, deltaUSol, settings_.printSolverStatus);
@@ -297,6 +499,10 @@ SqpSolver::OcpSubproblemSolution SqpSolver::getOCPSolution(const vector_t& delta
     throw std::runtime_error("[SqpSolver] Failed to solve QP");
   }
 
+  if (settings_.moveBlockingSize > 1) {
+    multiple_shooting::expandMoveBlocking(moveBlockingIndices_, dynamics_, blockedDeltaXSol_, blockedDeltaUSol_, deltaXSol, deltaUSol);
+  }
+
   // to determine if the solution is a descent direction for the cost: compute gradient(cost)' * [dx; du]
   solution.armijoDescentMetric = armijoDescentMetric(cost_, deltaXSol, deltaUSol);
 
@@ -319,9 +525,16 @@ void SqpSolver::extractValueFunction(const std::vector<AnnotatedTime>& time, con
 }
 
 PrimalSolution SqpSolver::toPrimalSolution(const std::vector<AnnotatedTime>& time, vector_array_t&& x, vector_array_t&& u) {
+  OCS2_TRACE_ZONE("SqpSolver::toPrimalSolution");
   if (settings_.useFeedbackPolicy) {
     ModeSchedule modeSchedule = this->getReferenceManager().getModeSchedule();
-    matrix_array_t KMatrices = hpipmInterface_.getRiccatiFeedback(dynamics_[0], cost_[0]);
+    matrix_array_t KMatrices;
+    if (settings_.moveBlockingSize > 1) {
+      const auto blockedKMatrices = hpipmInterface_.getRiccatiFeedback(blockedDynamics_[0], blockedCost_[0]);
+      multiple_shooting::expandMoveBlockingGain(moveBlockingIndices_, dynamics_, blockedKMatrices, KMatrices);
+    } else {
+      KMatrices = hpipmInterface_.getRiccatiFeedback(dynamics_[0], cost_[0]);
+    }
     if (settings_.projectStateInputEqualityConstraints) {
       multiple_shooting::remapProjectedGain(constraintsProjection_, KMatrices);
     }
@@ -335,10 +548,12 @@ PrimalSolution SqpSolver::toPrimalSolution(const std::vector<AnnotatedTime>& tim
 
 PerformanceIndex SqpSolver::setupQuadraticSubproblem(const std::vector<AnnotatedTime>& time, const vector_t& initState,
                                                      const vector_array_t& x, const vector_array_t& u, std::vector<Metrics>& metrics) {
+  OCS2_TRACE_ZONE("SqpSolver::setupQuadraticSubproblem");
   // Problem horizon
   const int N = static_cast<int>(time.size()) - 1;
 
-  std::vector<PerformanceIndex> performance(settings_.nThreads, PerformanceIndex());
+  auto& performance = workerPerformance_;
+  performance.assign(settings_.nThreads, PerformanceIndex());
   cost_.resize(N + 1);
   dynamics_.resize(N);
   stateInputEqConstraints_.resize(N + 1);  // +1 because of HpipmInterface size check
@@ -348,67 +563,103 @@ PerformanceIndex SqpSolver::setupQuadraticSubproblem(const std::vector<Annotated
   projectionMultiplierCoefficients_.resize(N);
   metrics.resize(N + 1);
 
-  std::atomic_int timeIndex{0};
-  auto parallelTask = [&](int workerId) {
-    // Get worker specific resources
-    OptimalControlProblem& ocpDefinition = ocpDefinitions_[workerId];
-    PerformanceIndex workerPerformance;  // Accumulate performance in local variable
-
-    int i = timeIndex++;
-    while (i < N) {
-      if (time[i].event == AnnotatedTime::Event::PreEvent) {
-        // Event node
-        auto result = multiple_shooting::setupEventNode(ocpDefinition, time[i].time, x[i], x[i + 1]);
-        metrics[i] = multiple_shooting::computeMetrics(result);
-        workerPerformance += multiple_shooting::computePerformanceIndex(result);
-        cost_[i] = std::move(result.cost);
-        dynamics_[i] = std::move(result.dynamics);
-        stateInputEqConstraints_[i].resize(0, x[i].size());
-        stateIneqConstraints_[i] = std::move(result.ineqConstraints);
-        stateInputIneqConstraints_[i].resize(0, x[i].size());
-        constraintsProjection_[i].resize(0, x[i].size());
-        projectionMultiplierCoefficients_[i] = multiple_shooting::ProjectionMultiplierCoefficients();
-      } else {
-        // Normal, intermediate node
-        const scalar_t ti = getIntervalStart(time[i]);
-        const scalar_t dt = getIntervalDuration(time[i], time[i + 1]);
-        auto result = multiple_shooting::setupIntermediateNode(ocpDefinition, sensitivityDiscretizer_, ti, dt, x[i], x[i + 1], u[i]);
-        metrics[i] = multiple_shooting::computeMetrics(result);
-        workerPerformance += multiple_shooting::computePerformanceIndex(result, dt);
-        if (settings_.projectStateInputEqualityConstraints) {
-          multiple_shooting::projectTranscription(result, settings_.extractProjectionMultiplier);
-        }
-        cost_[i] = std::move(result.cost);
-        dynamics_[i] = std::move(result.dynamics);
-        stateInputEqConstraints_[i] = std::move(result.stateInputEqConstraints);
-        stateIneqConstraints_[i] = std::move(result.stateIneqConstraints);
-        stateInputIneqConstraints_[i] = std::move(result.stateInputIneqConstraints);
-        constraintsProjection_[i] = std::move(result.constraintsProjection);
-        projectionMultiplierCoefficients_[i] = std::move(result.projectionMultiplierCoefficients);
-      }
+  // Metrics, projection and storage of an intermediate node whose transcription is computed
+  auto finishIntermediateNode = [&](int workerId, int i, scalar_t dt, multiple_shooting::Transcription& result) {
+    multiple_shooting::computeMetrics(result, metrics[i]);
+    performance[workerId] += multiple_shooting::computePerformanceIndex(result, dt);
+    if (settings_.projectStateInputEqualityConstraints) {
+      // The arena only holds the temporaries of one node, such that its size does not depend on the distribution of the nodes
+      workerArenas_[workerId].reset();
+      multiple_shooting::projectTranscription(result, settings_.extractProjectionMultiplier, workerArenas_[workerId]);
+    }
+    // Swapping hands the buffers of the previous approximation of node i back to the worker for reuse
+    std::swap(cost_[i], result.cost);
+    std::swap(dynamics_[i], result.dynamics);
+    std::swap(stateInputEqConstraints_[i], result.stateInputEqConstraints);
+    std::swap(stateIneqConstraints_[i], result.stateIneqConstraints);
+    std::swap(stateInputIneqConstraints_[i], result.stateInputIneqConstraints);
+    std::swap(constraintsProjection_[i], result.constraintsProjection);
+    std::swap(projectionMultiplierCoefficients_[i], result.projectionMultiplierCoefficients);
+  };
 
-      i = timeIndex++;
+  // Group consecutive intermediate nodes in blocks of up to numLanes nodes, such that their dynamics are evaluated at once. The terminal
+  // and the event nodes are blocks of their own.
+  const auto numLanes = static_cast<int>(ocpDefinitions_.front().dynamicsPtr->getNumLanes());
+  const auto isIntermediateNode = [&](int i) { return i < N && time[i].event != AnnotatedTime::Event::PreEvent; };
+  nodeBlocks_.clear();
+  for (int i = 0; i <= N;) {
+    int end = i + 1;
+    if (isIntermediateNode(i)) {
+      while (end < N && end - i < numLanes && isIntermediateNode(end)) {
+        end++;
+      }
     }
+    nodeBlocks_.emplace_back(i, end);
+    i = end;
+  }
+
+  auto parallelTask = [&](int workerId, int b) {
+    // Get worker specific resources
+    OptimalControlProblem& ocpDefinition = ocpDefinitions_[workerId];
+    PerformanceIndex& workerPerformance = performance[workerId];  // Accumulate performance per worker
+    const int begin = nodeBlocks_[b].first;
+    const int end = nodeBlocks_[b].second;
 
-    if (i == N) {  // Only one worker will execute this
+    if (begin == N) {
+      // Terminal node
+      OCS2_TRACE_ZONE("SqpSolver::setupNode");
       const scalar_t tN = getIntervalStart(time[N]);
-      auto result = multiple_shooting::setupTerminalNode(ocpDefinition, tN, x[N]);
+      auto& result = terminalTranscription_;
+      multiple_shooting::setupTerminalNode(ocpDefinition, tN, x[N], result);
+      metrics[N] = multiple_shooting::computeMetrics(result);
+      workerPerformance += multiple_shooting::computePerformanceIndex(result);
+      std::swap(cost_[N], result.cost);
+      stateInputEqConstraints_[N].resize(0, x[N].size());
+      std::swap(stateIneqConstraints_[N], result.ineqConstraints);
+    } else if (time[begin].event == AnnotatedTime::Event::PreEvent) {
+      // Event node
+      OCS2_TRACE_ZONE("SqpSolver::setupNode");
+      const int i = begin;
+      auto result = multiple_shooting::setupEventNode(ocpDefinition, time[i].time, x[i], x[i + 1]);
       metrics[i] = multiple_shooting::computeMetrics(result);
       workerPerformance += multiple_shooting::computePerformanceIndex(result);
       cost_[i] = std::move(result.cost);
+      dynamics_[i] = std::move(result.dynamics);
       stateInputEqConstraints_[i].resize(0, x[i].size());
       stateIneqConstraints_[i] = std::move(result.ineqConstraints);
+      stateInputIneqConstraints_[i].resize(0, x[i].size());
+      constraintsProjection_[i].resize(0, x[i].size());
+      projectionMultiplierCoefficients_[i] = multiple_shooting::ProjectionMultiplierCoefficients();
+    } else {
+      // Normal, intermediate nodes, written into the storage of the worker
+      OCS2_TRACE_ZONE("SqpSolver::setupNodeBlock");
+      auto& workspace = workerBlocks_[workerId];
+      auto& block = workspace.block;
+      block.resize(end - begin);
+      if (workspace.xNext.size() < block.size) {
+        workspace.xNext.resize(block.size);
+        workspace.transcriptions.resize(block.size);
+      }
+      for (int i = begin; i < end; i++) {
+        const int k = i - begin;
+        block.t[k] = getIntervalStart(time[i]);
+        block.dt[k] = getIntervalDuration(time[i], time[i + 1]);
+        block.x[k] = x[i];
+        block.u[k] = u[i];
+        workspace.xNext[k] = x[i + 1];
+      }
+      multiple_shooting::setupIntermediateNodes(ocpDefinition, blockSensitivityDiscretizer_, block, workspace.xNext,
+                                                workspace.transcriptions);
+      for (int i = begin; i < end; i++) {
+        finishIntermediateNode(workerId, i, block.dt[i - begin], workspace.transcriptions[i - begin]);
+      }
     }
-
-    // Accumulate! Same worker might run multiple tasks
-    performance[workerId] += workerPerformance;
   };
-  runParallel(std::move(parallelTask));
+  parallelFor(0, static_cast<int>(nodeBlocks_.size()), std::move(parallelTask));
 
   // Account for initial state in performance
-  const vector_t initDynamicsViolation = initState - x.front();
-  metrics.front().dynamicsViolation += initDynamicsViolation;
-  performance.front().dynamicsViolationSSE += initDynamicsViolation.squaredNorm();
+  metrics.front().dynamicsViolation += initState - x.front();
+  performance.front().dynamicsViolationSSE += (initState - x.front()).squaredNorm();
 
   // Sum performance of the threads
   PerformanceIndex totalPerformance = std::accumulate(std::next(performance.begin()), performance.end(), performance.front());
@@ -419,40 +670,35 @@ PerformanceIndex SqpSolver::setupQuadraticSubproblem(const std::vector<Annotated
 
 PerformanceIndex SqpSolver::computePerformance(const std::vector<AnnotatedTime>& time, const vector_t& initState, const vector_array_t& x,
                                                const vector_array_t& u, std::vector<Metrics>& metrics) {
+  OCS2_TRACE_ZONE("SqpSolver::computePerformance");
   // Problem size
   const int N = static_cast<int>(time.size()) - 1;
   metrics.resize(N + 1);
 
-  std::vector<PerformanceIndex> performance(settings_.nThreads, PerformanceIndex());
-  std::atomic_int timeIndex{0};
-  auto parallelTask = [&](int workerId) {
+  auto& performance = workerPerformance_;
+  performance.assign(settings_.nThreads, PerformanceIndex());
+  auto parallelTask = [&](int workerId, int i) {
     // Get worker specific resources
     OptimalControlProblem& ocpDefinition = ocpDefinitions_[workerId];
 
-    int i = timeIndex++;
-    while (i < N) {
-      if (time[i].event == AnnotatedTime::Event::PreEvent) {
-        // Event node
-        metrics[i] = multiple_shooting::computeEventMetrics(ocpDefinition, time[i].time, x[i], x[i + 1]);
-        performance[workerId] += toPerformanceIndex(metrics[i]);
-      } else {
-        // Normal, intermediate node
-        const scalar_t ti = getIntervalStart(time[i]);
-        const scalar_t dt = getIntervalDuration(time[i], time[i + 1]);
-        metrics[i] = multiple_shooting::computeIntermediateMetrics(ocpDefinition, discretizer_, ti, dt, x[i], x[i + 1], u[i]);
-        performance[workerId] += toPerformanceIndex(metrics[i], dt);
-      }
-
-      i = timeIndex++;
-    }
-
-    if (i == N) {  // Only one worker will execute this
+    if (i == N) {
+      // Terminal node
       const scalar_t tN = getIntervalStart(time[N]);
       metrics[N] = multiple_shooting::computeTerminalMetrics(ocpDefinition, tN, x[N]);
       performance[workerId] += toPerformanceIndex(metrics[N]);
+    } else if (time[i].event == AnnotatedTime::Event::PreEvent) {
+      // Event node
+      metrics[i] = multiple_shooting::computeEventMetrics(ocpDefinition, time[i].time, x[i], x[i + 1]);
+      performance[workerId] += toPerformanceIndex(metrics[i]);
+    } else {
+      // Normal, intermediate node
+      const scalar_t ti = getIntervalStart(time[i]);
+      const scalar_t dt = getIntervalDuration(time[i], time[i + 1]);
+      metrics[i] = multiple_shooting::computeIntermediateMetrics(ocpDefinition, discretizer_, ti, dt, x[i], x[i + 1], u[i]);
+      performance[workerId] += toPerformanceIndex(metrics[i], dt);
     }
   };
-  runParallel(std::move(parallelTask));
+  parallelFor(0, N + 1, std::move(parallelTask));
 
   // Account for initial state in performance
   const vector_t initDynamicsViolation = initState - x.front();
@@ -468,6 +714,7 @@ PerformanceIndex SqpSolver::computePerformance(const std::vector<AnnotatedTime>&
 sqp::StepInfo SqpSolver::takeStep(const PerformanceIndex& baseline, const std::vector<AnnotatedTime>& timeDiscretization,
                                   const vector_t& initState, const OcpSubproblemSolution& subproblemSolution, vector_array_t& x,
                                   vector_array_t& u, std::vector<Metrics>& metrics) {
+  OCS2_TRACE_ZONE("SqpSolver::takeStep");
   using StepType = FilterLinesearch::StepType;
 
   /*
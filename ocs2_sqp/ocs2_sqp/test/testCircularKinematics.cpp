@@ -141,3 +141,57 @@ TEST(test_circular_kinematics, solve_EqConstraints_inQPSubproblem) {
     ASSERT_TRUE(u.isApprox(primalSolution.controllerPtr_->computeInput(t, x)));
   }
 }
+
+TEST(test_circular_kinematics, intermediate_solutions) {
+  // optimal control problem
+  ocs2::OptimalControlProblem problem = ocs2::createCircularKinematicsProblem("/tmp/ocs2/sqp_test_generated");
+
+  // Initializer
+  ocs2::DefaultInitializer zeroInitializer(2);
+
+  // Solver settings
+  ocs2::sqp::Settings settings;
+  settings.dt = 0.01;
+  settings.sqpIteration = 20;
+  settings.projectStateInputEqualityConstraints = true;
+  settings.useFeedbackPolicy = true;
+  settings.nThreads = 1;
+
+  // Additional problem definitions
+  const ocs2::scalar_t startTime = 0.0;
+  const ocs2::scalar_t finalTime = 1.0;
+  const ocs2::vector_t initState = (ocs2::vector_t(2) << 1.0, 0.0).finished();  // radius 1.0
+
+  // Collect the intermediate iterates
+  std::vector<ocs2::PrimalSolution> intermediateSolutions;
+  std::vector<ocs2::PerformanceIndex> intermediatePerformances;
+  ocs2::SqpSolver solver(settings, problem, zeroInitializer);
+  solver.setIntermediateSolutionCallback([&](const ocs2::PrimalSolution& primalSolution, const ocs2::PerformanceIndex& performance) {
+    intermediateSolutions.push_back(primalSolution);
+    intermediatePerformances.push_back(performance);
+  });
+  solver.run(startTime, initState, finalTime);
+
+  // All iterates except the last one are published
+  const auto& iterationsLog = solver.getIterationsLog();
+  ASSERT_GT(iterationsLog.size(), 1);
+  ASSERT_EQ(intermediateSolutions.size(), iterationsLog.size() - 1);
+  for (size_t i = 0; i < intermediateSolutions.size(); i++) {
+    const auto& primalSolution = intermediateSolutions[i];
+    ASSERT_DOUBLE_EQ(primalSolution.timeTrajectory_.front(), startTime);
+    ASSERT_DOUBLE_EQ(primalSolution.timeTrajectory_.back(), finalTime);
+    ASSERT_EQ(primalSolution.stateTrajectory_.size(), primalSolution.timeTrajectory_.size());
+    ASSERT_TRUE(primalSolution.controllerPtr_ != nullptr);
+    ASSERT_DOUBLE_EQ(intermediatePerformances[i].merit, iterationsLog[i].merit);
+  }
+
+  // Without a callback, the solution is the same
+  ocs2::SqpSolver referenceSolver(settings, problem, zeroInitializer);
+  referenceSolver.run(startTime, initState, finalTime);
+  const auto primalSolution = solver.primalSolution(finalTime);
+  const auto referenceSolution = referenceSolver.primalSolution(finalTime);
+  ASSERT_EQ(primalSolution.stateTrajectory_.size(), referenceSolution.stateTrajectory_.size());
+  for (size_t i = 0; i < primalSolution.stateTrajectory_.size(); i++) {
+    ASSERT_TRUE(primalSolution.stateTrajectory_[i].isApprox(referenceSolution.stateTrajectory_[i]));
+  }
+}
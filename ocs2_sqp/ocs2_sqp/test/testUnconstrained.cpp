@@ -29,9 +29,14 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <memory>
+
+#include "ocs2_sqp/SqpMpc.h"
 #include "ocs2_sqp/SqpSolver.h"
 
 #include <ocs2_core/initialization/DefaultInitializer.h>
+#include <ocs2_core/misc/AllocationTracking.h>
 
 #include <ocs2_oc/synchronized_module/ReferenceManager.h>
 #include <ocs2_oc/test/testProblemsGeneration.h>
@@ -91,6 +96,61 @@ std::pair<PrimalSolution, std::vector<PerformanceIndex>> solveWithFeedbackSettin
   return {solver.primalSolution(finalTime), solver.getIterationsLog()};
 }
 
+/** Linear dynamics that count the linearizations of all clones */
+class CountingSystemDynamics final : public LinearSystemDynamics {
+ public:
+  CountingSystemDynamics(matrix_t A, matrix_t B, std::shared_ptr<std::atomic<int>> numLinearizationsPtr)
+      : LinearSystemDynamics(std::move(A), std::move(B)), numLinearizationsPtr_(std::move(numLinearizationsPtr)) {}
+
+  CountingSystemDynamics* clone() const override { return new CountingSystemDynamics(*this); }
+
+  VectorFunctionLinearApproximation linearApproximation(scalar_t t, const vector_t& x, const vector_t& u,
+                                                        const PreComputation& preComp) override {
+    ++*numLinearizationsPtr_;
+    return LinearSystemDynamics::linearApproximation(t, x, u, preComp);
+  }
+
+  void linearApproximationBatch(size_t numPoints, const scalar_array_t& t, const vector_array_t& x, const vector_array_t& u,
+                                std::vector<VectorFunctionLinearApproximation>& approximations) override {
+    *numLinearizationsPtr_ += static_cast<int>(numPoints);
+    LinearSystemDynamics::linearApproximationBatch(numPoints, t, x, u, approximations);
+  }
+
+ private:
+  std::shared_ptr<std::atomic<int>> numLinearizationsPtr_;
+};
+
+/** Linear dynamics with an added sinusoidal term, such that the SQP takes several iterations. The approximations are written in place. */
+class SinusoidalSystemDynamics final : public LinearSystemDynamics {
+ public:
+  SinusoidalSystemDynamics(matrix_t A, matrix_t B) : LinearSystemDynamics(std::move(A), std::move(B)) {}
+
+  SinusoidalSystemDynamics* clone() const override { return new SinusoidalSystemDynamics(*this); }
+
+  vector_t computeFlowMap(scalar_t t, const vector_t& x, const vector_t& u, const PreComputation& preComp) override {
+    vector_t f = LinearSystemDynamics::computeFlowMap(t, x, u, preComp);
+    f.array() += x.array().sin();
+    return f;
+  }
+
+  VectorFunctionLinearApproximation linearApproximation(scalar_t t, const vector_t& x, const vector_t& u,
+                                                        const PreComputation& preComp) override {
+    auto approximation = LinearSystemDynamics::linearApproximation(t, x, u, preComp);
+    approximation.f.array() += x.array().sin();
+    approximation.dfdx.diagonal().array() += x.array().cos();
+    return approximation;
+  }
+
+  void linearApproximationBatch(size_t numPoints, const scalar_array_t& t, const vector_array_t& x, const vector_array_t& u,
+                                std::vector<VectorFunctionLinearApproximation>& approximations) override {
+    LinearSystemDynamics::linearApproximationBatch(numPoints, t, x, u, approximations);
+    for (size_t k = 0; k < numPoints; k++) {
+      approximations[k].f.array() += x[k].array().sin();
+      approximations[k].dfdx.diagonal().array() += x[k].array().cos();
+    }
+  }
+};
+
 }  // namespace
 }  // namespace ocs2
 
@@ -160,3 +220,145 @@ TEST(test_unconstrained, noFeedback) {
         withEmptyConstraint.controllerPtr_->computeInput(t, x).isApprox(withNullConstraint.controllerPtr_->computeInput(t, x), tol));
   }
 }
+
+TEST(test_unconstrained, realTimeIteration) {
+  int n = 3;
+  int m = 2;
+  const double tol = 1e-9;
+  const auto dynamics = ocs2::getRandomDynamics(n, m);
+  const auto costs = ocs2::getRandomCost(n, m);
+  auto numLinearizationsPtr = std::make_shared<std::atomic<int>>(0);
+
+  ocs2::OptimalControlProblem problem;
+  problem.dynamicsPtr.reset(new ocs2::CountingSystemDynamics(dynamics.dfdx, dynamics.dfdu, numLinearizationsPtr));
+  problem.costPtr->add("intermediateCost", ocs2::getOcs2Cost(costs));
+  problem.finalCostPtr->add("finalCost", ocs2::getOcs2StateCost(costs));
+  ocs2::TargetTrajectories targetTrajectories({0.0}, {ocs2::vector_t::Ones(n)}, {ocs2::vector_t::Ones(m)});
+  problem.targetTrajectoriesPtr = &targetTrajectories;
+  ocs2::DefaultInitializer zeroInitializer(m);
+
+  ocs2::sqp::Settings settings;
+  settings.dt = 0.05;
+  settings.sqpIteration = 10;
+  settings.nThreads = 2;
+  ocs2::SqpSolver referenceSolver(settings, problem, zeroInitializer);
+  referenceSolver.setReferenceManager(std::make_shared<ocs2::ReferenceManager>(targetTrajectories));
+
+  // The next run is predicted 0.1 [s] after the last one
+  ocs2::mpc::Settings mpcSettings;
+  mpcSettings.timeHorizon_ = 1.0;
+  mpcSettings.mpcDesiredFrequency_ = 10.0;
+  settings.realTimeIteration = true;
+  ocs2::SqpMpc mpc(mpcSettings, settings, problem, zeroInitializer);
+  mpc.getSolverPtr()->setReferenceManager(std::make_shared<ocs2::ReferenceManager>(targetTrajectories));
+
+  // The first run is solved to convergence
+  const ocs2::vector_t initState = ocs2::vector_t::Ones(n);
+  referenceSolver.run(0.0, initState, 1.0);
+  ASSERT_TRUE(mpc.run(0.0, initState));
+
+  // Each further run starts off the predicted time. The QP prepared on the predicted grid is solved without a new linearization and
+  // its solution is shifted to the actual time, which is exact for a time-invariant linear-quadratic problem.
+  for (const ocs2::scalar_t initTime : {0.103, 0.198, 0.3}) {
+    const int numLinearizationsBeforePreparation = *numLinearizationsPtr;
+    mpc.prepareNextRun();
+    const int numLinearizations = *numLinearizationsPtr;
+    ASSERT_GT(numLinearizations, numLinearizationsBeforePreparation);
+
+    const ocs2::vector_t measuredState = ocs2::vector_t::Random(n);
+    ASSERT_TRUE(mpc.run(initTime, measuredState));
+    ASSERT_EQ(*numLinearizationsPtr, numLinearizations) << "MESSAGE: the prepared QP was not reused!";
+    ASSERT_EQ(mpc.getSolverPtr()->getIterationsLog().size(), 1);
+
+    referenceSolver.run(initTime, measuredState, initTime + 1.0);
+    const auto referenceSolution = referenceSolver.primalSolution(initTime + 1.0);
+    const auto rtiSolution = mpc.getSolverPtr()->primalSolution(initTime + 1.0);
+    ASSERT_EQ(rtiSolution.timeTrajectory_.size(), referenceSolution.timeTrajectory_.size());
+    for (int i = 0; i < rtiSolution.timeTrajectory_.size(); i++) {
+      ASSERT_NEAR(rtiSolution.timeTrajectory_[i], referenceSolution.timeTrajectory_[i], tol);
+      ASSERT_TRUE(rtiSolution.stateTrajectory_[i].isApprox(referenceSolution.stateTrajectory_[i], tol));
+    }
+  }
+}
+
+TEST(test_unconstrained, moveBlocking) {
+  int n = 3;
+  int m = 2;
+  const double tol = 1e-9;
+  const auto dynamics = ocs2::getRandomDynamics(n, m);
+  const auto costs = ocs2::getRandomCost(n, m);
+
+  ocs2::OptimalControlProblem problem;
+  problem.dynamicsPtr = ocs2::getOcs2Dynamics(dynamics);
+  problem.costPtr->add("intermediateCost", ocs2::getOcs2Cost(costs));
+  problem.finalCostPtr->add("finalCost", ocs2::getOcs2StateCost(costs));
+  ocs2::TargetTrajectories targetTrajectories({0.0}, {ocs2::vector_t::Ones(n)}, {ocs2::vector_t::Ones(m)});
+  problem.targetTrajectoriesPtr = &targetTrajectories;
+  ocs2::DefaultInitializer zeroInitializer(m);
+
+  ocs2::sqp::Settings settings;
+  settings.dt = 0.05;
+  settings.sqpIteration = 10;
+  settings.nThreads = 2;
+  ocs2::SqpSolver referenceSolver(settings, problem, zeroInitializer);
+  referenceSolver.setReferenceManager(std::make_shared<ocs2::ReferenceManager>(targetTrajectories));
+  settings.moveBlockingSize = 4;
+  settings.moveBlockingFreeIntervals = 2;
+  ocs2::SqpSolver blockingSolver(settings, problem, zeroInitializer);
+  blockingSolver.setReferenceManager(std::make_shared<ocs2::ReferenceManager>(targetTrajectories));
+
+  const ocs2::vector_t initState = ocs2::vector_t::Ones(n);
+  referenceSolver.run(0.0, initState, 1.0);
+  blockingSolver.run(0.0, initState, 1.0);
+
+  // The blocked QP is exact for a linear-quadratic problem, and its cost is bounded by the unrestricted one
+  const auto& performance = blockingSolver.getIterationsLog();
+  ASSERT_LE(performance.size(), 2);
+  ASSERT_LT(performance.back().dynamicsViolationSSE, tol);
+  ASSERT_GE(performance.back().cost, referenceSolver.getIterationsLog().back().cost - tol);
+
+  // 20 intervals with the blocks {0}, {1}, {2, ..., 5}, {6, ..., 9}, ..., {18, 19}
+  const auto solution = blockingSolver.primalSolution(1.0);
+  ASSERT_FALSE(solution.inputTrajectory_[1].isApprox(solution.inputTrajectory_[2], tol));
+  for (int i = 3; i < 6; i++) {
+    ASSERT_TRUE(solution.inputTrajectory_[i].isApprox(solution.inputTrajectory_[2], tol));
+  }
+  ASSERT_TRUE(solution.inputTrajectory_[19].isApprox(solution.inputTrajectory_[18], tol));
+}
+
+TEST(test_unconstrained, steadyStateAllocations) {
+  // The LQ approximation must not allocate from the third iteration on, which aborts the test with Policy::Abort. Without
+  // OCS2_ALLOCATION_TRACKING nothing is counted and the test only checks that the reporting does not interfere with the solver.
+  const auto policy = ocs2::allocation::getPolicy();
+  ocs2::allocation::setPolicy(ocs2::allocation::Policy::Abort);
+
+  int n = 3;
+  int m = 2;
+  const auto dynamics = ocs2::getRandomDynamics(n, m);
+  const auto costs = ocs2::getRandomCost(n, m);
+
+  ocs2::OptimalControlProblem problem;
+  problem.dynamicsPtr.reset(new ocs2::SinusoidalSystemDynamics(dynamics.dfdx, dynamics.dfdu));
+  problem.costPtr->add("intermediateCost", ocs2::getOcs2Cost(costs));
+  problem.finalCostPtr->add("finalCost", ocs2::getOcs2StateCost(costs));
+  ocs2::TargetTrajectories targetTrajectories({0.0}, {ocs2::vector_t::Ones(n)}, {ocs2::vector_t::Ones(m)});
+  problem.targetTrajectoriesPtr = &targetTrajectories;
+  ocs2::DefaultInitializer zeroInitializer(m);
+
+  // The tolerances are disabled, such that only the linesearch or the iteration limit stops the solver
+  ocs2::sqp::Settings settings;
+  settings.dt = 0.05;
+  settings.sqpIteration = 5;
+  settings.deltaTol = -1.0;
+  settings.costTol = -1.0;
+  settings.nThreads = 2;
+  ocs2::SqpSolver solver(settings, problem, zeroInitializer);
+  solver.setReferenceManager(std::make_shared<ocs2::ReferenceManager>(targetTrajectories));
+
+  const auto numViolations = ocs2::allocation::getNumViolations();
+  solver.run(0.0, ocs2::vector_t::Ones(n), 1.0);
+  EXPECT_GE(solver.getIterationsLog().size(), 3) << "MESSAGE: no steady-state iteration was run!";
+  EXPECT_EQ(ocs2::allocation::getNumViolations(), numViolations) << "MESSAGE: the LQ approximation allocated!";
+
+  ocs2::allocation::setPolicy(policy);
+}